@@ -0,0 +1,351 @@
+// bench/actor_workloads.cpp
+// OmniMailbox actor scheduler scaling harness
+//
+// Runs message-passing actor workloads on ActorSystem and sweeps the
+// worker count to show how the work-stealing scheduler scales:
+//
+//   skynet     Every actor spawns 10 children until --depth; leaves reply
+//              with their number, parents sum the 10 replies and pass the
+//              sum up. Spawn-heavy, tree-shaped, mostly stolen work.
+//   ping-ring  --ring-size actors in a ring, --tokens tokens in flight,
+//              each token forwarded --hops times. Send/schedule-heavy;
+//              one token is a pure latency chain, many tokens give the
+//              workers independent work.
+//
+// Every actor-to-actor link is its own SPSC channel (ActorSystem::Connect),
+// so skynet also measures private mailbox queue creation and teardown
+// (actor mailboxes never go through the broker).
+//
+// Usage:
+//   bench-actors [--workload=skynet|ping-ring|both] [--workers=1,2,4]
+//                [--depth=N] [--ring-size=N] [--tokens=N] [--hops=N]
+//                [--batch=N] [--repeat=N]
+
+#include <omni/mailbox.hpp>
+#include "bench_common.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using omni::bench::NowNs;
+
+struct Options {
+    bool skynet = true;
+    bool ping_ring = true;
+    std::vector<int64_t> workers;   // Empty = 1, 2, 4, ... hardware_concurrency()
+    int64_t depth = 4;              // skynet: 10^depth leaves
+    int64_t ring_size = 512;
+    int64_t tokens = 64;
+    int64_t hops = 10'000;          // Per token
+    int64_t batch = 64;
+    int64_t repeat = 3;             // Best of N per row
+};
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (auto v = omni::bench::FlagValue(arg, "workload")) {
+            options.skynet = (*v == "skynet" || *v == "both");
+            options.ping_ring = (*v == "ping-ring" || *v == "both");
+        } else if (auto v = omni::bench::FlagValue(arg, "workers")) {
+            options.workers.clear();
+            for (auto item : omni::bench::SplitList(*v)) {
+                options.workers.push_back(omni::bench::ParseInt(item, -1));
+            }
+        } else if (auto v = omni::bench::FlagValue(arg, "depth")) {
+            options.depth = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "ring-size")) {
+            options.ring_size = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "tokens")) {
+            options.tokens = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "hops")) {
+            options.hops = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "batch")) {
+            options.batch = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "repeat")) {
+            options.repeat = omni::bench::ParseInt(*v, -1);
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    if (options.workers.empty()) {
+        const int64_t cpus = std::max<int64_t>(1, std::thread::hardware_concurrency());
+        for (int64_t n = 1; n < cpus; n *= 2) {
+            options.workers.push_back(n);
+        }
+        options.workers.push_back(cpus);
+    }
+    const bool workers_valid = std::all_of(options.workers.begin(), options.workers.end(),
+                                           [](int64_t n) { return n >= 1; });
+    if ((!options.skynet && !options.ping_ring) || !workers_valid || options.depth < 1 || options.depth > 6 ||
+        options.ring_size < 2 || options.tokens < 1 || options.tokens > options.ring_size ||
+        options.hops < 1 || options.batch < 1 || options.repeat < 1) {
+        std::fprintf(stderr, "Invalid argument (workers >= 1, depth 1..6, 1 <= tokens <= ring-size)\n");
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint8_t> Encode(uint64_t value) {
+    std::vector<uint8_t> bytes(sizeof(value));
+    std::memcpy(bytes.data(), &value, sizeof(value));
+    return bytes;
+}
+
+uint64_t Decode(std::span<const uint8_t> bytes) {
+    uint64_t value = 0;
+    std::memcpy(&value, bytes.data(), sizeof(value));
+    return value;
+}
+
+// Actors never block: a full mailbox (not expected with these sizes) is retried
+void SendOrSpin(omni::ActorRef& ref, std::span<const uint8_t> data) {
+    while (ref.Send(data) == omni::PushResult::QueueFull) {
+        std::this_thread::yield();
+    }
+}
+
+struct RunResult {
+    bool ok = false;
+    double seconds = 0.0;
+    omni::ActorSystem::Stats stats{};
+};
+
+// Completion flag the main thread sleeps on
+struct Done {
+    std::atomic<uint32_t> flag{0};
+    std::atomic<uint64_t> value{0};
+
+    void Set(uint64_t result) noexcept {
+        value.store(result, std::memory_order_relaxed);
+        flag.store(1, std::memory_order_release);
+        flag.notify_one();
+    }
+
+    uint64_t Wait() noexcept {
+        flag.wait(0, std::memory_order_acquire);
+        return value.load(std::memory_order_relaxed);
+    }
+};
+
+constexpr omni::ChannelConfig SKYNET_MAILBOX{.capacity = 16, .max_message_size = 64};
+
+// One skynet node: on "go", spawn 10 children (or reply if a leaf), then sum replies
+omni::ActorSystem::Behavior SkynetNode(int64_t level, int64_t depth, uint64_t number,
+                                       std::shared_ptr<omni::ActorRef> parent, Done* done) {
+    return [=, started = false, pending = 10, sum = uint64_t{0}](omni::ActorContext& context, std::span<const uint8_t> message) mutable {
+        auto reply = [&](uint64_t value) {
+            if (parent) {
+                SendOrSpin(*parent, Encode(value));
+            } else {
+                done->Set(value);
+            }
+            context.Stop();
+        };
+
+        if (level == depth) {
+            reply(number);
+            return;
+        }
+        if (!started) {
+            // First message is "go": fan out one level down
+            started = true;
+            auto& system = context.System();
+            uint64_t child_base = number * 10;
+            for (int i = 0; i < 10; ++i) {
+                auto up = system.Connect(context.Self(), SKYNET_MAILBOX);
+                auto child = up ? system.Spawn(SkynetNode(level + 1, depth, child_base + i,
+                                                          std::make_shared<omni::ActorRef>(std::move(*up)), done))
+                                : std::nullopt;
+                auto down = child ? system.Connect(*child, SKYNET_MAILBOX) : std::nullopt;
+                if (!down) {
+                    std::fprintf(stderr, "skynet: spawn failed (max_actors or memory)\n");
+                    std::abort();
+                }
+                SendOrSpin(*down, Encode(0));
+            }
+            return;
+        }
+        sum += Decode(message);
+        if (--pending == 0) {
+            reply(sum);
+        }
+    };
+}
+
+RunResult RunSkynet(const Options& options, size_t workers) {
+    int64_t nodes = 0;
+    for (int64_t level = 0, width = 1; level <= options.depth; ++level, width *= 10) {
+        nodes += width;
+    }
+    const uint64_t leaves = static_cast<uint64_t>(nodes - (nodes - 1) / 10);
+
+    omni::ActorSystemConfig config;
+    config.workers = workers;
+    config.batch_size = static_cast<size_t>(options.batch);
+    config.max_actors = static_cast<size_t>(nodes);
+    omni::ActorSystem system(std::move(config));
+
+    RunResult result;
+    Done done;
+    const uint64_t start = NowNs();
+    auto root = system.Spawn(SkynetNode(0, options.depth, 0, nullptr, &done));
+    auto go = root ? system.Connect(*root, SKYNET_MAILBOX) : std::nullopt;
+    if (!go) {
+        return result;
+    }
+    SendOrSpin(*go, Encode(0));
+    const uint64_t sum = done.Wait();
+    result.seconds = static_cast<double>(NowNs() - start) / 1e9;
+    result.stats = system.GetStats();
+    result.ok = sum == leaves * (leaves - 1) / 2;
+    if (!result.ok) {
+        std::fprintf(stderr, "skynet: wrong sum %llu\n", static_cast<unsigned long long>(sum));
+    }
+    return result;
+}
+
+RunResult RunPingRing(const Options& options, size_t workers) {
+    const size_t ring = static_cast<size_t>(options.ring_size);
+    const uint64_t tokens = static_cast<uint64_t>(options.tokens);
+    const uint64_t hops = static_cast<uint64_t>(options.hops);
+
+    // Every token may sit in one mailbox at once, so sends never see QueueFull
+    const omni::ChannelConfig mailbox{.capacity = std::bit_ceil(static_cast<size_t>(tokens) + 1),
+                                      .max_message_size = 64};
+    omni::ActorSystemConfig config;
+    config.workers = workers;
+    config.batch_size = static_cast<size_t>(options.batch);
+    config.max_actors = ring;
+    config.mailbox = mailbox;
+    omni::ActorSystem system(std::move(config));
+
+    RunResult result;
+    Done done;
+    std::atomic<uint64_t> finished{0};
+    std::vector<std::unique_ptr<omni::ActorRef>> next(ring);
+    std::vector<omni::ActorId> ids;
+    for (size_t i = 0; i < ring; ++i) {
+        auto id = system.Spawn([&, i](omni::ActorContext&, std::span<const uint8_t> message) {
+            const uint64_t remaining = Decode(message);
+            if (remaining == 0) {
+                if (finished.fetch_add(1, std::memory_order_acq_rel) + 1 == tokens) {
+                    done.Set(0);
+                }
+                return;
+            }
+            SendOrSpin(*next[i], Encode(remaining - 1));
+        });
+        if (!id) {
+            return result;
+        }
+        ids.push_back(*id);
+    }
+    for (size_t i = 0; i < ring; ++i) {
+        auto ref = system.Connect(ids[(i + 1) % ring]);
+        if (!ref) {
+            return result;
+        }
+        next[i] = std::make_unique<omni::ActorRef>(std::move(*ref));
+    }
+
+    // Tokens start evenly spaced around the ring
+    std::vector<omni::ActorRef> starters;
+    for (uint64_t t = 0; t < tokens; ++t) {
+        auto ref = system.Connect(ids[t * ring / tokens]);
+        if (!ref) {
+            return result;
+        }
+        starters.push_back(std::move(*ref));
+    }
+
+    const uint64_t start = NowNs();
+    for (auto& starter : starters) {
+        SendOrSpin(starter, Encode(hops));
+    }
+    done.Wait();
+    result.seconds = static_cast<double>(NowNs() - start) / 1e9;
+    result.stats = system.GetStats();
+    result.ok = true;
+
+    // Behaviors reference `next`: stop the workers before it goes away
+    system.Shutdown();
+    return result;
+}
+
+void PrintHeader(const char* title) {
+    std::printf("\n%s\n", title);
+    std::printf("%8s %10s %10s %12s %8s %10s %10s %10s %8s\n",
+                "workers", "time_ms", "messages", "msgs/sec", "speedup", "runs", "steals", "yields", "parks");
+}
+
+void PrintRow(size_t workers, const RunResult& r, double baseline_seconds) {
+    const double rate = r.seconds > 0 ? static_cast<double>(r.stats.messages) / r.seconds : 0.0;
+    std::printf("%8zu %10.2f %10llu %12.0f %7.2fx %10llu %10llu %10llu %8llu\n",
+                workers, r.seconds * 1e3,
+                static_cast<unsigned long long>(r.stats.messages), rate,
+                r.seconds > 0 ? baseline_seconds / r.seconds : 0.0,
+                static_cast<unsigned long long>(r.stats.runs),
+                static_cast<unsigned long long>(r.stats.steals),
+                static_cast<unsigned long long>(r.stats.yields),
+                static_cast<unsigned long long>(r.stats.parks));
+}
+
+// Best of options.repeat runs per worker count; speedup is relative to the first row
+template<typename Workload>
+bool Sweep(const Options& options, const char* title, Workload workload) {
+    PrintHeader(title);
+    double baseline = 0.0;
+    for (int64_t workers : options.workers) {
+        RunResult best;
+        for (int64_t rep = 0; rep < options.repeat; ++rep) {
+            RunResult r = workload(static_cast<size_t>(workers));
+            if (!r.ok) {
+                return false;
+            }
+            if (!best.ok || r.seconds < best.seconds) {
+                best = r;
+            }
+        }
+        if (baseline == 0.0) {
+            baseline = best.seconds;
+        }
+        PrintRow(static_cast<size_t>(workers), best, baseline);
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    if (options.skynet) {
+        const std::string title = "skynet (depth " + std::to_string(options.depth) + ")";
+        if (!Sweep(options, title.c_str(), [&](size_t workers) { return RunSkynet(options, workers); })) {
+            return 1;
+        }
+    }
+    if (options.ping_ring) {
+        const std::string title = "ping-ring (" + std::to_string(options.ring_size) + " actors, " +
+                                  std::to_string(options.tokens) + " tokens x " +
+                                  std::to_string(options.hops) + " hops)";
+        if (!Sweep(options, title.c_str(), [&](size_t workers) { return RunPingRing(options, workers); })) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,250 @@
+// bench/api_paths.cpp
+// OmniMailbox API path benchmarks
+//
+// Throughput of every producer/consumer path, parameterized over message
+// size and ring capacity (and batch size where relevant), so hot loops can
+// pick the cheapest API:
+//   - TryPush (baseline) vs zero-copy Reserve/Commit
+//   - BatchPush and BatchPop at several batch sizes
+//   - BlockingPush/BlockingPop with a parked peer (wake-up path)
+//   - FlatBuffers Telemetry encode/decode through a channel
+//     (bench/flatbuffers_telemetry.cpp)
+//
+// JSON output compatible with benchmark_results.json:
+//   bench-api --benchmark_format=json --benchmark_out=api_results.json
+
+#include <benchmark/benchmark.h>
+#include <omni/mailbox.hpp>
+#include "bench_channel.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using omni::bench::BenchChannel;
+using omni::bench::DrainThread;
+
+constexpr uint8_t STOP_MARKER = 0x00;  // First payload byte that ends a peer thread
+
+// Baseline: TryPush + memcpy of the payload, consumer drains with BatchPop
+static void BM_Path_TryPush(benchmark::State& state) {
+    const size_t msg_size = static_cast<size_t>(state.range(0));
+    BenchChannel channel(state, "bench-api-trypush", static_cast<size_t>(state.range(1)), msg_size);
+    if (!channel) {
+        return;
+    }
+
+    std::vector<uint8_t> payload(msg_size, 0xAB);
+    DrainThread drain(channel->consumer);
+
+    for (auto _ : state) {
+        while (channel->producer.TryPush(payload) != omni::PushResult::Success) {
+            std::this_thread::yield();  // Queue full: let the consumer run
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * msg_size);
+}
+
+// Zero-copy Reserve/Commit: payload written directly into the ring slot
+static void BM_Path_ReserveCommit(benchmark::State& state) {
+    const size_t msg_size = static_cast<size_t>(state.range(0));
+    BenchChannel channel(state, "bench-api-reserve", static_cast<size_t>(state.range(1)), msg_size);
+    if (!channel) {
+        return;
+    }
+
+    DrainThread drain(channel->consumer);
+
+    for (auto _ : state) {
+        auto reservation = channel->producer.Reserve(msg_size);
+        while (!reservation) {
+            std::this_thread::yield();
+            reservation = channel->producer.Reserve(msg_size);
+        }
+        std::memset(reservation->data, 0xAB, msg_size);  // Stand-in for in-place serialization
+        benchmark::DoNotOptimize(channel->producer.Commit(msg_size));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * msg_size);
+}
+
+// BatchPush: one iteration pushes `batch` messages (one notify per call)
+static void BM_Path_BatchPush(benchmark::State& state) {
+    const size_t msg_size = static_cast<size_t>(state.range(0));
+    const size_t batch = static_cast<size_t>(state.range(2));
+    BenchChannel channel(state, "bench-api-batchpush", static_cast<size_t>(state.range(1)), msg_size);
+    if (!channel) {
+        return;
+    }
+
+    std::vector<uint8_t> payload(msg_size, 0xAB);
+    std::vector<std::span<const uint8_t>> spans(batch, std::span<const uint8_t>(payload));
+    DrainThread drain(channel->consumer);
+
+    for (auto _ : state) {
+        std::span<const std::span<const uint8_t>> remaining(spans);
+        while (!remaining.empty()) {
+            const size_t pushed = channel->producer.BatchPush(remaining);
+            remaining = remaining.subspan(pushed);
+            if (!remaining.empty()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+    state.SetBytesProcessed(state.iterations() * batch * msg_size);
+}
+
+// BatchPop: one iteration is one BatchPop(batch) call on a continuously fed queue
+static void BM_Path_BatchPop(benchmark::State& state) {
+    const size_t msg_size = static_cast<size_t>(state.range(0));
+    const size_t batch = static_cast<size_t>(state.range(2));
+    BenchChannel channel(state, "bench-api-batchpop", static_cast<size_t>(state.range(1)), msg_size);
+    if (!channel) {
+        return;
+    }
+
+    std::vector<uint8_t> payload(msg_size, 0xAB);
+    std::atomic<bool> running{true};
+    std::thread feeder([&]() {
+        std::vector<std::span<const uint8_t>> spans(64, std::span<const uint8_t>(payload));
+        while (running.load(std::memory_order_relaxed)) {
+            if (channel->producer.BatchPush(spans) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t received = 0;
+    for (auto _ : state) {
+        auto [result, messages] = channel->consumer.BatchPop(batch);
+        for (const auto& msg : messages) {
+            benchmark::DoNotOptimize(msg.Data().data());
+        }
+        received += messages.size();
+        if (messages.empty()) {
+            std::this_thread::yield();
+        }
+    }
+
+    running.store(false, std::memory_order_relaxed);
+    feeder.join();
+
+    state.SetItemsProcessed(static_cast<int64_t>(received));
+    state.SetBytesProcessed(static_cast<int64_t>(received * msg_size));
+}
+
+// BlockingPush/BlockingPop round trip where each side parks between messages:
+// measures the notify -> wake path rather than the spin path
+static void BM_Path_BlockingParkedPeer(benchmark::State& state) {
+    const size_t msg_size = static_cast<size_t>(state.range(0));
+    const size_t capacity = static_cast<size_t>(state.range(1));
+    BenchChannel request(state, "bench-api-parked-req", capacity, msg_size);
+    BenchChannel reply(state, "bench-api-parked-rep", capacity, msg_size);
+    if (!request || !reply) {
+        return;
+    }
+
+    std::vector<uint8_t> payload(msg_size, 0xAB);
+
+    // Peer parks in BlockingPop (infinite timeout) until the next request.
+    // An infinite wait is only woken by a write_index change, so the run is
+    // ended with an explicit stop message rather than by closing the channel.
+    std::thread peer([&]() {
+        while (true) {
+            auto [result, msg] = request->consumer.BlockingPop();
+            if (result != omni::PopResult::Success || msg->Data()[0] == STOP_MARKER) {
+                break;
+            }
+            if (reply->producer.BlockingPush(msg->Data(), std::chrono::seconds(1)) != omni::PushResult::Success) {
+                break;
+            }
+        }
+    });
+
+    for (auto _ : state) {
+        if (request->producer.BlockingPush(payload, std::chrono::seconds(1)) != omni::PushResult::Success) {
+            state.SkipWithError("BlockingPush failed");
+            break;
+        }
+        auto [result, msg] = reply->consumer.BlockingPop(std::chrono::seconds(1));
+        if (result != omni::PopResult::Success) {
+            state.SkipWithError("BlockingPop failed");
+            break;
+        }
+        benchmark::DoNotOptimize(msg->Data().data());
+    }
+
+    payload[0] = STOP_MARKER;
+    while (request->producer.TryPush(payload) == omni::PushResult::QueueFull) {
+        std::this_thread::yield();
+    }
+    peer.join();
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// BlockingPush/BlockingPop streaming on a small ring: producer repeatedly
+// waits for space while the consumer repeatedly waits for data
+static void BM_Path_BlockingStream(benchmark::State& state) {
+    const size_t msg_size = static_cast<size_t>(state.range(0));
+    BenchChannel channel(state, "bench-api-blocking", static_cast<size_t>(state.range(1)), msg_size);
+    if (!channel) {
+        return;
+    }
+
+    std::vector<uint8_t> payload(msg_size, 0xAB);
+    std::thread consumer([&]() {
+        while (true) {
+            auto [result, msg] = channel->consumer.BlockingPop(std::chrono::milliseconds(100));
+            if (result == omni::PopResult::ChannelClosed) {
+                break;
+            }
+            if (result == omni::PopResult::Success) {
+                benchmark::DoNotOptimize(msg->Data().data());
+            }
+        }
+    });
+
+    for (auto _ : state) {
+        if (channel->producer.BlockingPush(payload, std::chrono::seconds(1)) != omni::PushResult::Success) {
+            state.SkipWithError("BlockingPush failed");
+            break;
+        }
+    }
+
+    channel.CloseProducer();
+    consumer.join();
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * msg_size);
+}
+
+// Message size x capacity grid shared by all paths
+static void SizeCapacityArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"size", "capacity"});
+    b->ArgsProduct({{64, 1024, 4096}, {64, 1024}});
+}
+
+// Message size x capacity x batch grid
+static void BatchArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"size", "capacity", "batch"});
+    b->ArgsProduct({{64, 1024}, {64, 1024}, {8, 32, 128}});
+}
+
+BENCHMARK(BM_Path_TryPush)->Apply(SizeCapacityArgs)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_Path_ReserveCommit)->Apply(SizeCapacityArgs)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_Path_BatchPush)->Apply(BatchArgs)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_Path_BatchPop)->Apply(BatchArgs)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_Path_BlockingParkedPeer)->Apply(SizeCapacityArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Path_BlockingStream)
+    ->ArgNames({"size", "capacity"})
+    ->ArgsProduct({{64, 1024}, {8, 64}})
+    ->Unit(benchmark::kNanosecond);
+
+BENCHMARK_MAIN();
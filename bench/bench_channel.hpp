@@ -0,0 +1,90 @@
+// bench/bench_channel.hpp
+// Google Benchmark helpers: scoped broker channel and background drain thread.
+
+#ifndef OMNI_BENCH_CHANNEL_HPP
+#define OMNI_BENCH_CHANNEL_HPP
+
+#include <benchmark/benchmark.h>
+#include <omni/mailbox.hpp>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace omni::bench {
+
+// Uniquely named channel, removed from the broker when the benchmark ends
+class BenchChannel {
+public:
+    BenchChannel(benchmark::State& state, const std::string& prefix, size_t capacity, size_t max_message_size) {
+        static std::atomic<size_t> counter{0};
+        name_ = prefix + "-" + std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+
+        auto [error, pair] = MailboxBroker::Instance().RequestChannel(name_, {
+            .capacity = capacity,
+            .max_message_size = max_message_size
+        });
+        if (error != ChannelError::Success) {
+            state.SkipWithError("Failed to create channel");
+            return;
+        }
+        pair_ = std::move(pair);
+    }
+
+    ~BenchChannel() {
+        if (pair_) {
+            pair_.reset();
+            MailboxBroker::Instance().RemoveChannel(name_);
+        }
+    }
+
+    BenchChannel(const BenchChannel&) = delete;
+    BenchChannel& operator=(const BenchChannel&) = delete;
+
+    explicit operator bool() const noexcept { return pair_.has_value(); }
+    ChannelPair* operator->() noexcept { return &*pair_; }
+
+    // Destroy the producer early so a consumer blocked on this channel sees ChannelClosed
+    void CloseProducer() noexcept {
+        ProducerHandle closing = std::move(pair_->producer);
+    }
+
+private:
+    std::string name_;
+    std::optional<ChannelPair> pair_;
+};
+
+// Background consumer that drains a channel with BatchPop until destroyed
+class DrainThread {
+public:
+    explicit DrainThread(ConsumerHandle& consumer)
+        : thread_([this, &consumer]() {
+            while (running_.load(std::memory_order_relaxed)) {
+                auto [result, messages] = consumer.BatchPop(256);
+                if (messages.empty()) {
+                    std::this_thread::yield();
+                }
+                for (const auto& msg : messages) {
+                    benchmark::DoNotOptimize(msg.Data().data());
+                }
+            }
+        })
+    {
+    }
+
+    ~DrainThread() {
+        running_.store(false, std::memory_order_relaxed);
+        thread_.join();
+    }
+
+    DrainThread(const DrainThread&) = delete;
+    DrainThread& operator=(const DrainThread&) = delete;
+
+private:
+    std::atomic<bool> running_{true};
+    std::thread thread_;
+};
+
+} // namespace omni::bench
+
+#endif // OMNI_BENCH_CHANNEL_HPP
@@ -0,0 +1,59 @@
+// bench/bench_common.hpp
+// Shared helpers for the standalone benchmark harnesses (not part of the library).
+
+#ifndef OMNI_BENCH_COMMON_HPP
+#define OMNI_BENCH_COMMON_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace omni::bench {
+
+// Monotonic nanoseconds (steady_clock; comparable across threads)
+[[nodiscard]] inline uint64_t NowNs() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Busy-wait until `deadline_ns` (open-loop pacing without sleep jitter)
+inline void SpinUntil(uint64_t deadline_ns) noexcept {
+    while (NowNs() < deadline_ns) {
+    }
+}
+
+// Parse "--name=value" style flags; returns value if `arg` matches `name`
+[[nodiscard]] inline std::optional<std::string_view> FlagValue(std::string_view arg, std::string_view name) noexcept {
+    if (arg.size() > name.size() + 3 && arg.substr(0, 2) == "--" &&
+        arg.substr(2, name.size()) == name && arg[name.size() + 2] == '=') {
+        return arg.substr(name.size() + 3);
+    }
+    return std::nullopt;
+}
+
+[[nodiscard]] inline int64_t ParseInt(std::string_view text, int64_t fallback) noexcept {
+    const std::string copy(text);
+    char* end = nullptr;
+    const long long value = std::strtoll(copy.c_str(), &end, 10);
+    return (end && *end == '\0' && !copy.empty()) ? static_cast<int64_t>(value) : fallback;
+}
+
+// Split a "--name=a,b,c" list value into items (views into `text`)
+[[nodiscard]] inline std::vector<std::string_view> SplitList(std::string_view text) {
+    std::vector<std::string_view> items;
+    while (!text.empty()) {
+        const size_t comma = text.find(',');
+        items.push_back(text.substr(0, comma));
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+    }
+    return items;
+}
+
+} // namespace omni::bench
+
+#endif // OMNI_BENCH_COMMON_HPP
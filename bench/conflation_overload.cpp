@@ -0,0 +1,267 @@
+// bench/conflation_overload.cpp
+// OmniMailbox conflating-channel overload harness
+//
+// Shows that consumer work on a conflating channel is bounded by the number
+// of keys, not by the number of updates published while it lagged.
+//
+//   burst  The producer publishes `updates` quotes over K keys (uniform
+//          round robin) while the consumer is stalled, then one drain pass
+//          runs. Deliveries per drain stay <= K however large the burst.
+//   live   A producer thread publishes continuously; the consumer spends
+//          `work` ns per delivered message, so it can never keep up with
+//          every update. Reports the delivery ratio and conflation rate.
+//
+// Usage:
+//   bench-conflation [--mode=burst|live|both] [--keys=64,1024,16384]
+//                    [--updates=N] [--work=NS] [--repeat=N]
+
+#include <omni/mailbox.hpp>
+#include "bench_common.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using omni::bench::NowNs;
+
+// Drain passes take everything queued: the bound on a pass is the key count
+constexpr size_t kUnbounded = std::numeric_limits<size_t>::max();
+
+struct Options {
+    bool burst = true;
+    bool live = true;
+    std::vector<int64_t> keys{64, 1024, 16384};
+    int64_t updates = 1'000'000;  // Per row
+    int64_t work = 2000;          // Live mode: consumer ns per delivery
+    int64_t repeat = 3;           // Best of N per row (burst)
+};
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (auto v = omni::bench::FlagValue(arg, "mode")) {
+            options.burst = (*v == "burst" || *v == "both");
+            options.live = (*v == "live" || *v == "both");
+        } else if (auto v = omni::bench::FlagValue(arg, "keys")) {
+            options.keys.clear();
+            for (auto item : omni::bench::SplitList(*v)) {
+                options.keys.push_back(omni::bench::ParseInt(item, -1));
+            }
+        } else if (auto v = omni::bench::FlagValue(arg, "updates")) {
+            options.updates = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "work")) {
+            options.work = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "repeat")) {
+            options.repeat = omni::bench::ParseInt(*v, -1);
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    // Channel capacity is the key count; ChannelConfig caps it at 524288
+    const bool keys_valid = !options.keys.empty() &&
+        std::all_of(options.keys.begin(), options.keys.end(), [](int64_t n) { return n >= 1 && n <= 524288; });
+    if ((!options.burst && !options.live) || !keys_valid || options.updates < 1 ||
+        options.work < 0 || options.repeat < 1) {
+        std::fprintf(stderr, "Invalid argument (keys 1..524288, updates >= 1, work >= 0)\n");
+        return false;
+    }
+    return true;
+}
+
+// 32-byte quote: update sequence (checked on delivery) and padding
+std::array<uint8_t, 32> Quote(uint64_t seq) {
+    std::array<uint8_t, 32> bytes{};
+    std::memcpy(bytes.data(), &seq, sizeof(seq));
+    return bytes;
+}
+
+uint64_t SeqOf(std::span<const uint8_t> data) {
+    uint64_t seq = 0;
+    std::memcpy(&seq, data.data(), sizeof(seq));
+    return seq;
+}
+
+std::optional<omni::ConflatingChannelPair> MakeChannel(size_t keys) {
+    auto& broker = omni::MailboxBroker::Instance();
+    const std::string name = "bench-conflation";
+    broker.RemoveChannel(name);
+    auto [error, channel] = broker.RequestConflatingChannel(name, {.capacity = keys, .max_message_size = 64});
+    if (error != omni::ChannelError::Success) {
+        std::fprintf(stderr, "RequestConflatingChannel failed for %zu keys\n", keys);
+        return std::nullopt;
+    }
+    return std::move(channel);
+}
+
+struct BurstResult {
+    bool ok = false;
+    uint64_t delivered = 0;
+    uint64_t conflated = 0;
+    double publish_ns = 0.0;  // Per update
+    double drain_us = 0.0;    // Whole pass
+};
+
+// Stalled consumer: publish the whole burst, then drain once
+BurstResult RunBurst(const Options& options, size_t keys) {
+    BurstResult result;
+    auto channel = MakeChannel(keys);
+    if (!channel) {
+        return result;
+    }
+    auto& [producer, consumer] = *channel;
+    const auto updates = static_cast<uint64_t>(options.updates);
+
+    const uint64_t publish_start = NowNs();
+    for (uint64_t seq = 0; seq < updates; ++seq) {
+        (void)producer.TryPush(seq % keys, Quote(seq));
+    }
+    const uint64_t publish_end = NowNs();
+
+    // Each key must arrive once, carrying its last update
+    bool latest = true;
+    const uint64_t drain_start = NowNs();
+    result.delivered = consumer.DrainBatch(kUnbounded, [&](uint64_t key, std::span<const uint8_t> data) {
+        const uint64_t seq = SeqOf(data);
+        latest &= seq % keys == key && seq + keys >= updates;
+    });
+    const uint64_t drain_end = NowNs();
+
+    result.conflated = consumer.ConflatedMessages();
+    result.publish_ns = static_cast<double>(publish_end - publish_start) / static_cast<double>(updates);
+    result.drain_us = static_cast<double>(drain_end - drain_start) / 1e3;
+    result.ok = latest && result.delivered == std::min<uint64_t>(keys, updates) &&
+                result.delivered + result.conflated == updates;
+    return result;
+}
+
+struct LiveResult {
+    bool ok = false;
+    double seconds = 0.0;
+    uint64_t published = 0;
+    uint64_t delivered = 0;
+    uint64_t conflated = 0;
+    uint64_t max_drain = 0;  // Largest single drain pass
+};
+
+// Spin for `ns` to model per-message consumer work
+void Work(int64_t ns) {
+    const uint64_t until = NowNs() + static_cast<uint64_t>(ns);
+    while (NowNs() < until) {
+    }
+}
+
+// Continuous producer against a consumer that is slower than the feed
+LiveResult RunLive(const Options& options, size_t keys) {
+    LiveResult result;
+    auto channel = MakeChannel(keys);
+    if (!channel) {
+        return result;
+    }
+    auto& consumer = channel->consumer;
+    const auto updates = static_cast<uint64_t>(options.updates);
+
+    std::atomic<bool> done{false};
+    const uint64_t start = NowNs();
+    std::thread producer([producer = std::move(channel->producer), keys, updates, &done]() mutable {
+        for (uint64_t seq = 0; seq < updates; ++seq) {
+            (void)producer.TryPush(seq % keys, Quote(seq));
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    std::vector<uint64_t> last(keys, 0);  // Newest sequence seen + 1 per key
+    bool ordered = true;
+    while (true) {
+        const bool closed = done.load(std::memory_order_acquire);
+        const size_t drained = consumer.DrainBatch(kUnbounded, [&](uint64_t key, std::span<const uint8_t> data) {
+            const uint64_t seq = SeqOf(data);
+            ordered &= seq % keys == key && seq + 1 > last[key];
+            last[key] = seq + 1;
+            Work(options.work);
+        });
+        result.max_drain = std::max<uint64_t>(result.max_drain, drained);
+        result.delivered += drained;
+        if (drained == 0) {
+            if (closed) {
+                break;  // Producer finished before this (empty) pass: nothing left
+            }
+            std::this_thread::yield();
+        }
+    }
+    result.seconds = static_cast<double>(NowNs() - start) / 1e9;
+    producer.join();
+
+    // Final value of every key delivered last
+    for (size_t key = 0; key < keys && key < updates; ++key) {
+        const uint64_t final_seq = updates - 1 - (updates - 1 - key) % keys;
+        ordered &= last[key] == final_seq + 1;
+    }
+    result.published = updates;
+    result.conflated = consumer.ConflatedMessages();
+    result.ok = ordered && result.delivered + result.conflated == updates && result.max_drain <= keys;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    if (options.burst) {
+        std::printf("\nburst (consumer stalled, %lld updates, then one drain)\n",
+                    static_cast<long long>(options.updates));
+        std::printf("%8s %10s %12s %12s %12s %12s\n",
+                    "keys", "updates", "delivered", "conflated", "publish_ns", "drain_us");
+        for (int64_t keys : options.keys) {
+            BurstResult best;
+            for (int64_t rep = 0; rep < options.repeat; ++rep) {
+                BurstResult r = RunBurst(options, static_cast<size_t>(keys));
+                if (!r.ok) {
+                    std::fprintf(stderr, "burst: wrong delivery at %lld keys\n", static_cast<long long>(keys));
+                    return 1;
+                }
+                if (!best.ok || r.drain_us < best.drain_us) {
+                    best = r;
+                }
+            }
+            std::printf("%8lld %10lld %12llu %12llu %12.1f %12.1f\n",
+                        static_cast<long long>(keys), static_cast<long long>(options.updates),
+                        static_cast<unsigned long long>(best.delivered),
+                        static_cast<unsigned long long>(best.conflated), best.publish_ns, best.drain_us);
+        }
+    }
+
+    if (options.live) {
+        std::printf("\nlive (producer thread, consumer spends %lld ns per delivery)\n",
+                    static_cast<long long>(options.work));
+        std::printf("%8s %10s %10s %12s %12s %10s %10s\n",
+                    "keys", "time_ms", "published", "delivered", "conflated", "deliv_%", "max_drain");
+        for (int64_t keys : options.keys) {
+            const LiveResult r = RunLive(options, static_cast<size_t>(keys));
+            if (!r.ok) {
+                std::fprintf(stderr, "live: lost final value or stale delivery at %lld keys\n",
+                             static_cast<long long>(keys));
+                return 1;
+            }
+            std::printf("%8lld %10.2f %10llu %12llu %12llu %10.2f %10llu\n",
+                        static_cast<long long>(keys), r.seconds * 1e3,
+                        static_cast<unsigned long long>(r.published), static_cast<unsigned long long>(r.delivered),
+                        static_cast<unsigned long long>(r.conflated),
+                        100.0 * static_cast<double>(r.delivered) / static_cast<double>(r.published),
+                        static_cast<unsigned long long>(r.max_drain));
+        }
+    }
+    return 0;
+}
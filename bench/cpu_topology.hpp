@@ -0,0 +1,121 @@
+// bench/cpu_topology.hpp
+// Producer/consumer placement for benchmarks, on top of omni::CpuTopology.
+//
+// The topology comes from omni::CpuTopology::Detect() (CPUs in the process
+// affinity mask, with core, package and LLC sharing); on platforms without
+// it every CPU is its own core on one package/LLC, so only the "none" and
+// "spread" placements are meaningful.
+
+#ifndef OMNI_BENCH_CPU_TOPOLOGY_HPP
+#define OMNI_BENCH_CPU_TOPOLOGY_HPP
+
+#include <omni/placement.hpp>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace omni::bench {
+
+// Where the two threads of one producer/consumer pair are placed
+enum class Placement {
+    None,        // Unpinned: the scheduler decides
+    Smt,         // Both threads on SMT siblings of one physical core
+    SameL3,      // Different physical cores sharing an L3 (same CCX/die)
+    CrossL3,     // Different L3 domains on the same package
+    CrossSocket, // Different packages
+    Spread       // Any two unused CPUs, in order
+};
+
+[[nodiscard]] inline const char* PlacementName(Placement placement) noexcept {
+    switch (placement) {
+        case Placement::None:        return "none";
+        case Placement::Smt:         return "smt";
+        case Placement::SameL3:      return "l3";
+        case Placement::CrossL3:     return "cross-l3";
+        case Placement::CrossSocket: return "cross-socket";
+        case Placement::Spread:      return "spread";
+    }
+    return "unknown";
+}
+
+[[nodiscard]] inline std::optional<Placement> ParsePlacement(std::string_view name) noexcept {
+    for (Placement p : {Placement::None, Placement::Smt, Placement::SameL3,
+                        Placement::CrossL3, Placement::CrossSocket, Placement::Spread}) {
+        if (name == PlacementName(p)) {
+            return p;
+        }
+    }
+    return std::nullopt;
+}
+
+// One-line summary, e.g. "16 CPUs, 8 cores, 2 L3 domains, 1 package"
+[[nodiscard]] inline std::string DescribeTopology(std::span<const CpuInfo> topology) {
+    std::set<int> cores;
+    std::set<int> l3s;
+    std::set<int> packages;
+    for (const auto& info : topology) {
+        cores.insert(info.core);
+        l3s.insert(info.llc);
+        packages.insert(info.package);
+    }
+    return std::to_string(topology.size()) + " CPUs, " + std::to_string(cores.size()) + " cores, " +
+           std::to_string(l3s.size()) + " L3 domains, " + std::to_string(packages.size()) + " packages";
+}
+
+[[nodiscard]] inline bool SatisfiesPlacement(const CpuInfo& a, const CpuInfo& b, Placement placement) noexcept {
+    switch (placement) {
+        case Placement::Smt:         return a.core == b.core;
+        case Placement::SameL3:      return a.core != b.core && a.llc == b.llc;
+        case Placement::CrossL3:     return a.package == b.package && a.llc != b.llc;
+        case Placement::CrossSocket: return a.package != b.package;
+        case Placement::Spread:
+        case Placement::None:        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Choose {producer_cpu, consumer_cpu} for `pairs` pairs.
+ *
+ * Each CPU is used at most once. Placement::None returns {-1, -1} for
+ * every pair. Returns std::nullopt if the topology cannot host that many
+ * pairs with the requested relationship.
+ */
+[[nodiscard]] inline std::optional<std::vector<std::pair<int, int>>> PlanPlacement(
+    std::span<const CpuInfo> topology, Placement placement, size_t pairs) {
+    std::vector<std::pair<int, int>> plan;
+    if (placement == Placement::None) {
+        plan.assign(pairs, {-1, -1});
+        return plan;
+    }
+
+    std::vector<bool> used(topology.size(), false);
+    for (size_t pair = 0; pair < pairs; ++pair) {
+        bool placed = false;
+        for (size_t i = 0; i < topology.size() && !placed; ++i) {
+            if (used[i]) {
+                continue;
+            }
+            for (size_t j = 0; j < topology.size(); ++j) {
+                if (j != i && !used[j] && SatisfiesPlacement(topology[i], topology[j], placement)) {
+                    used[i] = used[j] = true;
+                    plan.emplace_back(topology[i].cpu, topology[j].cpu);
+                    placed = true;
+                    break;
+                }
+            }
+        }
+        if (!placed) {
+            return std::nullopt;
+        }
+    }
+    return plan;
+}
+
+} // namespace omni::bench
+
+#endif // OMNI_BENCH_CPU_TOPOLOGY_HPP
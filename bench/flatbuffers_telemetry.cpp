@@ -0,0 +1,103 @@
+// bench/flatbuffers_telemetry.cpp
+// OmniMailbox FlatBuffers Telemetry benchmark (linked into bench-api)
+//
+// End-to-end cost of the intended zero-copy usage: the producer builds a
+// Telemetry table with FlatBufferBuilder, copies the finished buffer into a
+// reserved ring slot and commits; the consumer verifies the buffer in place
+// and reads every field. Parameterized over ring capacity (the encoded
+// message is ~64 bytes, so max_message_size is fixed).
+
+#include <benchmark/benchmark.h>
+#include <omni/mailbox.hpp>
+#include <flatbuffers/flatbuffers.h>
+#include "example_message_generated.h"
+#include "bench_channel.hpp"
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+constexpr size_t TELEMETRY_MAX_SIZE = 256;
+
+// Decode one Telemetry message in place; returns false if verification fails
+bool DecodeTelemetry(std::span<const uint8_t> data, bool verify) {
+    if (verify) {
+        flatbuffers::Verifier verifier(data.data(), data.size());
+        if (!omni::example::VerifyTelemetryBuffer(verifier)) {
+            return false;
+        }
+    }
+    const auto* telemetry = omni::example::GetTelemetry(data.data());
+    benchmark::DoNotOptimize(telemetry->timestamp());
+    benchmark::DoNotOptimize(telemetry->sensor_id()->data());
+    benchmark::DoNotOptimize(telemetry->temperature());
+    benchmark::DoNotOptimize(telemetry->pressure());
+    benchmark::DoNotOptimize(telemetry->priority());
+    return true;
+}
+
+} // namespace
+
+// Encode -> Reserve/Commit -> Pop -> (Verify) -> field reads
+static void BM_FlatBuffers_Telemetry(benchmark::State& state) {
+    const size_t capacity = static_cast<size_t>(state.range(0));
+    const bool verify = state.range(1) != 0;
+    omni::bench::BenchChannel channel(state, "bench-api-flatbuffers", capacity, TELEMETRY_MAX_SIZE);
+    if (!channel) {
+        return;
+    }
+
+    std::atomic<size_t> decode_errors{0};
+    std::thread consumer([&]() {
+        while (true) {
+            auto [result, messages] = channel->consumer.BatchPop(256);
+            for (const auto& msg : messages) {
+                if (!DecodeTelemetry(msg.Data(), verify)) {
+                    decode_errors.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            if (result == omni::PopResult::ChannelClosed && messages.empty()) {
+                break;
+            }
+            if (messages.empty()) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    flatbuffers::FlatBufferBuilder builder(TELEMETRY_MAX_SIZE);
+    uint64_t timestamp = 0;
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        builder.Clear();
+        const auto telemetry = omni::example::CreateTelemetryDirect(
+            builder, ++timestamp, "sensor-42", 21.5f, 101.3f, omni::example::Priority_High);
+        omni::example::FinishTelemetryBuffer(builder, telemetry);
+        const size_t size = builder.GetSize();
+
+        auto reservation = channel->producer.Reserve(size);
+        while (!reservation) {
+            std::this_thread::yield();
+            reservation = channel->producer.Reserve(size);
+        }
+        std::memcpy(reservation->data, builder.GetBufferPointer(), size);
+        channel->producer.Commit(size);
+        bytes += size;
+    }
+
+    channel.CloseProducer();
+    consumer.join();
+
+    if (decode_errors.load(std::memory_order_relaxed) != 0) {
+        state.SkipWithError("Telemetry verification failed");
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+BENCHMARK(BM_FlatBuffers_Telemetry)
+    ->ArgNames({"capacity", "verify"})
+    ->ArgsProduct({{64, 1024, 8192}, {0, 1}})
+    ->Unit(benchmark::kNanosecond);
@@ -0,0 +1,116 @@
+// bench/hdr_histogram.hpp
+// Minimal HDR (high dynamic range) histogram for latency benchmarks.
+//
+// Log-linear buckets: values below 256 are exact, larger values keep
+// 7 significant bits (<= 0.8% relative error) up to 2^40 ns (~18 min).
+// Recording is a count increment with no allocation, so every sample can
+// be recorded on the measuring thread.
+
+#ifndef OMNI_BENCH_HDR_HISTOGRAM_HPP
+#define OMNI_BENCH_HDR_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace omni::bench {
+
+class HdrHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 8;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t{1} << SUB_BUCKET_BITS;   // 256
+    static constexpr uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;              // 128
+    static constexpr uint64_t MAX_VALUE = (uint64_t{1} << 40) - 1;
+
+    HdrHistogram()
+        : counts_(IndexOf(MAX_VALUE) + 1, 0)
+    {
+    }
+
+    // Record one value (clamped to MAX_VALUE)
+    void Record(uint64_t value) noexcept {
+        value = std::min(value, MAX_VALUE);
+        ++counts_[IndexOf(value)];
+        ++total_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    void Merge(const HdrHistogram& other) noexcept {
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    void Reset() noexcept {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        total_ = 0;
+        sum_ = 0;
+        min_ = MAX_VALUE;
+        max_ = 0;
+    }
+
+    // Value at percentile (0-100]; highest value equivalent to the bucket
+    [[nodiscard]] uint64_t ValueAtPercentile(double percentile) const noexcept {
+        if (total_ == 0) {
+            return 0;
+        }
+        const double clamped = std::clamp(percentile, 0.0, 100.0);
+        uint64_t target = static_cast<uint64_t>(clamped / 100.0 * static_cast<double>(total_) + 0.5);
+        target = std::clamp<uint64_t>(target, 1, total_);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= target) {
+                return std::min(HighestEquivalent(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    [[nodiscard]] uint64_t Count() const noexcept { return total_; }
+    [[nodiscard]] uint64_t Min() const noexcept { return total_ ? min_ : 0; }
+    [[nodiscard]] uint64_t Max() const noexcept { return max_; }
+    [[nodiscard]] double Mean() const noexcept {
+        return total_ ? static_cast<double>(sum_) / static_cast<double>(total_) : 0.0;
+    }
+
+private:
+    [[nodiscard]] static constexpr size_t IndexOf(uint64_t value) noexcept {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        const uint32_t msb = 63u - static_cast<uint32_t>(std::countl_zero(value));
+        const uint32_t shift = msb - (SUB_BUCKET_BITS - 1);   // value >> shift in [128, 256)
+        return static_cast<size_t>(
+            SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + ((value >> shift) - SUB_BUCKET_HALF));
+    }
+
+    [[nodiscard]] static constexpr uint64_t HighestEquivalent(size_t index) noexcept {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        const uint64_t offset = index - SUB_BUCKET_COUNT;
+        const uint64_t shift = offset / SUB_BUCKET_HALF + 1;
+        const uint64_t sub = offset % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> counts_;
+    uint64_t total_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = MAX_VALUE;
+    uint64_t max_ = 0;
+};
+
+} // namespace omni::bench
+
+#endif // OMNI_BENCH_HDR_HISTOGRAM_HPP
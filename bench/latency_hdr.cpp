@@ -0,0 +1,298 @@
+// bench/latency_hdr.cpp
+// OmniMailbox latency harness with real percentiles
+//
+// Records every sample into an HDR histogram and reports
+// p50/p90/p99/p99.9/p99.99/max. Unlike BM_Latency_RoundTrip (which only
+// reports Google Benchmark's mean time per iteration), this harness
+// supports open-loop constant-rate load with coordinated-omission
+// correction: latency is measured from the time a message was *scheduled*
+// to be sent, so a stall that delays later sends is charged to every
+// message it delayed instead of silently disappearing.
+//
+// Modes:
+//   roundtrip  Ping-pong over two channels. --rate=0 is closed loop
+//              (back-to-back); --rate=N paces pings at N/s and also
+//              reports the CO-corrected response time.
+//   oneway     Producer sends at --rate=N/s, consumer measures
+//              scheduled-send -> pop (corrected) and actual-send -> pop.
+//
+// Usage:
+//   bench-latency [--mode=roundtrip|oneway] [--rate=N] [--samples=N]
+//                 [--warmup=N] [--size=BYTES] [--capacity=N]
+//                 [--producer-cpu=N] [--consumer-cpu=N] [--wait=spin|block]
+
+#include <omni/mailbox.hpp>
+#include "bench_common.hpp"
+#include "hdr_histogram.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using omni::bench::HdrHistogram;
+using omni::bench::NowNs;
+
+struct Options {
+    std::string mode = "roundtrip";
+    int64_t rate = 0;               // Messages per second, 0 = closed loop
+    int64_t samples = 1'000'000;
+    int64_t warmup = 10'000;
+    int64_t size = 64;
+    int64_t capacity = 1024;
+    int producer_cpu = -1;
+    int consumer_cpu = -1;
+    bool blocking = false;          // BlockingPop instead of TryPop spin
+};
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (auto v = omni::bench::FlagValue(arg, "mode")) {
+            options.mode = std::string(*v);
+        } else if (auto v = omni::bench::FlagValue(arg, "rate")) {
+            options.rate = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "samples")) {
+            options.samples = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "warmup")) {
+            options.warmup = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "size")) {
+            options.size = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "capacity")) {
+            options.capacity = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "producer-cpu")) {
+            options.producer_cpu = static_cast<int>(omni::bench::ParseInt(*v, -1));
+        } else if (auto v = omni::bench::FlagValue(arg, "consumer-cpu")) {
+            options.consumer_cpu = static_cast<int>(omni::bench::ParseInt(*v, -1));
+        } else if (auto v = omni::bench::FlagValue(arg, "wait")) {
+            options.blocking = (*v == "block");
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    if (options.mode != "roundtrip" && options.mode != "oneway") {
+        std::fprintf(stderr, "--mode must be roundtrip or oneway\n");
+        return false;
+    }
+    if (options.mode == "oneway" && options.rate <= 0) {
+        std::fprintf(stderr, "--mode=oneway requires --rate=N (messages/sec)\n");
+        return false;
+    }
+    if (options.rate < 0 || options.samples <= 0 || options.warmup < 0 ||
+        options.size < 16 || options.capacity < 8) {
+        std::fprintf(stderr, "Invalid numeric argument (size >= 16, capacity >= 8)\n");
+        return false;
+    }
+    return true;
+}
+
+// Scheduled send time of message i under open-loop pacing
+uint64_t IntendedNs(uint64_t start_ns, int64_t i, int64_t rate) {
+    return start_ns + static_cast<uint64_t>(i) * 1'000'000'000ull / static_cast<uint64_t>(rate);
+}
+
+void PushSpin(omni::ProducerHandle& producer, std::span<const uint8_t> data) {
+    while (producer.TryPush(data) == omni::PushResult::QueueFull) {
+    }
+}
+
+std::optional<omni::ConsumerHandle::Message> PopWait(omni::ConsumerHandle& consumer, bool blocking) {
+    while (true) {
+        auto [result, msg] = blocking
+            ? consumer.BlockingPop(std::chrono::milliseconds(1000))
+            : consumer.TryPop();
+        if (result == omni::PopResult::Success) {
+            return msg;
+        }
+        if (result == omni::PopResult::ChannelClosed) {
+            return std::nullopt;
+        }
+    }
+}
+
+void PrintHeader() {
+    std::printf("%-28s %10s %10s %10s %10s %10s %10s %10s %12s\n",
+                "latency (ns)", "p50", "p90", "p99", "p99.9", "p99.99", "max", "mean", "count");
+}
+
+void PrintRow(const char* label, const HdrHistogram& h) {
+    std::printf("%-28s %10llu %10llu %10llu %10llu %10llu %10llu %10.1f %12llu\n",
+                label,
+                static_cast<unsigned long long>(h.ValueAtPercentile(50.0)),
+                static_cast<unsigned long long>(h.ValueAtPercentile(90.0)),
+                static_cast<unsigned long long>(h.ValueAtPercentile(99.0)),
+                static_cast<unsigned long long>(h.ValueAtPercentile(99.9)),
+                static_cast<unsigned long long>(h.ValueAtPercentile(99.99)),
+                static_cast<unsigned long long>(h.Max()),
+                h.Mean(),
+                static_cast<unsigned long long>(h.Count()));
+}
+
+bool RunRoundTrip(const Options& options, HdrHistogram& service, HdrHistogram& response) {
+    auto& broker = omni::MailboxBroker::Instance();
+    const omni::ChannelConfig config{
+        .capacity = static_cast<size_t>(options.capacity),
+        .max_message_size = static_cast<size_t>(options.size)
+    };
+    auto [error1, ping] = broker.RequestChannel("bench-latency-ping", config);
+    auto [error2, pong] = broker.RequestChannel("bench-latency-pong", config);
+    if (error1 != omni::ChannelError::Success || error2 != omni::ChannelError::Success) {
+        std::fprintf(stderr, "Failed to create channels\n");
+        // Handles first, and only the channels created here (not a NameExists one)
+        ping.reset();
+        pong.reset();
+        if (error1 == omni::ChannelError::Success) {
+            broker.RemoveChannel("bench-latency-ping");
+        }
+        if (error2 == omni::ChannelError::Success) {
+            broker.RemoveChannel("bench-latency-pong");
+        }
+        return false;
+    }
+
+    // Echo thread: pop ping, push it back on pong
+    std::thread echo([&]() {
+        if (options.consumer_cpu >= 0 && !omni::PinCurrentThread(options.consumer_cpu)) {
+            std::fprintf(stderr, "warning: could not pin echo thread to CPU %d\n", options.consumer_cpu);
+        }
+        while (auto msg = PopWait(ping->consumer, options.blocking)) {
+            PushSpin(pong->producer, msg->Data());
+        }
+    });
+
+    if (options.producer_cpu >= 0 && !omni::PinCurrentThread(options.producer_cpu)) {
+        std::fprintf(stderr, "warning: could not pin ping thread to CPU %d\n", options.producer_cpu);
+    }
+
+    std::vector<uint8_t> payload(static_cast<size_t>(options.size), 0xCD);
+    const int64_t total = options.warmup + options.samples;
+    const uint64_t start = NowNs();
+
+    for (int64_t i = 0; i < total; ++i) {
+        const uint64_t intended = options.rate > 0 ? IntendedNs(start, i, options.rate) : 0;
+        if (options.rate > 0) {
+            omni::bench::SpinUntil(intended);
+        }
+
+        const uint64_t sent = NowNs();
+        PushSpin(ping->producer, payload);
+        if (!PopWait(pong->consumer, options.blocking)) {
+            break;
+        }
+        const uint64_t done = NowNs();
+
+        if (i >= options.warmup) {
+            service.Record(done - sent);
+            if (options.rate > 0) {
+                response.Record(done - intended);
+            }
+        }
+    }
+
+    // Destroying the ping producer closes the channel and ends the echo loop
+    {
+        omni::ProducerHandle closing = std::move(ping->producer);
+    }
+    echo.join();
+    ping.reset();
+    pong.reset();
+    broker.RemoveChannel("bench-latency-ping");
+    broker.RemoveChannel("bench-latency-pong");
+    return true;
+}
+
+bool RunOneWay(const Options& options, HdrHistogram& service, HdrHistogram& response) {
+    auto& broker = omni::MailboxBroker::Instance();
+    auto [error, channel] = broker.RequestChannel("bench-latency-oneway", {
+        .capacity = static_cast<size_t>(options.capacity),
+        .max_message_size = static_cast<size_t>(options.size)
+    });
+    if (error != omni::ChannelError::Success) {
+        std::fprintf(stderr, "Failed to create channel\n");
+        return false;
+    }
+
+    const int64_t total = options.warmup + options.samples;
+
+    // Consumer: record scheduled->pop (corrected) and sent->pop (raw)
+    std::thread consumer([&]() {
+        if (options.consumer_cpu >= 0 && !omni::PinCurrentThread(options.consumer_cpu)) {
+            std::fprintf(stderr, "warning: could not pin consumer to CPU %d\n", options.consumer_cpu);
+        }
+        for (int64_t i = 0; i < total; ++i) {
+            auto msg = PopWait(channel->consumer, options.blocking);
+            if (!msg) {
+                break;
+            }
+            const uint64_t done = NowNs();
+            uint64_t intended = 0;
+            uint64_t sent = 0;
+            std::memcpy(&intended, msg->Data().data(), sizeof(intended));
+            std::memcpy(&sent, msg->Data().data() + sizeof(intended), sizeof(sent));
+            if (i >= options.warmup) {
+                response.Record(done - intended);
+                service.Record(done - sent);
+            }
+        }
+    });
+
+    if (options.producer_cpu >= 0 && !omni::PinCurrentThread(options.producer_cpu)) {
+        std::fprintf(stderr, "warning: could not pin producer to CPU %d\n", options.producer_cpu);
+    }
+
+    std::vector<uint8_t> payload(static_cast<size_t>(options.size), 0xCD);
+    const uint64_t start = NowNs() + 1'000'000;  // 1ms for the consumer to start
+
+    for (int64_t i = 0; i < total; ++i) {
+        const uint64_t intended = IntendedNs(start, i, options.rate);
+        omni::bench::SpinUntil(intended);
+        const uint64_t sent = NowNs();
+        std::memcpy(payload.data(), &intended, sizeof(intended));
+        std::memcpy(payload.data() + sizeof(intended), &sent, sizeof(sent));
+        PushSpin(channel->producer, payload);  // A full queue delays later sends (charged via intended)
+    }
+
+    consumer.join();
+    channel.reset();
+    broker.RemoveChannel("bench-latency-oneway");
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    HdrHistogram service;
+    HdrHistogram response;
+
+    const bool ok = options.mode == "roundtrip"
+        ? RunRoundTrip(options, service, response)
+        : RunOneWay(options, service, response);
+    if (!ok) {
+        return 1;
+    }
+
+    std::printf("mode=%s rate=%s samples=%lld warmup=%lld size=%lld capacity=%lld "
+                "producer_cpu=%d consumer_cpu=%d wait=%s\n\n",
+                options.mode.c_str(),
+                options.rate > 0 ? (std::to_string(options.rate) + "/s").c_str() : "closed-loop",
+                static_cast<long long>(options.samples), static_cast<long long>(options.warmup),
+                static_cast<long long>(options.size), static_cast<long long>(options.capacity),
+                options.producer_cpu, options.consumer_cpu, options.blocking ? "block" : "spin");
+
+    PrintHeader();
+    PrintRow(options.mode == "roundtrip" ? "round-trip (service)" : "one-way (from actual send)", service);
+    if (response.Count() > 0) {
+        PrintRow(options.mode == "roundtrip" ? "round-trip (CO-corrected)" : "one-way (CO-corrected)", response);
+    }
+    return 0;
+}
@@ -0,0 +1,206 @@
+// bench/memory_footprint.cpp
+// OmniMailbox channel memory footprint and creation time benchmarks
+//
+// Creates K channels of one configuration per iteration and reports, per
+// channel (Google Benchmark user counters, so they land in the JSON output
+// alongside benchmark_results.json):
+//
+//   create_ns       RequestChannel() wall time (includes the eager memset)
+//   memset_ns       Zeroing a never-touched ring of the same size (first-touch
+//                   page faults included): the eager-memset share of create_ns
+//                   for rings large enough to be served fresh by mmap, an
+//                   upper bound for small rings carved from resident heap
+//   heap_bytes      Bytes allocated by RequestChannel() (exact: counted by
+//                   this binary's global operator new)
+//   allocs          Number of heap allocations
+//   ring_bytes      capacity * slot_size (the ring buffer itself)
+//   overhead_bytes  heap_bytes - ring_bytes: queue control block, pimpls,
+//                   registry node and name strings
+//   rss_bytes       Resident set growth (/proc/self/statm); rings above the
+//                   malloc mmap threshold are fully resident because of the
+//                   memset, smaller ones may reuse already-resident heap
+//   vsz_bytes       Virtual size growth
+//
+//   bench-memory --benchmark_format=json --benchmark_out=memory_results.json
+
+#include <benchmark/benchmark.h>
+#include <omni/mailbox.hpp>
+#include <omni/detail/spsc_queue.hpp>
+#include "bench_common.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(OMNI_PLATFORM_LINUX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Heap accounting, enabled only around the measured RequestChannel() calls
+std::atomic<bool> counting{false};
+std::atomic<uint64_t> counted_bytes{0};
+std::atomic<uint64_t> counted_allocs{0};
+
+void* CountedAlloc(std::size_t size, std::size_t alignment) {
+    if (counting.load(std::memory_order_relaxed)) {
+        counted_bytes.fetch_add(size, std::memory_order_relaxed);
+        counted_allocs.fetch_add(1, std::memory_order_relaxed);
+    }
+    void* ptr = alignment <= alignof(std::max_align_t)
+        ? std::malloc(size ? size : 1)
+        : std::aligned_alloc(alignment, (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+// Out of line: once free() is inlined into a delete-expression, GCC sees
+// free() on a pointer from operator new (-Wmismatched-new-delete)
+[[gnu::noinline]] void CountedFree(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+struct MemorySnapshot {
+    uint64_t vsz = 0;
+    uint64_t rss = 0;
+};
+
+MemorySnapshot ReadMemory() {
+    MemorySnapshot snapshot;
+#if defined(OMNI_PLATFORM_LINUX)
+    if (FILE* file = std::fopen("/proc/self/statm", "r")) {
+        unsigned long long size = 0;
+        unsigned long long resident = 0;
+        if (std::fscanf(file, "%llu %llu", &size, &resident) == 2) {
+            const uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            snapshot.vsz = size * page;
+            snapshot.rss = resident * page;
+        }
+        std::fclose(file);
+    }
+#endif
+    return snapshot;
+}
+
+constexpr uint64_t RING_BUDGET_BYTES = 256ull << 20;  // Caps K for large rings
+
+} // namespace
+
+void* operator new(std::size_t size) { return CountedAlloc(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t al) { return CountedAlloc(size, static_cast<std::size_t>(al)); }
+void operator delete(void* ptr) noexcept { CountedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { CountedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { CountedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { CountedFree(ptr); }
+
+static void BM_Memory_CreateChannels(benchmark::State& state) {
+    auto& broker = omni::MailboxBroker::Instance();
+    const omni::ChannelConfig config{
+        .capacity = static_cast<size_t>(state.range(0)),
+        .max_message_size = static_cast<size_t>(state.range(1))
+    };
+    // Ring size as the queue computes it (slot header and alignment included)
+    const omni::ChannelConfig normalized = config.Normalize();
+    const uint64_t ring_bytes = normalized.capacity *
+        omni::detail::SPSCQueue::SlotSize(normalized.max_message_size, normalized.message_deadlines);
+    const size_t channels = static_cast<size_t>(std::clamp<uint64_t>(
+        RING_BUDGET_BYTES / ring_bytes, 1, static_cast<uint64_t>(state.range(2))));
+
+    static std::atomic<size_t> run_counter{0};
+    const std::string prefix = "bench-memory-" + std::to_string(run_counter.fetch_add(1)) + "-";
+    std::vector<std::string> names;
+    for (size_t i = 0; i < channels; ++i) {
+        names.push_back(prefix + std::to_string(i));
+    }
+
+    std::vector<omni::ChannelPair> pairs;
+    pairs.reserve(channels);
+
+    uint64_t create_ns = 0;
+    uint64_t heap_bytes = 0;
+    uint64_t allocs = 0;
+    int64_t rss_bytes = 0;
+    int64_t vsz_bytes = 0;
+
+    for (auto _ : state) {
+        const MemorySnapshot before = ReadMemory();
+        counted_bytes.store(0, std::memory_order_relaxed);
+        counted_allocs.store(0, std::memory_order_relaxed);
+        counting.store(true, std::memory_order_relaxed);
+        const uint64_t start = omni::bench::NowNs();
+
+        for (const auto& name : names) {
+            auto [error, pair] = broker.RequestChannel(name, config);
+            if (error != omni::ChannelError::Success) {
+                counting.store(false, std::memory_order_relaxed);
+                state.SkipWithError("Failed to create channel");
+                return;
+            }
+            pairs.push_back(std::move(*pair));
+        }
+
+        create_ns += omni::bench::NowNs() - start;
+        counting.store(false, std::memory_order_relaxed);
+        const MemorySnapshot after = ReadMemory();
+        heap_bytes += counted_bytes.load(std::memory_order_relaxed);
+        allocs += counted_allocs.load(std::memory_order_relaxed);
+        rss_bytes += static_cast<int64_t>(after.rss) - static_cast<int64_t>(before.rss);
+        vsz_bytes += static_cast<int64_t>(after.vsz) - static_cast<int64_t>(before.vsz);
+
+        // Teardown is not part of the measurement
+        state.PauseTiming();
+        pairs.clear();
+        for (const auto& name : names) {
+            broker.RemoveChannel(name);
+        }
+        state.ResumeTiming();
+    }
+
+    // Eager memset cost: zeroing a never-touched ring, as SPSCQueue does.
+    // Pages are dropped before each pass so first-touch faults are included
+    // (malloc would otherwise hand back already-resident memory).
+    uint64_t memset_ns = 0;
+    const size_t memset_reps = std::min<size_t>(channels, 16);
+    const size_t page = 4096;
+    const size_t ring_alloc = (static_cast<size_t>(ring_bytes) + page - 1) / page * page;
+    uint8_t* ring = static_cast<uint8_t*>(std::aligned_alloc(page, ring_alloc));
+    for (size_t i = 0; ring && i < memset_reps; ++i) {
+#if defined(OMNI_PLATFORM_LINUX)
+        madvise(ring, ring_alloc, MADV_DONTNEED);
+#endif
+        const uint64_t start = omni::bench::NowNs();
+        std::memset(ring, 0, static_cast<size_t>(ring_bytes));
+        benchmark::ClobberMemory();
+        memset_ns += omni::bench::NowNs() - start;
+    }
+    std::free(ring);
+    memset_ns /= memset_reps;
+
+    const double per_channel = 1.0 / (static_cast<double>(state.iterations()) * static_cast<double>(channels));
+    state.counters["channels"] = static_cast<double>(channels);
+    state.counters["create_ns"] = static_cast<double>(create_ns) * per_channel;
+    state.counters["memset_ns"] = static_cast<double>(memset_ns);
+    state.counters["heap_bytes"] = static_cast<double>(heap_bytes) * per_channel;
+    state.counters["allocs"] = static_cast<double>(allocs) * per_channel;
+    state.counters["ring_bytes"] = static_cast<double>(ring_bytes);
+    state.counters["overhead_bytes"] = static_cast<double>(heap_bytes) * per_channel - static_cast<double>(ring_bytes);
+    state.counters["rss_bytes"] = static_cast<double>(rss_bytes) * per_channel;
+    state.counters["vsz_bytes"] = static_cast<double>(vsz_bytes) * per_channel;
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(channels));
+}
+
+// capacity x max_message_size x requested channel count
+BENCHMARK(BM_Memory_CreateChannels)
+    ->ArgNames({"capacity", "msg_size", "channels"})
+    ->ArgsProduct({{64, 1024, 4096}, {64, 1024, 4096}, {64}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,243 @@
+// bench/merge_throughput.cpp
+// OmniMailbox k-way merge throughput harness
+//
+// Measures MergeConsumer throughput for several input counts. Each input
+// carries a strictly increasing timestamp; timestamps are interleaved over
+// the inputs (input i gets t = k * inputs + i), so every emitted message
+// comes from a different input than the last and the heap does real work.
+//
+//   prefilled  Every ring is filled, the producers are closed, and only the
+//              merge is timed (heap + Peek + DrainBatch per message).
+//   live       One producer thread per input pushes while the merge runs;
+//              includes stalls while the merge waits on an empty input.
+//
+// Usage:
+//   bench-merge [--mode=prefilled|live|both] [--inputs=2,8,32]
+//               [--messages=N] [--capacity=N] [--repeat=N]
+
+#include <omni/mailbox.hpp>
+#include "bench_common.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using omni::bench::NowNs;
+
+struct Options {
+    bool prefilled = true;
+    bool live = true;
+    std::vector<int64_t> inputs{2, 8, 32};
+    int64_t messages = 2'000'000;   // Per row, over all inputs
+    int64_t capacity = 4096;        // Per input ring
+    int64_t repeat = 3;             // Best of N per row
+};
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (auto v = omni::bench::FlagValue(arg, "mode")) {
+            options.prefilled = (*v == "prefilled" || *v == "both");
+            options.live = (*v == "live" || *v == "both");
+        } else if (auto v = omni::bench::FlagValue(arg, "inputs")) {
+            options.inputs.clear();
+            for (auto item : omni::bench::SplitList(*v)) {
+                options.inputs.push_back(omni::bench::ParseInt(item, -1));
+            }
+        } else if (auto v = omni::bench::FlagValue(arg, "messages")) {
+            options.messages = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "capacity")) {
+            options.capacity = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "repeat")) {
+            options.repeat = omni::bench::ParseInt(*v, -1);
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    const bool inputs_valid = !options.inputs.empty() &&
+        std::all_of(options.inputs.begin(), options.inputs.end(), [](int64_t n) { return n >= 1 && n <= 1024; });
+    if ((!options.prefilled && !options.live) || !inputs_valid || options.messages < 1 ||
+        options.capacity < 2 || options.repeat < 1) {
+        std::fprintf(stderr, "Invalid argument (inputs 1..1024, messages >= 1, capacity >= 2)\n");
+        return false;
+    }
+    return true;
+}
+
+// 16-byte event: timestamp (merge key) and a payload word
+std::array<uint8_t, 16> Event(uint64_t ts) {
+    std::array<uint8_t, 16> bytes{};
+    std::memcpy(bytes.data(), &ts, sizeof(ts));
+    return bytes;
+}
+
+struct RunResult {
+    bool ok = false;
+    double seconds = 0.0;
+    uint64_t messages = 0;
+    omni::MergeConsumer::Stats stats{};
+};
+
+std::vector<omni::ChannelPair> MakeInputs(size_t inputs, size_t capacity) {
+    auto& broker = omni::MailboxBroker::Instance();
+    std::vector<omni::ChannelPair> channels;
+    for (size_t i = 0; i < inputs; ++i) {
+        const std::string name = "bench-merge-" + std::to_string(i);
+        broker.RemoveChannel(name);
+        auto [error, channel] = broker.RequestChannel(name, {.capacity = capacity, .max_message_size = 16});
+        if (error != omni::ChannelError::Success) {
+            std::fprintf(stderr, "RequestChannel failed for %s\n", name.c_str());
+            return {};
+        }
+        channels.push_back(std::move(*channel));
+    }
+    return channels;
+}
+
+// Fill every ring, close the producers, time the merge alone; repeated in
+// fill/merge cycles until options.messages were merged
+RunResult RunPrefilled(const Options& options, size_t inputs) {
+    RunResult result;
+    uint64_t merged_ns = 0;
+    uint64_t ts = 0;
+    omni::MergeConsumer::Stats totals{};
+    const size_t per_input = static_cast<size_t>(options.capacity) - 1;
+
+    while (result.messages < static_cast<uint64_t>(options.messages)) {
+        auto channels = MakeInputs(inputs, static_cast<size_t>(options.capacity));
+        if (channels.empty()) {
+            return result;
+        }
+        omni::MergeConsumer merge;
+        for (size_t k = 0; k < per_input; ++k) {
+            for (size_t i = 0; i < inputs; ++i) {
+                (void)channels[i].producer.TryPush(Event(ts++));
+            }
+        }
+        for (auto& channel : channels) {
+            (void)merge.AddInput(std::move(channel.consumer));
+            auto closed = std::move(channel.producer);
+        }
+
+        uint64_t checksum = 0;
+        const uint64_t start = NowNs();
+        while (!merge.Done()) {
+            merge.Poll([&](size_t, uint64_t key, std::span<const uint8_t>) { checksum += key; });
+        }
+        merged_ns += NowNs() - start;
+
+        const auto stats = merge.GetStats();
+        result.messages += stats.messages;
+        totals.late += stats.late;
+        totals.stalls += stats.stalls;
+        if (checksum == 0 && stats.messages > 1) {
+            std::fprintf(stderr, "prefilled: empty checksum\n");
+            return result;
+        }
+    }
+    result.seconds = static_cast<double>(merged_ns) / 1e9;
+    result.stats = totals;
+    result.stats.messages = result.messages;
+    result.ok = totals.late == 0;
+    return result;
+}
+
+// One producer thread per input pushing concurrently with the merge
+RunResult RunLive(const Options& options, size_t inputs) {
+    RunResult result;
+    auto channels = MakeInputs(inputs, static_cast<size_t>(options.capacity));
+    if (channels.empty()) {
+        return result;
+    }
+    omni::MergeConsumer merge;
+    for (auto& channel : channels) {
+        (void)merge.AddInput(std::move(channel.consumer));
+    }
+    const uint64_t per_input = static_cast<uint64_t>(options.messages) / inputs;
+
+    const uint64_t start = NowNs();
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < inputs; ++i) {
+        producers.emplace_back([producer = std::move(channels[i].producer), i, inputs, per_input]() mutable {
+            for (uint64_t k = 0; k < per_input; ++k) {
+                const auto event = Event(k * inputs + i);
+                while (producer.TryPush(event) == omni::PushResult::QueueFull) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    while (!merge.Done()) {
+        if (merge.Poll([](size_t, uint64_t, std::span<const uint8_t>) {}) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    result.seconds = static_cast<double>(NowNs() - start) / 1e9;
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    result.stats = merge.GetStats();
+    result.messages = result.stats.messages;
+    result.ok = result.messages == per_input * inputs && result.stats.late == 0;
+    return result;
+}
+
+void PrintHeader(const char* title) {
+    std::printf("\n%s\n", title);
+    std::printf("%8s %10s %10s %12s %8s %10s\n", "inputs", "time_ms", "messages", "msgs/sec", "ns/msg", "stalls");
+}
+
+void PrintRow(size_t inputs, const RunResult& r) {
+    const double rate = r.seconds > 0 ? static_cast<double>(r.messages) / r.seconds : 0.0;
+    std::printf("%8zu %10.2f %10llu %12.0f %8.1f %10llu\n",
+                inputs, r.seconds * 1e3, static_cast<unsigned long long>(r.messages), rate,
+                r.messages > 0 ? r.seconds * 1e9 / static_cast<double>(r.messages) : 0.0,
+                static_cast<unsigned long long>(r.stats.stalls));
+}
+
+template<typename Workload>
+bool Sweep(const Options& options, const char* title, Workload workload) {
+    PrintHeader(title);
+    for (int64_t inputs : options.inputs) {
+        RunResult best;
+        for (int64_t rep = 0; rep < options.repeat; ++rep) {
+            RunResult r = workload(static_cast<size_t>(inputs));
+            if (!r.ok) {
+                std::fprintf(stderr, "%s: run failed or out of order at %lld inputs\n", title,
+                             static_cast<long long>(inputs));
+                return false;
+            }
+            if (!best.ok || r.seconds < best.seconds) {
+                best = r;
+            }
+        }
+        PrintRow(static_cast<size_t>(inputs), best);
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    if (options.prefilled &&
+        !Sweep(options, "prefilled (merge only)", [&](size_t inputs) { return RunPrefilled(options, inputs); })) {
+        return 1;
+    }
+    if (options.live &&
+        !Sweep(options, "live (one producer thread per input)", [&](size_t inputs) { return RunLive(options, inputs); })) {
+        return 1;
+    }
+    return 0;
+}
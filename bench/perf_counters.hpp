@@ -0,0 +1,188 @@
+// bench/perf_counters.hpp
+// Hardware/software performance counters around a benchmark region.
+//
+// Uses Linux perf_event_open on the calling thread with inherit=1, so
+// threads created after the counters are opened (benchmark consumers,
+// echo threads) are counted too once they have been joined. Each counter
+// is opened independently; any the kernel refuses (containers without
+// CAP_PERFMON, perf_event_paranoid, missing PMU in VMs) are simply left
+// out, and on other platforms no counter is ever available.
+
+#ifndef OMNI_BENCH_PERF_COUNTERS_HPP
+#define OMNI_BENCH_PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#if defined(OMNI_PLATFORM_LINUX)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace omni::bench {
+
+enum class PerfEvent : uint8_t {
+    Cycles,
+    Instructions,
+    L1DMisses,
+    LLCMisses,
+    DTLBMisses,
+    ContextSwitches,
+    Count_
+};
+
+inline constexpr size_t PERF_EVENT_COUNT = static_cast<size_t>(PerfEvent::Count_);
+
+// Short names used as benchmark counter prefixes ("cycles" -> "cycles/msg")
+[[nodiscard]] inline const char* PerfEventName(PerfEvent event) noexcept {
+    switch (event) {
+        case PerfEvent::Cycles:          return "cycles";
+        case PerfEvent::Instructions:    return "instructions";
+        case PerfEvent::L1DMisses:       return "L1d-misses";
+        case PerfEvent::LLCMisses:       return "LLC-misses";
+        case PerfEvent::DTLBMisses:      return "dTLB-misses";
+        case PerfEvent::ContextSwitches: return "context-switches";
+        case PerfEvent::Count_:          break;
+    }
+    return "unknown";
+}
+
+class PerfCounters {
+public:
+    // Opens (but does not start) every counter the kernel allows
+    PerfCounters() noexcept {
+#if defined(OMNI_PLATFORM_LINUX)
+        for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+            fds_[i] = Open(static_cast<PerfEvent>(i));
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(OMNI_PLATFORM_LINUX)
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // True if at least one counter could be opened
+    [[nodiscard]] bool Available() const noexcept {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Start() noexcept {
+#if defined(OMNI_PLATFORM_LINUX)
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    void Stop() noexcept {
+#if defined(OMNI_PLATFORM_LINUX)
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Counter value since Start(), scaled for PMU multiplexing.
+     *
+     * Returns std::nullopt if the counter is unavailable or never ran.
+     * Counts from inherited threads are included only after they exit.
+     */
+    [[nodiscard]] std::optional<double> Read(PerfEvent event) const noexcept {
+#if defined(OMNI_PLATFORM_LINUX)
+        const int fd = fds_[static_cast<size_t>(event)];
+        uint64_t values[3] = {};  // value, time_enabled, time_running
+        if (fd < 0 || read(fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) ||
+            values[2] == 0) {
+            return std::nullopt;
+        }
+        return static_cast<double>(values[0]) * static_cast<double>(values[1]) /
+               static_cast<double>(values[2]);
+#else
+        (void)event;
+        return std::nullopt;
+#endif
+    }
+
+private:
+#if defined(OMNI_PLATFORM_LINUX)
+    static int Open(PerfEvent event) noexcept {
+        constexpr auto CacheMiss = [](uint64_t cache) {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        };
+
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        switch (event) {
+            case PerfEvent::Cycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case PerfEvent::Instructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case PerfEvent::L1DMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = CacheMiss(PERF_COUNT_HW_CACHE_L1D);
+                break;
+            case PerfEvent::LLCMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = CacheMiss(PERF_COUNT_HW_CACHE_LL);
+                break;
+            case PerfEvent::DTLBMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = CacheMiss(PERF_COUNT_HW_CACHE_DTLB);
+                break;
+            case PerfEvent::ContextSwitches:
+                attr.type = PERF_TYPE_SOFTWARE;
+                attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES;
+                break;
+            case PerfEvent::Count_:
+                return -1;
+        }
+
+        // Count kernel time when allowed; retry user-only under perf_event_paranoid >= 2
+        int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd < 0) {
+            attr.exclude_kernel = 1;
+            fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+        return fd;
+    }
+#endif
+
+    std::array<int, PERF_EVENT_COUNT> fds_{-1, -1, -1, -1, -1, -1};
+};
+
+} // namespace omni::bench
+
+#endif // OMNI_BENCH_PERF_COUNTERS_HPP
@@ -0,0 +1,273 @@
+// bench/reference_queues.hpp
+// Reference queue implementations for baseline comparison (benchmarks only).
+//
+// All three carry variable-size byte messages up to max_message_size in
+// the same way OmniMailbox does, so they can run through the same harness:
+//
+//   MutexDequeQueue  std::mutex + condition_variable around a bounded
+//                    std::deque<std::vector<uint8_t>> (one allocation per
+//                    message, the "obvious" thread-safe queue)
+//   LamportRing      Classic Lamport SPSC ring of fixed-size slots: every
+//                    operation loads the remote index with acquire
+//   CachedIndexRing  Lamport ring where each side caches the remote index
+//                    and reloads it only when the cached value says
+//                    full/empty (fewer cross-core cache-line transfers)
+//
+// The two rings keep their indices on separate cache lines, so the only
+// difference between them is index caching.
+//
+// Interface (shared by all three):
+//   bool TryPush(std::span<const uint8_t>)
+//   void PushWait(std::span<const uint8_t>)            // until success
+//   bool TryConsume(F&& f)                             // f(span) on the slot, then release
+//   bool ConsumeWait(F&& f, std::chrono::milliseconds)  // false on timeout; max() = forever
+
+#ifndef OMNI_BENCH_REFERENCE_QUEUES_HPP
+#define OMNI_BENCH_REFERENCE_QUEUES_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace omni::bench::reference {
+
+inline constexpr size_t CACHE_LINE = 64;
+
+class MutexDequeQueue {
+public:
+    MutexDequeQueue(size_t capacity, size_t /*max_message_size*/)
+        : capacity_(capacity)
+    {
+    }
+
+    bool TryPush(std::span<const uint8_t> data) {
+        {
+            std::lock_guard lock(mutex_);
+            if (queue_.size() >= capacity_) {
+                return false;
+            }
+            queue_.emplace_back(data.begin(), data.end());
+        }
+        not_empty_.notify_one();
+        return true;
+    }
+
+    void PushWait(std::span<const uint8_t> data) {
+        {
+            std::unique_lock lock(mutex_);
+            not_full_.wait(lock, [&]() { return queue_.size() < capacity_; });
+            queue_.emplace_back(data.begin(), data.end());
+        }
+        not_empty_.notify_one();
+    }
+
+    template<typename F>
+    bool TryConsume(F&& f) {
+        std::vector<uint8_t> message;
+        {
+            std::lock_guard lock(mutex_);
+            if (queue_.empty()) {
+                return false;
+            }
+            message = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        not_full_.notify_one();
+        f(std::span<const uint8_t>(message));
+        return true;
+    }
+
+    template<typename F>
+    bool ConsumeWait(F&& f, std::chrono::milliseconds timeout) {
+        std::vector<uint8_t> message;
+        {
+            std::unique_lock lock(mutex_);
+            const auto ready = [&]() { return !queue_.empty(); };
+            if (timeout == std::chrono::milliseconds::max()) {
+                not_empty_.wait(lock, ready);
+            } else if (!not_empty_.wait_for(lock, timeout, ready)) {
+                return false;
+            }
+            message = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        not_full_.notify_one();
+        f(std::span<const uint8_t>(message));
+        return true;
+    }
+
+private:
+    const size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<std::vector<uint8_t>> queue_;
+};
+
+namespace detail {
+
+// Fixed-size slot storage shared by both rings: [uint32 size][payload]
+class SlotArray {
+public:
+    SlotArray(size_t capacity, size_t max_message_size)
+        : mask_(capacity - 1)
+        , slot_size_((sizeof(uint32_t) + max_message_size + 7) & ~size_t{7})
+        , storage_(new uint8_t[capacity * slot_size_]())
+    {
+    }
+
+    void Write(uint64_t index, std::span<const uint8_t> data) noexcept {
+        uint8_t* slot = Slot(index);
+        const uint32_t size = static_cast<uint32_t>(data.size());
+        std::memcpy(slot, &size, sizeof(size));
+        std::memcpy(slot + sizeof(size), data.data(), data.size());
+    }
+
+    [[nodiscard]] std::span<const uint8_t> Read(uint64_t index) const noexcept {
+        const uint8_t* slot = Slot(index);
+        uint32_t size = 0;
+        std::memcpy(&size, slot, sizeof(size));
+        return {slot + sizeof(size), size};
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept { return mask_ + 1; }
+
+private:
+    [[nodiscard]] uint8_t* Slot(uint64_t index) const noexcept {
+        return storage_.get() + (index & mask_) * slot_size_;
+    }
+
+    const size_t mask_;
+    const size_t slot_size_;
+    std::unique_ptr<uint8_t[]> storage_;
+};
+
+// Blocking wrappers for the lock-free rings: retry, yielding between attempts
+template<typename Ring>
+void PushWaitSpin(Ring& ring, std::span<const uint8_t> data) {
+    while (!ring.TryPush(data)) {
+        std::this_thread::yield();
+    }
+}
+
+template<typename Ring, typename F>
+bool ConsumeWaitSpin(Ring& ring, F&& f, std::chrono::milliseconds timeout) {
+    const bool infinite = timeout == std::chrono::milliseconds::max();
+    const auto deadline = infinite ? std::chrono::steady_clock::time_point::max()
+                                   : std::chrono::steady_clock::now() + timeout;
+    while (!ring.TryConsume(f)) {
+        if (!infinite && std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+} // namespace detail
+
+// PRECONDITION: capacity is a power of 2
+class LamportRing {
+public:
+    LamportRing(size_t capacity, size_t max_message_size)
+        : slots_(capacity, max_message_size)
+    {
+    }
+
+    bool TryPush(std::span<const uint8_t> data) noexcept {
+        const uint64_t write = write_.load(std::memory_order_relaxed);
+        if (write - read_.load(std::memory_order_acquire) >= slots_.Capacity()) {
+            return false;
+        }
+        slots_.Write(write, data);
+        write_.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    void PushWait(std::span<const uint8_t> data) { detail::PushWaitSpin(*this, data); }
+
+    template<typename F>
+    bool TryConsume(F&& f) {
+        const uint64_t read = read_.load(std::memory_order_relaxed);
+        if (read == write_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        f(slots_.Read(read));
+        read_.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename F>
+    bool ConsumeWait(F&& f, std::chrono::milliseconds timeout) {
+        return detail::ConsumeWaitSpin(*this, f, timeout);
+    }
+
+private:
+    alignas(CACHE_LINE) std::atomic<uint64_t> write_{0};
+    alignas(CACHE_LINE) std::atomic<uint64_t> read_{0};
+    alignas(CACHE_LINE) detail::SlotArray slots_;
+};
+
+// PRECONDITION: capacity is a power of 2
+class CachedIndexRing {
+public:
+    CachedIndexRing(size_t capacity, size_t max_message_size)
+        : slots_(capacity, max_message_size)
+    {
+    }
+
+    bool TryPush(std::span<const uint8_t> data) noexcept {
+        const uint64_t write = write_.load(std::memory_order_relaxed);
+        if (write - cached_read_ >= slots_.Capacity()) {
+            cached_read_ = read_.load(std::memory_order_acquire);
+            if (write - cached_read_ >= slots_.Capacity()) {
+                return false;
+            }
+        }
+        slots_.Write(write, data);
+        write_.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    void PushWait(std::span<const uint8_t> data) { detail::PushWaitSpin(*this, data); }
+
+    template<typename F>
+    bool TryConsume(F&& f) {
+        const uint64_t read = read_.load(std::memory_order_relaxed);
+        if (read == cached_write_) {
+            cached_write_ = write_.load(std::memory_order_acquire);
+            if (read == cached_write_) {
+                return false;
+            }
+        }
+        f(slots_.Read(read));
+        read_.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename F>
+    bool ConsumeWait(F&& f, std::chrono::milliseconds timeout) {
+        return detail::ConsumeWaitSpin(*this, f, timeout);
+    }
+
+private:
+    // Producer line: own index + cached copy of the consumer's
+    alignas(CACHE_LINE) std::atomic<uint64_t> write_{0};
+    uint64_t cached_read_ = 0;
+    // Consumer line: own index + cached copy of the producer's
+    alignas(CACHE_LINE) std::atomic<uint64_t> read_{0};
+    uint64_t cached_write_ = 0;
+    alignas(CACHE_LINE) detail::SlotArray slots_;
+};
+
+} // namespace omni::bench::reference
+
+#endif // OMNI_BENCH_REFERENCE_QUEUES_HPP
@@ -0,0 +1,295 @@
+// bench/registry_churn.cpp
+// OmniMailbox broker registry contention and channel churn harness
+//
+// Worker threads hammer the broker registry with a weighted mix of
+// RequestChannel / HasChannel / RemoveChannel / GetStats over a pool of
+// channel names drawn from a Zipf distribution (a few hot names, a long
+// tail), while --resident long-lived channels keep the registry large.
+// Every operation is timed individually and reported as ops/sec plus
+// p50/p99/p99.9 latency per operation type.
+//
+// Created channels get a capacity and message size drawn from a mixed
+// distribution (mostly small rings, some large), and their handles are
+// dropped immediately so a later RemoveChannel can retire them: one
+// request + remove pair is one unit of churn.
+//
+// Usage:
+//   bench-registry [--threads=N] [--sweep] [--duration-ms=N] [--names=N]
+//                  [--zipf=S] [--resident=N] [--mix=REQ:HAS:REMOVE:STATS]
+
+#include <omni/mailbox.hpp>
+#include "bench_common.hpp"
+#include "hdr_histogram.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using omni::bench::HdrHistogram;
+using omni::bench::NowNs;
+
+enum Op : size_t { OP_REQUEST, OP_HAS, OP_REMOVE, OP_STATS, OP_COUNT };
+
+constexpr std::array<const char*, OP_COUNT> OP_NAMES{"RequestChannel", "HasChannel", "RemoveChannel", "GetStats"};
+
+struct Options {
+    int64_t threads = std::max(2u, std::thread::hardware_concurrency());
+    bool sweep = false;             // Run 1, 2, 4, ... threads up to --threads
+    int64_t duration_ms = 2000;
+    int64_t names = 4096;           // Churn name pool size
+    double zipf = 0.99;             // Name skew; 0 = uniform
+    int64_t resident = 1000;        // Long-lived channels registered for the whole run
+    std::array<int64_t, OP_COUNT> mix{30, 50, 15, 5};
+};
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (auto v = omni::bench::FlagValue(arg, "threads")) {
+            options.threads = omni::bench::ParseInt(*v, -1);
+        } else if (arg == "--sweep") {
+            options.sweep = true;
+        } else if (auto v = omni::bench::FlagValue(arg, "duration-ms")) {
+            options.duration_ms = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "names")) {
+            options.names = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "zipf")) {
+            options.zipf = std::strtod(std::string(*v).c_str(), nullptr);
+        } else if (auto v = omni::bench::FlagValue(arg, "resident")) {
+            options.resident = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "mix")) {
+            long long weights[OP_COUNT] = {};
+            if (std::sscanf(std::string(*v).c_str(), "%lld:%lld:%lld:%lld",
+                            &weights[0], &weights[1], &weights[2], &weights[3]) != OP_COUNT) {
+                std::fprintf(stderr, "--mix expects REQ:HAS:REMOVE:STATS\n");
+                return false;
+            }
+            for (size_t op = 0; op < OP_COUNT; ++op) {
+                options.mix[op] = weights[op];
+            }
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    const bool mix_valid = std::all_of(options.mix.begin(), options.mix.end(), [](int64_t w) { return w >= 0; }) &&
+                           std::any_of(options.mix.begin(), options.mix.end(), [](int64_t w) { return w > 0; });
+    if (options.threads <= 0 || options.duration_ms <= 0 || options.names <= 0 ||
+        options.resident < 0 || options.zipf < 0.0 || !mix_valid) {
+        std::fprintf(stderr, "Invalid numeric argument\n");
+        return false;
+    }
+    return true;
+}
+
+// Realistic, variable-length names: "<service>.shard-<n>.<topic>"
+std::string MakeName(const char* prefix, int64_t i) {
+    static constexpr std::array<const char*, 6> SERVICES{"orders", "md", "risk-engine", "gw", "pricing", "audit-log"};
+    static constexpr std::array<const char*, 5> TOPICS{"events", "cmd", "snapshots", "heartbeat", "fills"};
+    return std::string(prefix) + SERVICES[static_cast<size_t>(i) % SERVICES.size()] +
+           ".shard-" + std::to_string(i) + "." + TOPICS[static_cast<size_t>(i / 7) % TOPICS.size()];
+}
+
+// Mostly small rings, occasionally large ones (allocation cost is part of RequestChannel)
+omni::ChannelConfig DrawConfig(std::mt19937_64& rng) {
+    static constexpr std::array<size_t, 8> CAPACITIES{64, 64, 256, 256, 256, 1024, 1024, 4096};
+    static constexpr std::array<size_t, 4> MESSAGE_SIZES{256, 256, 1024, 4096};
+    return omni::ChannelConfig{
+        .capacity = CAPACITIES[rng() % CAPACITIES.size()],
+        .max_message_size = MESSAGE_SIZES[rng() % MESSAGE_SIZES.size()]
+    };
+}
+
+// Inverse-CDF Zipf sampler over [0, n)
+class ZipfSampler {
+public:
+    ZipfSampler(size_t n, double s) : cdf_(n) {
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += 1.0 / std::pow(static_cast<double>(i + 1), s);
+            cdf_[i] = sum;
+        }
+        for (auto& value : cdf_) {
+            value /= sum;
+        }
+    }
+
+    size_t operator()(std::mt19937_64& rng) const {
+        const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        const auto it = std::lower_bound(cdf_.begin(), cdf_.end(), u);
+        return std::min(static_cast<size_t>(it - cdf_.begin()), cdf_.size() - 1);
+    }
+
+private:
+    std::vector<double> cdf_;
+};
+
+struct ThreadResult {
+    std::array<HdrHistogram, OP_COUNT> latency;
+    std::array<uint64_t, OP_COUNT> succeeded{};
+};
+
+void RunOnce(const Options& options, size_t threads, const std::vector<std::string>& names,
+             const ZipfSampler& zipf) {
+    auto& broker = omni::MailboxBroker::Instance();
+    const int64_t mix_total = options.mix[0] + options.mix[1] + options.mix[2] + options.mix[3];
+
+    std::vector<ThreadResult> results(threads);
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> ready{0};
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            std::mt19937_64 rng(0x9E3779B97F4A7C15ull * (t + 1));
+            ThreadResult& result = results[t];
+            ready.fetch_add(1, std::memory_order_acq_rel);
+            while (ready.load(std::memory_order_acquire) < threads) {
+                std::this_thread::yield();
+            }
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                int64_t pick = static_cast<int64_t>(rng() % static_cast<uint64_t>(mix_total));
+                size_t op = 0;
+                while (pick >= options.mix[op]) {
+                    pick -= options.mix[op];
+                    ++op;
+                }
+                const std::string& name = names[zipf(rng)];
+
+                bool ok = false;
+                const uint64_t begin = NowNs();
+                switch (op) {
+                    case OP_REQUEST: {
+                        // Handles are dropped at scope exit, leaving the channel removable
+                        auto [error, pair] = broker.RequestChannel(name, DrawConfig(rng));
+                        ok = error == omni::ChannelError::Success;
+                        break;
+                    }
+                    case OP_HAS:
+                        ok = broker.HasChannel(name);
+                        break;
+                    case OP_REMOVE:
+                        ok = broker.RemoveChannel(name);
+                        break;
+                    default: {
+                        const auto stats = broker.GetStats();
+                        ok = stats.active_channels > 0;
+                        break;
+                    }
+                }
+                result.latency[op].Record(NowNs() - begin);
+                result.succeeded[op] += ok ? 1 : 0;
+            }
+        });
+    }
+
+    while (ready.load(std::memory_order_acquire) < threads) {
+        std::this_thread::yield();
+    }
+    const uint64_t start = NowNs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(options.duration_ms));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double seconds = static_cast<double>(NowNs() - start) / 1e9;
+
+    std::printf("\nthreads=%zu registered=%zu\n", threads, broker.GetStats().active_channels);
+    std::printf("%-16s %12s %12s %8s %10s %10s %10s %10s\n",
+                "operation", "ops", "ops/sec", "ok %", "p50 ns", "p99 ns", "p99.9 ns", "max ns");
+
+    uint64_t total_ops = 0;
+    for (size_t op = 0; op < OP_COUNT; ++op) {
+        HdrHistogram merged;
+        uint64_t succeeded = 0;
+        for (const auto& result : results) {
+            merged.Merge(result.latency[op]);
+            succeeded += result.succeeded[op];
+        }
+        total_ops += merged.Count();
+        if (merged.Count() == 0) {
+            continue;
+        }
+        std::printf("%-16s %12llu %12.0f %7.1f%% %10llu %10llu %10llu %10llu\n",
+                    OP_NAMES[op],
+                    static_cast<unsigned long long>(merged.Count()),
+                    static_cast<double>(merged.Count()) / seconds,
+                    100.0 * static_cast<double>(succeeded) / static_cast<double>(merged.Count()),
+                    static_cast<unsigned long long>(merged.ValueAtPercentile(50.0)),
+                    static_cast<unsigned long long>(merged.ValueAtPercentile(99.0)),
+                    static_cast<unsigned long long>(merged.ValueAtPercentile(99.9)),
+                    static_cast<unsigned long long>(merged.Max()));
+    }
+    std::printf("%-16s %12llu %12.0f\n", "total",
+                static_cast<unsigned long long>(total_ops), static_cast<double>(total_ops) / seconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    auto& broker = omni::MailboxBroker::Instance();
+
+    // Long-lived channels: handles kept open so churn can never remove them
+    std::vector<omni::ChannelPair> resident;
+    std::vector<std::string> resident_names;
+    std::mt19937_64 config_rng(42);
+    for (int64_t i = 0; i < options.resident; ++i) {
+        resident_names.push_back(MakeName("resident.", i));
+        auto [error, pair] = broker.RequestChannel(resident_names.back(), DrawConfig(config_rng));
+        if (error != omni::ChannelError::Success) {
+            std::fprintf(stderr, "Failed to create resident channel %lld\n", static_cast<long long>(i));
+            return 1;
+        }
+        resident.push_back(std::move(*pair));
+    }
+
+    std::vector<std::string> names;
+    for (int64_t i = 0; i < options.names; ++i) {
+        names.push_back(MakeName("churn.", i));
+    }
+    const ZipfSampler zipf(names.size(), options.zipf);
+
+    std::printf("names=%lld zipf=%.2f resident=%lld mix=%lld:%lld:%lld:%lld duration=%lldms\n",
+                static_cast<long long>(options.names), options.zipf,
+                static_cast<long long>(options.resident),
+                static_cast<long long>(options.mix[0]), static_cast<long long>(options.mix[1]),
+                static_cast<long long>(options.mix[2]), static_cast<long long>(options.mix[3]),
+                static_cast<long long>(options.duration_ms));
+
+    std::vector<size_t> thread_counts;
+    if (options.sweep) {
+        for (size_t n = 1; n < static_cast<size_t>(options.threads); n *= 2) {
+            thread_counts.push_back(n);
+        }
+    }
+    thread_counts.push_back(static_cast<size_t>(options.threads));
+
+    for (size_t threads : thread_counts) {
+        RunOnce(options, threads, names, zipf);
+        for (const auto& name : names) {
+            broker.RemoveChannel(name);  // Start every run from the same registry size
+        }
+    }
+
+    resident.clear();
+    for (const auto& name : resident_names) {
+        broker.RemoveChannel(name);
+    }
+    return 0;
+}
@@ -0,0 +1,341 @@
+// bench/scaling.cpp
+// OmniMailbox multi-channel, multi-core scaling harness
+//
+// Runs N independent producer/consumer channel pairs concurrently, each
+// thread pinned according to a topology-aware placement, and reports
+// per-pair and aggregate throughput plus one-way latency percentiles.
+// Sweeping N shows where shared resources (SMT core, L3, memory
+// bandwidth, cross-socket interconnect) stop aggregate throughput from
+// scaling linearly.
+//
+// Placements (per pair):
+//   smt           producer and consumer on SMT siblings of one core
+//   l3            different cores sharing an L3 (same CCX/die)
+//   cross-l3      different L3 domains on one package
+//   cross-socket  different packages
+//   spread        any two unused CPUs, in CPU order
+//   none          unpinned
+//
+// Usage:
+//   bench-scaling [--placement=NAME|all] [--pairs=N] [--duration-ms=N]
+//                 [--size=BYTES] [--capacity=N] [--rate=N] [--per-pair]
+
+#include <omni/mailbox.hpp>
+#include "bench_common.hpp"
+#include "cpu_topology.hpp"
+#include "hdr_histogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using omni::bench::HdrHistogram;
+using omni::bench::NowNs;
+using omni::bench::Placement;
+
+struct Options {
+    std::vector<Placement> placements{Placement::SameL3};
+    int64_t pairs = 0;              // 0 = sweep 1, 2, 4, ... up to the placeable maximum
+    int64_t duration_ms = 1000;
+    int64_t size = 64;
+    int64_t capacity = 1024;
+    int64_t rate = 0;               // Per-pair messages/sec, 0 = saturate
+    bool per_pair = false;          // Print one row per pair
+};
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (auto v = omni::bench::FlagValue(arg, "placement")) {
+            if (*v == "all") {
+                options.placements = {Placement::Smt, Placement::SameL3, Placement::CrossL3,
+                                      Placement::CrossSocket, Placement::None};
+            } else if (auto placement = omni::bench::ParsePlacement(*v)) {
+                options.placements = {*placement};
+            } else {
+                std::fprintf(stderr, "Unknown placement: %.*s\n", static_cast<int>(v->size()), v->data());
+                return false;
+            }
+        } else if (auto v = omni::bench::FlagValue(arg, "pairs")) {
+            options.pairs = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "duration-ms")) {
+            options.duration_ms = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "size")) {
+            options.size = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "capacity")) {
+            options.capacity = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "rate")) {
+            options.rate = omni::bench::ParseInt(*v, -1);
+        } else if (arg == "--per-pair") {
+            options.per_pair = true;
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    if (options.pairs < 0 || options.duration_ms <= 0 || options.rate < 0 ||
+        options.size < 16 || options.capacity < 8) {
+        std::fprintf(stderr, "Invalid numeric argument (size >= 16, capacity >= 8)\n");
+        return false;
+    }
+    return true;
+}
+
+// Per-pair result, written only by that pair's consumer thread
+struct PairResult {
+    int producer_cpu = -1;
+    int consumer_cpu = -1;
+    uint64_t messages = 0;
+    HdrHistogram latency;
+};
+
+struct RunResult {
+    double seconds = 0.0;
+    bool pinned = true;  // False: some thread could not take its planned CPU
+    std::vector<std::unique_ptr<PairResult>> pairs;
+};
+
+// Run all pairs for the configured duration; plan holds {producer_cpu, consumer_cpu}
+bool RunPairs(const Options& options, const std::vector<std::pair<int, int>>& plan, RunResult& run) {
+    auto& broker = omni::MailboxBroker::Instance();
+    std::vector<std::string> names;
+    std::vector<omni::ChannelPair> channels;
+
+    // Handles first: RemoveChannel refuses channels with live handles
+    auto release = [&]() {
+        channels.clear();
+        for (const auto& name : names) {
+            broker.RemoveChannel(name);
+        }
+    };
+
+    for (size_t i = 0; i < plan.size(); ++i) {
+        names.push_back("bench-scaling-" + std::to_string(i));
+        auto [error, pair] = broker.RequestChannel(names.back(), {
+            .capacity = static_cast<size_t>(options.capacity),
+            .max_message_size = static_cast<size_t>(options.size)
+        });
+        if (error != omni::ChannelError::Success) {
+            std::fprintf(stderr, "Failed to create channel %zu\n", i);
+            names.pop_back();  // Not ours (e.g. NameExists)
+            release();
+            return false;
+        }
+        channels.push_back(std::move(*pair));
+
+        run.pairs.push_back(std::make_unique<PairResult>());
+        run.pairs.back()->producer_cpu = plan[i].first;
+        run.pairs.back()->consumer_cpu = plan[i].second;
+    }
+
+    // Every thread pins itself, then waits for the common start time
+    std::atomic<size_t> ready{0};
+    std::atomic<uint64_t> start_ns{0};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> pin_failed{false};
+    const size_t thread_count = plan.size() * 2;
+
+    // A CPU that is offline or outside the affinity mask / cpuset leaves the
+    // thread unpinned; the run is then not the placement it would be reported as
+    auto pin = [&](int cpu, const char* role, size_t pair) {
+        if (cpu >= 0 && !omni::PinCurrentThread(cpu)) {
+            std::fprintf(stderr, "warning: could not pin pair %zu %s to CPU %d\n", pair, role, cpu);
+            pin_failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    auto wait_for_start = [&]() {
+        ready.fetch_add(1, std::memory_order_acq_rel);
+        uint64_t start = 0;
+        while ((start = start_ns.load(std::memory_order_acquire)) == 0) {
+            std::this_thread::yield();
+        }
+        return start;
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < plan.size(); ++i) {
+        // Producer: timestamp in the payload (scheduled time when paced)
+        threads.emplace_back([&, i]() {
+            pin(plan[i].first, "producer", i);
+            auto& producer = channels[i].producer;
+            std::vector<uint8_t> payload(static_cast<size_t>(options.size), 0xCD);
+            const uint64_t start = wait_for_start();
+
+            for (uint64_t n = 0; !stop.load(std::memory_order_relaxed); ++n) {
+                uint64_t stamp = 0;
+                if (options.rate > 0) {
+                    stamp = start + n * 1'000'000'000ull / static_cast<uint64_t>(options.rate);
+                    omni::bench::SpinUntil(stamp);
+                } else {
+                    stamp = NowNs();
+                }
+                std::memcpy(payload.data(), &stamp, sizeof(stamp));
+                while (producer.TryPush(payload) == omni::PushResult::QueueFull) {
+                    if (stop.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+                }
+            }
+        });
+
+        // Consumer: drains in batches, one clock read per batch
+        threads.emplace_back([&, i]() {
+            pin(plan[i].second, "consumer", i);
+            auto& consumer = channels[i].consumer;
+            PairResult& result = *run.pairs[i];
+            wait_for_start();
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto [status, messages] = consumer.BatchPop(64);
+                if (messages.empty()) {
+                    continue;
+                }
+                const uint64_t now = NowNs();
+                for (const auto& msg : messages) {
+                    uint64_t stamp = 0;
+                    std::memcpy(&stamp, msg.Data().data(), sizeof(stamp));
+                    result.latency.Record(now > stamp ? now - stamp : 0);
+                }
+                result.messages += messages.size();
+            }
+        });
+    }
+
+    while (ready.load(std::memory_order_acquire) < thread_count) {
+        std::this_thread::yield();
+    }
+    // Every thread has pinned (or failed to) before it counts itself ready
+    run.pinned = !pin_failed.load(std::memory_order_relaxed);
+    const uint64_t begin = NowNs() + 1'000'000;  // 1ms for every thread to observe the start
+    start_ns.store(begin, std::memory_order_release);
+    if (run.pinned) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1 + options.duration_ms));
+    }
+    stop.store(true, std::memory_order_relaxed);
+    const uint64_t end = NowNs();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    run.seconds = static_cast<double>(end - begin) / 1e9;
+
+    release();
+    return true;
+}
+
+void PrintRow(const char* label, int producer_cpu, int consumer_cpu, double mmsg_per_sec,
+              double mb_per_sec, const HdrHistogram& h) {
+    std::printf("%-12s %6d %6d %12.2f %12.1f %10llu %10llu %10llu\n",
+                label, producer_cpu, consumer_cpu, mmsg_per_sec, mb_per_sec,
+                static_cast<unsigned long long>(h.ValueAtPercentile(50.0)),
+                static_cast<unsigned long long>(h.ValueAtPercentile(99.0)),
+                static_cast<unsigned long long>(h.ValueAtPercentile(99.9)));
+}
+
+// Pair counts to run: 1, 2, 4, ... plus the largest placeable count
+std::vector<size_t> SweepCounts(const Options& options, size_t max_pairs) {
+    if (options.pairs > 0) {
+        return {static_cast<size_t>(options.pairs)};
+    }
+    std::vector<size_t> counts;
+    for (size_t n = 1; n < max_pairs; n *= 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(max_pairs);
+    return counts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    const auto detected = omni::CpuTopology::Detect();
+    const auto topology = detected.Cpus();
+    std::printf("topology: %s\n", omni::bench::DescribeTopology(topology).c_str());
+    std::printf("size=%lld capacity=%lld duration=%lldms rate=%s\n",
+                static_cast<long long>(options.size), static_cast<long long>(options.capacity),
+                static_cast<long long>(options.duration_ms),
+                options.rate > 0 ? (std::to_string(options.rate) + "/s per pair").c_str() : "saturate");
+
+    for (Placement placement : options.placements) {
+        // Largest pair count this placement can host without sharing CPUs
+        size_t max_pairs = 0;
+        while (omni::bench::PlanPlacement(topology, placement, max_pairs + 1) &&
+               max_pairs + 1 <= topology.size() / 2) {
+            ++max_pairs;
+        }
+        if (placement == Placement::None) {
+            max_pairs = std::max<size_t>(1, topology.size() / 2);
+        }
+
+        std::printf("\n== placement=%s (max %zu pairs)\n", omni::bench::PlacementName(placement), max_pairs);
+        if (max_pairs == 0) {
+            std::printf("   not available on this topology\n");
+            continue;
+        }
+        std::printf("%-12s %6s %6s %12s %12s %10s %10s %10s %10s\n",
+                    "pairs", "p-cpu", "c-cpu", "Mmsg/s", "MB/s", "p50 ns", "p99 ns", "p99.9 ns", "scaling");
+
+        double single_pair_rate = 0.0;
+        for (size_t count : SweepCounts(options, max_pairs)) {
+            const auto plan = omni::bench::PlanPlacement(topology, placement, count);
+            if (!plan) {
+                std::printf("%-12zu placement unavailable\n", count);
+                continue;
+            }
+
+            RunResult run;
+            if (!RunPairs(options, *plan, run)) {
+                return 1;
+            }
+            if (!run.pinned) {
+                std::printf("%-12zu pinning failed: placement not in effect, not reported\n", count);
+                continue;
+            }
+
+            HdrHistogram aggregate;
+            uint64_t total = 0;
+            for (const auto& pair : run.pairs) {
+                aggregate.Merge(pair->latency);
+                total += pair->messages;
+                if (options.per_pair) {
+                    const double rate = static_cast<double>(pair->messages) / run.seconds;
+                    PrintRow("  pair", pair->producer_cpu, pair->consumer_cpu, rate / 1e6,
+                             rate * static_cast<double>(options.size) / 1e6, pair->latency);
+                }
+            }
+
+            const double rate = static_cast<double>(total) / run.seconds;
+            if (count == 1) {
+                single_pair_rate = rate;
+            }
+            // Scaling efficiency: aggregate / (pairs * single-pair throughput)
+            const double efficiency = single_pair_rate > 0.0
+                ? rate / (static_cast<double>(count) * single_pair_rate)
+                : 0.0;
+
+            const std::string label = std::to_string(count);
+            std::printf("%-12s %6s %6s %12.2f %12.1f %10llu %10llu %10llu %9.0f%%\n",
+                        label.c_str(), "-", "-", rate / 1e6,
+                        rate * static_cast<double>(options.size) / 1e6,
+                        static_cast<unsigned long long>(aggregate.ValueAtPercentile(50.0)),
+                        static_cast<unsigned long long>(aggregate.ValueAtPercentile(99.0)),
+                        static_cast<unsigned long long>(aggregate.ValueAtPercentile(99.9)),
+                        efficiency * 100.0);
+        }
+    }
+    return 0;
+}
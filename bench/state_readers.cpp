@@ -0,0 +1,210 @@
+// bench/state_readers.cpp
+// OmniMailbox state channel reader harness
+//
+// Measures StateConsumer reads per second while a writer thread publishes
+// at a fixed rate (default 1 MHz, open loop: paced by the clock, never by
+// the reader). Every value is checked for tearing.
+//
+//   read     The reader calls Read() in a tight loop (copy + validate).
+//   changed  The reader polls ChangedSince() and calls Read() only when the
+//            version moved: the usual hot-path pattern for config state.
+//
+// Usage:
+//   bench-state [--mode=read|changed|both] [--sizes=16,64,256,1024]
+//               [--rate=HZ] [--ms=N] [--reader-cpu=N] [--writer-cpu=N]
+//   --rate=0 runs the reader without a writer.
+
+#include <omni/mailbox.hpp>
+#include "bench_common.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using omni::bench::NowNs;
+
+struct Options {
+    bool read = true;
+    bool changed = true;
+    std::vector<int64_t> sizes{16, 64, 256, 1024};
+    int64_t rate = 1'000'000;  // Writer publishes per second (0 = no writer)
+    int64_t ms = 500;          // Per row
+    int reader_cpu = -1;
+    int writer_cpu = -1;
+};
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (auto v = omni::bench::FlagValue(arg, "mode")) {
+            options.read = (*v == "read" || *v == "both");
+            options.changed = (*v == "changed" || *v == "both");
+        } else if (auto v = omni::bench::FlagValue(arg, "sizes")) {
+            options.sizes.clear();
+            for (auto item : omni::bench::SplitList(*v)) {
+                options.sizes.push_back(omni::bench::ParseInt(item, -1));
+            }
+        } else if (auto v = omni::bench::FlagValue(arg, "rate")) {
+            options.rate = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "ms")) {
+            options.ms = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "reader-cpu")) {
+            options.reader_cpu = static_cast<int>(omni::bench::ParseInt(*v, -1));
+        } else if (auto v = omni::bench::FlagValue(arg, "writer-cpu")) {
+            options.writer_cpu = static_cast<int>(omni::bench::ParseInt(*v, -1));
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    // Values carry an 8-byte counter; ChannelConfig caps them at 1 MiB
+    const bool sizes_valid = !options.sizes.empty() &&
+        std::all_of(options.sizes.begin(), options.sizes.end(), [](int64_t n) { return n >= 9 && n <= 1'048'576; });
+    if ((!options.read && !options.changed) || !sizes_valid || options.rate < 0 || options.ms < 1) {
+        std::fprintf(stderr, "Invalid argument (sizes 9..1048576, rate >= 0, ms >= 1)\n");
+        return false;
+    }
+    return true;
+}
+
+// Counter at offset 0, then its low byte repeated: a torn copy mixes two
+// counters, so the filler disagrees with the counter somewhere
+void Fill(std::vector<uint8_t>& value, uint64_t counter) {
+    std::memset(value.data() + sizeof(counter), static_cast<uint8_t>(counter), value.size() - sizeof(counter));
+    std::memcpy(value.data(), &counter, sizeof(counter));
+}
+
+bool Consistent(std::span<const uint8_t> data) {
+    uint64_t counter = 0;
+    std::memcpy(&counter, data.data(), sizeof(counter));
+    const auto low = static_cast<uint8_t>(counter);
+    return std::all_of(data.begin() + sizeof(counter), data.end(), [low](uint8_t b) { return b == low; });
+}
+
+struct RunResult {
+    bool ok = false;
+    double seconds = 0.0;
+    uint64_t checks = 0;     // Read() or ChangedSince() calls
+    uint64_t reads = 0;      // Successful Read() copies
+    uint64_t versions = 0;   // Distinct versions the reader saw
+    uint64_t published = 0;
+    uint64_t retries = 0;
+};
+
+RunResult Run(const Options& options, size_t size, bool changed_only) {
+    RunResult result;
+    auto& broker = omni::MailboxBroker::Instance();
+    broker.RemoveChannel("bench-state");
+    auto [error, channel] = broker.RequestStateChannel("bench-state", {.max_message_size = size});
+    if (error != omni::ChannelError::Success) {
+        std::fprintf(stderr, "RequestStateChannel failed for %zu bytes\n", size);
+        return result;
+    }
+    auto& consumer = channel->consumer;
+
+    std::vector<uint8_t> initial(size);
+    Fill(initial, 0);
+    (void)channel->producer.Publish(initial);
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&, producer = std::move(channel->producer)]() mutable {
+        omni::PinCurrentThread(options.writer_cpu);
+        if (options.rate == 0) {
+            return;
+        }
+        std::vector<uint8_t> value(size);
+        const uint64_t period = 1'000'000'000ULL / static_cast<uint64_t>(options.rate);
+        uint64_t next = NowNs();
+        for (uint64_t counter = 1; !stop.load(std::memory_order_relaxed); ++counter) {
+            omni::bench::SpinUntil(next);
+            next += period;
+            Fill(value, counter);
+            (void)producer.Publish(value);
+        }
+        result.published = producer.Version();
+    });
+
+    omni::PinCurrentThread(options.reader_cpu);
+    bool torn = false;
+    uint64_t seen = 0;
+    const uint64_t start = NowNs();
+    const uint64_t end = start + static_cast<uint64_t>(options.ms) * 1'000'000ULL;
+    while (true) {
+        // Check the clock every 1024 iterations only
+        for (int i = 0; i < 1024; ++i) {
+            ++result.checks;
+            if (changed_only && !consumer.ChangedSince(seen)) {
+                continue;
+            }
+            auto [r, snapshot] = consumer.Read();
+            if (r != omni::PopResult::Success || !snapshot) {
+                torn = true;  // Reported as a failed run (no snapshot to look at)
+                break;
+            }
+            torn |= !Consistent(snapshot->data);
+            result.versions += snapshot->version != seen;
+            seen = snapshot->version;
+            ++result.reads;
+        }
+        if (torn || NowNs() >= end) {
+            break;
+        }
+    }
+    result.seconds = static_cast<double>(NowNs() - start) / 1e9;
+    stop.store(true, std::memory_order_relaxed);
+    writer.join();
+
+    result.retries = consumer.Retries();
+    result.ok = !torn;
+    return result;
+}
+
+void PrintHeader(const char* title, const Options& options) {
+    std::printf("\n%s, writer at %lld Hz\n", title, static_cast<long long>(options.rate));
+    std::printf("%8s %14s %8s %12s %12s %12s %10s\n",
+                "bytes", "checks/sec", "ns/chk", "reads", "versions", "published", "retries");
+}
+
+void PrintRow(size_t size, const RunResult& r) {
+    const double rate = r.seconds > 0 ? static_cast<double>(r.checks) / r.seconds : 0.0;
+    std::printf("%8zu %14.0f %8.2f %12llu %12llu %12llu %10llu\n",
+                size, rate, r.checks > 0 ? r.seconds * 1e9 / static_cast<double>(r.checks) : 0.0,
+                static_cast<unsigned long long>(r.reads), static_cast<unsigned long long>(r.versions),
+                static_cast<unsigned long long>(r.published), static_cast<unsigned long long>(r.retries));
+}
+
+bool Sweep(const Options& options, const char* title, bool changed_only) {
+    PrintHeader(title, options);
+    for (int64_t size : options.sizes) {
+        const RunResult r = Run(options, static_cast<size_t>(size), changed_only);
+        if (!r.ok) {
+            std::fprintf(stderr, "%s: torn or failed read at %lld bytes\n", title, static_cast<long long>(size));
+            return false;
+        }
+        PrintRow(static_cast<size_t>(size), r);
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    if (options.read && !Sweep(options, "read (Read() every check)", false)) {
+        return 1;
+    }
+    if (options.changed && !Sweep(options, "changed (ChangedSince(), Read() on change)", true)) {
+        return 1;
+    }
+    return 0;
+}
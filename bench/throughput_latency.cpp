@@ -3,14 +3,57 @@
 // 
 // This file implements throughput and latency benchmarks as specified
 // in section 8.1 of the design specification.
+//
+// BM_Reference_* run in-repo reference queues (mutex+deque, Lamport ring,
+// cached-index ring; bench/reference_queues.hpp) through the same harness,
+// message sizes and capacity, as a fixed baseline for OmniMailbox results.
+//
+// --perf-counters adds per-message hardware counters (cycles, instructions,
+// L1d/LLC/dTLB misses, context switches) via perf_event_open, covering
+// both the benchmark thread and its consumer/responder thread.
 
 #include <benchmark/benchmark.h>
 #include <omni/mailbox.hpp>
+#include "perf_counters.hpp"
+#include "reference_queues.hpp"
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 #include <atomic>
 #include <chrono>
 
+namespace {
+
+bool perf_counters_enabled = false;
+
+// Open and start counters before spawning helper threads (inherit covers them)
+void StartPerfCounters(std::optional<omni::bench::PerfCounters>& counters) {
+    if (perf_counters_enabled) {
+        counters.emplace();
+        counters->Start();
+    }
+}
+
+// Stop counters (after helper threads are joined) and report "<event>/msg"
+void ReportPerfCounters(benchmark::State& state, std::optional<omni::bench::PerfCounters>& counters,
+                        double messages) {
+    if (!counters || messages <= 0.0) {
+        return;
+    }
+    counters->Stop();
+    for (size_t i = 0; i < omni::bench::PERF_EVENT_COUNT; ++i) {
+        const auto event = static_cast<omni::bench::PerfEvent>(i);
+        if (auto value = counters->Read(event)) {
+            state.counters[std::string(omni::bench::PerfEventName(event)) + "/msg"] = *value / messages;
+        }
+    }
+}
+
+} // namespace
+
 // Throughput: Single channel, uncontended
 // Producer in one thread, consumer in another
 // Measures messages per second for different message sizes
@@ -37,6 +80,9 @@ static void BM_Throughput_Uncontended(benchmark::State& state) {
     std::atomic<bool> consumer_running{true};
     std::atomic<size_t> messages_consumed{0};
     
+    std::optional<omni::bench::PerfCounters> counters;
+    StartPerfCounters(counters);
+    
     // Consumer thread - runs continuously
     std::thread consumer([&]() {
         while (consumer_running.load(std::memory_order_relaxed)) {
@@ -67,6 +113,7 @@ static void BM_Throughput_Uncontended(benchmark::State& state) {
     // Signal consumer to stop
     consumer_running.store(false, std::memory_order_relaxed);
     consumer.join();
+    ReportPerfCounters(state, counters, static_cast<double>(messages_consumed.load()));
     
     // Report metrics
     state.SetItemsProcessed(state.iterations());
@@ -84,6 +131,8 @@ BENCHMARK(BM_Throughput_Uncontended)
 // Latency: Round-trip ping-pong
 // Measures round-trip time between two threads
 // Uses 64-byte messages
+// NOTE: Reports mean time per iteration only; use bench-latency
+// (bench/latency_hdr.cpp) for per-message percentiles
 static void BM_Latency_RoundTrip(benchmark::State& state) {
     auto& broker = omni::MailboxBroker::Instance();
     
@@ -105,6 +154,9 @@ static void BM_Latency_RoundTrip(benchmark::State& state) {
     
     std::atomic<bool> responder_running{true};
     
+    std::optional<omni::bench::PerfCounters> counters;
+    StartPerfCounters(counters);
+    
     // Responder thread - echoes messages back
     std::thread responder([&]() {
         while (responder_running.load(std::memory_order_relaxed)) {
@@ -143,6 +195,9 @@ static void BM_Latency_RoundTrip(benchmark::State& state) {
     // Signal responder to stop
     responder_running.store(false, std::memory_order_relaxed);
     responder.join();
+    
+    // Two messages (ping + pong) per iteration
+    ReportPerfCounters(state, counters, 2.0 * static_cast<double>(state.iterations()));
 }
 
 // Register latency benchmark
@@ -151,4 +206,134 @@ BENCHMARK(BM_Latency_RoundTrip)
     ->UseManualTime()
     ->Unit(benchmark::kNanosecond);
 
-BENCHMARK_MAIN();
+// Reference queues: same harness, sizes and capacity as the OmniMailbox
+// benchmarks above (2048 slots, 8192-byte max message)
+using omni::bench::reference::CachedIndexRing;
+using omni::bench::reference::LamportRing;
+using omni::bench::reference::MutexDequeQueue;
+
+template<typename Queue>
+static void BM_Reference_Throughput(benchmark::State& state) {
+    Queue queue(2048, 8192);
+    
+    const size_t msg_size = state.range(0);
+    std::vector<uint8_t> payload(msg_size, 0xAB);
+    
+    std::atomic<bool> consumer_running{true};
+    std::atomic<size_t> messages_consumed{0};
+    
+    std::optional<omni::bench::PerfCounters> counters;
+    StartPerfCounters(counters);
+    
+    std::thread consumer([&]() {
+        while (consumer_running.load(std::memory_order_relaxed)) {
+            const bool popped = queue.TryConsume([](std::span<const uint8_t> data) {
+                benchmark::DoNotOptimize(data);
+            });
+            if (popped) {
+                messages_consumed.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    for (auto _ : state) {
+        if (!queue.TryPush(payload)) {
+            state.PauseTiming();
+            std::this_thread::sleep_for(std::chrono::microseconds(1));
+            state.ResumeTiming();
+        }
+    }
+    
+    consumer_running.store(false, std::memory_order_relaxed);
+    consumer.join();
+    ReportPerfCounters(state, counters, static_cast<double>(messages_consumed.load()));
+    
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * msg_size);
+}
+
+template<typename Queue>
+static void BM_Reference_RoundTrip(benchmark::State& state) {
+    Queue ping(2048, 8192);
+    Queue pong(2048, 8192);
+    
+    std::vector<uint8_t> payload(64, 0xCD);
+    std::atomic<bool> responder_running{true};
+    
+    std::optional<omni::bench::PerfCounters> counters;
+    StartPerfCounters(counters);
+    
+    std::thread responder([&]() {
+        while (responder_running.load(std::memory_order_relaxed)) {
+            ping.ConsumeWait([&](std::span<const uint8_t> data) {
+                pong.TryPush(data);
+            }, std::chrono::milliseconds(100));
+        }
+    });
+    
+    for (auto _ : state) {
+        auto start = std::chrono::high_resolution_clock::now();
+        
+        ping.PushWait(payload);
+        const bool received = pong.ConsumeWait([](std::span<const uint8_t> data) {
+            benchmark::DoNotOptimize(data);
+        }, std::chrono::milliseconds::max());
+        
+        auto end = std::chrono::high_resolution_clock::now();
+        
+        if (!received) {
+            state.SkipWithError("Pong failed");
+            break;
+        }
+        
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+        state.SetIterationTime(elapsed.count() / 1e9);
+    }
+    
+    responder_running.store(false, std::memory_order_relaxed);
+    responder.join();
+    
+    ReportPerfCounters(state, counters, 2.0 * static_cast<double>(state.iterations()));
+}
+
+#define OMNI_REFERENCE_BENCHMARKS(Queue)                                   \
+    BENCHMARK_TEMPLATE(BM_Reference_Throughput, Queue)                     \
+        ->Arg(64)->Arg(256)->Arg(1024)->Arg(4096)                          \
+        ->Unit(benchmark::kMicrosecond);                                   \
+    BENCHMARK_TEMPLATE(BM_Reference_RoundTrip, Queue)                      \
+        ->UseManualTime()                                                  \
+        ->Unit(benchmark::kNanosecond)
+
+OMNI_REFERENCE_BENCHMARKS(MutexDequeQueue);
+OMNI_REFERENCE_BENCHMARKS(LamportRing);
+OMNI_REFERENCE_BENCHMARKS(CachedIndexRing);
+
+int main(int argc, char** argv) {
+    // Strip our own flag before Google Benchmark rejects it as unrecognized
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--perf-counters") {
+            perf_counters_enabled = true;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    
+    if (perf_counters_enabled && !omni::bench::PerfCounters().Available()) {
+        std::fprintf(stderr, "perf counters unavailable (perf_event_open refused; "
+                             "check perf_event_paranoid or container capabilities), continuing without them\n");
+        perf_counters_enabled = false;
+    }
+    
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,336 @@
+// bench/wakeup_latency.cpp
+// OmniMailbox wake-up latency harness
+//
+// Measures how long an idle waiter takes to observe its peer's action
+// after an idle gap, per wait strategy:
+//
+//   consumer side  commit -> pop returns, with the consumer idle for the gap
+//   producer side  pop -> BlockingPush/TryPush returns, with the producer
+//                  waiting on a full ring for the gap
+//
+// Wait strategies:
+//   spin      TryPop/TryPush busy loop
+//   yield     TryPop/TryPush + std::this_thread::yield() when not ready
+//   blocking  BlockingPop/BlockingPush with a finite timeout (library
+//             hybrid: ~1-2us spin, then yield, repeated)
+//   park      BlockingPop() with infinite timeout (futex wait on
+//             write_index). Consumer side only: BlockingPush never parks.
+//
+// Usage:
+//   bench-wakeup [--side=consumer|producer|both] [--modes=spin,yield,blocking,park]
+//                [--gaps-us=1,10,100,1000,10000] [--samples=N] [--max-ms-per-gap=N]
+//                [--producer-cpu=N] [--consumer-cpu=N]
+
+#include <omni/mailbox.hpp>
+#include "bench_common.hpp"
+#include "hdr_histogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using omni::bench::HdrHistogram;
+using omni::bench::NowNs;
+
+enum class WaitMode { Spin, Yield, Blocking, Park };
+
+constexpr const char* ModeName(WaitMode mode) noexcept {
+    switch (mode) {
+        case WaitMode::Spin:     return "spin";
+        case WaitMode::Yield:    return "yield";
+        case WaitMode::Blocking: return "blocking";
+        case WaitMode::Park:     return "park";
+    }
+    return "unknown";
+}
+
+constexpr size_t MESSAGE_SIZE = 64;
+constexpr uint8_t STOP_MARKER = 0xFF;  // Payload byte 8: ends the consumer thread
+
+struct Options {
+    bool consumer_side = true;
+    bool producer_side = true;
+    std::vector<WaitMode> modes{WaitMode::Spin, WaitMode::Yield, WaitMode::Blocking, WaitMode::Park};
+    std::vector<int64_t> gaps_us{1, 10, 100, 1000, 10000};
+    int64_t samples = 1000;
+    int64_t max_ms_per_gap = 2000;  // Caps samples for long gaps
+    int producer_cpu = -1;
+    int consumer_cpu = -1;
+};
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (auto v = omni::bench::FlagValue(arg, "side")) {
+            options.consumer_side = (*v == "consumer" || *v == "both");
+            options.producer_side = (*v == "producer" || *v == "both");
+        } else if (auto v = omni::bench::FlagValue(arg, "modes")) {
+            options.modes.clear();
+            for (auto name : omni::bench::SplitList(*v)) {
+                bool found = false;
+                for (WaitMode mode : {WaitMode::Spin, WaitMode::Yield, WaitMode::Blocking, WaitMode::Park}) {
+                    if (name == ModeName(mode)) {
+                        options.modes.push_back(mode);
+                        found = true;
+                    }
+                }
+                if (!found) {
+                    std::fprintf(stderr, "Unknown mode: %.*s\n", static_cast<int>(name.size()), name.data());
+                    return false;
+                }
+            }
+        } else if (auto v = omni::bench::FlagValue(arg, "gaps-us")) {
+            options.gaps_us.clear();
+            for (auto item : omni::bench::SplitList(*v)) {
+                options.gaps_us.push_back(omni::bench::ParseInt(item, -1));
+            }
+        } else if (auto v = omni::bench::FlagValue(arg, "samples")) {
+            options.samples = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "max-ms-per-gap")) {
+            options.max_ms_per_gap = omni::bench::ParseInt(*v, -1);
+        } else if (auto v = omni::bench::FlagValue(arg, "producer-cpu")) {
+            options.producer_cpu = static_cast<int>(omni::bench::ParseInt(*v, -1));
+        } else if (auto v = omni::bench::FlagValue(arg, "consumer-cpu")) {
+            options.consumer_cpu = static_cast<int>(omni::bench::ParseInt(*v, -1));
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    const bool gaps_valid = !options.gaps_us.empty() &&
+        std::all_of(options.gaps_us.begin(), options.gaps_us.end(), [](int64_t g) { return g >= 0; });
+    if ((!options.consumer_side && !options.producer_side) || options.modes.empty() || !gaps_valid ||
+        options.samples <= 0 || options.max_ms_per_gap <= 0) {
+        std::fprintf(stderr, "Invalid argument (--side=consumer|producer|both, gaps >= 0, samples > 0)\n");
+        return false;
+    }
+    return true;
+}
+
+// Idle for `gap_ns`: sleep through most of a long gap, spin the rest for precision
+void IdleFor(uint64_t gap_ns) {
+    const uint64_t deadline = NowNs() + gap_ns;
+    if (gap_ns > 200'000) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(gap_ns - 100'000));
+    }
+    omni::bench::SpinUntil(deadline);
+}
+
+std::optional<omni::ConsumerHandle::Message> WaitPop(omni::ConsumerHandle& consumer, WaitMode mode) {
+    while (true) {
+        auto [result, msg] = mode == WaitMode::Park     ? consumer.BlockingPop()
+                           : mode == WaitMode::Blocking ? consumer.BlockingPop(std::chrono::milliseconds(1000))
+                                                        : consumer.TryPop();
+        if (result == omni::PopResult::Success) {
+            return msg;
+        }
+        if (result == omni::PopResult::ChannelClosed) {
+            return std::nullopt;
+        }
+        if (mode == WaitMode::Yield) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool WaitPush(omni::ProducerHandle& producer, std::span<const uint8_t> data, WaitMode mode) {
+    while (true) {
+        const auto result = mode == WaitMode::Blocking
+            ? producer.BlockingPush(data, std::chrono::milliseconds(1000))
+            : producer.TryPush(data);
+        if (result == omni::PushResult::Success) {
+            return true;
+        }
+        if (result == omni::PushResult::ChannelClosed) {
+            return false;
+        }
+        if (mode == WaitMode::Yield) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Samples for one gap, bounded by the per-gap time budget
+int64_t SamplesFor(const Options& options, int64_t gap_us) {
+    if (gap_us == 0) {
+        return options.samples;
+    }
+    return std::clamp<int64_t>(options.max_ms_per_gap * 1000 / gap_us, 10, options.samples);
+}
+
+// Consumer idle for the gap, then producer commits: commit -> pop returns
+bool MeasureConsumerWake(const Options& options, WaitMode mode, int64_t gap_us, HdrHistogram& latency) {
+    auto& broker = omni::MailboxBroker::Instance();
+    auto [error, channel] = broker.RequestChannel("bench-wakeup-consumer", {
+        .capacity = 64,
+        .max_message_size = MESSAGE_SIZE
+    });
+    if (error != omni::ChannelError::Success) {
+        std::fprintf(stderr, "Failed to create channel\n");
+        return false;
+    }
+
+    const int64_t samples = SamplesFor(options, gap_us);
+    std::atomic<int64_t> observed{0};
+
+    std::thread consumer([&]() {
+        omni::PinCurrentThread(options.consumer_cpu);
+        while (auto msg = WaitPop(channel->consumer, mode)) {
+            const uint64_t now = NowNs();
+            if (msg->Data()[8] == STOP_MARKER) {
+                break;
+            }
+            uint64_t committed = 0;
+            std::memcpy(&committed, msg->Data().data(), sizeof(committed));
+            latency.Record(now > committed ? now - committed : 0);
+            observed.fetch_add(1, std::memory_order_release);
+        }
+    });
+
+    omni::PinCurrentThread(options.producer_cpu);
+    std::vector<uint8_t> payload(MESSAGE_SIZE, 0);
+    for (int64_t i = 0; i < samples; ++i) {
+        // Previous message observed: the consumer is now idle for the gap
+        while (observed.load(std::memory_order_acquire) < i) {
+            std::this_thread::yield();
+        }
+        IdleFor(static_cast<uint64_t>(gap_us) * 1000);
+
+        auto reservation = channel->producer.Reserve(MESSAGE_SIZE);
+        const uint64_t now = NowNs();
+        std::memcpy(reservation->data, &now, sizeof(now));
+        reservation->data[8] = 0;
+        channel->producer.Commit(MESSAGE_SIZE);
+    }
+
+    payload[8] = STOP_MARKER;
+    while (channel->producer.TryPush(payload) == omni::PushResult::QueueFull) {
+        std::this_thread::yield();
+    }
+    consumer.join();
+    channel.reset();
+    broker.RemoveChannel("bench-wakeup-consumer");
+    return true;
+}
+
+// Producer waits on a full ring for the gap, then one slot is freed: pop -> push returns
+bool MeasureProducerWake(const Options& options, WaitMode mode, int64_t gap_us, HdrHistogram& latency) {
+    auto& broker = omni::MailboxBroker::Instance();
+    auto [error, channel] = broker.RequestChannel("bench-wakeup-producer", {
+        .capacity = 8,
+        .max_message_size = MESSAGE_SIZE
+    });
+    if (error != omni::ChannelError::Success) {
+        std::fprintf(stderr, "Failed to create channel\n");
+        return false;
+    }
+
+    std::vector<uint8_t> payload(MESSAGE_SIZE, 0xCD);
+    while (channel->producer.TryPush(payload) == omni::PushResult::Success) {
+    }
+
+    const int64_t samples = SamplesFor(options, gap_us);
+    std::atomic<int64_t> waiting{-1};       // Round the producer is about to wait in
+    std::atomic<int64_t> completed{0};      // Rounds whose push has returned
+    std::atomic<uint64_t> freed_at{0};      // Timestamp taken just before the pop
+
+    std::thread producer([&]() {
+        omni::PinCurrentThread(options.producer_cpu);
+        for (int64_t i = 0; i < samples; ++i) {
+            waiting.store(i, std::memory_order_release);
+            if (!WaitPush(channel->producer, payload, mode)) {
+                break;
+            }
+            const uint64_t now = NowNs();
+            const uint64_t freed = freed_at.load(std::memory_order_acquire);
+            latency.Record(now > freed ? now - freed : 0);
+            completed.store(i + 1, std::memory_order_release);
+        }
+    });
+
+    omni::PinCurrentThread(options.consumer_cpu);
+    for (int64_t i = 0; i < samples; ++i) {
+        while (waiting.load(std::memory_order_acquire) < i) {
+            std::this_thread::yield();
+        }
+        IdleFor(static_cast<uint64_t>(gap_us) * 1000);
+
+        freed_at.store(NowNs(), std::memory_order_release);
+        auto [result, msg] = channel->consumer.TryPop();
+        if (result != omni::PopResult::Success) {
+            break;
+        }
+        while (completed.load(std::memory_order_acquire) <= i) {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    channel.reset();
+    broker.RemoveChannel("bench-wakeup-producer");
+    return true;
+}
+
+void PrintHeader(const char* side) {
+    std::printf("\n%s wake-up (ns)\n", side);
+    std::printf("%10s %-9s %10s %10s %10s %10s %10s %8s\n",
+                "gap", "mode", "p50", "p90", "p99", "p99.9", "max", "count");
+}
+
+void PrintRow(int64_t gap_us, WaitMode mode, const HdrHistogram& h) {
+    const std::string gap = gap_us >= 1000 ? std::to_string(gap_us / 1000) + "ms" : std::to_string(gap_us) + "us";
+    std::printf("%10s %-9s %10llu %10llu %10llu %10llu %10llu %8llu\n",
+                gap.c_str(), ModeName(mode),
+                static_cast<unsigned long long>(h.ValueAtPercentile(50.0)),
+                static_cast<unsigned long long>(h.ValueAtPercentile(90.0)),
+                static_cast<unsigned long long>(h.ValueAtPercentile(99.0)),
+                static_cast<unsigned long long>(h.ValueAtPercentile(99.9)),
+                static_cast<unsigned long long>(h.Max()),
+                static_cast<unsigned long long>(h.Count()));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    if (options.consumer_side) {
+        PrintHeader("consumer (commit -> pop returns)");
+        for (int64_t gap : options.gaps_us) {
+            for (WaitMode mode : options.modes) {
+                HdrHistogram latency;
+                if (!MeasureConsumerWake(options, mode, gap, latency)) {
+                    return 1;
+                }
+                PrintRow(gap, mode, latency);
+            }
+        }
+    }
+
+    if (options.producer_side) {
+        PrintHeader("producer (pop -> push returns)");
+        for (int64_t gap : options.gaps_us) {
+            for (WaitMode mode : options.modes) {
+                if (mode == WaitMode::Park) {
+                    continue;  // BlockingPush has no futex park path
+                }
+                HdrHistogram latency;
+                if (!MeasureProducerWake(options, mode, gap, latency)) {
+                    return 1;
+                }
+                PrintRow(gap, mode, latency);
+            }
+        }
+    }
+    return 0;
+}
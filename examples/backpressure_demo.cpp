@@ -8,6 +8,8 @@
  * - Producer handling QueueFull condition
  * - Different strategies: blocking, dropping, retrying
  * - Monitoring queue saturation
+ * - Proactive throttling driven by high/low watermark callbacks
+ * - Overwrite-oldest (lossy) channels for monitoring feeds
  */
 
 #include <omni/mailbox.hpp>
@@ -17,6 +19,176 @@
 #include <chrono>
 #include <atomic>
 
+namespace {
+
+struct ThrottleResult {
+    int attempted = 0;
+    int dropped = 0;
+    int throttle_events = 0;
+    std::chrono::milliseconds elapsed{0};
+};
+
+// Simulate per-message work without relying on sleep granularity
+void SpinFor(std::chrono::microseconds duration) {
+    const auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+// Bursty producer vs. steady consumer on a small queue.
+// Without watermarks the producer only learns about the backlog from
+// QueueFull (and drops). With watermarks it pauses at the high watermark
+// and resumes once the consumer drains to the low watermark.
+ThrottleResult RunThrottleScenario(bool use_watermarks) {
+    constexpr int TOTAL_MESSAGES = 4000;
+    constexpr int BURST_SIZE = 96;
+    
+    auto& broker = omni::MailboxBroker::Instance();
+    const char* name = use_watermarks ? "throttle-demo-watermarks" : "throttle-demo-baseline";
+    auto [error, channel] = broker.RequestChannel(name, {
+        .capacity = 64,
+        .max_message_size = 64
+    });
+    if (error != omni::ChannelError::Success) {
+        return {};
+    }
+    
+    ThrottleResult result;
+    std::atomic<bool> producer_finished{false};
+    
+    // Steady consumer: ~20us of work per message
+    std::thread consumer_thread([&channel, &producer_finished]() {
+        auto& consumer = channel->consumer;
+        while (!producer_finished.load() || consumer.AvailableMessages() > 0) {
+            auto [pop_result, msg] = consumer.BlockingPop(std::chrono::milliseconds(10));
+            if (pop_result == omni::PopResult::Success) {
+                SpinFor(std::chrono::microseconds(20));
+            }
+        }
+    });
+    
+    auto& producer = channel->producer;
+    bool throttled = false;
+    if (use_watermarks) {
+        // Callback runs on this (producer) thread inside TryPush/CheckWatermarks
+        (void)producer.SetWatermarkCallback({.high_percent = 75, .low_percent = 25},
+            [&throttled, &result](omni::WatermarkEvent event, size_t) {
+                throttled = (event == omni::WatermarkEvent::High);
+                result.throttle_events += throttled ? 1 : 0;
+            });
+    }
+    
+    const auto start = std::chrono::steady_clock::now();
+    std::string payload(32, 'x');
+    std::span<const uint8_t> data(
+        reinterpret_cast<const uint8_t*>(payload.data()),
+        payload.size()
+    );
+    
+    // Bursts arrive 4x faster than the consumer drains them; the average rate does not
+    for (int i = 0; i < TOTAL_MESSAGES; ++i) {
+        while (throttled) {
+            SpinFor(std::chrono::microseconds(5));
+            producer.CheckWatermarks();  // Fires Low once the consumer catches up
+        }
+        
+        ++result.attempted;
+        if (producer.TryPush(data) == omni::PushResult::QueueFull) {
+            ++result.dropped;
+        }
+        
+        if ((i + 1) % BURST_SIZE == 0) {
+            SpinFor(std::chrono::microseconds(1600));  // Gap between bursts
+        } else {
+            SpinFor(std::chrono::microseconds(5));
+        }
+    }
+    result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    
+    producer_finished.store(true);
+    consumer_thread.join();
+    
+    channel.reset();
+    broker.RemoveChannel(name);
+    return result;
+}
+
+struct OverwriteResult {
+    int pushed = 0;
+    uint64_t received = 0;
+    uint64_t missed = 0;
+    uint64_t last_sequence = 0;
+};
+
+// Same bursty producer on a lossy channel: pushes never fail, the oldest
+// unread samples are overwritten, and the consumer learns exactly how many
+// it missed from the sequence gap.
+OverwriteResult RunOverwriteScenario() {
+    constexpr int TOTAL_MESSAGES = 4000;
+    constexpr int BURST_SIZE = 96;
+    
+    auto& broker = omni::MailboxBroker::Instance();
+    auto [error, channel] = broker.RequestLossyChannel("overwrite-demo", {
+        .capacity = 64,
+        .max_message_size = 64
+    });
+    if (error != omni::ChannelError::Success) {
+        return {};
+    }
+    
+    OverwriteResult result;
+    std::thread consumer_thread([&channel, &result]() {
+        auto& consumer = channel->consumer;
+        while (true) {
+            auto [pop_result, msg] = consumer.BlockingPop(std::chrono::milliseconds(10));
+            if (pop_result == omni::PopResult::Success) {
+                ++result.received;
+                result.missed += msg->missed;
+                result.last_sequence = msg->sequence;
+                SpinFor(std::chrono::microseconds(20));
+            } else if (pop_result == omni::PopResult::ChannelClosed) {
+                break;
+            }
+        }
+    });
+    
+    auto& producer = channel->producer;
+    std::string payload(32, 'x');
+    std::span<const uint8_t> data(
+        reinterpret_cast<const uint8_t*>(payload.data()),
+        payload.size()
+    );
+    for (int i = 0; i < TOTAL_MESSAGES; ++i) {
+        if (producer.TryPush(data) == omni::PushResult::Success) {  // Never QueueFull
+            ++result.pushed;
+        }
+        if ((i + 1) % BURST_SIZE == 0) {
+            SpinFor(std::chrono::microseconds(1600));
+        } else {
+            SpinFor(std::chrono::microseconds(5));
+        }
+    }
+    
+    { auto closing = std::move(producer); }  // Consumer drains, then sees ChannelClosed
+    consumer_thread.join();
+    
+    channel.reset();
+    broker.RemoveChannel("overwrite-demo");
+    return result;
+}
+
+void PrintThrottleResult(const char* label, const ThrottleResult& result) {
+    const double drop_rate = result.attempted > 0
+        ? (result.dropped * 100.0) / result.attempted
+        : 0.0;
+    std::cout << label << ": dropped " << result.dropped << "/" << result.attempted
+              << " (" << drop_rate << "%), throttle events " << result.throttle_events
+              << ", elapsed " << result.elapsed.count() << "ms\n";
+}
+
+} // namespace
+
 int main() {
     std::cout << "=== OmniMailbox Backpressure Demo ===\n\n";
     
@@ -155,6 +327,28 @@ int main() {
     channel.reset();
     broker.RemoveChannel("backpressure-demo");
     
+    // Scenario 2: watermark-driven throttling
+    std::cout << "\n=== Watermark Throttling ===\n";
+    std::cout << "Bursty producer (96 msgs @ 5us, then 1.6ms gap) vs. consumer (20us/msg), capacity 64\n";
+    std::cout << "Throttled run pauses at 75% full and resumes at 25%\n\n";
+    
+    PrintThrottleResult("Drop on QueueFull   ", RunThrottleScenario(false));
+    PrintThrottleResult("Watermark throttling", RunThrottleScenario(true));
+    
+    std::cout << "\nThrottling trades producer latency for zero/near-zero drops;\n";
+    std::cout << "the producer reacts before the queue is full instead of after.\n";
+    
+    // Scenario 3: overwrite oldest instead of dropping newest
+    std::cout << "\n=== Overwrite Oldest (Lossy Channel) ===\n";
+    std::cout << "Same bursty producer, capacity 64; TryPush never fails and never waits\n\n";
+    
+    const OverwriteResult lossy = RunOverwriteScenario();
+    std::cout << "Pushed " << lossy.pushed << ", received " << lossy.received
+              << ", missed " << lossy.missed << " (received + missed = "
+              << (lossy.received + lossy.missed) << ", last sequence " << lossy.last_sequence << ")\n";
+    std::cout << "\nFor monitoring feeds the consumer always ends on the newest samples,\n";
+    std::cout << "and every gap is reported instead of silently dropped at the producer.\n";
+    
     std::cout << "\n=== Demo Complete ===\n";
     return 0;
 }
@@ -0,0 +1,221 @@
+#ifndef OMNI_ACTOR_SYSTEM_HPP
+#define OMNI_ACTOR_SYSTEM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+#include "omni/detail/config.hpp"
+#include "omni/producer_handle.hpp"
+
+namespace omni {
+
+class ActorSystem;
+
+namespace detail {
+    struct ActorCell;
+    class ActorScheduler;
+}
+
+/// Actor identifier (never 0)
+using ActorId = uint64_t;
+
+/**
+ * @brief Configuration for ActorSystem.
+ */
+struct ActorSystemConfig {
+    /// Worker threads (0 = std::thread::hardware_concurrency())
+    size_t workers = 0;
+
+    /// CPUs to pin workers to, worker i -> worker_cpus[i % size] (empty = unpinned)
+    std::vector<int> worker_cpus;
+
+    /// Messages an actor may handle per scheduling before yielding its worker
+    /// (clamped to >= 1). Bounds how long one busy actor can starve the others.
+    size_t batch_size = 64;
+
+    /// Maximum live actors (rounded up to a power of 2). Sizes the run queues
+    /// up front so scheduling never allocates.
+    size_t max_actors = 65'536;
+
+    /// Mailbox channel config used by Connect() unless overridden
+    ChannelConfig mailbox{.capacity = 256, .max_message_size = 256};
+};
+
+/**
+ * @brief Per-delivery view of the running actor, passed to its behavior.
+ *
+ * Only valid during the call.
+ */
+class ActorContext {
+public:
+    [[nodiscard]] ActorId Self() const noexcept;
+
+    /// Owning system (Spawn()/Connect() may be called from behaviors)
+    [[nodiscard]] ActorSystem& System() const noexcept;
+
+    /// Stop this actor after the current message. Remaining and future
+    /// messages are dropped and senders see ChannelClosed.
+    void Stop() noexcept;
+
+private:
+    friend struct detail::ActorCell;
+    explicit ActorContext(detail::ActorCell& cell) noexcept : cell_(&cell) {}
+    detail::ActorCell* cell_;
+};
+
+/**
+ * @brief Sending end of one actor mailbox (one SPSC channel).
+ *
+ * Move-only; like ProducerHandle, one thread (or one actor) sends at a time.
+ * Every sender gets its own channel into the target (see ActorSystem::Connect),
+ * so actors with many senders still only ever use SPSC queues.
+ */
+class ActorRef {
+public:
+    /**
+     * @brief Copy a message into the mailbox and make the actor runnable.
+     *
+     * Never blocks.
+     *
+     * @return Success, QueueFull (mailbox full: retry or drop), InvalidSize,
+     *         or ChannelClosed (actor stopped or system shut down)
+     */
+    [[nodiscard]] PushResult Send(std::span<const uint8_t> data) noexcept;
+
+    /// Target actor
+    [[nodiscard]] ActorId Target() const noexcept;
+
+    ~ActorRef();
+    ActorRef(ActorRef&&) noexcept;
+    ActorRef& operator=(ActorRef&&) noexcept;
+    ActorRef(const ActorRef&) = delete;
+    ActorRef& operator=(const ActorRef&) = delete;
+
+private:
+    friend class detail::ActorScheduler;
+    ActorRef(std::shared_ptr<detail::ActorCell> cell, ProducerHandle producer) noexcept;
+
+    // Declared first so the producer is closed before the cell (which owns
+    // the consumer end) can go away
+    std::shared_ptr<detail::ActorCell> cell_;
+    ProducerHandle producer_;
+};
+
+/**
+ * @brief Lightweight actors on OmniMailbox channels, run by a work-stealing pool.
+ *
+ * Each actor owns one mailbox made of SPSC channels (one per ActorRef).
+ * A send that finds the actor idle makes it runnable. The actor is pushed
+ * onto the sending worker's deque, or onto a shared injection queue when
+ * the sender is not a worker. Workers pop their own deque LIFO (the woken
+ * actor runs next, while the message is still in cache), take from the
+ * injection queue, and steal FIFO from other workers when idle. Idle
+ * workers park on a futex.
+ *
+ * An actor runs on one worker at a time and handles at most `batch_size`
+ * messages per scheduling, round-robin over its channels. It then goes
+ * back through the injection queue if more are pending.
+ *
+ * @par Hot Path Cost
+ * Send: one TryPush plus one fetch_add on the actor's signal word; the
+ * deque push and the sleeper check only happen on an idle-to-runnable
+ * transition. Delivery is ConsumerHandle::DrainBatch (in place, one
+ * release store per batch). Scheduling never allocates.
+ *
+ * @par Thread Safety
+ * All methods are thread-safe and may be called from behaviors, except
+ * Shutdown() and the destructor. Behaviors must not throw.
+ *
+ * @par Example
+ * @code
+ * omni::ActorSystem system({.workers = 4});
+ * auto counter = system.Spawn([count = 0](omni::ActorContext&, std::span<const uint8_t>) mutable {
+ *     ++count;
+ * });
+ * auto ref = system.Connect(*counter);
+ * (void)ref->Send(payload);
+ * @endcode
+ */
+class ActorSystem {
+public:
+    /// Called for every message, on whichever worker runs the actor
+    using Behavior = std::function<void(ActorContext& context, std::span<const uint8_t> message)>;
+
+    /**
+     * @brief Scheduler statistics (relaxed loads, approximate).
+     */
+    struct Stats {
+        size_t actors;          ///< Live actors
+        uint64_t runs;          ///< Actor schedulings executed
+        uint64_t messages;      ///< Messages delivered to behaviors
+        uint64_t steals;        ///< Actors taken from another worker's deque
+        uint64_t injected;      ///< Actors taken from the injection queue
+        uint64_t yields;        ///< Runs that used the whole batch and requeued
+        uint64_t parks;         ///< Times a worker went to sleep
+        size_t mailboxes;       ///< Open mailbox channels across live actors
+    };
+
+    /**
+     * @brief Start the worker threads.
+     *
+     * @par Exceptions
+     * Allocation or thread creation failure throws (not a hot-path API).
+     */
+    explicit ActorSystem(ActorSystemConfig config = {});
+
+    /// Calls Shutdown()
+    ~ActorSystem();
+
+    ActorSystem(const ActorSystem&) = delete;
+    ActorSystem& operator=(const ActorSystem&) = delete;
+
+    /**
+     * @brief Create an actor with no mailbox channels yet.
+     *
+     * @return Actor id, or nullopt if max_actors is reached, the system is
+     *         shut down, the behavior is empty, or allocation failed
+     */
+    [[nodiscard]] std::optional<ActorId> Spawn(Behavior behavior) noexcept;
+
+    /**
+     * @brief Open a new mailbox channel into an actor.
+     *
+     * The channel is created by the system, not registered in
+     * MailboxBroker::Instance(), so Connect() never takes the broker's
+     * registry lock. Once the ref is dropped and the channel drained, the
+     * actor's next run closes and frees it.
+     *
+     * @param target Receiving actor
+     * @param mailbox Channel config (default: ActorSystemConfig::mailbox)
+     * @return Sender, or nullopt if the actor is unknown or stopped, or the
+     *         channel could not be created
+     */
+    [[nodiscard]] std::optional<ActorRef> Connect(ActorId target) noexcept;
+    [[nodiscard]] std::optional<ActorRef> Connect(ActorId target, const ChannelConfig& mailbox) noexcept;
+
+    /**
+     * @brief Stop the workers and release all actors (idempotent).
+     *
+     * Messages still queued are dropped. Outstanding ActorRefs return
+     * ChannelClosed; an actor's channels are freed once the last ref to
+     * it is destroyed. Sends must not race with Shutdown().
+     * Must not be called from a behavior.
+     */
+    void Shutdown() noexcept;
+
+    [[nodiscard]] size_t WorkerCount() const noexcept;
+
+    [[nodiscard]] Stats GetStats() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace omni
+
+#endif // OMNI_ACTOR_SYSTEM_HPP
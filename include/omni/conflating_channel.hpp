@@ -0,0 +1,154 @@
+#ifndef OMNI_CONFLATING_CHANNEL_HPP
+#define OMNI_CONFLATING_CHANNEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+#include "omni/detail/config.hpp"
+
+namespace omni {
+
+class MailboxBroker;
+
+namespace detail {
+    struct SPSCQueue;
+    struct ConflationState;
+}
+
+/**
+ * @brief Producer side of a key-conflating (last-value) channel.
+ *
+ * Every message carries a key. A key that is still waiting for the consumer
+ * has its value overwritten in place instead of appended, so a lagging
+ * consumer sees each key's latest value once, not every stale update. Keys
+ * live in a fixed-capacity open-addressed table allocated with the channel;
+ * a push never allocates. Single producer, as ProducerHandle.
+ */
+class ConflatingProducer {
+public:
+    /**
+     * @brief Publish the latest value for `key`.
+     *
+     * Never waits for the consumer. Costs one table probe, a seqlock write
+     * of the value and one full fence; only a key going clean -> dirty is
+     * appended to the consumer's queue.
+     *
+     * @return Success; InvalidSize if data is empty or larger than
+     *         max_message_size; QueueFull if `key` is new and Capacity()
+     *         distinct keys are already in use; ChannelClosed if the
+     *         consumer is gone
+     */
+    [[nodiscard]] PushResult TryPush(uint64_t key, std::span<const uint8_t> data) noexcept;
+
+    [[nodiscard]] bool IsConnected() const noexcept;  // Consumer alive
+    [[nodiscard]] size_t Capacity() const noexcept;   // Distinct keys
+    [[nodiscard]] size_t MaxMessageSize() const noexcept;
+    [[nodiscard]] size_t KeyCount() const noexcept;   // Distinct keys seen so far
+
+    // RAII: signals the consumer (sets producer_alive = false)
+    ~ConflatingProducer() noexcept;
+
+    ConflatingProducer(ConflatingProducer&&) noexcept;
+    ConflatingProducer& operator=(ConflatingProducer&&) noexcept;
+    ConflatingProducer(const ConflatingProducer&) = delete;
+    ConflatingProducer& operator=(const ConflatingProducer&) = delete;
+
+private:
+    friend class MailboxBroker;
+    ConflatingProducer(std::shared_ptr<detail::SPSCQueue> queue, std::shared_ptr<detail::ConflationState> state,
+                       std::vector<uint32_t> table) noexcept;
+
+    // Entry for `key`, inserting it if new; nullopt if the table is full
+    [[nodiscard]] std::optional<uint32_t> FindOrInsert(uint64_t key) noexcept;
+
+    std::shared_ptr<detail::SPSCQueue> queue_;
+    std::shared_ptr<detail::ConflationState> state_;
+    std::vector<uint32_t> table_;  // Open-addressed key -> entry + 1 (0 = free), producer-private
+    uint32_t entries_ = 0;
+};
+
+/**
+ * @brief Consumer side of a key-conflating channel.
+ *
+ * Pops deliver at most one message per dirty key: its latest value, in the
+ * order keys first became dirty. Work per drain is bounded by the number of
+ * keys, however far the producer is ahead.
+ *
+ * @par Thread Safety
+ * Single consumer, as ConsumerHandle.
+ */
+class ConflatingConsumer {
+public:
+    /// One delivered value, copied out of the key's slot
+    struct Message {
+        uint64_t key;
+        std::span<const uint8_t> data;  ///< Valid until the next pop
+        uint64_t conflated;             ///< Older updates of this key replaced since its last delivery
+    };
+
+    /// In-place handler for DrainBatch(); `data` is valid only during the call
+    using BatchHandler = std::function<void(uint64_t key, std::span<const uint8_t> data)>;
+
+    /**
+     * @brief Take the latest value of the oldest dirty key.
+     *
+     * @return Success, Empty, or ChannelClosed once the producer is gone
+     *         and no key is dirty
+     */
+    [[nodiscard]] std::pair<PopResult, std::optional<Message>> TryPop() noexcept;
+
+    /// Deliver up to max_count dirty keys, oldest dirtiness first, never
+    /// blocking. One release store of the read index per batch.
+    /// HANDLER: Must not throw and must not pop on this consumer
+    /// RETURNS: Messages handled
+    size_t DrainBatch(size_t max_count, const BatchHandler& handler) noexcept;
+
+    [[nodiscard]] bool IsConnected() const noexcept;  // Producer alive
+    [[nodiscard]] size_t Capacity() const noexcept;   // Distinct keys
+    [[nodiscard]] size_t MaxMessageSize() const noexcept;
+
+    /// Keys queued for delivery (approximate)
+    [[nodiscard]] size_t DirtyKeys() const noexcept;
+
+    /// Total updates replaced before the consumer saw them
+    [[nodiscard]] uint64_t ConflatedMessages() const noexcept;
+
+    // RAII: signals the producer (sets consumer_alive = false)
+    ~ConflatingConsumer() noexcept;
+
+    ConflatingConsumer(ConflatingConsumer&&) noexcept;
+    ConflatingConsumer& operator=(ConflatingConsumer&&) noexcept;
+    ConflatingConsumer(const ConflatingConsumer&) = delete;
+    ConflatingConsumer& operator=(const ConflatingConsumer&) = delete;
+
+private:
+    friend class MailboxBroker;
+    ConflatingConsumer(std::shared_ptr<detail::SPSCQueue> queue, std::shared_ptr<detail::ConflationState> state,
+                       std::vector<uint64_t> delivered, std::vector<uint8_t> scratch) noexcept;
+
+    // Take the next dirty key at `read` and copy its value into scratch_.
+    // Returns the entry, or nullopt if its value was already delivered.
+    [[nodiscard]] std::optional<uint32_t> Take(uint64_t read, size_t& size, uint64_t& conflated) noexcept;
+
+    std::shared_ptr<detail::SPSCQueue> queue_;
+    std::shared_ptr<detail::ConflationState> state_;
+    std::vector<uint64_t> delivered_;  // Stamp of the last value delivered per entry
+    std::vector<uint8_t> scratch_;     // Copy target; popped data points here
+};
+
+/**
+ * @brief Both ends of a conflating channel (see MailboxBroker::RequestConflatingChannel).
+ */
+struct ConflatingChannelPair {
+    ConflatingProducer producer;
+    ConflatingConsumer consumer;
+};
+
+} // namespace omni
+
+#endif // OMNI_CONFLATING_CHANNEL_HPP
@@ -1,12 +1,14 @@
 #ifndef OMNI_CONSUMER_HANDLE_HPP
 #define OMNI_CONSUMER_HANDLE_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
 #include <span>
 #include <chrono>
+#include <functional>
 #include <vector>
 #include "omni/detail/config.hpp"
 
@@ -14,9 +16,11 @@ namespace omni {
 
 // Forward declarations
 class MailboxBroker;
+class FairMultiplexer;
 
 namespace detail {
     struct SPSCQueue;
+    class ActorScheduler;
 }
 
 class ConsumerHandle {
@@ -52,6 +56,7 @@ public:
         uint64_t messages_received;
         uint64_t bytes_received;
         uint64_t failed_pops;  // Timeouts + ChannelClosed
+        uint64_t messages_expired;  // Dropped past their deadline (ChannelConfig::message_deadlines)
     };
     
     // Blocking pop with timeout
@@ -64,6 +69,9 @@ public:
     
     // Non-blocking pop attempt
     // RETURNS: Empty immediately if no messages
+    // DEADLINES: On channels with ChannelConfig::message_deadlines, every pop
+    //            (and Peek/DrainBatch) silently drops messages whose deadline
+    //            has passed, counting them in Stats::messages_expired
     [[nodiscard]] std::pair<PopResult, std::optional<Message>> TryPop() noexcept;
     
     // Batch pop (fill vector up to max_count)
@@ -75,11 +83,58 @@ public:
         std::chrono::milliseconds timeout = std::chrono::milliseconds::zero()
     ) noexcept;
     
+    // Oldest message without consuming it: a view into the ring, valid until
+    // the next pop on this consumer (the slot stays owned by the consumer).
+    // Not const: expired messages ahead of the head are released (and
+    // counted), and the next pop returns this message even if its deadline
+    // passes meanwhile.
+    // RETURNS: nullopt if empty
+    [[nodiscard]] std::optional<std::span<const uint8_t>> Peek() noexcept;
+    
+    // In-place batch handler: `data` points into the ring and is valid only
+    // during the call (the slot is released after the handler returns)
+    using BatchHandler = std::function<void(std::span<const uint8_t> data)>;
+    
+    // Drain up to max_count messages in place, oldest first, never blocking
+    // One acquire load of the producer index and one release store of the
+    // read index per batch; no allocation (unlike BatchPop).
+    // HANDLER: Must not throw and must not pop on this consumer (re-entrancy)
+    // RETURNS: Number of messages handled (0 if empty or max_count == 0)
+    size_t DrainBatch(size_t max_count, const BatchHandler& handler) noexcept;
+    
+    // Flight recorder trigger, invoked on the consumer thread when a pop that
+    // had to wait (BlockingPop, BatchPop with timeout) took longer than the
+    // threshold from call to successful return. Immediate pops are not timed.
+    // `events` holds both sides' recent events, oldest first, valid only
+    // during the call.
+    using FlightRecorderCallback = std::function<void(
+        std::chrono::nanoseconds latency, std::span<const FlightEvent> events)>;
+    
+    // Register pop latency trigger (replaces any previous one)
+    // PRECONDITION: Called from the consumer thread
+    // ERROR: Returns false if threshold <= 0, callback is empty or the dump
+    //        buffer cannot be allocated (allocated here, never on trigger)
+    // CALLBACK: Must not throw and must not pop on this consumer (re-entrancy)
+    bool SetPopLatencyTrigger(std::chrono::nanoseconds threshold, FlightRecorderCallback callback) noexcept;
+    
+    // Remove pop latency trigger
+    void ClearPopLatencyTrigger() noexcept;
+    
+    // Snapshot this channel's flight recorder (both sides, oldest first)
+    // Any thread; throws std::bad_alloc on allocation failure (not a hot-path API)
+    [[nodiscard]] std::vector<FlightEvent> DumpFlightRecorder() const;
+    
+    // Pin the calling thread to the consumer CPU planned for this channel
+    // (see ProducerHandle::ApplyPlacement)
+    // PRECONDITION: Called from the consumer thread, before the hot loop
+    // ERROR: Returns false if no consumer CPU is planned or pinning failed
+    bool ApplyPlacement() noexcept;
+    
     // Query state (relaxed reads, approximate)
     [[nodiscard]] bool IsConnected() const noexcept;  // Producer alive
     [[nodiscard]] size_t Capacity() const noexcept;
     [[nodiscard]] size_t MaxMessageSize() const noexcept;
-    [[nodiscard]] size_t AvailableMessages() const noexcept;  // Approx pending
+    [[nodiscard]] size_t AvailableMessages() const noexcept;  // Approx pending (expired included)
     
     // Get channel configuration
     // Returns the normalized configuration used to create the channel.
@@ -114,8 +169,21 @@ public:
 
 private:
     friend class MailboxBroker;
+    friend class FairMultiplexer;
+    friend class detail::ActorScheduler;  // Actor mailboxes (outside the broker registry)
     explicit ConsumerHandle(std::shared_ptr<detail::SPSCQueue> queue);
     
+    // Have the producer set `mask` in `*word` after every publish and on
+    // disconnect (nullptr disarms). `owner` keeps the word alive. False on
+    // allocation failure (binding unchanged).
+    [[nodiscard]] bool BindReadySignal(std::atomic<uint64_t>* word, uint64_t mask,
+                                       std::shared_ptr<const void> owner) noexcept;
+    
+    // True once a push has run armed under the latest binding: every message
+    // published before it is visible, and every later push sets the bit.
+    // Until then a push that raced the bind may have set nothing.
+    [[nodiscard]] bool ReadySignalAcknowledged() const noexcept;
+    
     struct Impl;
     std::unique_ptr<Impl> pimpl_;
 };
@@ -0,0 +1,150 @@
+#ifndef OMNI_CONSUMER_POOL_HPP
+#define OMNI_CONSUMER_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "omni/consumer_handle.hpp"
+
+namespace omni {
+
+/**
+ * @brief Configuration for ConsumerPool.
+ */
+struct ConsumerPoolConfig {
+    /// Worker threads (0 = std::thread::hardware_concurrency())
+    size_t workers = 0;
+
+    /// CPUs to pin workers to, worker i -> worker_cpus[i % size] (empty = unpinned)
+    std::vector<int> worker_cpus;
+
+    /// Maximum messages drained from one channel per turn (clamped to >= 1).
+    /// Bounds how long one busy channel holds a worker.
+    size_t batch_size = 64;
+
+    /// Maximum registered channels (rounded up to a power of 2). Sizes the
+    /// per-worker ready deques up front so scheduling never allocates.
+    size_t max_channels = 4096;
+};
+
+/**
+ * @brief Worker pool that drains many consumers with work stealing.
+ *
+ * Takes ownership of ConsumerHandles and runs each channel's handler on
+ * whichever worker has capacity, instead of a fixed channel-to-thread map.
+ *
+ * Every channel has a home worker that polls it (one relaxed index check
+ * per pass). A channel found non-empty is marked ready and pushed onto the
+ * home worker's deque. Owners pop their deque LIFO; idle workers steal the
+ * oldest ready channels FIFO from the others, so the draining of busy
+ * channels moves off overloaded workers.
+ *
+ * @par One Drainer per Channel
+ * A channel is pushed only when its ready flag goes from clear to set, and
+ * the flag is cleared (release) only after the drain that took it
+ * finishes. So at most one worker calls DrainBatch() on a channel at any
+ * time and the SPSC consumer side stays single-threaded, even though it
+ * moves between threads. Handlers of different channels run in parallel.
+ *
+ * @par Idle Behavior
+ * Producers do not notify the pool: workers busy-poll, and yield the CPU
+ * between passes once a few passes in a row found nothing. For one
+ * isolated core that never yields, use PollRuntime.
+ *
+ * @par Thread Safety
+ * All methods are thread-safe. Handlers must not call AddChannel(),
+ * RemoveChannel() or Shutdown() (they return failure there instead of
+ * deadlocking). Handlers must not throw.
+ *
+ * @par Example
+ * @code
+ * omni::ConsumerPool pool({.workers = 4});
+ * for (auto& channel : channels) {
+ *     pool.AddChannel(std::move(channel.consumer), [](std::span<const uint8_t> data) {
+ *         Process(data);  // Never concurrent for one channel
+ *     });
+ * }
+ * @endcode
+ */
+class ConsumerPool {
+public:
+    /// Registration id (never 0)
+    using ChannelId = uint64_t;
+
+    /// Called for every message, on the worker currently draining the channel
+    using Handler = ConsumerHandle::BatchHandler;
+
+    /**
+     * @brief Pool statistics (relaxed loads, approximate).
+     *
+     * A pass is one scan of a worker's home channels plus the drains that
+     * follow it; a drain is one DrainBatch() on one ready channel.
+     */
+    struct Stats {
+        uint64_t passes;        ///< Worker passes
+        uint64_t idle_passes;   ///< Passes that handled no message
+        uint64_t drains;        ///< DrainBatch() calls on ready channels
+        uint64_t messages;      ///< Messages handled
+        uint64_t steals;        ///< Drains of a channel taken from another worker
+        size_t channels;        ///< Channels currently registered
+    };
+
+    /**
+     * @brief Start the worker threads.
+     *
+     * @par Exceptions
+     * Allocation or thread creation failure throws (not a hot-path API).
+     */
+    explicit ConsumerPool(ConsumerPoolConfig config = {});
+
+    /// Calls Shutdown(); registered consumer handles are destroyed
+    ~ConsumerPool();
+
+    ConsumerPool(const ConsumerPool&) = delete;
+    ConsumerPool& operator=(const ConsumerPool&) = delete;
+
+    /**
+     * @brief Register a consumer; polled from the workers' next pass on.
+     *
+     * Takes ownership of the handle on success (on failure it is left
+     * untouched). Blocks until every worker has seen the new channel list.
+     *
+     * @return Registration id, or nullopt if the handler is empty,
+     *         max_channels is reached, the pool is shut down, the call
+     *         comes from a worker, or allocation failed
+     */
+    [[nodiscard]] std::optional<ChannelId> AddChannel(ConsumerHandle&& consumer, Handler handler) noexcept;
+
+    /**
+     * @brief Unregister a consumer and give its handle back.
+     *
+     * Returns once no worker can drain the channel any more (it waits for
+     * a drain in progress), so the caller may consume from the handle
+     * directly. Messages still queued are left in the channel.
+     *
+     * @return The handle, or nullopt if the id is unknown or the call
+     *         comes from a worker
+     */
+    [[nodiscard]] std::optional<ConsumerHandle> RemoveChannel(ChannelId id) noexcept;
+
+    /// Stop and join the workers (idempotent). Channels stay registered.
+    void Shutdown() noexcept;
+
+    [[nodiscard]] size_t WorkerCount() const noexcept;
+
+    /// Totals over all workers since construction
+    [[nodiscard]] Stats GetStats() const noexcept;
+
+    /// Messages handled by one worker (0 if out of range); shows how evenly load spreads
+    [[nodiscard]] uint64_t WorkerMessages(size_t worker) const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace omni
+
+#endif // OMNI_CONSUMER_POOL_HPP
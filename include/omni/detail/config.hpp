@@ -4,9 +4,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <algorithm>
+#include <array>
 
 namespace omni {
 
+// Number of configurable queue-depth watermarks tracked per channel
+constexpr size_t WATERMARK_COUNT = 3;
+
 // Push operation result codes
 enum class PushResult {
     Success,
@@ -32,11 +36,82 @@ enum class ChannelError {
     AllocationFailed
 };
 
+// Watermark crossing reported to producer callbacks and broker observers
+enum class WatermarkEvent {
+    High,   // Depth rose to or above the high watermark
+    Low     // Depth fell to or below the low watermark after a High event
+};
+
+// High/low watermark pair with hysteresis (percent of usable capacity)
+struct WatermarkConfig {
+    uint8_t high_percent = 80;  // Fire High when depth >= high
+    uint8_t low_percent = 50;   // Then fire Low when depth <= low (must be < high)
+    
+    [[nodiscard]] bool IsValid() const noexcept {
+        return high_percent >= 1 && high_percent <= 100 && low_percent < high_percent;
+    }
+};
+
+// Flight recorder event kinds (per-channel ring of recent events)
+enum class FlightEventType : uint8_t {
+    Push,           // Commit/TryPush/BlockingPush: index = write index, value = bytes
+    BatchPush,      // index = first write index, value = message count
+    Pop,            // TryPop/BlockingPop: index = read index, value = bytes
+    BatchPop,       // index = first read index, value = message count
+    QueueFull,      // Start of a full episode: index = write index
+    Timeout,        // BlockingPush/BlockingPop timed out
+    Park,           // Blocking call started waiting
+    Wake,           // Blocking call resumed after waiting (succeeded)
+    Disconnect,     // Handle destroyed
+    Expire          // Messages dropped past their deadline: index = first read index, value = count
+};
+
+// One flight recorder entry (decoded snapshot, see MailboxBroker::DumpFlightRecorder)
+struct FlightEvent {
+    uint64_t ticks;         // Raw timestamp (TSC on x86-64, steady_clock ns elsewhere)
+    int64_t age_ns;         // Time before the dump was taken (>= 0, approximate)
+    uint32_t index;         // Low 32 bits of the ring index
+    uint32_t value;         // Bytes or count (saturates at 2^24 - 1), 0 if unused
+    FlightEventType type;
+    bool producer;          // Recorded by the producer (false = consumer)
+};
+
+// Queue saturation statistics (sampled on the producer path, relaxed atomics)
+struct SaturationStats {
+    uint64_t max_depth;                                     // Highest queue depth observed by producer
+    uint64_t full_events;                                   // Times the queue became full (episodes)
+    std::array<uint8_t, WATERMARK_COUNT> watermark_percent; // Thresholds, percent of usable capacity
+    std::array<uint64_t, WATERMARK_COUNT> time_above_ns;    // Cumulative time at or above each threshold
+};
+
+// How close a channel's producer and consumer CPUs should be (see CpuTopology::Recommend)
+enum class PlacementPolicy : uint8_t {
+    SameCore,   // SMT siblings of one physical core (shared L1/L2)
+    SameLLC,    // Different physical cores sharing the last-level cache
+    SameNode    // Different physical cores on the same NUMA node
+};
+
+// CPUs planned for a channel's endpoints (-1 = no plan for that side)
+struct ChannelPlacement {
+    int producer_cpu = -1;
+    int consumer_cpu = -1;
+    PlacementPolicy policy = PlacementPolicy::SameLLC;
+};
+
 // Channel configuration parameters
 struct ChannelConfig {
     size_t capacity = 1024;             // Ring buffer capacity (will be rounded to power-of-2)
     size_t max_message_size = 4096;     // Maximum message size in bytes
     
+    // Depth thresholds for saturation tracking, percent of usable capacity (ascending, 1-100)
+    std::array<uint8_t, WATERMARK_COUNT> watermark_percent{50, 80, 95};
+    
+    // Reserve an 8-byte deadline in each slot header so producers can attach
+    // a per-message deadline or TTL and consumers drop expired messages
+    // (RequestChannel() and priority lanes only; lossy, conflating and state
+    // channels reject it with InvalidConfig)
+    bool message_deadlines = false;
+    
     // Normalize configuration to valid values
     [[nodiscard]] ChannelConfig Normalize() const noexcept {
         ChannelConfig normalized = *this;
@@ -45,6 +120,12 @@ struct ChannelConfig {
         normalized.capacity = std::clamp(capacity, size_t(8), size_t(524'288));
         normalized.max_message_size = std::clamp(max_message_size, size_t(64), size_t(1'048'576));
         
+        // Watermarks: clamp to [1, 100] and sort ascending
+        for (auto& percent : normalized.watermark_percent) {
+            percent = std::clamp(percent, uint8_t(1), uint8_t(100));
+        }
+        std::sort(normalized.watermark_percent.begin(), normalized.watermark_percent.end());
+        
         // Then round up to power-of-2
         if ((normalized.capacity & (normalized.capacity - 1)) != 0) {
             normalized.capacity = RoundUpPowerOf2(normalized.capacity);
@@ -68,6 +149,16 @@ struct ChannelConfig {
             return false;
         }
         
+        // Watermarks must be in [1, 100] and ascending
+        for (size_t i = 0; i < WATERMARK_COUNT; ++i) {
+            if (watermark_percent[i] < 1 || watermark_percent[i] > 100) {
+                return false;
+            }
+            if (i > 0 && watermark_percent[i] < watermark_percent[i - 1]) {
+                return false;
+            }
+        }
+        
         return true;
     }
     
@@ -0,0 +1,43 @@
+#ifndef OMNI_DETAIL_CONFLATION_HPP
+#define OMNI_DETAIL_CONFLATION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace omni::detail {
+
+/**
+ * @brief Key state shared by both ends of a conflating channel.
+ *
+ * One entry per distinct key, allocated by the producer in first-seen order
+ * and never freed. The entry's latest value lives in SPSCQueue slot `entry`
+ * under SPSCQueue::stamps[entry]; this struct holds the rest.
+ *
+ * The dirty ring is indexed by the queue's write_index/read_index: the
+ * producer appends an entry when it goes clean -> dirty, so an entry is
+ * queued at most once and the ring (capacity slots) never overflows.
+ */
+struct ConflationState {
+    explicit ConflationState(size_t capacity)
+        : keys(new uint64_t[capacity]())
+        , order(std::make_unique<std::atomic<uint32_t>[]>(capacity))
+        , dirty(std::make_unique<std::atomic<uint8_t>[]>(capacity)) {}
+
+    // Entry -> key. Written once, before the entry is first queued
+    // (published by the release store of write_index).
+    std::unique_ptr<uint64_t[]> keys;
+
+    // Dirty ring: entries in order of first dirtiness. Position w is only
+    // written once the entry there a lap earlier was taken: otherwise all
+    // `capacity` entries would be queued, including the one being queued.
+    std::unique_ptr<std::atomic<uint32_t>[]> order;
+
+    // 1 while the entry is queued and not yet taken by the consumer
+    std::unique_ptr<std::atomic<uint8_t>[]> dirty;
+};
+
+} // namespace omni::detail
+
+#endif // OMNI_DETAIL_CONFLATION_HPP
@@ -0,0 +1,147 @@
+#ifndef OMNI_DETAIL_FLIGHT_RECORDER_HPP
+#define OMNI_DETAIL_FLIGHT_RECORDER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "omni/detail/config.hpp"
+#include "omni/detail/spsc_queue.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define OMNI_FLIGHT_RECORDER_TSC 1
+#endif
+
+namespace omni::detail {
+
+/**
+ * @brief Always-on per-channel flight recorder.
+ *
+ * Each side of a channel owns a FlightRing of FLIGHT_RECORDER_EVENTS
+ * slots that only its own thread writes, so recording is a few stores
+ * plus a TSC read, with no RMW and no remote cache line. Readers (dumps)
+ * may race with the writer; slots that could have been overwritten
+ * during the read are discarded by re-checking the head.
+ *
+ * @par Memory Ordering
+ * Seqlock-style (see seqlock.hpp), with `head` as the claim stamp:
+ * Writer: head.store(n + 1, relaxed); atomic_thread_fence(release);
+ *         slot stores (relaxed); published.store(n + 1, release)
+ * Reader: p = published.load(acquire); copy slots below p;
+ *         atomic_thread_fence(acquire); h = head.load(relaxed)
+ * A copied slot that saw any store of write w makes the re-load return
+ * more than w, so every slot write w may have touched is discarded.
+ *
+ * @par Cost
+ * ~10-25 cycles per event (rdtsc + 4 stores to lines the writer already
+ * owns; both fences are free on x86). Empty polls are not recorded, and
+ * QueueFull is recorded once per full episode, so polling loops cannot
+ * flush the history.
+ */
+
+// Timestamp source: TSC where available (cheap, constant-rate on modern x86)
+[[nodiscard]] inline uint64_t FlightTicks() noexcept {
+#if defined(OMNI_FLIGHT_RECORDER_TSC)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Nanoseconds per tick (calibrated once against steady_clock; dump path only)
+[[nodiscard]] inline double FlightNsPerTick() noexcept {
+#if defined(OMNI_FLIGHT_RECORDER_TSC)
+    static const double ns_per_tick = []() noexcept {
+        const auto start_time = std::chrono::steady_clock::now();
+        const uint64_t start_ticks = FlightTicks();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        const uint64_t end_ticks = FlightTicks();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_time).count();
+        return end_ticks > start_ticks
+            ? static_cast<double>(elapsed) / static_cast<double>(end_ticks - start_ticks)
+            : 1.0;
+    }();
+    return ns_per_tick;
+#else
+    return 1.0;
+#endif
+}
+
+// Writer only: append one event (relaxed slot stores)
+inline void RecordFlight(FlightRing& ring, FlightEventType type, uint64_t index, uint64_t value) noexcept {
+    constexpr uint64_t MAX_VALUE = (uint64_t{1} << 24) - 1;
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_relaxed);  // Claim before overwriting
+    std::atomic_thread_fence(std::memory_order_release);
+    auto& slot = ring.slots[head & (FLIGHT_RECORDER_EVENTS - 1)];
+    slot.ticks.store(FlightTicks(), std::memory_order_relaxed);
+    slot.packed.store(
+        (index << 32) | (std::min(value, MAX_VALUE) << 8) | static_cast<uint64_t>(type),
+        std::memory_order_relaxed);
+    ring.published.store(head + 1, std::memory_order_release);
+}
+
+// Any thread: append the still-valid events of one ring to `out`
+inline void ReadFlightRing(const FlightRing& ring, bool producer, std::vector<FlightEvent>& out) noexcept {
+    const uint64_t published = ring.published.load(std::memory_order_acquire);  // Slots below are complete
+    const uint64_t first = published > FLIGHT_RECORDER_EVENTS ? published - FLIGHT_RECORDER_EVENTS : 0;
+    const size_t start = out.size();
+
+    for (uint64_t seq = first; seq < published; ++seq) {
+        const auto& slot = ring.slots[seq & (FLIGHT_RECORDER_EVENTS - 1)];
+        const uint64_t packed = slot.packed.load(std::memory_order_relaxed);
+        out.push_back(FlightEvent{
+            .ticks = slot.ticks.load(std::memory_order_relaxed),
+            .age_ns = 0,
+            .index = static_cast<uint32_t>(packed >> 32),
+            .value = static_cast<uint32_t>((packed >> 8) & 0xFFFFFF),
+            .type = static_cast<FlightEventType>(packed & 0xFF),
+            .producer = producer
+        });
+    }
+
+    // Drop entries the writer may have overwritten while we were reading:
+    // write w (claimed once head > w) reuses the slot of event w - EVENTS
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimed = ring.head.load(std::memory_order_relaxed);
+    const uint64_t reused_below = claimed > FLIGHT_RECORDER_EVENTS ? claimed - FLIGHT_RECORDER_EVENTS : 0;
+    const uint64_t overwritten = reused_below > first ? std::min(reused_below - first, published - first) : 0;
+    out.erase(out.begin() + static_cast<std::ptrdiff_t>(start),
+              out.begin() + static_cast<std::ptrdiff_t>(start + overwritten));
+}
+
+/**
+ * @brief Snapshot both rings of a queue, oldest first.
+ *
+ * `out` is cleared and refilled; with capacity reserved for
+ * 2 * FLIGHT_RECORDER_EVENTS entries no allocation happens.
+ */
+inline void ReadFlightRecorder(const SPSCQueue& queue, std::vector<FlightEvent>& out) noexcept {
+    out.clear();
+    ReadFlightRing(queue.producer_flight, true, out);
+    ReadFlightRing(queue.consumer_flight, false, out);
+
+    std::sort(out.begin(), out.end(), [](const FlightEvent& a, const FlightEvent& b) {
+        return a.ticks < b.ticks;
+    });
+
+    const uint64_t now = FlightTicks();
+    const double ns_per_tick = FlightNsPerTick();
+    for (auto& event : out) {
+        const uint64_t age_ticks = now > event.ticks ? now - event.ticks : 0;
+        event.age_ns = static_cast<int64_t>(static_cast<double>(age_ticks) * ns_per_tick);
+    }
+}
+
+} // namespace omni::detail
+
+#endif // OMNI_DETAIL_FLIGHT_RECORDER_HPP
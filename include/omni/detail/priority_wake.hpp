@@ -0,0 +1,20 @@
+#ifndef OMNI_DETAIL_PRIORITY_WAKE_HPP
+#define OMNI_DETAIL_PRIORITY_WAKE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include "omni/detail/spsc_queue.hpp"
+
+namespace omni::detail {
+
+// Wake word shared by all lanes of a priority channel. The consumer parks on
+// `epoch` after raising `consumer_parked`; producers bump and notify only when
+// they see the flag, so an awake consumer costs a push one fence and a load.
+struct PriorityWake {
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> epoch{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> consumer_parked{false};
+};
+
+} // namespace omni::detail
+
+#endif // OMNI_DETAIL_PRIORITY_WAKE_HPP
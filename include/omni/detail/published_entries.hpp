@@ -0,0 +1,166 @@
+#ifndef OMNI_DETAIL_PUBLISHED_ENTRIES_HPP
+#define OMNI_DETAIL_PUBLISHED_ENTRIES_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "omni/detail/spsc_queue.hpp"
+
+namespace omni::detail {
+
+// xorshift64 step for victim selection; `state` must start nonzero
+inline uint64_t NextRandom(uint64_t& state) noexcept {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+/**
+ * @brief Channel entries read lock-free by runner threads, changed by a writer.
+ *
+ * Shared by PollRuntime and ConsumerPool. Writers (serialized by the
+ * owner's mutex) copy the published array, change the copy and publish
+ * it. Each reader loads the current array once per pass and acknowledges
+ * the generation it switched to; once every reader has acknowledged, no
+ * pass can still be reading an older array, so the writer frees it.
+ * Readers never lock, allocate or wait.
+ *
+ * @tparam Entry Constructible as Entry(uint64_t id, args...); has `id`
+ *
+ * @par Thread Safety
+ * Add()/Remove()/AttachReader(): writer, under the owner's mutex.
+ * Acquire(): the reader passed in. Count(): any thread.
+ */
+template<typename Entry>
+class PublishedEntries {
+public:
+    // Immutable once published
+    struct Array {
+        uint64_t generation = 0;
+        std::vector<Entry*> entries;
+    };
+
+    // One per reader thread; `acked` is the writer's view of its progress
+    struct Reader {
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> acked{0};
+        uint64_t seen = 0;  // Reader-owned
+    };
+
+    PublishedEntries() : published_(std::make_unique<Array>()) {
+        current_.store(published_.get(), std::memory_order_release);
+    }
+
+    PublishedEntries(const PublishedEntries&) = delete;
+    PublishedEntries& operator=(const PublishedEntries&) = delete;
+
+    // Register a reader Publish() waits for. Call before the reader starts.
+    void AttachReader(Reader& reader) {
+        readers_.push_back(&reader);
+    }
+
+    // Reader side, at the start of every pass: the array to use for the pass.
+    // Acknowledging a new generation means the previous pass (and with it
+    // every use of the older array) is finished.
+    const Array& Acquire(Reader& reader) const noexcept {
+        const Array* array = current_.load(std::memory_order_acquire);
+        if (array->generation != reader.seen) {
+            reader.seen = array->generation;
+            reader.acked.store(reader.seen, std::memory_order_release);
+        }
+        return *array;
+    }
+
+    // Allocates everything before constructing the entry, so on failure the
+    // arguments (e.g. a consumer handle passed as an rvalue) are untouched.
+    // `readers_running`: wait for the readers to acknowledge (false while
+    // they are stopped and would never do so).
+    // RETURNS: the new entry's id, or nullopt on allocation failure
+    template<typename... Args>
+    std::optional<uint64_t> Add(bool readers_running, Args&&... args) noexcept {
+        try {
+            owned_.reserve(owned_.size() + 1);
+            auto next = std::make_unique<Array>();
+            next->entries.reserve(published_->entries.size() + 1);
+            next->entries = published_->entries;
+
+            const uint64_t id = next_id_;
+            auto entry = std::make_unique<Entry>(id, std::forward<Args>(args)...);
+            ++next_id_;
+            next->entries.push_back(entry.get());
+            owned_.push_back(std::move(entry));
+            Publish(std::move(next), readers_running);
+            return id;
+        } catch (const std::bad_alloc&) {
+            return std::nullopt;
+        }
+    }
+
+    // Unpublish entry `id` and hand it back; no reader pass can reach it
+    // once this returns.
+    // RETURNS: the entry, or nullptr if unknown or on allocation failure
+    //          (the entry then stays registered)
+    std::unique_ptr<Entry> Remove(uint64_t id, bool readers_running) noexcept {
+        auto owner = std::find_if(owned_.begin(), owned_.end(),
+                                  [id](const auto& entry) { return entry->id == id; });
+        if (owner == owned_.end()) {
+            return nullptr;
+        }
+        try {
+            auto next = std::make_unique<Array>();
+            next->entries.reserve(published_->entries.size());
+            for (Entry* entry : published_->entries) {
+                if (entry != owner->get()) {
+                    next->entries.push_back(entry);
+                }
+            }
+            Publish(std::move(next), readers_running);
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+        std::unique_ptr<Entry> entry = std::move(*owner);
+        owned_.erase(owner);
+        return entry;
+    }
+
+    [[nodiscard]] size_t Count() const noexcept {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Publish `next` and free the previous array once every reader has moved on
+    void Publish(std::unique_ptr<Array> next, bool readers_running) noexcept {
+        next->generation = published_->generation + 1;
+        const uint64_t generation = next->generation;
+        current_.store(next.get(), std::memory_order_release);
+        if (readers_running) {
+            for (const Reader* reader : readers_) {
+                while (reader->acked.load(std::memory_order_acquire) < generation) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        published_ = std::move(next);
+        count_.store(published_->entries.size(), std::memory_order_relaxed);
+    }
+
+    // Writer side
+    std::vector<std::unique_ptr<Entry>> owned_;
+    std::unique_ptr<Array> published_;      // Owns the array current_ points to
+    std::vector<const Reader*> readers_;
+    uint64_t next_id_ = 1;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<const Array*> current_{nullptr};
+    std::atomic<size_t> count_{0};
+};
+
+} // namespace omni::detail
+
+#endif // OMNI_DETAIL_PUBLISHED_ENTRIES_HPP
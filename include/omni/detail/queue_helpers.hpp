@@ -1,6 +1,7 @@
 #ifndef OMNI_DETAIL_QUEUE_HELPERS_HPP
 #define OMNI_DETAIL_QUEUE_HELPERS_HPP
 
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
@@ -52,6 +53,16 @@ constexpr size_t MAX_SAFE_MESSAGE_SIZE = std::numeric_limits<size_t>::max() - 12
  */
 constexpr size_t SIZE_PREFIX_BYTES = 4;
 
+/**
+ * @brief Size of the optional per-message deadline (ChannelConfig::message_deadlines).
+ */
+constexpr size_t DEADLINE_BYTES = 8;
+
+/**
+ * @brief Deadline value meaning "never expires".
+ */
+constexpr uint64_t NO_DEADLINE = 0;
+
 // ============================================================================
 // Validation Utilities
 // ============================================================================
@@ -356,6 +367,52 @@ inline void WriteSizePrefix(uint8_t* slot, size_t size) noexcept {
     return slot + SIZE_PREFIX_BYTES;
 }
 
+// ============================================================================
+// Message Deadlines
+// ============================================================================
+
+/**
+ * @brief Current time in deadline units (steady_clock nanoseconds).
+ */
+[[nodiscard]] inline uint64_t DeadlineNowNs() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Convert a steady_clock deadline to deadline units.
+ * 
+ * Never returns NO_DEADLINE: a deadline at or before the clock's epoch
+ * becomes 1 (already expired).
+ */
+[[nodiscard]] inline uint64_t ToDeadlineNs(std::chrono::steady_clock::time_point deadline) noexcept {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    return ns > 0 ? static_cast<uint64_t>(ns) : 1;
+}
+
+/**
+ * @brief Write a message's deadline into its slot header.
+ * 
+ * @param slot Pointer to the slot's size prefix (the deadline occupies the
+ *             DEADLINE_BYTES in front of it, see SPSCQueue::slots)
+ * @param deadline_ns Deadline in DeadlineNowNs() units, or NO_DEADLINE
+ */
+inline void WriteDeadline(uint8_t* slot, uint64_t deadline_ns) noexcept {
+    std::memcpy(slot - DEADLINE_BYTES, &deadline_ns, DEADLINE_BYTES);
+}
+
+/**
+ * @brief Read a message's deadline from its slot header.
+ * 
+ * @param slot Pointer to the slot's size prefix
+ * @return Deadline in DeadlineNowNs() units, or NO_DEADLINE
+ */
+[[nodiscard]] inline uint64_t ReadDeadline(const uint8_t* slot) noexcept {
+    uint64_t deadline_ns = NO_DEADLINE;
+    std::memcpy(&deadline_ns, slot - DEADLINE_BYTES, DEADLINE_BYTES);
+    return deadline_ns;
+}
+
 } // namespace omni::detail
 
 #endif // OMNI_DETAIL_QUEUE_HELPERS_HPP
@@ -0,0 +1,116 @@
+#ifndef OMNI_DETAIL_SATURATION_HPP
+#define OMNI_DETAIL_SATURATION_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "omni/detail/config.hpp"
+#include "omni/detail/spsc_queue.hpp"
+
+namespace omni::detail {
+
+/**
+ * @brief Producer-side queue saturation tracking.
+ *
+ * Records peak depth, time spent at or above each configured watermark,
+ * and the number of times the queue became full. All updates happen on
+ * the producer thread using depths it already computed from its
+ * acquire-loaded read index, so no extra remote cache line is touched.
+ *
+ * @par Cost
+ * Steady state (level unchanged, no new peak): 3 compares, no stores.
+ * A steady_clock read is taken only when the watermark level changes.
+ *
+ * @par Accuracy
+ * Depth is sampled at producer operations. If the producer goes idle
+ * while above a watermark, time keeps accruing until its next push
+ * observes the lower depth (upper bound, never under-reports).
+ */
+
+// Monotonic timestamp used for watermark time accounting
+[[nodiscard]] inline int64_t SaturationNowNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Number of watermarks reached at given depth (thresholds are ascending)
+[[nodiscard]] inline uint32_t WatermarkLevel(const SPSCQueue& queue, uint64_t depth) noexcept {
+    uint32_t level = 0;
+    for (size_t i = 0; i < WATERMARK_COUNT; ++i) {
+        level += depth >= queue.watermark_slots[i] ? 1u : 0u;
+    }
+    return level;
+}
+
+// Producer only: update peak depth and watermark level (shared by the two entry points below)
+inline void UpdateSaturationLevel(SPSCQueue& queue, uint64_t depth) noexcept {
+    auto& sat = queue.saturation;
+
+    if (depth > sat.max_depth.load(std::memory_order_relaxed)) {
+        sat.max_depth.store(depth, std::memory_order_relaxed);
+    }
+
+    const uint32_t old_level = sat.level.load(std::memory_order_relaxed);
+    const uint32_t new_level = WatermarkLevel(queue, depth);
+    if (new_level == old_level) {
+        return;  // Fast path: no clock read
+    }
+
+    // Close the interval for every watermark that was reached
+    const int64_t now = SaturationNowNs();
+    const int64_t since = sat.level_since_ns.load(std::memory_order_relaxed);
+    const uint64_t elapsed = static_cast<uint64_t>(now - since);
+    for (uint32_t i = 0; i < old_level; ++i) {
+        AddRelaxed(sat.time_above_ns[i], elapsed);
+    }
+    sat.level_since_ns.store(now, std::memory_order_relaxed);
+    sat.level.store(new_level, std::memory_order_relaxed);
+}
+
+// Producer only: record depth observed after a successful push
+inline void RecordProducerDepth(SPSCQueue& queue, uint64_t depth) noexcept {
+    if (queue.saturation.in_full_episode) {
+        queue.saturation.in_full_episode = false;  // Store only when an episode ends
+    }
+    UpdateSaturationLevel(queue, depth);
+}
+
+// Producer only: record a push attempt that found the queue full
+inline void RecordProducerFull(SPSCQueue& queue) noexcept {
+    auto& sat = queue.saturation;
+    if (sat.in_full_episode) {
+        return;  // Same episode (e.g. BlockingPush retry loop)
+    }
+    sat.in_full_episode = true;
+    AddRelaxed(sat.full_events, 1);
+    UpdateSaturationLevel(queue, queue.capacity - 1);
+}
+
+// Any thread: snapshot saturation counters, including the open interval
+[[nodiscard]] inline SaturationStats ReadSaturation(const SPSCQueue& queue) noexcept {
+    const auto& sat = queue.saturation;
+
+    SaturationStats stats{
+        .max_depth = sat.max_depth.load(std::memory_order_relaxed),
+        .full_events = sat.full_events.load(std::memory_order_relaxed),
+        .watermark_percent = queue.watermark_percent,
+        .time_above_ns = {}
+    };
+
+    const uint32_t level = sat.level.load(std::memory_order_relaxed);
+    const int64_t since = sat.level_since_ns.load(std::memory_order_relaxed);
+    const int64_t now = SaturationNowNs();
+    const uint64_t open = now > since ? static_cast<uint64_t>(now - since) : 0;
+
+    for (size_t i = 0; i < WATERMARK_COUNT; ++i) {
+        stats.time_above_ns[i] = sat.time_above_ns[i].load(std::memory_order_relaxed);
+        if (i < level) {
+            stats.time_above_ns[i] += open;
+        }
+    }
+    return stats;
+}
+
+} // namespace omni::detail
+
+#endif // OMNI_DETAIL_SATURATION_HPP
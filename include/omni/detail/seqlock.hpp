@@ -0,0 +1,76 @@
+#ifndef OMNI_DETAIL_SEQLOCK_HPP
+#define OMNI_DETAIL_SEQLOCK_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace omni::detail {
+
+/**
+ * @brief Word-wise copies for seqlock-protected buffers.
+ *
+ * A writer bumps a sequence stamp to odd, fences, writes the buffer and
+ * publishes an even stamp; a reader loads the stamp, copies, fences and
+ * re-checks it. The shared bytes are only ever accessed as relaxed atomic
+ * 4-byte words, so a reader racing the writer gets torn values (rejected by
+ * the re-check) but never a data race.
+ *
+ * @par Layout
+ * `shared` must be 4-byte aligned with room for SeqlockWords(bytes) words:
+ * a trailing partial word is written whole (zero padded).
+ *
+ * @par Memory Ordering
+ * Writer: stamp.store(odd, relaxed); atomic_thread_fence(release);
+ *         SeqlockStore(...); stamp.store(even, release)
+ * Reader: s1 = stamp.load(acquire); SeqlockLoad(...);
+ *         atomic_thread_fence(acquire); valid if stamp.load(relaxed) == s1
+ */
+
+constexpr size_t SEQLOCK_WORD_BYTES = sizeof(uint32_t);
+
+// State channels (MailboxBroker::RequestStateChannel) double-buffer their
+// value: version v lives in slot v % STATE_CHANNEL_SLOTS, so a reader only
+// retries if the writer publishes twice during one copy
+constexpr size_t STATE_CHANNEL_SLOTS = 2;
+
+[[nodiscard]] inline constexpr size_t SeqlockWords(size_t bytes) noexcept {
+    return (bytes + SEQLOCK_WORD_BYTES - 1) / SEQLOCK_WORD_BYTES;
+}
+
+// Copy `bytes` from private `src` into the shared buffer
+inline void SeqlockStore(uint8_t* shared, const uint8_t* src, size_t bytes) noexcept {
+    auto* words = reinterpret_cast<uint32_t*>(shared);
+    const size_t whole = bytes / SEQLOCK_WORD_BYTES;
+    for (size_t i = 0; i < whole; ++i) {
+        uint32_t word;
+        std::memcpy(&word, src + i * SEQLOCK_WORD_BYTES, SEQLOCK_WORD_BYTES);
+        std::atomic_ref<uint32_t>(words[i]).store(word, std::memory_order_relaxed);
+    }
+    if (const size_t tail = bytes % SEQLOCK_WORD_BYTES; tail != 0) {
+        uint32_t word = 0;
+        std::memcpy(&word, src + whole * SEQLOCK_WORD_BYTES, tail);
+        std::atomic_ref<uint32_t>(words[whole]).store(word, std::memory_order_relaxed);
+    }
+}
+
+// Copy `bytes` from the shared buffer into private `dst` (may be torn until
+// the caller's stamp re-check passes)
+inline void SeqlockLoad(uint8_t* dst, const uint8_t* shared, size_t bytes) noexcept {
+    // atomic_ref needs a non-const referent; the loads never write
+    auto* words = reinterpret_cast<uint32_t*>(const_cast<uint8_t*>(shared));
+    const size_t whole = bytes / SEQLOCK_WORD_BYTES;
+    for (size_t i = 0; i < whole; ++i) {
+        const uint32_t word = std::atomic_ref<uint32_t>(words[i]).load(std::memory_order_relaxed);
+        std::memcpy(dst + i * SEQLOCK_WORD_BYTES, &word, SEQLOCK_WORD_BYTES);
+    }
+    if (const size_t tail = bytes % SEQLOCK_WORD_BYTES; tail != 0) {
+        const uint32_t word = std::atomic_ref<uint32_t>(words[whole]).load(std::memory_order_relaxed);
+        std::memcpy(dst + whole * SEQLOCK_WORD_BYTES, &word, tail);
+    }
+}
+
+} // namespace omni::detail
+
+#endif // OMNI_DETAIL_SEQLOCK_HPP
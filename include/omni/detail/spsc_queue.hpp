@@ -2,9 +2,18 @@
 #define OMNI_DETAIL_SPSC_QUEUE_HPP
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <cassert>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "omni/detail/config.hpp"
+#include "omni/detail/queue_helpers.hpp"
 
 namespace omni::detail {
 
@@ -21,6 +30,97 @@ namespace omni::detail {
 #pragma warning(disable: 4324)  // Structure was padded due to alignment specifier
 #endif
 
+// Producer-written channel counters (relaxed, single writer)
+// Kept on their own cache line so the consumer never pulls it in exclusive mode
+struct alignas(CACHE_LINE_SIZE) ProducerCounters {
+    std::atomic<uint64_t> messages_sent{0};
+    std::atomic<uint64_t> bytes_sent{0};
+    std::atomic<uint64_t> failed_pushes{0};    // Timeouts + ChannelClosed + QueueFull
+};
+
+// Consumer-written channel counters (relaxed, single writer)
+struct alignas(CACHE_LINE_SIZE) ConsumerCounters {
+    std::atomic<uint64_t> messages_received{0};
+    std::atomic<uint64_t> bytes_received{0};
+    std::atomic<uint64_t> failed_pops{0};      // Timeouts + ChannelClosed
+    std::atomic<uint64_t> messages_lost{0};    // Overwritten before being read (lossy/conflating/state)
+    std::atomic<uint64_t> messages_expired{0}; // Dropped unread past their deadline
+};
+
+// Producer-written saturation tracking (relaxed, single writer)
+// Separate line from ProducerCounters: only touched on depth/level changes
+struct alignas(CACHE_LINE_SIZE) SaturationCounters {
+    std::atomic<uint64_t> max_depth{0};
+    std::atomic<uint64_t> full_events{0};
+    std::atomic<uint64_t> time_above_ns[WATERMARK_COUNT]{};
+    std::atomic<uint32_t> level{0};             // Number of watermarks currently reached
+    std::atomic<int64_t> level_since_ns{0};     // steady_clock time of last level change
+    bool in_full_episode = false;               // Producer-private: suppress repeat full events
+};
+
+// Flight recorder: events per side (power of 2). 16 bytes each, so both
+// rings of a channel take 1KB and stay cache resident.
+constexpr size_t FLIGHT_RECORDER_EVENTS = 32;
+
+// One encoded flight recorder slot (relaxed stores only)
+struct FlightSlot {
+    std::atomic<uint64_t> ticks{0};
+    std::atomic<uint64_t> packed{0};            // index << 32 | value << 8 | type
+};
+
+// Single-writer ring of recent events (one per side, on the writer's own lines)
+struct alignas(CACHE_LINE_SIZE) FlightRing {
+    std::atomic<uint64_t> head{0};              // Events claimed (stored before the slot is written)
+    std::atomic<uint64_t> published{0};         // Events fully written
+    std::array<FlightSlot, FLIGHT_RECORDER_EVENTS> slots{};
+};
+
+// Broker-level watermark observer (channel name, event, depth at crossing)
+using WatermarkObserverFn = std::function<void(std::string_view, WatermarkEvent, size_t)>;
+
+// Broker watermark observer binding (read-mostly; armed/disarmed by the broker)
+// The producer checks high_slots on every push; the observer pointer is only
+// loaded when a crossing actually fires.
+struct alignas(CACHE_LINE_SIZE) WatermarkObserverBinding {
+    std::atomic<uint64_t> high_slots{0};        // 0 = disarmed
+    std::atomic<uint64_t> low_slots{0};
+    std::atomic<std::shared_ptr<const WatermarkObserverFn>> observer;
+    bool above = false;                         // Producer-private hysteresis state
+};
+
+// Ready-bitmap binding (see FairMultiplexer). While armed, the producer sets
+// `mask` in `*word` after publishing, so a multiplexer finds non-empty
+// channels from one bitmap instead of probing every ring. Read-mostly line:
+// disarmed it costs a push one acquire load. A disarmed push has no fence
+// before its word load, so it can miss a concurrent bind: the binder keeps
+// checking the ring until `acknowledged` reaches its generation.
+struct alignas(CACHE_LINE_SIZE) ReadySignalBinding {
+    std::atomic<std::atomic<uint64_t>*> word{nullptr};  // nullptr = disarmed
+    std::atomic<uint64_t> mask{0};                      // Stored before word
+    std::atomic<uint64_t> generation{0};                // Bumped after word on every bind
+    std::atomic<uint64_t> acknowledged{0};              // Last generation an armed push saw (producer)
+    // Every bitmap ever bound (consumer side only). Never shrinks: a producer
+    // may still hold a stale word pointer after a re-bind.
+    std::vector<std::shared_ptr<const void>> owners;
+};
+
+// Endpoint CPU placement (cold: written by the broker and by ApplyPlacement(),
+// read for stats). Planned CPUs are stored independently, so a reader racing
+// with a re-plan may briefly see one old and one new side.
+struct alignas(CACHE_LINE_SIZE) PlacementState {
+    std::atomic<int32_t> planned_producer_cpu{-1};
+    std::atomic<int32_t> planned_consumer_cpu{-1};
+    std::atomic<uint8_t> policy{static_cast<uint8_t>(PlacementPolicy::SameLLC)};
+    std::atomic<int32_t> pinned_producer_cpu{-1};   // Set by ProducerHandle::ApplyPlacement()
+    std::atomic<int32_t> pinned_consumer_cpu{-1};   // Set by ConsumerHandle::ApplyPlacement()
+};
+
+// Single-writer counter increment: plain load + store instead of a locked RMW.
+// Only valid when exactly one thread ever writes the counter (SPSC ownership).
+inline void AddRelaxed(std::atomic<uint64_t>& counter, uint64_t delta) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
 struct SPSCQueue {
     // Producer-owned cache line (relaxed for own index, acquire for remote)
     alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> write_index{0};
@@ -35,26 +135,85 @@ struct SPSCQueue {
     alignas(CACHE_LINE_SIZE) std::atomic<bool> producer_alive{true};
     alignas(CACHE_LINE_SIZE) std::atomic<bool> consumer_alive{true};
     
+    // Per-channel statistics, shared by handles and broker (producer and consumer lines kept apart)
+    ProducerCounters producer_stats;
+    ConsumerCounters consumer_stats;
+    SaturationCounters saturation;
+    WatermarkObserverBinding watermark_observer;
+    ReadySignalBinding ready_signal;
+    
+    // Flight recorder rings (producer-written, consumer-written)
+    FlightRing producer_flight;
+    FlightRing consumer_flight;
+    
+    // Endpoint CPU placement (see MailboxBroker::PlaceChannel)
+    PlacementState placement;
+    
     // Configuration (immutable after construction)
     const size_t capacity;          // Must be power of 2
     const size_t max_message_size;
-    const size_t slot_size;         // 4 (size prefix) + max_message_size + alignment
+    const size_t deadline_bytes;    // DEADLINE_BYTES if messages carry deadlines, else 0
+    const size_t slot_size;         // deadline_bytes + 4 (size prefix) + max_message_size + alignment
+    
+    // Saturation watermarks (percent of usable capacity, and the same as slot counts)
+    const std::array<uint8_t, WATERMARK_COUNT> watermark_percent;
+    const std::array<uint64_t, WATERMARK_COUNT> watermark_slots;
     
     // Buffer storage
     std::unique_ptr<uint8_t[]> buffer;
     
+    // Size prefix of slot 0 (buffer + deadline_bytes): handles index slots
+    // from here, so a slot's deadline sits just in front of its size prefix
+    uint8_t* const slots;
+    
+    // Overwrite-oldest channels only (see MailboxBroker::RequestLossyChannel):
+    // one sequence stamp per slot, 2 * index + 1 while message `index` is
+    // being written and 2 * (index + 1) once it is complete. Conflating
+    // channels reuse it per key entry: odd while writing, 2 * updates once
+    // complete. State channels use two slots as a lossy channel of capacity
+    // 2 whose reader takes the newest message. Null otherwise.
+    std::unique_ptr<std::atomic<uint64_t>[]> stamps;
+    
+    // Registry name and id (set by broker before handles exist; empty/0 for test queues)
+    std::string name;
+    uint64_t id = 0;
+    
     // Constructor
-    SPSCQueue(size_t cap, size_t max_msg_size)
+    SPSCQueue(size_t cap, size_t max_msg_size,
+              std::array<uint8_t, WATERMARK_COUNT> watermarks = ChannelConfig{}.watermark_percent,
+              bool message_deadlines = false)
         : capacity(cap)
         , max_message_size(max_msg_size)
-        , slot_size(AlignUp(4 + max_msg_size, 8))
+        , deadline_bytes(message_deadlines ? DEADLINE_BYTES : 0)
+        , slot_size(SlotSize(max_msg_size, message_deadlines))
+        , watermark_percent(watermarks)
+        , watermark_slots(WatermarkSlots(cap, watermarks))
         , buffer(new uint8_t[capacity * slot_size])
+        , slots(buffer.get() + deadline_bytes)
     {
         assert((capacity & (capacity - 1)) == 0);  // Power of 2
         std::memset(buffer.get(), 0, capacity * slot_size);
     }
     
+    // Bytes per slot: optional deadline + size prefix + payload, 8-byte aligned
+    // (the ring is capacity * SlotSize(); also used by bench-memory)
+    static constexpr size_t SlotSize(size_t max_msg_size, bool message_deadlines) {
+        return AlignUp((message_deadlines ? DEADLINE_BYTES : 0) + SIZE_PREFIX_BYTES + max_msg_size, 8);
+    }
+    
 private:
+    // Convert percent thresholds to depth thresholds (rounded up, at least 1 slot)
+    static constexpr std::array<uint64_t, WATERMARK_COUNT> WatermarkSlots(
+        size_t cap, std::array<uint8_t, WATERMARK_COUNT> percent)
+    {
+        std::array<uint64_t, WATERMARK_COUNT> slots{};
+        const uint64_t usable = cap - 1;  // "Leave 1 slot empty" rule
+        for (size_t i = 0; i < WATERMARK_COUNT; ++i) {
+            slots[i] = std::max<uint64_t>(1, (usable * percent[i] + 99) / 100);
+        }
+        return slots;
+    }
+    
     static constexpr size_t AlignUp(size_t val, size_t align) {
         return (val + align - 1) & ~(align - 1);
     }
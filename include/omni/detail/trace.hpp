@@ -0,0 +1,61 @@
+#ifndef OMNI_DETAIL_TRACE_HPP
+#define OMNI_DETAIL_TRACE_HPP
+
+/**
+ * @brief Compile-time optional USDT (static tracepoint) probes.
+ *
+ * Built with OMNI_HAVE_USDT (CMake: -DOMNI_ENABLE_USDT=ON, requires
+ * <sys/sdt.h> from systemtap-sdt-dev), each OMNI_TRACE() site becomes a
+ * single NOP plus an ELF note under provider "omni". Tools such as
+ * bpftrace, perf and SystemTap patch the NOP only while attached.
+ * Without OMNI_HAVE_USDT the macro expands to nothing and its arguments
+ * are not evaluated.
+ *
+ * @par Probe Arguments
+ * Every probe carries the channel id first (SPSCQueue::id, assigned by
+ * the broker, 0 for queues created outside it). Indices are the absolute
+ * (unmasked) write/read indices, so `omni:commit` for index N pairs with
+ * the `omni:pop`, `omni:batch_pop` or `omni:expire` covering the same N.
+ * batch_pop and expire each describe one contiguous run: a batch with
+ * expired messages in the middle fires one probe per run.
+ *
+ * Lossy, conflating and state channels fire `omni:publish` instead of
+ * commit: their messages can be overwritten, re-queued or superseded
+ * without ever being popped, so a publish has no guaranteed partner.
+ *
+ * | Probe            | Arguments                                   |
+ * |------------------|---------------------------------------------|
+ * | channel_create   | id, name (const char*), capacity            |
+ * | commit           | id, write_index, size                       |
+ * | batch_push       | id, first_write_index, count, bytes         |
+ * | publish          | id, write_index, size (may never be popped) |
+ * | pop              | id, read_index, size                        |
+ * | batch_pop        | id, first_read_index, count, bytes          |
+ * | expire           | id, first_read_index, count (dropped unread)|
+ * | producer_park    | id, write_index, read_index (queue full)    |
+ * | producer_wake    | id, read_index                              |
+ * | consumer_park    | id, read_index, write_index (queue empty)   |
+ * | consumer_wake    | id, write_index                             |
+ * | liveness         | id, side (0 = producer, 1 = consumer), alive|
+ *
+ * See tools/bpftrace/omni_queue_delay.bt for per-channel queueing delay.
+ */
+
+#if defined(OMNI_HAVE_USDT)
+#include <sys/sdt.h>
+#define OMNI_TRACE(probe, ...) STAP_PROBEV(omni, probe, __VA_ARGS__)
+#else
+#define OMNI_TRACE(probe, ...) do { } while (0)
+#endif
+
+namespace omni::detail {
+
+// Probe argument for the "side" field of omni:liveness
+enum TraceSide : int {
+    TRACE_SIDE_PRODUCER = 0,
+    TRACE_SIDE_CONSUMER = 1
+};
+
+} // namespace omni::detail
+
+#endif // OMNI_DETAIL_TRACE_HPP
@@ -0,0 +1,84 @@
+#ifndef OMNI_DETAIL_WATERMARK_HPP
+#define OMNI_DETAIL_WATERMARK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "omni/detail/config.hpp"
+#include "omni/detail/queue_helpers.hpp"
+
+namespace omni::detail {
+
+/**
+ * @brief Depth thresholds for one high/low watermark pair.
+ *
+ * Computed once when a callback or observer is registered so the push
+ * path only compares integers.
+ */
+struct WatermarkThresholds {
+    uint64_t high_slots;    // Fire High when depth >= high_slots
+    uint64_t low_slots;     // Fire Low when depth <= low_slots (after High)
+};
+
+/**
+ * @brief Convert a WatermarkConfig into slot counts for a queue.
+ *
+ * High rounds up (at least 1 slot), low rounds down, so the hysteresis
+ * band is never empty for valid configs.
+ */
+[[nodiscard]] inline constexpr WatermarkThresholds ComputeWatermarkThresholds(
+    size_t capacity,
+    WatermarkConfig config) noexcept
+{
+    const uint64_t usable = capacity - 1;  // "Leave 1 slot empty" rule
+    uint64_t high = (usable * config.high_percent + 99) / 100;
+    high = high == 0 ? 1 : high;
+    uint64_t low = (usable * config.low_percent) / 100;
+    low = low >= high ? high - 1 : low;
+    return WatermarkThresholds{.high_slots = high, .low_slots = low};
+}
+
+/**
+ * @brief Queue depth derived from the producer's free-slot arithmetic.
+ *
+ * Uses AvailableSlots() so watermark evaluation shares the exact same
+ * "leave 1 slot empty" rule as the full check.
+ */
+[[nodiscard]] inline constexpr uint64_t ProducerDepth(
+    uint64_t write_index,
+    uint64_t read_index,
+    size_t capacity) noexcept
+{
+    return (capacity - 1) - AvailableSlots(write_index, read_index, capacity);
+}
+
+/**
+ * @brief Hysteresis state machine for one watermark pair.
+ *
+ * @param above In/out: true while between a High and the following Low
+ * @param depth Current queue depth
+ * @return Event to report, or nullopt if no crossing
+ *
+ * @par Performance
+ * Two compares and a branch on the common (no crossing) path.
+ */
+[[nodiscard]] inline std::optional<WatermarkEvent> EvaluateWatermark(
+    bool& above,
+    uint64_t depth,
+    const WatermarkThresholds& thresholds) noexcept
+{
+    if (!above) {
+        if (depth >= thresholds.high_slots) {
+            above = true;
+            return WatermarkEvent::High;
+        }
+    } else if (depth <= thresholds.low_slots) {
+        above = false;
+        return WatermarkEvent::Low;
+    }
+    return std::nullopt;
+}
+
+} // namespace omni::detail
+
+#endif // OMNI_DETAIL_WATERMARK_HPP
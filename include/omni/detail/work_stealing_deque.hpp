@@ -0,0 +1,113 @@
+#ifndef OMNI_DETAIL_WORK_STEALING_DEQUE_HPP
+#define OMNI_DETAIL_WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "omni/detail/spsc_queue.hpp"
+
+namespace omni::detail {
+
+/**
+ * @brief Bounded Chase-Lev work-stealing deque of pointers.
+ *
+ * The owning worker pushes and pops at the bottom (LIFO, cache-warm);
+ * other workers steal from the top (FIFO) with a CAS. Memory orderings
+ * follow Le, Pop, Cohen, Zappa Nardelli, "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013), without the
+ * growable array: callers size the deque for the most items that can
+ * be queued at once, so Push() never allocates.
+ *
+ * @tparam T Element type (stored as T*)
+ *
+ * @par Thread Safety
+ * Push()/Pop(): owner thread only. Steal()/Empty(): any thread.
+ */
+template<typename T>
+class WorkStealingDeque {
+public:
+    // PRECONDITION: capacity is a power of 2
+    explicit WorkStealingDeque(size_t capacity)
+        : mask_(capacity - 1)
+        , slots_(new std::atomic<T*>[capacity])
+    {
+        assert((capacity & (capacity - 1)) == 0);
+        for (size_t i = 0; i < capacity; ++i) {
+            slots_[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    // Owner: false if full
+    bool Push(T* item) noexcept {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        if (bottom - top > static_cast<int64_t>(mask_)) {
+            return false;
+        }
+        slots_[static_cast<size_t>(bottom) & mask_].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner: most recently pushed item, nullptr if empty
+    T* Pop() noexcept {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);  // Was empty
+            return nullptr;
+        }
+
+        T* item = slots_[static_cast<size_t>(bottom) & mask_].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last item: race thieves for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread: oldest item, nullptr if empty or lost a race
+    T* Steal() noexcept {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        T* item = slots_[static_cast<size_t>(top) & mask_].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    // Any thread (approximate)
+    [[nodiscard]] bool Empty() const noexcept {
+        return top_.load(std::memory_order_acquire) >= bottom_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept { return mask_ + 1; }
+
+private:
+    // Thieves CAS top_; the owner writes bottom_ on every operation
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> top_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom_{0};
+    alignas(CACHE_LINE_SIZE) const size_t mask_;
+    std::unique_ptr<std::atomic<T*>[]> slots_;
+};
+
+} // namespace omni::detail
+
+#endif // OMNI_DETAIL_WORK_STEALING_DEQUE_HPP
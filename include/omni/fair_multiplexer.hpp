@@ -0,0 +1,154 @@
+#ifndef OMNI_FAIR_MULTIPLEXER_HPP
+#define OMNI_FAIR_MULTIPLEXER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include "omni/consumer_handle.hpp"
+
+namespace omni {
+
+/**
+ * @brief What a FairMultiplexer's deficit counts.
+ */
+enum class FairShareUnit : uint8_t {
+    Messages,   ///< Every message costs 1
+    Bytes       ///< A message costs its payload size
+};
+
+/**
+ * @brief Configuration for FairMultiplexer.
+ */
+struct FairMultiplexerConfig {
+    FairShareUnit unit = FairShareUnit::Messages;
+
+    /// Credit per unit of weight added to a ready source each round
+    /// (0 = 16 messages, or 16 KiB in Bytes mode)
+    uint32_t quantum = 0;
+
+    /// Most messages taken from one source per visit, whatever its credit
+    /// (clamped to >= 1). Bounds how long a heavy source holds the thread.
+    size_t max_batch = 256;
+
+    /// Most sources (rounded up to a multiple of 64: one bitmap word each)
+    size_t max_sources = 256;
+};
+
+/**
+ * @brief Deficit round-robin over many independent channels.
+ *
+ * Takes ownership of ConsumerHandles and shares the calling thread between
+ * them in proportion to per-source weights. Each Poll() is one round: every
+ * ready source gets weight * quantum credit and is drained while its credit
+ * lasts (a message may overdraw it; the debt is carried into the next
+ * round). A source that runs empty forfeits leftover credit, as in classic
+ * DRR, so idle sources cannot bank service.
+ *
+ * @par Ready Bitmap
+ * Owned channels are bound to a bitmap with one bit per source. Producers
+ * set their bit after publishing (one fence and load per push; the RMW only
+ * on the clear -> set edge), so a round visits ready sources only and never
+ * touches the rings of idle ones. The multiplexer clears a bit before
+ * draining and sets it again itself if messages remain. A push racing
+ * AddSource() can miss the binding, so a new source's ring is also checked
+ * every round until its producer has pushed once under the binding.
+ *
+ * @par Thread Safety
+ * Not thread-safe: like a ConsumerHandle, one thread owns the multiplexer.
+ * Producers push from any thread as usual. The handler must not call back
+ * into the multiplexer and must not throw.
+ *
+ * @par Example
+ * @code
+ * omni::FairMultiplexer mux({.unit = omni::FairShareUnit::Bytes});
+ * auto premium = mux.AddSource(std::move(client_a.consumer), 4);
+ * auto basic = mux.AddSource(std::move(client_b.consumer), 1);
+ * while (running) {
+ *     if (mux.Poll(handle_request) == 0) {
+ *         std::this_thread::yield();
+ *     }
+ * }
+ * @endcode
+ */
+class FairMultiplexer {
+public:
+    /// Registration id (never 0)
+    using SourceId = uint64_t;
+
+    /// Called for every message with the source it came from
+    using Handler = std::function<void(SourceId source, std::span<const uint8_t> data)>;
+
+    /// Service received by one source
+    struct SourceStats {
+        uint64_t messages;      ///< Messages handled
+        uint64_t bytes;         ///< Payload bytes handled
+        uint64_t visits;        ///< Rounds in which the source was drained
+        int64_t deficit;        ///< Credit left (negative: carried overdraft)
+        uint32_t weight;
+        bool closed;            ///< Producer gone and nothing left to drain
+    };
+
+    /// Totals since construction
+    struct Stats {
+        uint64_t rounds;        ///< Poll() calls that found a ready source
+        uint64_t empty_polls;   ///< Poll() calls with an all-clear bitmap
+        uint64_t visits;        ///< Source drains over all rounds
+        uint64_t messages;
+        uint64_t bytes;
+        size_t sources;         ///< Sources currently registered
+    };
+
+    /**
+     * @brief Allocate the bitmap and source table.
+     *
+     * @par Exceptions
+     * Allocation failure throws (not a hot-path API).
+     */
+    explicit FairMultiplexer(FairMultiplexerConfig config = {});
+
+    /// Unbinds and destroys the registered consumer handles
+    ~FairMultiplexer();
+
+    FairMultiplexer(const FairMultiplexer&) = delete;
+    FairMultiplexer& operator=(const FairMultiplexer&) = delete;
+
+    /**
+     * @brief Take ownership of a consumer and schedule it with `weight`.
+     *
+     * @return Registration id, or nullopt if the weight is 0, the handle is
+     *         moved-from, max_sources is reached, or allocation failed (the
+     *         handle is then left with the caller)
+     */
+    [[nodiscard]] std::optional<SourceId> AddSource(ConsumerHandle&& consumer, uint32_t weight = 1) noexcept;
+
+    /// Unbind a source and give its handle back (queued messages stay in it)
+    [[nodiscard]] std::optional<ConsumerHandle> RemoveSource(SourceId source) noexcept;
+
+    /// Change a source's weight from the next round on (false if unknown or 0)
+    bool SetWeight(SourceId source, uint32_t weight) noexcept;
+
+    /**
+     * @brief Run one round over the ready sources.
+     *
+     * Never blocks. Closed sources are reported in their stats and skipped
+     * until removed.
+     *
+     * @return Messages handled (0 if no source was ready)
+     */
+    size_t Poll(const Handler& handler) noexcept;
+
+    [[nodiscard]] std::optional<SourceStats> GetSourceStats(SourceId source) const noexcept;
+    [[nodiscard]] Stats GetStats() const noexcept;
+    [[nodiscard]] size_t SourceCount() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace omni
+
+#endif // OMNI_FAIR_MULTIPLEXER_HPP
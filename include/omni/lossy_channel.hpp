@@ -0,0 +1,133 @@
+#ifndef OMNI_LOSSY_CHANNEL_HPP
+#define OMNI_LOSSY_CHANNEL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+#include "omni/detail/config.hpp"
+
+namespace omni {
+
+class MailboxBroker;
+
+namespace detail {
+    struct SPSCQueue;
+}
+
+/**
+ * @brief Producer side of an overwrite-oldest (lossy) channel.
+ *
+ * TryPush never waits and never reports QueueFull: when the consumer falls
+ * a full ring behind, the oldest unread messages are overwritten. The push
+ * never reads the consumer's index, so it is wait-free and touches no line
+ * the consumer writes. Single producer, as ProducerHandle.
+ */
+class LossyProducer {
+public:
+    /**
+     * @brief Publish a message, overwriting the oldest one if the ring is full.
+     *
+     * @return Success; InvalidSize if data is empty or larger than
+     *         max_message_size; ChannelClosed if the consumer is gone
+     */
+    [[nodiscard]] PushResult TryPush(std::span<const uint8_t> data) noexcept;
+
+    [[nodiscard]] bool IsConnected() const noexcept;  // Consumer alive
+    [[nodiscard]] size_t Capacity() const noexcept;
+    [[nodiscard]] size_t MaxMessageSize() const noexcept;
+
+    /// Messages published so far (the next message's sequence number)
+    [[nodiscard]] uint64_t Published() const noexcept;
+
+    // RAII: signals the consumer (sets producer_alive = false)
+    ~LossyProducer() noexcept;
+
+    LossyProducer(LossyProducer&&) noexcept;
+    LossyProducer& operator=(LossyProducer&&) noexcept;
+    LossyProducer(const LossyProducer&) = delete;
+    LossyProducer& operator=(const LossyProducer&) = delete;
+
+private:
+    friend class MailboxBroker;
+    explicit LossyProducer(std::shared_ptr<detail::SPSCQueue> queue) noexcept;
+
+    std::shared_ptr<detail::SPSCQueue> queue_;
+};
+
+/**
+ * @brief Consumer side of an overwrite-oldest (lossy) channel.
+ *
+ * Every slot carries a sequence stamp. A pop copies the slot out and
+ * re-checks the stamp, so a message overwritten mid-read is never returned
+ * torn; the consumer then skips ahead to the oldest message still intact
+ * and reports exactly how many it missed.
+ *
+ * @par Thread Safety
+ * Single consumer, as ConsumerHandle.
+ */
+class LossyConsumer {
+public:
+    /// One popped message, copied out of the ring
+    struct Message {
+        std::span<const uint8_t> data;  ///< Valid until the next pop
+        uint64_t sequence;              ///< Producer's message number, from 0
+        uint64_t missed;                ///< Overwritten since the previous pop (sequence gap)
+    };
+
+    /**
+     * @brief Pop the oldest message that has not been overwritten.
+     *
+     * @return Success, Empty, or ChannelClosed once the producer is gone
+     *         and every remaining message has been read
+     */
+    [[nodiscard]] std::pair<PopResult, std::optional<Message>> TryPop() noexcept;
+
+    /// Poll (spin, then yield) until a message arrives, the producer goes
+    /// away or the timeout expires. The producer never notifies, so no wait
+    /// blocks in the kernel.
+    [[nodiscard]] std::pair<PopResult, std::optional<Message>> BlockingPop(
+        std::chrono::milliseconds timeout = std::chrono::milliseconds::max()
+    ) noexcept;
+
+    [[nodiscard]] bool IsConnected() const noexcept;  // Producer alive
+    [[nodiscard]] size_t Capacity() const noexcept;
+    [[nodiscard]] size_t MaxMessageSize() const noexcept;
+
+    /// Unread messages still in the ring (approximate, at most Capacity())
+    [[nodiscard]] size_t AvailableMessages() const noexcept;
+
+    /// Total messages overwritten before this consumer read them
+    [[nodiscard]] uint64_t MissedMessages() const noexcept;
+
+    // RAII: signals the producer (sets consumer_alive = false)
+    ~LossyConsumer() noexcept;
+
+    LossyConsumer(LossyConsumer&&) noexcept;
+    LossyConsumer& operator=(LossyConsumer&&) noexcept;
+    LossyConsumer(const LossyConsumer&) = delete;
+    LossyConsumer& operator=(const LossyConsumer&) = delete;
+
+private:
+    friend class MailboxBroker;
+    LossyConsumer(std::shared_ptr<detail::SPSCQueue> queue, std::vector<uint8_t> scratch) noexcept;
+
+    std::shared_ptr<detail::SPSCQueue> queue_;
+    std::vector<uint8_t> scratch_;  // Copy target; popped data points here
+};
+
+/**
+ * @brief Both ends of a lossy channel (see MailboxBroker::RequestLossyChannel).
+ */
+struct LossyChannelPair {
+    LossyProducer producer;
+    LossyConsumer consumer;
+};
+
+} // namespace omni
+
+#endif // OMNI_LOSSY_CHANNEL_HPP
@@ -20,3 +20,13 @@
 #include "omni/mailbox_broker.hpp"
 #include "omni/producer_handle.hpp"
 #include "omni/consumer_handle.hpp"
+#include "omni/placement.hpp"
+#include "omni/poll_runtime.hpp"
+#include "omni/actor_system.hpp"
+#include "omni/consumer_pool.hpp"
+#include "omni/priority_channel.hpp"
+#include "omni/fair_multiplexer.hpp"
+#include "omni/merge_consumer.hpp"
+#include "omni/lossy_channel.hpp"
+#include "omni/conflating_channel.hpp"
+#include "omni/state_channel.hpp"
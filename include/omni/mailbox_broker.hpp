@@ -2,13 +2,22 @@
 #define OMNI_MAILBOX_BROKER_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 #include "omni/detail/config.hpp"
 #include "omni/producer_handle.hpp"
 #include "omni/consumer_handle.hpp"
+#include "omni/placement.hpp"
+#include "omni/priority_channel.hpp"
+#include "omni/lossy_channel.hpp"
+#include "omni/conflating_channel.hpp"
+#include "omni/state_channel.hpp"
 
 namespace omni {
 
@@ -124,6 +133,10 @@ public:
      * new channel if not found. Configuration is automatically normalized
      * before use.
      * 
+     * With config.message_deadlines, each slot carries an 8-byte deadline:
+     * ProducerHandle::TryPushWithDeadline()/TryPushWithTtl() set it and the
+     * consumer drops expired messages unread (ChannelStats::messages_expired).
+     * 
      * @param name Unique channel identifier
      * @param config Channel configuration (auto-normalized)
      * @return Pair of (error code, optional channel pair)
@@ -181,6 +194,148 @@ public:
         const ChannelConfig& config = {}
     ) noexcept;
     
+    /**
+     * @brief Create a multi-lane priority channel.
+     * 
+     * Registers one ring per lane, named "<name>.lane0", "<name>.lane1", ...
+     * (lane 0 is the highest priority), behind a single producer and a
+     * single consumer. Lanes show up in GetStats()/GetChannelStats() like
+     * any other channel and are cleaned up the same way.
+     * 
+     * @param name Prefix for the lane channel names
+     * @param config Per-lane ring configs, dequeue mode and weights
+     * @return {error, pair}, as RequestChannel()
+     * 
+     * @par Error Conditions
+     * - InvalidConfig: no lanes or more than MAX_PRIORITY_LANES, weights
+     *   neither empty nor one non-zero weight per lane, or a lane config
+     *   invalid after normalization
+     * - NameExists / AllocationFailed: as RequestChannel() for any lane;
+     *   lanes already created are removed again
+     * 
+     * @par Example
+     * @code
+     * auto [error, channel] = broker.RequestPriorityChannel("orders", {
+     *     .lanes = {{.capacity = 64}, {.capacity = 4096}},   // control, bulk
+     * });
+     * channel->producer.TryPush(0, cancel_bytes);  // Overtakes queued bulk
+     * @endcode
+     */
+    [[nodiscard]] std::pair<ChannelError, std::optional<PriorityChannelPair>> RequestPriorityChannel(
+        std::string_view name,
+        const PriorityChannelConfig& config = {}
+    ) noexcept;
+    
+    /**
+     * @brief Create an overwrite-oldest (lossy) channel.
+     * 
+     * For feeds where the newest data matters more than every message
+     * (telemetry, monitoring): LossyProducer::TryPush() always succeeds,
+     * overwriting the oldest unread message once the consumer is a full
+     * ring behind, and never waits for the consumer. The consumer detects
+     * overwrites through per-slot sequence stamps, never returns a torn
+     * message and reports how many messages it missed.
+     * 
+     * Registered like any other channel (stats, RemoveChannel, flight
+     * recorder); ChannelStats::messages_lost counts the overwritten messages.
+     * 
+     * @param name Unique channel identifier
+     * @param config Channel configuration (auto-normalized; all `capacity`
+     *               slots are usable)
+     * @return {error, pair}, as RequestChannel(); also InvalidConfig if
+     *         config.message_deadlines is set
+     * 
+     * @par Example
+     * @code
+     * auto [error, channel] = broker.RequestLossyChannel("cpu-metrics", {.capacity = 256});
+     * channel->producer.TryPush(sample);   // Never QueueFull
+     * 
+     * if (auto [result, msg] = channel->consumer.TryPop(); result == PopResult::Success) {
+     *     if (msg->missed > 0) {
+     *         gaps += msg->missed;          // Sequence jumped by missed + 1
+     *     }
+     * }
+     * @endcode
+     */
+    [[nodiscard]] std::pair<ChannelError, std::optional<LossyChannelPair>> RequestLossyChannel(
+        std::string_view name,
+        const ChannelConfig& config = {}
+    ) noexcept;
+    
+    /**
+     * @brief Create a key-conflating (last-value) channel.
+     * 
+     * For state feeds keyed by an id (quotes per instrument, status per
+     * device) where only each key's latest value matters: a push for a key
+     * that is still queued overwrites its value in place, so a slow consumer
+     * receives each changed key once, with its newest value, instead of
+     * working through a backlog of stale updates. Per-drain work is bounded
+     * by the number of keys, not by the producer's rate.
+     * 
+     * `config.capacity` is the number of distinct keys (the key table is
+     * fixed at creation; a new key beyond it is rejected with QueueFull).
+     * ChannelStats::messages_lost counts the updates conflated away and
+     * `depth` the keys waiting for delivery.
+     * 
+     * @param name Unique channel identifier
+     * @param config Channel configuration (auto-normalized; capacity = keys)
+     * @return {error, pair}, as RequestChannel(); also InvalidConfig if
+     *         config.message_deadlines is set
+     * 
+     * @par Example
+     * @code
+     * auto [error, channel] = broker.RequestConflatingChannel("quotes", {.capacity = 4096});
+     * channel->producer.TryPush(instrument_id, quote);  // Replaces a pending quote
+     * 
+     * channel->consumer.DrainBatch(256, [](uint64_t id, std::span<const uint8_t> latest) {
+     *     Reprice(id, latest);
+     * });
+     * @endcode
+     */
+    [[nodiscard]] std::pair<ChannelError, std::optional<ConflatingChannelPair>> RequestConflatingChannel(
+        std::string_view name,
+        const ChannelConfig& config = {}
+    ) noexcept;
+    
+    /**
+     * @brief Create a state channel holding one value (seqlock, double buffered).
+     * 
+     * For configuration or state snapshots (risk limits, routing tables)
+     * read far more often than they change, where a queue is the wrong
+     * tool: StateProducer::Publish() replaces the value and bumps its
+     * version without waiting, StateConsumer::Read() copies the latest
+     * value without blocking the writer and retries on a torn copy, and
+     * StateConsumer::ChangedSince() is a single load.
+     * 
+     * Only `config.max_message_size` applies (the value's size limit);
+     * `capacity` is ignored. Registered like any other channel;
+     * ChannelStats counts published versions as sent, versions the
+     * consumer read as received and versions it never saw as
+     * messages_lost.
+     * 
+     * @param name Unique channel identifier
+     * @param config Channel configuration (auto-normalized)
+     * @return {error, pair}, as RequestChannel(); also InvalidConfig if
+     *         config.message_deadlines is set
+     * 
+     * @par Example
+     * @code
+     * auto [error, channel] = broker.RequestStateChannel("risk-limits", {.max_message_size = 256});
+     * channel->producer.Publish(limits_bytes);
+     * 
+     * uint64_t seen = 0;
+     * if (channel->consumer.ChangedSince(seen)) {      // One load on the hot path
+     *     auto [result, snapshot] = channel->consumer.Read();
+     *     seen = snapshot->version;
+     *     std::memcpy(&limits, snapshot->data.data(), sizeof(limits));
+     * }
+     * @endcode
+     */
+    [[nodiscard]] std::pair<ChannelError, std::optional<StateChannelPair>> RequestStateChannel(
+        std::string_view name,
+        const ChannelConfig& config = {}
+    ) noexcept;
+    
     /**
      * @brief Check if channel exists.
      * 
@@ -230,16 +385,212 @@ public:
     /**
      * @brief Get broker statistics (approximate).
      * 
+     * Message and byte totals are summed from the per-channel counters
+     * stored on each queue, plus the final counts of channels that were
+     * removed from the registry (so totals never go backwards).
+     * 
      * @return Current statistics snapshot
      * 
      * @par Thread Safety
-     * Uses relaxed atomics. Values may be stale but reads are safe.
+     * Uses relaxed atomics under the registry read lock. Never takes the
+     * write lock, so concurrent RequestChannel() calls are only delayed
+     * by the O(n) counter loads, not by any channel operation.
      * 
      * @par Performance
      * O(n) where n = number of active channels (iterates to sum stats).
+     * Producer/consumer hot paths are unaffected (read-only access to
+     * counter cache lines).
      */
     [[nodiscard]] Stats GetStats() const noexcept;
     
+    /**
+     * @brief Per-channel statistics snapshot.
+     * 
+     * Producer-side and consumer-side counters are read independently
+     * with relaxed loads, so a snapshot taken mid-transfer may show
+     * messages_received slightly behind messages_sent.
+     */
+    struct ChannelStats {
+        std::string name;                ///< Channel identifier
+        uint64_t id;                     ///< Numeric id carried by trace probes (see detail/trace.hpp)
+        size_t capacity;                 ///< Normalized ring capacity (slots)
+        size_t max_message_size;         ///< Normalized maximum payload size
+        size_t depth;                    ///< Messages currently queued (approximate)
+        uint64_t messages_sent;          ///< Producer: committed messages
+        uint64_t bytes_sent;             ///< Producer: committed payload bytes
+        uint64_t failed_pushes;          ///< Producer: QueueFull + Timeout + ChannelClosed
+        uint64_t messages_received;      ///< Consumer: popped messages
+        uint64_t bytes_received;         ///< Consumer: popped payload bytes
+        uint64_t failed_pops;            ///< Consumer: Timeout + ChannelClosed
+        uint64_t messages_lost;          ///< Consumer: overwritten before being read (lossy/conflating/state)
+        uint64_t messages_expired;       ///< Consumer: dropped unread past their deadline
+        bool producer_alive;             ///< Producer handle still exists
+        bool consumer_alive;             ///< Consumer handle still exists
+        SaturationStats saturation;      ///< Peak depth, watermark time, full events
+        ChannelPlacement placement;      ///< Planned endpoint CPUs (-1 = not placed)
+        int producer_pinned_cpu;         ///< CPU the producer thread pinned itself to (-1 = never)
+        int consumer_pinned_cpu;         ///< CPU the consumer thread pinned itself to (-1 = never)
+    };
+    
+    /**
+     * @brief Get statistics for a single channel.
+     * 
+     * @param name Channel identifier
+     * @return Snapshot of channel counters, or nullopt if not registered
+     * 
+     * @par Thread Safety
+     * Uses shared_mutex (read lock) only for the registry lookup.
+     * 
+     * @par Example
+     * @code
+     * if (auto stats = broker.GetChannelStats("orders")) {
+     *     std::cout << stats->depth << "/" << stats->capacity << "\n";
+     * }
+     * @endcode
+     */
+    [[nodiscard]] std::optional<ChannelStats> GetChannelStats(std::string_view name) const noexcept;
+    
+    /**
+     * @brief Visit statistics for every registered channel.
+     * 
+     * Channel references are snapshotted under the registry read lock,
+     * then the lock is released before counters are read and the
+     * visitor is invoked. The visitor may therefore call back into the
+     * broker (including RequestChannel/RemoveChannel) without deadlock.
+     * 
+     * @param visitor Called once per channel, in unspecified order
+     * 
+     * @par Thread Safety
+     * Safe to call concurrently with all other broker methods. Channels
+     * created after the snapshot are not visited; channels removed after
+     * the snapshot are still visited (their queues are kept alive).
+     * 
+     * @par Exceptions
+     * Exceptions thrown by the visitor propagate to the caller. Snapshot
+     * allocation failure throws std::bad_alloc (not a hot-path API).
+     */
+    void ForEachChannelStats(const std::function<void(const ChannelStats&)>& visitor) const;
+    
+    /**
+     * @brief Broker-level watermark observer, called for any channel.
+     * 
+     * @param channel Channel name (valid only during the call)
+     * @param event High (depth rose to >= high) or Low (depth fell to <= low)
+     * @param depth Queue depth observed by the producer at the crossing
+     */
+    using WatermarkObserver = std::function<void(std::string_view channel, WatermarkEvent event, size_t depth)>;
+    
+    /**
+     * @brief Install (or clear) a watermark observer for all channels.
+     * 
+     * Arms every existing channel and every channel created afterwards
+     * with thresholds derived from `config` and each channel's capacity.
+     * Crossings are detected with hysteresis on the producer thread
+     * during push calls (see ProducerHandle::SetWatermarkCallback), so
+     * the observer runs on that channel's producer thread.
+     * 
+     * @param config High/low thresholds in percent of usable capacity
+     * @param observer Callback; an empty function disarms all channels
+     * @return false if config is invalid (previous observer kept)
+     * 
+     * @par Hot Path Cost
+     * Disarmed: one load per push. Armed: two loads plus
+     * two compares; the observer pointer is only loaded on a crossing.
+     * 
+     * @par Thread Safety
+     * Uses shared_mutex (write lock). The observer may be invoked
+     * concurrently from different producer threads and may still be
+     * running on a producer thread briefly after being replaced.
+     * It must not throw and must not push on the channel that fired.
+     * 
+     * @par Exceptions
+     * Allocation failure throws std::bad_alloc (not a hot-path API).
+     */
+    bool SetWatermarkObserver(WatermarkConfig config, WatermarkObserver observer);
+    
+    /**
+     * @brief Snapshot a channel's flight recorder.
+     * 
+     * Every channel keeps its last FLIGHT_RECORDER_EVENTS producer events
+     * and consumer events (push, pop, batch, full, timeout, park, wake,
+     * disconnect) with TSC timestamps. Returned events are merged and
+     * ordered oldest first; `age_ns` is relative to the time of the dump.
+     * 
+     * @param name Channel name
+     * @return Events, or nullopt if no channel has this name
+     * 
+     * @par Thread Safety
+     * Read lock for the lookup only. The rings are read with relaxed loads
+     * while producer and consumer keep running; entries overwritten during
+     * the read are discarded.
+     * 
+     * @par Exceptions
+     * Allocation failure throws std::bad_alloc (not a hot-path API).
+     */
+    [[nodiscard]] std::optional<std::vector<FlightEvent>> DumpFlightRecorder(std::string_view name) const;
+    
+    /**
+     * @brief Replace the CPU topology used by PlaceChannel().
+     * 
+     * By default the topology is detected from sysfs on the first
+     * PlaceChannel() call (see CpuTopology::Detect). Set it explicitly to
+     * restrict placement to a CPU subset or to describe a machine whose
+     * sysfs is incomplete (some VMs and containers).
+     * 
+     * @par Thread Safety
+     * Uses shared_mutex (write lock). Existing placements are kept.
+     */
+    void SetCpuTopology(CpuTopology topology) noexcept;
+    
+    /**
+     * @brief Plan producer and consumer CPUs for a channel.
+     * 
+     * Asks the topology for a CPU pair with the requested sharing level,
+     * steering away from CPUs already planned for other channels, and
+     * records it on the channel (visible in ChannelStats::placement).
+     * Nothing is pinned here: each endpoint thread calls ApplyPlacement()
+     * on its handle.
+     * 
+     * @param name Channel name
+     * @param policy Required sharing level between producer and consumer
+     * @return The recorded placement, or nullopt if no channel has this
+     *         name or no CPU pair satisfies the policy (previous plan kept)
+     * 
+     * @par Thread Safety
+     * Uses shared_mutex (write lock), so concurrent calls never hand out
+     * the same least-loaded pair twice.
+     * 
+     * @par Example
+     * @code
+     * auto [error, channel] = broker.RequestChannel("md.feed");
+     * broker.PlaceChannel("md.feed", omni::PlacementPolicy::SameLLC);
+     * 
+     * std::thread producer_thread([&] {
+     *     channel->producer.ApplyPlacement();  // Pins to the planned CPU
+     *     // ...
+     * });
+     * @endcode
+     * 
+     * @par Exceptions
+     * Topology detection and allocation failure throw std::bad_alloc
+     * (not a hot-path API).
+     */
+    std::optional<ChannelPlacement> PlaceChannel(
+        std::string_view name,
+        PlacementPolicy policy = PlacementPolicy::SameLLC
+    );
+    
+    /**
+     * @brief Record an explicit placement for a channel.
+     * 
+     * For deployments that keep CPU assignments in configuration. CPUs are
+     * not checked against the topology; ApplyPlacement() fails for CPUs
+     * the process may not use. Use -1 for a side that should stay unpinned.
+     * 
+     * @return false if no channel has this name or a CPU is below -1
+     */
+    bool SetChannelPlacement(std::string_view name, const ChannelPlacement& placement) noexcept;
+    
     /**
      * @brief Shutdown all channels (signals stop, does NOT wait).
      * 
@@ -0,0 +1,129 @@
+#ifndef OMNI_MERGE_CONSUMER_HPP
+#define OMNI_MERGE_CONSUMER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include "omni/consumer_handle.hpp"
+
+namespace omni {
+
+/**
+ * @brief Configuration for MergeConsumer.
+ */
+struct MergeConsumerConfig {
+    /// How far (in key units) an empty input may trail the newest key seen
+    /// on any input. A head whose key is at least this much older than the
+    /// newest key is emitted without waiting for the empty inputs. The
+    /// default always waits for them: exact order, but one silent input
+    /// stalls the merge.
+    uint64_t max_lateness = std::numeric_limits<uint64_t>::max();
+};
+
+/**
+ * @brief K-way merge of several channels into one key-ordered stream.
+ *
+ * For a logical stream split over several producers (e.g. one feed handler
+ * per line), each ordered by its own key such as a timestamp. The merge
+ * keeps a min-heap over the head message of every input, read in place
+ * with ConsumerHandle::Peek(), and hands messages to the handler in key
+ * order (ties: lower input first). Nothing is copied.
+ *
+ * @par Ordering and Lateness
+ * Each input must be ordered by key. A head is emitted once no other input
+ * can still deliver an older key: an input that is currently empty (with
+ * a live producer) holds back heads newer than the last key it delivered,
+ * unless the head is older than the newest key seen by at least
+ * max_lateness. A message that arrives older than a key already emitted
+ * is still delivered (immediately) and counted in Stats::late.
+ *
+ * @par Thread Safety
+ * Not thread-safe: like a ConsumerHandle, one thread owns the merge.
+ * The handler must not call back into the merge and must not throw.
+ *
+ * @par Example
+ * @code
+ * omni::MergeConsumer merge(omni::MergeConsumer::KeyAtOffset(0), {.max_lateness = 50'000});
+ * for (auto& feed : feeds) {
+ *     merge.AddInput(std::move(feed.consumer));
+ * }
+ * while (!merge.Done()) {
+ *     merge.Poll([](size_t input, uint64_t ts, std::span<const uint8_t> data) { Apply(ts, data); });
+ * }
+ * @endcode
+ */
+class MergeConsumer {
+public:
+    using Key = uint64_t;
+
+    /// Ordering key of one message (called on the ring slot, in place)
+    using KeyExtractor = std::function<Key(std::span<const uint8_t> data)>;
+
+    /// Called for every message in merged order; `data` is valid only during the call
+    using Handler = std::function<void(size_t input, Key key, std::span<const uint8_t> data)>;
+
+    /// Totals since construction
+    struct Stats {
+        uint64_t messages;      ///< Messages emitted
+        uint64_t late;          ///< Emitted with a key older than one already emitted
+        uint64_t stalls;        ///< Poll() calls stopped by an empty live input
+        size_t closed_inputs;   ///< Inputs whose producer is gone and that are drained
+    };
+
+    /// Little-endian uint64 at `offset` in the payload (0 if the message is shorter)
+    [[nodiscard]] static KeyExtractor KeyAtOffset(size_t offset);
+
+    /**
+     * @brief Create an empty merge.
+     *
+     * @param key Key extractor (empty = KeyAtOffset(0))
+     *
+     * @par Exceptions
+     * Allocation failure throws (not a hot-path API).
+     */
+    explicit MergeConsumer(KeyExtractor key = {}, MergeConsumerConfig config = {});
+
+    ~MergeConsumer();
+
+    MergeConsumer(const MergeConsumer&) = delete;
+    MergeConsumer& operator=(const MergeConsumer&) = delete;
+
+    /**
+     * @brief Add an input; it takes part from the next Poll() on.
+     *
+     * @return Input index passed to the handler, or nullopt if allocation
+     *         failed (the handle is then left with the caller)
+     */
+    [[nodiscard]] std::optional<size_t> AddInput(ConsumerHandle&& consumer) noexcept;
+
+    /**
+     * @brief Emit messages in key order while the order is known.
+     *
+     * Never blocks: returns when max_count messages were emitted, every
+     * input is drained, or an empty live input has to be waited for.
+     *
+     * @return Messages emitted
+     */
+    size_t Poll(const Handler& handler, size_t max_count = std::numeric_limits<size_t>::max()) noexcept;
+
+    /// Every input's producer is gone and every input is drained
+    [[nodiscard]] bool Done() const noexcept;
+
+    /// Key of the last emitted message (nullopt before the first)
+    [[nodiscard]] std::optional<Key> LastKey() const noexcept;
+
+    [[nodiscard]] size_t InputCount() const noexcept;
+    [[nodiscard]] Stats GetStats() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace omni
+
+#endif // OMNI_MERGE_CONSUMER_HPP
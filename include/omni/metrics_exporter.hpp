@@ -0,0 +1,127 @@
+#ifndef OMNI_METRICS_EXPORTER_HPP
+#define OMNI_METRICS_EXPORTER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "omni/mailbox_broker.hpp"
+
+namespace omni {
+
+/**
+ * @brief Configuration for MetricsExporter.
+ */
+struct MetricsExporterConfig {
+    /// Interval between broker snapshots (clamped to >= 10ms)
+    std::chrono::milliseconds interval{1000};
+
+    /// File to (atomically) rewrite after each snapshot. Empty = disabled.
+    std::string file_path;
+
+    /// Loopback HTTP port serving GET /metrics. nullopt = disabled,
+    /// 0 = let the OS choose (query with BoundPort()).
+    std::optional<uint16_t> http_port;
+
+    /// Prefix for every metric family name
+    std::string metric_prefix = "omni";
+};
+
+/**
+ * @brief Periodic OpenMetrics (Prometheus) exporter for broker statistics.
+ *
+ * Owns one background thread that snapshots MailboxBroker::GetStats() and
+ * MailboxBroker::ForEachChannelStats() every `interval`, renders the
+ * result as OpenMetrics text, and publishes it to a file and/or a tiny
+ * HTTP endpoint bound to 127.0.0.1.
+ *
+ * @par Hot Path Cost
+ * Snapshots only perform relaxed loads of the per-channel counter cache
+ * lines; they never write queue state or take channel locks. Scrapes are
+ * served from the last rendered text, so scrape frequency and channel
+ * count (e.g. 5000 channels) do not add work to producers or consumers.
+ *
+ * @par Thread Safety
+ * Start()/Stop() must not race with each other. GetText() and
+ * SnapshotNow() are safe from any thread.
+ *
+ * @par Example
+ * @code
+ * omni::MetricsExporter exporter({
+ *     .interval = std::chrono::seconds(5),
+ *     .http_port = 9464
+ * });
+ * if (!exporter.Start()) {
+ *     // Port in use or platform without socket support
+ * }
+ * // curl http://127.0.0.1:9464/metrics
+ * @endcode
+ */
+class MetricsExporter {
+public:
+    /**
+     * @brief One channel in a snapshot, with rates derived from the previous snapshot.
+     */
+    struct ChannelSample {
+        MailboxBroker::ChannelStats stats;
+        double send_rate;       ///< Messages/sec committed since previous snapshot
+        double receive_rate;    ///< Messages/sec popped since previous snapshot
+    };
+
+    /**
+     * @brief Complete broker snapshot used for rendering.
+     */
+    struct Snapshot {
+        MailboxBroker::Stats broker;
+        std::vector<ChannelSample> channels;
+    };
+
+    explicit MetricsExporter(
+        MetricsExporterConfig config = {},
+        MailboxBroker& broker = MailboxBroker::Instance());
+
+    // Stops the background thread and closes the listening socket
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * @brief Take an initial snapshot and start the background thread.
+     *
+     * @return false if already running, if the HTTP port cannot be bound,
+     *         or if HTTP export is requested on a platform without support
+     */
+    [[nodiscard]] bool Start() noexcept;
+
+    /// Stop the background thread (idempotent)
+    void Stop() noexcept;
+
+    [[nodiscard]] bool IsRunning() const noexcept;
+
+    /// Actual HTTP port after Start() (0 if HTTP disabled or not started)
+    [[nodiscard]] uint16_t BoundPort() const noexcept;
+
+    /// Snapshot and render immediately (also rewrites file_path if set)
+    void SnapshotNow() noexcept;
+
+    /// Last rendered OpenMetrics text (empty before the first snapshot)
+    [[nodiscard]] std::string GetText() const;
+
+    /**
+     * @brief Render a snapshot as OpenMetrics text (terminated by "# EOF").
+     *
+     * Pure function, exposed for testing and for custom transports.
+     */
+    [[nodiscard]] static std::string Render(const Snapshot& snapshot, const std::string& prefix = "omni");
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace omni
+
+#endif // OMNI_METRICS_EXPORTER_HPP
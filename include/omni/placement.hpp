@@ -0,0 +1,121 @@
+#ifndef OMNI_PLACEMENT_HPP
+#define OMNI_PLACEMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "omni/detail/config.hpp"
+
+namespace omni {
+
+/**
+ * @brief One logical CPU and the resources it shares with others.
+ *
+ * Ids are opaque and only meaningful for equality: two CPUs with the same
+ * `core` are SMT siblings, the same `llc` share a last-level cache, the
+ * same `numa_node` share local memory.
+ */
+struct CpuInfo {
+    int cpu;            ///< Logical CPU number (as used by taskset / sched_setaffinity)
+    int core;           ///< Physical core id, unique across packages
+    int package;        ///< Socket
+    int llc;            ///< Last-level cache id (lowest CPU sharing it)
+    int numa_node;      ///< NUMA node
+};
+
+/**
+ * @brief CPU topology used to plan producer/consumer placement.
+ *
+ * Replaces hand-written taskset scripts: detect the topology once, ask for
+ * a CPU pair per channel with the sharing level the channel needs, and let
+ * each endpoint thread pin itself (see MailboxBroker::PlaceChannel and
+ * ProducerHandle::ApplyPlacement).
+ *
+ * @par Choosing a policy
+ * - SameCore: SMT siblings share L1/L2, so the index and slot cache lines
+ *   never leave the core. Best latency, but both threads compete for one
+ *   core's execution units.
+ * - SameLLC: separate cores, lines move through the shared L3. The usual
+ *   choice for throughput.
+ * - SameNode: only memory locality is guaranteed; use when the LLC pairs
+ *   are already taken by hotter channels.
+ */
+class CpuTopology {
+public:
+    /**
+     * @brief Read the topology of the CPUs this process may run on.
+     *
+     * On Linux, reads /sys/devices/system/cpu (core, package, highest cache
+     * level, NUMA node) for every CPU in the process affinity mask, so
+     * containers and taskset restrictions are respected. Missing sysfs
+     * entries fall back to one core per CPU, one LLC and one node.
+     * Elsewhere returns a flat topology of hardware_concurrency() CPUs.
+     *
+     * @par Exceptions
+     * Allocation failure throws std::bad_alloc (not a hot-path API).
+     */
+    [[nodiscard]] static CpuTopology Detect();
+
+    /**
+     * @brief Build a topology from explicit CPU descriptions.
+     *
+     * For tests and for deployments that describe their machines in
+     * configuration. Entries are sorted by CPU number; duplicates are dropped.
+     */
+    [[nodiscard]] static CpuTopology FromCpus(std::vector<CpuInfo> cpus);
+
+    /// CPUs in ascending order
+    [[nodiscard]] std::span<const CpuInfo> Cpus() const noexcept { return cpus_; }
+
+    /// Description of one CPU, or nullopt if it is not part of this topology
+    [[nodiscard]] std::optional<CpuInfo> Find(int cpu) const noexcept;
+
+    /**
+     * @brief Recommend a producer/consumer CPU pair for a policy.
+     *
+     * Picks two distinct CPUs with the requested sharing level, preferring
+     * the pair least used by `busy_cpus` (CPUs already given to other
+     * endpoints, repeats count as extra load; load on an SMT sibling counts
+     * against the core), then the closest pair, then the lowest CPU numbers.
+     *
+     * @param policy Required sharing level
+     * @param busy_cpus CPUs already assigned to other endpoints
+     * @return Placement, or nullopt if no pair satisfies the policy
+     *         (e.g. SameCore without SMT, SameLLC with one core per LLC)
+     *
+     * @par Performance
+     * O(n^2) in the number of CPUs; meant for setup, not per message.
+     *
+     * @par Exceptions
+     * Allocation failure throws std::bad_alloc (not a hot-path API).
+     */
+    [[nodiscard]] std::optional<ChannelPlacement> Recommend(
+        PlacementPolicy policy,
+        std::span<const int> busy_cpus = {}
+    ) const;
+
+private:
+    std::vector<CpuInfo> cpus_;
+};
+
+/**
+ * @brief Pin the calling thread to one CPU.
+ *
+ * @return false if the CPU is invalid, not allowed for this process, or
+ *         pinning is unsupported on this platform
+ */
+bool PinCurrentThread(int cpu) noexcept;
+
+namespace detail {
+
+// Parse a kernel CPU list ("0-3,8,10-11"); empty on malformed input
+[[nodiscard]] std::vector<int> ParseCpuList(std::string_view list);
+
+} // namespace detail
+
+} // namespace omni
+
+#endif // OMNI_PLACEMENT_HPP
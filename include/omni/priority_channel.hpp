@@ -0,0 +1,185 @@
+#ifndef OMNI_PRIORITY_CHANNEL_HPP
+#define OMNI_PRIORITY_CHANNEL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+#include "omni/detail/config.hpp"
+#include "omni/producer_handle.hpp"
+#include "omni/consumer_handle.hpp"
+
+namespace omni {
+
+class MailboxBroker;
+
+namespace detail {
+    struct PriorityWake;
+}
+
+// Most lanes a priority channel may have
+constexpr size_t MAX_PRIORITY_LANES = 8;
+
+/**
+ * @brief How a PriorityConsumer picks the next lane.
+ */
+enum class PriorityMode : uint8_t {
+    Strict,     ///< Always the highest non-empty lane (lower lanes can starve)
+    Weighted    ///< Highest non-empty lane with credit left; credits refill per round
+};
+
+/**
+ * @brief Configuration for MailboxBroker::RequestPriorityChannel().
+ */
+struct PriorityChannelConfig {
+    /// One ring per lane, lane 0 first (highest priority). 1..MAX_PRIORITY_LANES.
+    /// Lanes may differ: e.g. a small control lane ahead of a large bulk lane.
+    std::vector<ChannelConfig> lanes{ChannelConfig{}, ChannelConfig{}};
+
+    PriorityMode mode = PriorityMode::Strict;
+
+    /// Weighted mode: pops per round for each lane (all > 0). While several
+    /// lanes are backlogged they are served in proportion to their weights,
+    /// higher lanes first. Empty = 2^(lanes-1-i), e.g. {8, 4, 2, 1}.
+    std::vector<uint32_t> weights;
+};
+
+/**
+ * @brief Producer side of a priority channel: one SPSC ring per lane.
+ *
+ * Same single-producer rules as ProducerHandle: one thread pushes at a time.
+ * A push only ever waits on its own lane, so a full bulk lane never blocks
+ * control messages.
+ */
+class PriorityProducer {
+public:
+    /**
+     * @brief Non-blocking push onto one lane.
+     *
+     * @return As ProducerHandle::TryPush(); InvalidSize also if the lane
+     *         does not exist
+     */
+    [[nodiscard]] PushResult TryPush(size_t lane, std::span<const uint8_t> data) noexcept;
+
+    /// As ProducerHandle::BlockingPush(), on one lane
+    [[nodiscard]] PushResult BlockingPush(
+        size_t lane,
+        std::span<const uint8_t> data,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds::max()
+    ) noexcept;
+
+    [[nodiscard]] size_t LaneCount() const noexcept;
+
+    /// Direct access to one lane's ring (stats, watermarks, placement).
+    /// Pushing through it bypasses the consumer wake-up; use TryPush().
+    [[nodiscard]] const ProducerHandle& Lane(size_t lane) const noexcept;
+
+    // RAII: closes every lane and wakes a parked consumer
+    ~PriorityProducer() noexcept;
+
+    PriorityProducer(PriorityProducer&&) noexcept;
+    PriorityProducer& operator=(PriorityProducer&&) noexcept;
+    PriorityProducer(const PriorityProducer&) = delete;
+    PriorityProducer& operator=(const PriorityProducer&) = delete;
+
+private:
+    friend class MailboxBroker;
+    PriorityProducer(std::vector<ProducerHandle> lanes, std::shared_ptr<detail::PriorityWake> wake) noexcept;
+
+    // Wake the consumer if it is parked on the combined wake word
+    void NotifyConsumer() noexcept;
+
+    std::vector<ProducerHandle> lanes_;
+    std::shared_ptr<detail::PriorityWake> wake_;
+};
+
+/**
+ * @brief Consumer side of a priority channel.
+ *
+ * Pops serve the highest lane first (see PriorityMode). A parked
+ * BlockingPop() waits on one wake word shared by all lanes, so a push on
+ * any lane wakes it and the producer only pays for a wake-up when the
+ * consumer is actually parked.
+ */
+class PriorityConsumer {
+public:
+    using Message = ConsumerHandle::Message;
+    using BatchHandler = ConsumerHandle::BatchHandler;
+
+    /**
+     * @brief Pop from the highest eligible lane.
+     *
+     * @return Success, Empty, or ChannelClosed once the producer is gone
+     *         and every lane is drained
+     */
+    [[nodiscard]] std::pair<PopResult, std::optional<Message>> TryPop() noexcept;
+
+    /// As ConsumerHandle::BlockingPop(), across all lanes. An infinite timeout
+    /// parks on the combined wake word; a finite one spins then yields.
+    [[nodiscard]] std::pair<PopResult, std::optional<Message>> BlockingPop(
+        std::chrono::milliseconds timeout = std::chrono::milliseconds::max()
+    ) noexcept;
+
+    /// Up to max_count messages in priority order, never blocking.
+    /// Messages are valid until the next pop.
+    [[nodiscard]] std::pair<PopResult, std::vector<Message>> BatchPop(size_t max_count) noexcept;
+
+    /// In-place batch (see ConsumerHandle::DrainBatch) in priority order
+    size_t DrainBatch(size_t max_count, const BatchHandler& handler) noexcept;
+
+    /// Lane the last successful pop came from (for BatchPop/DrainBatch: the last message)
+    [[nodiscard]] size_t LastLane() const noexcept { return last_lane_; }
+
+    [[nodiscard]] size_t LaneCount() const noexcept;
+    [[nodiscard]] PriorityMode Mode() const noexcept { return mode_; }
+
+    /// Direct access to one lane's ring (stats, placement)
+    [[nodiscard]] const ConsumerHandle& Lane(size_t lane) const noexcept;
+
+    ~PriorityConsumer() noexcept;
+    PriorityConsumer(PriorityConsumer&&) noexcept;
+    PriorityConsumer& operator=(PriorityConsumer&&) noexcept;
+    PriorityConsumer(const PriorityConsumer&) = delete;
+    PriorityConsumer& operator=(const PriorityConsumer&) = delete;
+
+private:
+    friend class MailboxBroker;
+    PriorityConsumer(std::vector<ConsumerHandle> lanes, PriorityMode mode, std::vector<uint32_t> weights,
+                     std::shared_ptr<detail::PriorityWake> wake) noexcept;
+
+    // Highest non-empty lane allowed to run now (starts a new credit round in
+    // Weighted mode when every backlogged lane is out of credit), or nullopt
+    [[nodiscard]] std::optional<size_t> SelectLane() noexcept;
+
+    // Messages `lane` may deliver before the next selection
+    [[nodiscard]] size_t Allowance(size_t lane) const noexcept;
+
+    // Record `count` deliveries from `lane`
+    void Charge(size_t lane, size_t count) noexcept;
+
+    // Empty or ChannelClosed, for a pop that found nothing
+    [[nodiscard]] PopResult NothingResult() const noexcept;
+
+    std::vector<ConsumerHandle> lanes_;
+    PriorityMode mode_;
+    std::vector<uint32_t> weights_;
+    std::vector<uint32_t> credits_;
+    size_t last_lane_ = 0;
+    std::shared_ptr<detail::PriorityWake> wake_;
+};
+
+/**
+ * @brief Both ends of a priority channel (see MailboxBroker::RequestPriorityChannel).
+ */
+struct PriorityChannelPair {
+    PriorityProducer producer;
+    PriorityConsumer consumer;
+};
+
+} // namespace omni
+
+#endif // OMNI_PRIORITY_CHANNEL_HPP
@@ -7,6 +7,7 @@
 #include <optional>
 #include <span>
 #include <chrono>
+#include <functional>
 #include "omni/detail/config.hpp"
 
 namespace omni {
@@ -16,6 +17,7 @@ class MailboxBroker;
 
 namespace detail {
     struct SPSCQueue;
+    class ActorScheduler;
 }
 
 class ProducerHandle {
@@ -34,6 +36,7 @@ public:
         uint64_t messages_sent;
         uint64_t bytes_sent;
         uint64_t failed_pushes;  // Timeouts + ChannelClosed
+        SaturationStats saturation;  // Peak depth, watermark time, full events
     };
     
     // Reserve space in ring buffer (FAIL-FAST: no timeout)
@@ -55,6 +58,12 @@ public:
     // ERROR: Returns false if preconditions violated
     bool Commit(size_t actual_bytes) noexcept;
     
+    // Commit with a deadline: the consumer drops the message unread once
+    // `deadline` has passed (see ChannelConfig::message_deadlines)
+    // PRECONDITION: As Commit(); channel created with message_deadlines,
+    //               otherwise the deadline is not stored (never expires)
+    bool CommitWithDeadline(size_t actual_bytes, std::chrono::steady_clock::time_point deadline) noexcept;
+    
     // Abort reservation without sending
     void Rollback() noexcept;
     
@@ -72,6 +81,23 @@ public:
     // RETURNS: QueueFull immediately if no space
     [[nodiscard]] PushResult TryPush(std::span<const uint8_t> data) noexcept;
     
+    // Non-blocking push of a message that expires at `deadline`
+    // Consumers skip it, counted in ChannelStats::messages_expired, if they
+    // reach it after the deadline. Plain pushes on the same channel never expire.
+    // PRECONDITION: Channel created with ChannelConfig::message_deadlines,
+    //               otherwise the deadline is not stored (never expires)
+    // RETURNS: As TryPush()
+    [[nodiscard]] PushResult TryPushWithDeadline(
+        std::span<const uint8_t> data,
+        std::chrono::steady_clock::time_point deadline
+    ) noexcept;
+    
+    // TryPushWithDeadline(data, now + ttl)
+    [[nodiscard]] PushResult TryPushWithTtl(
+        std::span<const uint8_t> data,
+        std::chrono::nanoseconds ttl
+    ) noexcept;
+    
     // Batch push multiple messages (amortizes atomic overhead)
     // Attempts to push all messages in the span. Stops at first failure
     // (queue full or consumer disconnected) and returns number of successfully
@@ -81,6 +107,35 @@ public:
         std::span<const std::span<const uint8_t>> messages
     ) noexcept;
     
+    // Watermark callback, invoked on the producer thread inside push calls
+    // (Commit/TryPush/BlockingPush/BatchPush/failed Reserve) and CheckWatermarks()
+    // when queue depth crosses the configured thresholds.
+    using WatermarkCallback = std::function<void(WatermarkEvent event, size_t depth)>;
+    
+    // Register high/low watermark callback (replaces any previous one)
+    // PRECONDITION: Called from the producer thread (not synchronized with pushes)
+    // HYSTERESIS: High fires once when depth >= high; Low fires once when depth
+    //             later drops to <= low. No repeats while within the band.
+    // CALLBACK: Must not throw and must not push on this producer (re-entrancy)
+    // ERROR: Returns false if !config.IsValid() or callback is empty
+    bool SetWatermarkCallback(WatermarkConfig config, WatermarkCallback callback) noexcept;
+    
+    // Remove watermark callback
+    void ClearWatermarkCallback() noexcept;
+    
+    // Re-evaluate watermarks against current depth (acquire read of consumer index)
+    // A producer throttled after a High event calls this to observe the Low
+    // crossing, since no push happens while it is paused.
+    // RETURNS: Current queue depth
+    size_t CheckWatermarks() noexcept;
+    
+    // Pin the calling thread to the producer CPU planned for this channel
+    // (MailboxBroker::PlaceChannel / SetChannelPlacement) and record it in
+    // ChannelStats::producer_pinned_cpu.
+    // PRECONDITION: Called from the producer thread, before the hot loop
+    // ERROR: Returns false if no producer CPU is planned or pinning failed
+    bool ApplyPlacement() noexcept;
+    
     // Query state (relaxed reads, approximate)
     [[nodiscard]] bool IsConnected() const noexcept;  // Consumer alive
     [[nodiscard]] size_t Capacity() const noexcept;
@@ -121,8 +176,13 @@ public:
 
 private:
     friend class MailboxBroker;
+    friend class detail::ActorScheduler;  // Actor mailboxes (outside the broker registry)
     explicit ProducerHandle(std::shared_ptr<detail::SPSCQueue> queue);
     
+    // Commit/TryPush with a deadline in detail::DeadlineNowNs() units (NO_DEADLINE = none)
+    bool CommitDeadlineNs(size_t actual_bytes, uint64_t deadline_ns) noexcept;
+    [[nodiscard]] PushResult TryPushDeadlineNs(std::span<const uint8_t> data, uint64_t deadline_ns) noexcept;
+    
     struct Impl;
     std::unique_ptr<Impl> pimpl_;
 };
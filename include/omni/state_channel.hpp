@@ -0,0 +1,126 @@
+#ifndef OMNI_STATE_CHANNEL_HPP
+#define OMNI_STATE_CHANNEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+#include "omni/detail/config.hpp"
+
+namespace omni {
+
+class MailboxBroker;
+
+namespace detail {
+    struct SPSCQueue;
+}
+
+/**
+ * @brief Producer side of a state channel: one value, replaced by each publish.
+ *
+ * For configuration or state snapshots read far more often than they
+ * change. Publish never waits for the consumer; versions count publishes
+ * from 1 (0 = nothing published yet). Single producer, as ProducerHandle.
+ */
+class StateProducer {
+public:
+    /**
+     * @brief Replace the value; it becomes version Version() + 1.
+     *
+     * Seqlock write into the buffer the consumer is not reading (double
+     * buffered), then one release store of the version.
+     *
+     * @return Success; InvalidSize if data is empty or larger than
+     *         max_message_size; ChannelClosed if the consumer is gone
+     */
+    [[nodiscard]] PushResult Publish(std::span<const uint8_t> data) noexcept;
+
+    [[nodiscard]] bool IsConnected() const noexcept;  // Consumer alive
+    [[nodiscard]] size_t MaxMessageSize() const noexcept;
+    [[nodiscard]] uint64_t Version() const noexcept;  // Last version published
+
+    // RAII: signals the consumer (sets producer_alive = false)
+    ~StateProducer() noexcept;
+
+    StateProducer(StateProducer&&) noexcept;
+    StateProducer& operator=(StateProducer&&) noexcept;
+    StateProducer(const StateProducer&) = delete;
+    StateProducer& operator=(const StateProducer&) = delete;
+
+private:
+    friend class MailboxBroker;
+    explicit StateProducer(std::shared_ptr<detail::SPSCQueue> queue) noexcept;
+
+    std::shared_ptr<detail::SPSCQueue> queue_;
+};
+
+/**
+ * @brief Consumer side of a state channel.
+ *
+ * Reads never block the writer and never return a torn value: the copy is
+ * re-validated against the buffer's stamp and retried if the writer lapped
+ * it. The last value stays readable after the producer is gone.
+ *
+ * @par Thread Safety
+ * Single consumer, as ConsumerHandle. Read() copies into a buffer owned by
+ * this handle; ChangedSince() and Version() only load the version.
+ */
+class StateConsumer {
+public:
+    /// The value as of one version, copied out of the channel
+    struct Snapshot {
+        std::span<const uint8_t> data;  ///< Valid until the next Read()
+        uint64_t version;               ///< Publishes so far, including this one
+    };
+
+    /**
+     * @brief Copy the latest value.
+     *
+     * @return Success (latest version, even after the producer closed);
+     *         Empty if nothing was published yet; ChannelClosed if the
+     *         producer closed without publishing
+     */
+    [[nodiscard]] std::pair<PopResult, std::optional<Snapshot>> Read() noexcept;
+
+    /// True if a version newer than `version` was published. One acquire
+    /// load; a following Read() sees at least that version.
+    [[nodiscard]] bool ChangedSince(uint64_t version) const noexcept;
+
+    [[nodiscard]] uint64_t Version() const noexcept;  // Latest published
+    [[nodiscard]] bool IsConnected() const noexcept;  // Producer alive
+    [[nodiscard]] size_t MaxMessageSize() const noexcept;
+
+    /// Copies rejected because the writer overwrote the buffer mid-read
+    [[nodiscard]] uint64_t Retries() const noexcept { return retries_; }
+
+    // RAII: signals the producer (sets consumer_alive = false)
+    ~StateConsumer() noexcept;
+
+    StateConsumer(StateConsumer&&) noexcept;
+    StateConsumer& operator=(StateConsumer&&) noexcept;
+    StateConsumer(const StateConsumer&) = delete;
+    StateConsumer& operator=(const StateConsumer&) = delete;
+
+private:
+    friend class MailboxBroker;
+    StateConsumer(std::shared_ptr<detail::SPSCQueue> queue, std::vector<uint8_t> scratch) noexcept;
+
+    std::shared_ptr<detail::SPSCQueue> queue_;
+    std::vector<uint8_t> scratch_;  // Copy target; snapshot data points here
+    uint64_t retries_ = 0;
+};
+
+/**
+ * @brief Both ends of a state channel (see MailboxBroker::RequestStateChannel).
+ */
+struct StateChannelPair {
+    StateProducer producer;
+    StateConsumer consumer;
+};
+
+} // namespace omni
+
+#endif // OMNI_STATE_CHANNEL_HPP
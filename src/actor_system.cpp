@@ -0,0 +1,679 @@
+#include "omni/actor_system.hpp"
+#include "omni/consumer_handle.hpp"
+#include "omni/producer_handle.hpp"
+#include "omni/placement.hpp"
+#include "omni/detail/published_entries.hpp"
+#include "omni/detail/spsc_queue.hpp"
+#include "omni/detail/work_stealing_deque.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace omni {
+
+namespace detail {
+
+class ActorScheduler;
+
+// One mailbox channel: the queue is created here, not by the broker, so it
+// is kept next to the consumer for the closed-and-drained check
+struct ActorInbox {
+    std::shared_ptr<SPSCQueue> queue;
+    ConsumerHandle consumer;
+
+    // The sender's ref is gone and every message it sent has been handled.
+    // The acquire load of the closed flag sees the sender's last commit.
+    [[nodiscard]] bool Finished() const noexcept {
+        if (queue->producer_alive.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return queue->read_index.load(std::memory_order_relaxed) ==
+               queue->write_index.load(std::memory_order_acquire);
+    }
+};
+
+struct ActorCell {
+    // Pending-delivery count: senders bump it after every push, and the one
+    // that moves it off zero schedules the actor. Reset only by the worker
+    // that finds the mailbox empty, so an actor is queued at most once.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> signal{0};
+    std::atomic<bool> stopped{false};
+
+    ActorScheduler* const scheduler;
+    ActorSystem* const system;
+    const ActorId id;
+    ActorSystem::Behavior behavior;
+    ConsumerHandle::BatchHandler dispatch;
+
+    // Worker-owned (only the worker currently running the actor touches these)
+    std::vector<ActorInbox> inboxes;
+    size_t next_inbox = 0;
+
+    // Channels opened by Connect(), merged into inboxes by the next run
+    std::mutex pending_mutex;
+    std::vector<ActorInbox> pending;
+    uint64_t channels_opened = 0;  // Names "actor.<system>.<actor>.<n>" (guarded by pending_mutex)
+    std::atomic<bool> has_pending{false};
+
+    // Open channels (pending + inboxes), for ActorSystem::Stats
+    std::atomic<size_t> open_channels{0};
+
+    ActorCell(ActorScheduler* owner, ActorSystem* actor_system, ActorId actor_id,
+              ActorSystem::Behavior actor_behavior)
+        : scheduler(owner)
+        , system(actor_system)
+        , id(actor_id)
+        , behavior(std::move(actor_behavior))
+        , dispatch([this](std::span<const uint8_t> message) {
+              if (!stopped.load(std::memory_order_relaxed)) {
+                  ActorContext context(*this);
+                  behavior(context, message);
+              }
+          })
+    {
+    }
+
+    ~ActorCell() {
+        // Every ActorRef (and so every producer) is gone by now
+        Release();
+    }
+
+    ActorCell(const ActorCell&) = delete;
+    ActorCell& operator=(const ActorCell&) = delete;
+
+    // Close the mailbox (senders see ChannelClosed) and drop the behavior.
+    // PRECONDITION: the actor is not running
+    void Release() noexcept {
+        stopped.store(true, std::memory_order_relaxed);
+        inboxes.clear();
+        {
+            std::lock_guard lock(pending_mutex);
+            pending.clear();
+            has_pending.store(false, std::memory_order_relaxed);
+            open_channels.store(0, std::memory_order_relaxed);
+        }
+        // May destroy refs to other actors (and their cells); never this one,
+        // the caller keeps it alive
+        behavior = nullptr;
+    }
+
+    // Move channels opened since the last run into inboxes.
+    // Left pending if the vector cannot grow, so nothing allocates unguarded.
+    void MergePending() noexcept {
+        std::lock_guard lock(pending_mutex);
+        try {
+            inboxes.reserve(inboxes.size() + pending.size());
+        } catch (const std::bad_alloc&) {
+            return;
+        }
+        inboxes.insert(inboxes.end(), std::make_move_iterator(pending.begin()),
+                       std::make_move_iterator(pending.end()));
+        pending.clear();
+        has_pending.store(false, std::memory_order_relaxed);
+    }
+
+    // Close and free channels whose sender is gone and which are drained.
+    // Only channels the last run emptied are checked, so a busy mailbox
+    // pays nothing; erase() moves handles, it never allocates.
+    void PruneFinished() noexcept {
+        const size_t before = inboxes.size();
+        std::erase_if(inboxes, [](const ActorInbox& inbox) { return inbox.Finished(); });
+        if (inboxes.size() != before) {
+            open_channels.fetch_sub(before - inboxes.size(), std::memory_order_relaxed);
+            next_inbox = inboxes.empty() ? 0 : next_inbox % inboxes.size();
+        }
+    }
+};
+
+// Multi-producer/multi-consumer run queue for actors made runnable off the
+// workers, and for actors that used their whole batch. Sized for every live
+// actor, so Push() cannot fail: an actor is queued in at most one place.
+class InjectionQueue {
+public:
+    explicit InjectionQueue(size_t capacity)
+        : slots_(capacity)
+    {
+    }
+
+    void Push(ActorCell* cell) noexcept {
+        std::lock_guard lock(mutex_);
+        const size_t size = size_.load(std::memory_order_relaxed);
+        slots_[(head_ + size) % slots_.size()] = cell;
+        size_.store(size + 1, std::memory_order_relaxed);
+    }
+
+    ActorCell* Pop() noexcept {
+        if (Empty()) {
+            return nullptr;
+        }
+        std::lock_guard lock(mutex_);
+        const size_t size = size_.load(std::memory_order_relaxed);
+        if (size == 0) {
+            return nullptr;
+        }
+        ActorCell* cell = slots_[head_];
+        head_ = (head_ + 1) % slots_.size();
+        size_.store(size - 1, std::memory_order_relaxed);
+        return cell;
+    }
+
+    // Approximate; exact under the lock
+    [[nodiscard]] bool Empty() const noexcept {
+        return size_.load(std::memory_order_relaxed) == 0;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<ActorCell*> slots_;
+    size_t head_ = 0;
+    std::atomic<size_t> size_{0};
+};
+
+class ActorScheduler {
+public:
+    ActorScheduler(ActorSystem* system, ActorSystemConfig config);
+    ~ActorScheduler() { Shutdown(); }
+
+    ActorScheduler(const ActorScheduler&) = delete;
+    ActorScheduler& operator=(const ActorScheduler&) = delete;
+
+    // Make an idle actor runnable (called by the sender that moved signal off 0)
+    void Schedule(ActorCell* cell) noexcept;
+
+    std::optional<ActorId> Spawn(ActorSystem::Behavior behavior) noexcept;
+    std::optional<ActorRef> Connect(ActorId target, const ChannelConfig& mailbox) noexcept;
+    void Shutdown() noexcept;
+    [[nodiscard]] ActorSystem::Stats GetStats() const noexcept;
+
+    [[nodiscard]] size_t WorkerCount() const noexcept { return workers_.size(); }
+    [[nodiscard]] const ChannelConfig& DefaultMailbox() const noexcept { return config_.mailbox; }
+
+private:
+    // Worker-written counters (relaxed, single writer)
+    struct alignas(CACHE_LINE_SIZE) WorkerCounters {
+        std::atomic<uint64_t> runs{0};
+        std::atomic<uint64_t> messages{0};
+        std::atomic<uint64_t> steals{0};
+        std::atomic<uint64_t> injected{0};
+        std::atomic<uint64_t> yields{0};
+        std::atomic<uint64_t> parks{0};
+    };
+
+    struct Worker {
+        explicit Worker(size_t deque_capacity) : deque(deque_capacity) {}
+
+        ActorScheduler* owner = nullptr;
+        size_t index = 0;
+        WorkStealingDeque<ActorCell> deque;
+        WorkerCounters counters;
+        uint64_t rng = 0;
+        std::thread thread;
+    };
+
+    static constexpr uint32_t kInjectorInterval = 61;  // Check injector first every N ticks
+    static constexpr int kSpinRounds = 64;
+
+    void RunWorker(Worker& worker) noexcept;
+    ActorCell* FindWork(Worker& worker, uint32_t tick) noexcept;
+    ActorCell* Steal(Worker& worker) noexcept;
+    void RunActor(Worker& worker, ActorCell* cell) noexcept;
+    void Retire(ActorCell* cell) noexcept;
+    void WakeOne() noexcept;
+    void Park(Worker& worker) noexcept;
+    [[nodiscard]] bool HasWork() const noexcept;
+    [[nodiscard]] bool OnWorker() const noexcept;
+
+    // Worker running on this thread (nullptr off the workers)
+    static thread_local Worker* tls_worker_;
+
+    ActorSystem* const system_;
+    const ActorSystemConfig config_;
+    const uint64_t serial_;
+    InjectionQueue injector_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    mutable std::mutex registry_mutex_;
+    std::unordered_map<ActorId, std::shared_ptr<ActorCell>> actors_;
+    ActorId next_id_ = 1;
+    std::atomic<size_t> actor_count_{0};
+
+    std::mutex shutdown_mutex_;
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> stop_{false};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> sleepers_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> wake_epoch_{0};
+};
+
+namespace {
+
+std::atomic<uint64_t> g_system_serial{0};
+
+} // namespace
+
+thread_local ActorScheduler::Worker* ActorScheduler::tls_worker_ = nullptr;
+
+ActorScheduler::ActorScheduler(ActorSystem* system, ActorSystemConfig config)
+    : system_(system)
+    , config_{
+          .workers = config.workers ? config.workers : std::max(1u, std::thread::hardware_concurrency()),
+          .worker_cpus = std::move(config.worker_cpus),
+          .batch_size = std::max<size_t>(config.batch_size, 1),
+          .max_actors = std::bit_ceil(std::max<size_t>(config.max_actors, 1)),
+          .mailbox = config.mailbox}
+    , serial_(g_system_serial.fetch_add(1, std::memory_order_relaxed) + 1)
+    , injector_(config_.max_actors)
+{
+    workers_.reserve(config_.workers);
+    for (size_t i = 0; i < config_.workers; ++i) {
+        auto worker = std::make_unique<Worker>(config_.max_actors);
+        worker->owner = this;
+        worker->index = i;
+        worker->rng = 0x9E3779B97F4A7C15ULL * (i + 1);
+        workers_.push_back(std::move(worker));
+    }
+
+    // All deques exist before any worker can try to steal from them
+    try {
+        for (auto& worker : workers_) {
+            worker->thread = std::thread([this, w = worker.get()]() { RunWorker(*w); });
+        }
+    } catch (...) {
+        Shutdown();
+        throw;
+    }
+}
+
+bool ActorScheduler::OnWorker() const noexcept {
+    return tls_worker_ != nullptr && tls_worker_->owner == this;
+}
+
+void ActorScheduler::Schedule(ActorCell* cell) noexcept {
+    if (OnWorker()) {
+        // LIFO slot: the woken actor runs next on this worker, message still in cache
+        if (tls_worker_->deque.Push(cell)) {
+            WakeOne();
+            return;
+        }
+    }
+    injector_.Push(cell);
+    WakeOne();
+}
+
+void ActorScheduler::WakeOne() noexcept {
+    // Pairs with the fence in Park(): either the parking worker sees the
+    // new work, or we see it counted as a sleeper
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) > 0) {
+        wake_epoch_.fetch_add(1, std::memory_order_release);
+        wake_epoch_.notify_one();
+    }
+}
+
+bool ActorScheduler::HasWork() const noexcept {
+    if (!injector_.Empty()) {
+        return true;
+    }
+    return std::any_of(workers_.begin(), workers_.end(),
+                       [](const auto& worker) { return !worker->deque.Empty(); });
+}
+
+void ActorScheduler::Park(Worker& worker) noexcept {
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    const uint32_t epoch = wake_epoch_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!HasWork() && !stop_.load(std::memory_order_acquire)) {
+        detail::AddRelaxed(worker.counters.parks, 1);
+        wake_epoch_.wait(epoch, std::memory_order_acquire);
+    }
+    sleepers_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+ActorCell* ActorScheduler::Steal(Worker& worker) noexcept {
+    const size_t count = workers_.size();
+    if (count < 2) {
+        return nullptr;
+    }
+    const size_t start = NextRandom(worker.rng) % count;
+    for (size_t i = 0; i < count; ++i) {
+        Worker& victim = *workers_[(start + i) % count];
+        if (&victim == &worker) {
+            continue;
+        }
+        if (ActorCell* cell = victim.deque.Steal()) {
+            detail::AddRelaxed(worker.counters.steals, 1);
+            return cell;
+        }
+    }
+    return nullptr;
+}
+
+ActorCell* ActorScheduler::FindWork(Worker& worker, uint32_t tick) noexcept {
+    // Injector first now and then, so yielded actors are not starved by a
+    // worker that keeps waking actors on its own deque
+    if (tick % kInjectorInterval == 0) {
+        if (ActorCell* cell = injector_.Pop()) {
+            detail::AddRelaxed(worker.counters.injected, 1);
+            return cell;
+        }
+    }
+    if (ActorCell* cell = worker.deque.Pop()) {
+        return cell;
+    }
+    if (ActorCell* cell = injector_.Pop()) {
+        detail::AddRelaxed(worker.counters.injected, 1);
+        return cell;
+    }
+    return Steal(worker);
+}
+
+void ActorScheduler::RunWorker(Worker& worker) noexcept {
+    tls_worker_ = &worker;
+    if (!config_.worker_cpus.empty()) {
+        // Best effort: an unusable CPU leaves the worker unpinned
+        (void)PinCurrentThread(config_.worker_cpus[worker.index % config_.worker_cpus.size()]);
+    }
+
+    uint32_t tick = 0;
+    int idle_rounds = 0;
+    while (!stop_.load(std::memory_order_acquire)) {
+        if (ActorCell* cell = FindWork(worker, ++tick)) {
+            RunActor(worker, cell);
+            idle_rounds = 0;
+            continue;
+        }
+        if (++idle_rounds < kSpinRounds) {
+            std::this_thread::yield();
+            continue;
+        }
+        Park(worker);
+        idle_rounds = 0;
+    }
+
+    tls_worker_ = nullptr;
+}
+
+void ActorScheduler::RunActor(Worker& worker, ActorCell* cell) noexcept {
+    const uint64_t seen = cell->signal.load(std::memory_order_acquire);  // Sync with senders
+    if (cell->has_pending.load(std::memory_order_acquire)) {
+        cell->MergePending();
+    }
+
+    // Round-robin over the inbox channels, at most batch_size messages in total
+    const size_t budget = config_.batch_size;
+    const size_t inbox_count = cell->inboxes.size();
+    size_t handled = 0;
+    bool drained_closed = false;  // Some inbox was emptied and its sender is gone
+    for (size_t i = 0; i < inbox_count && handled < budget; ++i) {
+        const size_t index = (cell->next_inbox + i) % inbox_count;
+        auto& inbox = cell->inboxes[index];
+        handled += inbox.consumer.DrainBatch(budget - handled, cell->dispatch);
+        if (handled == budget) {
+            cell->next_inbox = (index + 1) % inbox_count;
+        } else if (!drained_closed) {
+            drained_closed = inbox.Finished();
+        }
+    }
+    if (drained_closed) {
+        cell->PruneFinished();
+    }
+
+    detail::AddRelaxed(worker.counters.runs, 1);
+    detail::AddRelaxed(worker.counters.messages, handled);
+
+    if (cell->stopped.load(std::memory_order_relaxed)) {
+        // Signal is never reset, so senders can no longer schedule it
+        Retire(cell);
+        return;
+    }
+    if (handled == budget) {
+        // Possibly more queued: back of the line, behind the other runnable actors
+        detail::AddRelaxed(worker.counters.yields, 1);
+        injector_.Push(cell);
+        WakeOne();
+        return;
+    }
+
+    uint64_t expected = seen;
+    if (!cell->signal.compare_exchange_strong(expected, 0, std::memory_order_acq_rel,
+                                              std::memory_order_relaxed)) {
+        // Sent to while running: run again (the message may be after our drain)
+        Schedule(cell);
+    }
+}
+
+void ActorScheduler::Retire(ActorCell* cell) noexcept {
+    std::shared_ptr<ActorCell> keep;
+    {
+        std::lock_guard lock(registry_mutex_);
+        auto it = actors_.find(cell->id);
+        if (it != actors_.end()) {
+            keep = std::move(it->second);
+            actors_.erase(it);
+            actor_count_.store(actors_.size(), std::memory_order_relaxed);
+        }
+    }
+    if (keep) {
+        keep->Release();
+    }
+    // Cell goes away with the last ActorRef
+}
+
+std::optional<ActorId> ActorScheduler::Spawn(ActorSystem::Behavior behavior) noexcept {
+    if (!behavior || stop_.load(std::memory_order_acquire)) {
+        return std::nullopt;
+    }
+    std::lock_guard lock(registry_mutex_);
+    if (actors_.size() >= config_.max_actors) {
+        return std::nullopt;
+    }
+    try {
+        const ActorId id = next_id_;
+        auto cell = std::make_shared<ActorCell>(this, system_, id, std::move(behavior));
+        actors_.emplace(id, std::move(cell));
+        ++next_id_;
+        actor_count_.store(actors_.size(), std::memory_order_relaxed);
+        return id;
+    } catch (const std::bad_alloc&) {
+        return std::nullopt;
+    }
+}
+
+std::optional<ActorRef> ActorScheduler::Connect(ActorId target, const ChannelConfig& mailbox) noexcept {
+    std::shared_ptr<ActorCell> cell;
+    {
+        std::lock_guard lock(registry_mutex_);
+        auto it = actors_.find(target);
+        if (it == actors_.end()) {
+            return std::nullopt;
+        }
+        cell = it->second;
+    }
+
+    // Mailboxes are private to the system: the queue is created here, never
+    // registered in (or locked through) the global broker
+    const ChannelConfig normalized = mailbox.Normalize();
+    if (!normalized.IsValid()) {
+        return std::nullopt;
+    }
+
+    try {
+        std::lock_guard lock(cell->pending_mutex);
+        if (cell->stopped.load(std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        cell->pending.reserve(cell->pending.size() + 1);
+        auto queue = std::make_shared<SPSCQueue>(normalized.capacity, normalized.max_message_size,
+                                                 normalized.watermark_percent, normalized.message_deadlines);
+        queue->name = "actor." + std::to_string(serial_) + "." + std::to_string(target) + "." +
+                      std::to_string(cell->channels_opened);
+
+        ProducerHandle producer(queue);
+        ConsumerHandle consumer(queue);
+        cell->pending.push_back(ActorInbox{std::move(queue), std::move(consumer)});
+        ++cell->channels_opened;
+        cell->open_channels.fetch_add(1, std::memory_order_relaxed);
+        // Published before the ref exists, so the run triggered by its first
+        // send sees the new channel
+        cell->has_pending.store(true, std::memory_order_release);
+        return ActorRef(cell, std::move(producer));
+    } catch (const std::bad_alloc&) {
+        return std::nullopt;
+    }
+}
+
+void ActorScheduler::Shutdown() noexcept {
+    if (OnWorker()) {
+        return;
+    }
+    std::lock_guard shutdown_lock(shutdown_mutex_);
+    stop_.store(true, std::memory_order_release);
+    wake_epoch_.fetch_add(1, std::memory_order_release);
+    wake_epoch_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    // Workers are gone; queued actors are simply dropped with the deques
+    std::unordered_map<ActorId, std::shared_ptr<ActorCell>> actors;
+    {
+        std::lock_guard lock(registry_mutex_);
+        actors.swap(actors_);
+        actor_count_.store(0, std::memory_order_relaxed);
+    }
+    // Breaks cycles of actors whose behaviors hold refs to each other
+    for (auto& [id, cell] : actors) {
+        cell->Release();
+    }
+}
+
+ActorSystem::Stats ActorScheduler::GetStats() const noexcept {
+    ActorSystem::Stats stats{};
+    stats.actors = actor_count_.load(std::memory_order_relaxed);
+    for (const auto& worker : workers_) {
+        const auto& counters = worker->counters;
+        stats.runs += counters.runs.load(std::memory_order_relaxed);
+        stats.messages += counters.messages.load(std::memory_order_relaxed);
+        stats.steals += counters.steals.load(std::memory_order_relaxed);
+        stats.injected += counters.injected.load(std::memory_order_relaxed);
+        stats.yields += counters.yields.load(std::memory_order_relaxed);
+        stats.parks += counters.parks.load(std::memory_order_relaxed);
+    }
+    std::lock_guard lock(registry_mutex_);
+    for (const auto& [id, cell] : actors_) {
+        stats.mailboxes += cell->open_channels.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+} // namespace detail
+
+// ============================================================================
+// ActorContext
+// ============================================================================
+
+ActorId ActorContext::Self() const noexcept {
+    return cell_->id;
+}
+
+ActorSystem& ActorContext::System() const noexcept {
+    return *cell_->system;
+}
+
+void ActorContext::Stop() noexcept {
+    cell_->stopped.store(true, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// ActorRef
+// ============================================================================
+
+ActorRef::ActorRef(std::shared_ptr<detail::ActorCell> cell, ProducerHandle producer) noexcept
+    : cell_(std::move(cell))
+    , producer_(std::move(producer))
+{
+}
+
+ActorRef::~ActorRef() = default;
+
+ActorRef::ActorRef(ActorRef&&) noexcept = default;
+
+ActorRef& ActorRef::operator=(ActorRef&& other) noexcept {
+    if (this != &other) {
+        // Producer first, so the old cell never outlives its last producer check
+        producer_ = std::move(other.producer_);
+        cell_ = std::move(other.cell_);
+    }
+    return *this;
+}
+
+PushResult ActorRef::Send(std::span<const uint8_t> data) noexcept {
+    if (!cell_) {
+        return PushResult::ChannelClosed;
+    }
+    const PushResult result = producer_.TryPush(data);
+    if (result == PushResult::Success &&
+        cell_->signal.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        cell_->scheduler->Schedule(cell_.get());
+    }
+    return result;
+}
+
+ActorId ActorRef::Target() const noexcept {
+    return cell_ ? cell_->id : 0;
+}
+
+// ============================================================================
+// ActorSystem
+// ============================================================================
+
+struct ActorSystem::Impl {
+    detail::ActorScheduler scheduler;
+
+    Impl(ActorSystem* system, ActorSystemConfig config)
+        : scheduler(system, std::move(config))
+    {
+    }
+};
+
+ActorSystem::ActorSystem(ActorSystemConfig config)
+    : pimpl_(std::make_unique<Impl>(this, std::move(config)))
+{
+}
+
+ActorSystem::~ActorSystem() {
+    Shutdown();
+}
+
+std::optional<ActorId> ActorSystem::Spawn(Behavior behavior) noexcept {
+    return pimpl_->scheduler.Spawn(std::move(behavior));
+}
+
+std::optional<ActorRef> ActorSystem::Connect(ActorId target) noexcept {
+    return pimpl_->scheduler.Connect(target, pimpl_->scheduler.DefaultMailbox());
+}
+
+std::optional<ActorRef> ActorSystem::Connect(ActorId target, const ChannelConfig& mailbox) noexcept {
+    return pimpl_->scheduler.Connect(target, mailbox);
+}
+
+void ActorSystem::Shutdown() noexcept {
+    pimpl_->scheduler.Shutdown();
+}
+
+size_t ActorSystem::WorkerCount() const noexcept {
+    return pimpl_->scheduler.WorkerCount();
+}
+
+ActorSystem::Stats ActorSystem::GetStats() const noexcept {
+    return pimpl_->scheduler.GetStats();
+}
+
+} // namespace omni
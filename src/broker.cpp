@@ -1,12 +1,102 @@
 #include "omni/mailbox_broker.hpp"
 #include "omni/detail/spsc_queue.hpp"
+#include "omni/detail/queue_helpers.hpp"
+#include "omni/detail/saturation.hpp"
+#include "omni/detail/watermark.hpp"
+#include "omni/detail/trace.hpp"
+#include "omni/detail/flight_recorder.hpp"
+#include "omni/detail/priority_wake.hpp"
+#include "omni/detail/conflation.hpp"
+#include "omni/detail/seqlock.hpp"
 #include <shared_mutex>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 #include <chrono>
 #include <atomic>
+#include <algorithm>
+#include <string>
 
 namespace omni {
 
+namespace {
+
+ChannelPlacement ReadPlacement(const detail::SPSCQueue& queue) noexcept {
+    return ChannelPlacement{
+        .producer_cpu = queue.placement.planned_producer_cpu.load(std::memory_order_relaxed),
+        .consumer_cpu = queue.placement.planned_consumer_cpu.load(std::memory_order_relaxed),
+        .policy = static_cast<PlacementPolicy>(queue.placement.policy.load(std::memory_order_relaxed))
+    };
+}
+
+// Publish a plan; handles read it with relaxed loads in ApplyPlacement()
+void StorePlacement(detail::SPSCQueue& queue, const ChannelPlacement& placement) noexcept {
+    queue.placement.planned_producer_cpu.store(placement.producer_cpu, std::memory_order_relaxed);
+    queue.placement.planned_consumer_cpu.store(placement.consumer_cpu, std::memory_order_relaxed);
+    queue.placement.policy.store(static_cast<uint8_t>(placement.policy), std::memory_order_relaxed);
+}
+
+// Read one channel's shared counters (relaxed loads, never writes queue state)
+MailboxBroker::ChannelStats ReadChannelStats(
+    const std::string& name,
+    const detail::SPSCQueue& queue) noexcept
+{
+    const uint64_t read = queue.read_index.load(std::memory_order_relaxed);
+    const uint64_t write = queue.write_index.load(std::memory_order_relaxed);
+    
+    // Lossy channels use every slot and may be lapped (write - read > capacity);
+    // conflating channels queue at most one ring entry per key; state channels
+    // count versions the consumer has not read yet (at most 2)
+    const size_t depth = queue.stamps
+        ? static_cast<size_t>(write >= read ? std::min<uint64_t>(write - read, queue.capacity) : 0)
+        : detail::AvailableMessages(read, write, queue.capacity);
+    
+    return MailboxBroker::ChannelStats{
+        .name = name,
+        .id = queue.id,
+        .capacity = queue.capacity,
+        .max_message_size = queue.max_message_size,
+        .depth = depth,
+        .messages_sent = queue.producer_stats.messages_sent.load(std::memory_order_relaxed),
+        .bytes_sent = queue.producer_stats.bytes_sent.load(std::memory_order_relaxed),
+        .failed_pushes = queue.producer_stats.failed_pushes.load(std::memory_order_relaxed),
+        .messages_received = queue.consumer_stats.messages_received.load(std::memory_order_relaxed),
+        .bytes_received = queue.consumer_stats.bytes_received.load(std::memory_order_relaxed),
+        .failed_pops = queue.consumer_stats.failed_pops.load(std::memory_order_relaxed),
+        .messages_lost = queue.consumer_stats.messages_lost.load(std::memory_order_relaxed),
+        .messages_expired = queue.consumer_stats.messages_expired.load(std::memory_order_relaxed),
+        .producer_alive = queue.producer_alive.load(std::memory_order_relaxed),
+        .consumer_alive = queue.consumer_alive.load(std::memory_order_relaxed),
+        .saturation = detail::ReadSaturation(queue),
+        .placement = ReadPlacement(queue),
+        .producer_pinned_cpu = queue.placement.pinned_producer_cpu.load(std::memory_order_relaxed),
+        .consumer_pinned_cpu = queue.placement.pinned_consumer_cpu.load(std::memory_order_relaxed)
+    };
+}
+
+// Point a queue's observer binding at the broker observer (nullptr disarms).
+// Observer is published before the thresholds so an armed producer always
+// finds it; disarming clears the thresholds first.
+void ArmWatermarkObserver(
+    detail::SPSCQueue& queue,
+    const WatermarkConfig& config,
+    const std::shared_ptr<const detail::WatermarkObserverFn>& observer) noexcept
+{
+    auto& binding = queue.watermark_observer;
+    if (!observer) {
+        binding.high_slots.store(0, std::memory_order_relaxed);
+        binding.observer.store(nullptr, std::memory_order_release);
+        return;
+    }
+    
+    const auto thresholds = detail::ComputeWatermarkThresholds(queue.capacity, config);
+    binding.observer.store(observer, std::memory_order_release);
+    binding.low_slots.store(thresholds.low_slots, std::memory_order_relaxed);
+    binding.high_slots.store(thresholds.high_slots, std::memory_order_release);
+}
+
+} // namespace
+
 struct MailboxBroker::Impl {
     struct ChannelState {
         std::shared_ptr<detail::SPSCQueue> queue;
@@ -18,6 +108,49 @@ struct MailboxBroker::Impl {
     std::unordered_map<std::string, ChannelState> channels_;
     std::atomic<size_t> total_created_{0};
     std::atomic<size_t> total_destroyed_{0};
+    
+    // Final counts of removed channels (keeps broker totals monotonic)
+    std::atomic<uint64_t> retired_messages_{0};
+    std::atomic<uint64_t> retired_bytes_{0};
+    
+    // Broker-level watermark observer (guarded by registry_mutex_)
+    WatermarkConfig watermark_config_{};
+    std::shared_ptr<const detail::WatermarkObserverFn> watermark_observer_;
+    
+    // CPU topology for PlaceChannel(), detected lazily (guarded by registry_mutex_)
+    std::optional<CpuTopology> topology_;
+    
+    // Create and register a queue for a normalized, valid config.
+    // Caller holds the write lock and has checked the name is free.
+    // Throws std::bad_alloc (nothing is registered then).
+    std::shared_ptr<detail::SPSCQueue> CreateQueue(std::string_view name, const ChannelConfig& normalized,
+                                                   bool message_deadlines = false) {
+        auto queue = std::make_shared<detail::SPSCQueue>(
+            normalized.capacity,
+            normalized.max_message_size,
+            normalized.watermark_percent,
+            message_deadlines
+        );
+        queue->name = std::string(name);
+        if (watermark_observer_) {
+            ArmWatermarkObserver(*queue, watermark_config_, watermark_observer_);
+        }
+        
+        // Store ChannelState in map
+        ChannelState state{
+            .queue = queue,
+            .name = std::string(name),
+            .created_at = std::chrono::steady_clock::now()
+        };
+        
+        channels_.emplace(state.name, std::move(state));
+        
+        // Increment total_created counter (relaxed ordering for stats);
+        // the new count doubles as the channel id carried by trace probes
+        queue->id = total_created_.fetch_add(1, std::memory_order_relaxed) + 1;
+        OMNI_TRACE(channel_create, queue->id, queue->name.c_str(), queue->capacity);
+        return queue;
+    }
 };
 
 // Constructor - Initialize pimpl
@@ -78,22 +211,8 @@ std::pair<ChannelError, std::optional<ChannelPair>> MailboxBroker::RequestChanne
     
     // 5. Try to create queue (catch bad_alloc, return AllocationFailed)
     try {
-        auto queue = std::make_shared<detail::SPSCQueue>(
-            normalized.capacity,
-            normalized.max_message_size
-        );
-        
-        // 6. Store ChannelState in map
-        Impl::ChannelState state{
-            .queue = queue,
-            .name = std::string(name),
-            .created_at = std::chrono::steady_clock::now()
-        };
-        
-        pimpl_->channels_.emplace(state.name, std::move(state));
-        
-        // 7. Increment total_created counter (relaxed ordering for stats)
-        pimpl_->total_created_.fetch_add(1, std::memory_order_relaxed);
+        // 6-7. Register it (map entry, id, observer)
+        auto queue = pimpl_->CreateQueue(name, normalized, normalized.message_deadlines);
         
         // 8. Create ProducerHandle and ConsumerHandle
         // Both handles reference the same queue
@@ -109,6 +228,164 @@ std::pair<ChannelError, std::optional<ChannelPair>> MailboxBroker::RequestChanne
     }
 }
 
+std::pair<ChannelError, std::optional<PriorityChannelPair>> MailboxBroker::RequestPriorityChannel(
+    std::string_view name,
+    const PriorityChannelConfig& config) noexcept
+{
+    const size_t lane_count = config.lanes.size();
+    if (lane_count == 0 || lane_count > MAX_PRIORITY_LANES) {
+        return {ChannelError::InvalidConfig, std::nullopt};
+    }
+    if (!config.weights.empty() &&
+        (config.weights.size() != lane_count ||
+         std::find(config.weights.begin(), config.weights.end(), 0u) != config.weights.end())) {
+        return {ChannelError::InvalidConfig, std::nullopt};
+    }
+    
+    // Lanes registered so far; on any failure the handles are dropped first,
+    // then the lanes unregistered (RemoveChannel refuses live channels)
+    std::vector<std::string> names;
+    std::vector<ProducerHandle> producers;
+    std::vector<ConsumerHandle> consumers;
+    auto roll_back = [&]() noexcept {
+        producers.clear();
+        consumers.clear();
+        for (const auto& created : names) {
+            RemoveChannel(created);
+        }
+    };
+    
+    try {
+        std::vector<uint32_t> weights = config.weights;
+        if (weights.empty()) {
+            for (size_t i = 0; i < lane_count; ++i) {
+                weights.push_back(uint32_t{1} << (lane_count - 1 - i));
+            }
+        }
+        
+        names.reserve(lane_count);
+        producers.reserve(lane_count);
+        consumers.reserve(lane_count);
+        auto wake = std::make_shared<detail::PriorityWake>();
+        
+        for (size_t i = 0; i < lane_count; ++i) {
+            names.push_back(std::string(name) + ".lane" + std::to_string(i));
+            auto [error, lane] = RequestChannel(names.back(), config.lanes[i]);
+            if (error != ChannelError::Success) {
+                names.pop_back();
+                roll_back();
+                return {error, std::nullopt};
+            }
+            producers.push_back(std::move(lane->producer));
+            consumers.push_back(std::move(lane->consumer));
+        }
+        
+        return {ChannelError::Success, PriorityChannelPair{
+            PriorityProducer(std::move(producers), wake),
+            PriorityConsumer(std::move(consumers), config.mode, std::move(weights), wake)
+        }};
+    } catch (const std::bad_alloc&) {
+        // Handles already moved into a half-built pair died during unwinding
+        roll_back();
+        return {ChannelError::AllocationFailed, std::nullopt};
+    }
+}
+
+std::pair<ChannelError, std::optional<LossyChannelPair>> MailboxBroker::RequestLossyChannel(
+    std::string_view name,
+    const ChannelConfig& config) noexcept
+{
+    const ChannelConfig normalized = config.Normalize();
+    if (!normalized.IsValid() || normalized.message_deadlines) {
+        return {ChannelError::InvalidConfig, std::nullopt};
+    }
+    
+    std::unique_lock lock(pimpl_->registry_mutex_);
+    if (pimpl_->channels_.contains(std::string(name))) {
+        return {ChannelError::NameExists, std::nullopt};
+    }
+    
+    try {
+        // Allocate everything first so a failure leaves nothing registered
+        auto stamps = std::make_unique<std::atomic<uint64_t>[]>(normalized.capacity);
+        std::vector<uint8_t> scratch(normalized.max_message_size);
+        auto queue = pimpl_->CreateQueue(name, normalized);
+        queue->stamps = std::move(stamps);  // Before any handle exists
+        
+        return {ChannelError::Success, LossyChannelPair{
+            LossyProducer(queue),
+            LossyConsumer(queue, std::move(scratch))
+        }};
+    } catch (const std::bad_alloc&) {
+        return {ChannelError::AllocationFailed, std::nullopt};
+    }
+}
+
+std::pair<ChannelError, std::optional<ConflatingChannelPair>> MailboxBroker::RequestConflatingChannel(
+    std::string_view name,
+    const ChannelConfig& config) noexcept
+{
+    const ChannelConfig normalized = config.Normalize();
+    if (!normalized.IsValid() || normalized.message_deadlines) {
+        return {ChannelError::InvalidConfig, std::nullopt};
+    }
+    
+    std::unique_lock lock(pimpl_->registry_mutex_);
+    if (pimpl_->channels_.contains(std::string(name))) {
+        return {ChannelError::NameExists, std::nullopt};
+    }
+    
+    try {
+        // Queue slot e holds key entry e's latest value; the ring indices
+        // walk the dirty-key order instead of the slots
+        auto stamps = std::make_unique<std::atomic<uint64_t>[]>(normalized.capacity);
+        auto state = std::make_shared<detail::ConflationState>(normalized.capacity);
+        std::vector<uint32_t> table(2 * normalized.capacity);  // At most half full
+        std::vector<uint64_t> delivered(normalized.capacity);
+        std::vector<uint8_t> scratch(normalized.max_message_size);
+        auto queue = pimpl_->CreateQueue(name, normalized);
+        queue->stamps = std::move(stamps);  // Before any handle exists
+        
+        return {ChannelError::Success, ConflatingChannelPair{
+            ConflatingProducer(queue, state, std::move(table)),
+            ConflatingConsumer(queue, state, std::move(delivered), std::move(scratch))
+        }};
+    } catch (const std::bad_alloc&) {
+        return {ChannelError::AllocationFailed, std::nullopt};
+    }
+}
+
+std::pair<ChannelError, std::optional<StateChannelPair>> MailboxBroker::RequestStateChannel(
+    std::string_view name,
+    const ChannelConfig& config) noexcept
+{
+    ChannelConfig normalized = config.Normalize();
+    if (!normalized.IsValid() || normalized.message_deadlines) {
+        return {ChannelError::InvalidConfig, std::nullopt};
+    }
+    // One value, double buffered: the ring is just the two buffers
+    normalized.capacity = detail::STATE_CHANNEL_SLOTS;
+    
+    std::unique_lock lock(pimpl_->registry_mutex_);
+    if (pimpl_->channels_.contains(std::string(name))) {
+        return {ChannelError::NameExists, std::nullopt};
+    }
+    
+    try {
+        auto stamps = std::make_unique<std::atomic<uint64_t>[]>(normalized.capacity);
+        std::vector<uint8_t> scratch(normalized.max_message_size);
+        auto queue = pimpl_->CreateQueue(name, normalized);
+        queue->stamps = std::move(stamps);  // Before any handle exists
+        
+        return {ChannelError::Success, StateChannelPair{
+            StateProducer(queue),
+            StateConsumer(queue, std::move(scratch))
+        }};
+    } catch (const std::bad_alloc&) {
+        return {ChannelError::AllocationFailed, std::nullopt};
+    }
+}
+
 bool MailboxBroker::HasChannel(std::string_view name) const noexcept {
     // Acquire shared lock (multiple readers allowed)
     std::shared_lock lock(pimpl_->registry_mutex_);
@@ -136,6 +413,13 @@ bool MailboxBroker::RemoveChannel(std::string_view name) noexcept {
         return false;  // Handles still exist
     }
     
+    // Fold final counters into broker totals before the queue goes away
+    const auto& counters = it->second.queue->producer_stats;
+    pimpl_->retired_messages_.fetch_add(
+        counters.messages_sent.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    pimpl_->retired_bytes_.fetch_add(
+        counters.bytes_sent.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    
     // Safe to erase - both handles destroyed
     pimpl_->channels_.erase(it);
     pimpl_->total_destroyed_.fetch_add(1, std::memory_order_relaxed);
@@ -144,29 +428,162 @@ bool MailboxBroker::RemoveChannel(std::string_view name) noexcept {
 }
 
 MailboxBroker::Stats MailboxBroker::GetStats() const noexcept {
-    // Acquire shared lock (multiple readers allowed)
+    // Acquire shared lock (multiple readers allowed, never blocks channel I/O)
     std::shared_lock lock(pimpl_->registry_mutex_);
     
-    // Aggregate stats across all channels
-    size_t total_messages = 0;
-    size_t total_bytes = 0;
+    // Aggregate per-channel counters stored on each queue (relaxed loads)
+    uint64_t total_messages = pimpl_->retired_messages_.load(std::memory_order_relaxed);
+    uint64_t total_bytes = pimpl_->retired_bytes_.load(std::memory_order_relaxed);
     
-    for (const auto& [name, state] : pimpl_->channels_) {
-        // Access producer/consumer statistics from queue
-        // Note: Queue doesn't store stats directly - they're in handles
-        // For broker-level aggregation, we'd need to track this differently
-        // Per spec section 5.2.1, we aggregate from active channels
-        // Since handles own stats, we can only report active channel count
+    for (const auto& entry : pimpl_->channels_) {
+        const auto& counters = entry.second.queue->producer_stats;
+        total_messages += counters.messages_sent.load(std::memory_order_relaxed);
+        total_bytes += counters.bytes_sent.load(std::memory_order_relaxed);
     }
     
     return Stats{
         .active_channels = pimpl_->channels_.size(),
         .total_channels_created = pimpl_->total_created_.load(std::memory_order_relaxed),
-        .total_messages_sent = total_messages,
-        .total_bytes_transferred = total_bytes
+        .total_messages_sent = static_cast<size_t>(total_messages),
+        .total_bytes_transferred = static_cast<size_t>(total_bytes)
     };
 }
 
+std::optional<MailboxBroker::ChannelStats> MailboxBroker::GetChannelStats(
+    std::string_view name) const noexcept
+{
+    // Look up under the read lock, then read counters without holding it
+    std::shared_ptr<detail::SPSCQueue> queue;
+    {
+        std::shared_lock lock(pimpl_->registry_mutex_);
+        auto it = pimpl_->channels_.find(std::string(name));
+        if (it == pimpl_->channels_.end()) {
+            return std::nullopt;
+        }
+        queue = it->second.queue;
+    }
+    
+    return ReadChannelStats(std::string(name), *queue);
+}
+
+void MailboxBroker::ForEachChannelStats(
+    const std::function<void(const ChannelStats&)>& visitor) const
+{
+    // 1. Snapshot queue references under the read lock (shared_ptr keeps them alive)
+    std::vector<std::pair<std::string, std::shared_ptr<detail::SPSCQueue>>> snapshot;
+    {
+        std::shared_lock lock(pimpl_->registry_mutex_);
+        snapshot.reserve(pimpl_->channels_.size());
+        for (const auto& [name, state] : pimpl_->channels_) {
+            snapshot.emplace_back(name, state.queue);
+        }
+    }
+    
+    // 2. Read counters and invoke visitor outside the lock
+    for (const auto& [name, queue] : snapshot) {
+        visitor(ReadChannelStats(name, *queue));
+    }
+}
+
+bool MailboxBroker::SetWatermarkObserver(WatermarkConfig config, WatermarkObserver observer) {
+    if (observer && !config.IsValid()) {
+        return false;
+    }
+    
+    // Allocate outside the lock (may throw)
+    std::shared_ptr<const detail::WatermarkObserverFn> shared;
+    if (observer) {
+        shared = std::make_shared<const detail::WatermarkObserverFn>(std::move(observer));
+    }
+    
+    std::unique_lock lock(pimpl_->registry_mutex_);
+    pimpl_->watermark_config_ = config;
+    pimpl_->watermark_observer_ = shared;
+    for (auto& [name, state] : pimpl_->channels_) {
+        ArmWatermarkObserver(*state.queue, config, shared);
+    }
+    return true;
+}
+
+std::optional<std::vector<FlightEvent>> MailboxBroker::DumpFlightRecorder(std::string_view name) const {
+    std::shared_ptr<detail::SPSCQueue> queue;
+    {
+        std::shared_lock lock(pimpl_->registry_mutex_);
+        auto it = pimpl_->channels_.find(std::string(name));
+        if (it == pimpl_->channels_.end()) {
+            return std::nullopt;
+        }
+        queue = it->second.queue;
+    }
+    
+    std::vector<FlightEvent> events;
+    events.reserve(2 * detail::FLIGHT_RECORDER_EVENTS);
+    detail::ReadFlightRecorder(*queue, events);
+    return events;
+}
+
+void MailboxBroker::SetCpuTopology(CpuTopology topology) noexcept {
+    std::unique_lock lock(pimpl_->registry_mutex_);
+    pimpl_->topology_ = std::move(topology);
+}
+
+std::optional<ChannelPlacement> MailboxBroker::PlaceChannel(std::string_view name, PlacementPolicy policy) {
+    // Detect outside the lock: sysfs reads must not stall channel creation
+    std::optional<CpuTopology> detected;
+    {
+        std::shared_lock lock(pimpl_->registry_mutex_);
+        if (!pimpl_->topology_) {
+            lock.unlock();
+            detected = CpuTopology::Detect();
+        }
+    }
+    
+    std::unique_lock lock(pimpl_->registry_mutex_);
+    if (!pimpl_->topology_) {
+        pimpl_->topology_ = std::move(detected);
+    }
+    
+    auto it = pimpl_->channels_.find(std::string(name));
+    if (it == pimpl_->channels_.end()) {
+        return std::nullopt;
+    }
+    
+    // CPUs planned for every other channel count as load
+    std::vector<int> busy;
+    busy.reserve(2 * pimpl_->channels_.size());
+    for (const auto& [other_name, state] : pimpl_->channels_) {
+        if (state.queue == it->second.queue) {
+            continue;
+        }
+        const ChannelPlacement planned = ReadPlacement(*state.queue);
+        for (int cpu : {planned.producer_cpu, planned.consumer_cpu}) {
+            if (cpu >= 0) {
+                busy.push_back(cpu);
+            }
+        }
+    }
+    
+    auto placement = pimpl_->topology_->Recommend(policy, busy);
+    if (placement) {
+        StorePlacement(*it->second.queue, *placement);
+    }
+    return placement;
+}
+
+bool MailboxBroker::SetChannelPlacement(std::string_view name, const ChannelPlacement& placement) noexcept {
+    if (placement.producer_cpu < -1 || placement.consumer_cpu < -1) {
+        return false;
+    }
+    
+    std::shared_lock lock(pimpl_->registry_mutex_);
+    auto it = pimpl_->channels_.find(std::string(name));
+    if (it == pimpl_->channels_.end()) {
+        return false;
+    }
+    StorePlacement(*it->second.queue, placement);
+    return true;
+}
+
 void MailboxBroker::Shutdown() noexcept {
     // Acquire write lock (exclusive access)
     std::unique_lock lock(pimpl_->registry_mutex_);
@@ -0,0 +1,335 @@
+#include "omni/conflating_channel.hpp"
+#include "omni/detail/spsc_queue.hpp"
+#include "omni/detail/conflation.hpp"
+#include "omni/detail/queue_helpers.hpp"
+#include "omni/detail/seqlock.hpp"
+#include "omni/detail/wait_strategy.hpp"
+#include "omni/detail/trace.hpp"
+#include "omni/detail/flight_recorder.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace omni {
+
+namespace {
+
+// splitmix64 finalizer: sequential keys (instrument ids) spread over the table
+inline uint64_t MixKey(uint64_t key) noexcept {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+} // namespace
+
+// ============================================================================
+// ConflatingProducer
+// ============================================================================
+
+ConflatingProducer::ConflatingProducer(std::shared_ptr<detail::SPSCQueue> queue,
+                                       std::shared_ptr<detail::ConflationState> state,
+                                       std::vector<uint32_t> table) noexcept
+    : queue_(std::move(queue)), state_(std::move(state)), table_(std::move(table)) {
+    queue_->producer_alive.store(true, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_PRODUCER, 1);
+}
+
+ConflatingProducer::~ConflatingProducer() noexcept {
+    if (!queue_) {
+        return;  // Moved-from
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    queue_->producer_alive.store(false, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_PRODUCER, 0);
+    detail::RecordFlight(queue_->producer_flight, FlightEventType::Disconnect,
+                         queue_->write_index.load(std::memory_order_relaxed), 0);
+}
+
+ConflatingProducer::ConflatingProducer(ConflatingProducer&&) noexcept = default;
+
+ConflatingProducer& ConflatingProducer::operator=(ConflatingProducer&& other) noexcept {
+    if (this != &other) {
+        ConflatingProducer closing(std::move(*this));  // Close like the destructor
+        queue_ = std::move(other.queue_);
+        state_ = std::move(other.state_);
+        table_ = std::move(other.table_);
+        entries_ = other.entries_;
+    }
+    return *this;
+}
+
+std::optional<uint32_t> ConflatingProducer::FindOrInsert(uint64_t key) noexcept {
+    // Linear probing in a table twice the key capacity: never more than half full
+    const size_t mask = table_.size() - 1;
+    for (size_t pos = MixKey(key) & mask;; pos = (pos + 1) & mask) {
+        const uint32_t slot = table_[pos];
+        if (slot == 0) {
+            if (entries_ == queue_->capacity) {
+                return std::nullopt;
+            }
+            const uint32_t entry = entries_++;
+            state_->keys[entry] = key;
+            table_[pos] = entry + 1;
+            return entry;
+        }
+        if (state_->keys[slot - 1] == key) {
+            return slot - 1;
+        }
+    }
+}
+
+PushResult ConflatingProducer::TryPush(uint64_t key, std::span<const uint8_t> data) noexcept {
+    if (!queue_) {
+        return PushResult::ChannelClosed;  // Moved-from
+    }
+    auto& queue = *queue_;
+    if (!detail::IsValidMessageSize(data.size(), queue.max_message_size)) {
+        return PushResult::InvalidSize;
+    }
+    if (!queue.consumer_alive.load(std::memory_order_relaxed)) {
+        detail::AddRelaxed(queue.producer_stats.failed_pushes, 1);
+        return PushResult::ChannelClosed;
+    }
+    const auto found = FindOrInsert(key);
+    if (!found) {
+        detail::AddRelaxed(queue.producer_stats.failed_pushes, 1);
+        return PushResult::QueueFull;  // Key table full
+    }
+    const uint32_t entry = *found;
+
+    // Overwrite the key's value in place (seqlock write, see detail/seqlock.hpp)
+    auto& stamp = queue.stamps[entry];
+    const uint64_t version = stamp.load(std::memory_order_relaxed);
+    uint8_t* slot = queue.buffer.get() + static_cast<size_t>(entry) * queue.slot_size;
+    stamp.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const auto size = static_cast<uint32_t>(data.size());
+    detail::SeqlockStore(slot, reinterpret_cast<const uint8_t*>(&size), detail::SIZE_PREFIX_BYTES);
+    detail::SeqlockStore(detail::GetPayloadPointer(slot), data.data(), data.size());
+    stamp.store(version + 2, std::memory_order_release);
+
+    // Pairs with the fence in Take(): either the consumer's read of this key
+    // (after clearing dirty) sees the value above, or this load sees the key
+    // clean and queues it again
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (state_->dirty[entry].load(std::memory_order_acquire) == 0) {
+        state_->dirty[entry].store(1, std::memory_order_relaxed);
+        const uint64_t write = queue.write_index.load(std::memory_order_relaxed);
+        state_->order[detail::GetSlotIndex(write, queue.capacity)].store(entry, std::memory_order_relaxed);
+        queue.write_index.store(write + 1, std::memory_order_release);
+        OMNI_TRACE(publish, queue.id, write, data.size());  // May be skipped by Take(): not a commit
+        detail::RecordFlight(queue.producer_flight, FlightEventType::Push, write, data.size());
+    }
+
+    detail::AddRelaxed(queue.producer_stats.messages_sent, 1);
+    detail::AddRelaxed(queue.producer_stats.bytes_sent, data.size());
+    return PushResult::Success;
+}
+
+bool ConflatingProducer::IsConnected() const noexcept {
+    return queue_ && queue_->consumer_alive.load(std::memory_order_relaxed);
+}
+
+size_t ConflatingProducer::Capacity() const noexcept {
+    return queue_ ? queue_->capacity : 0;
+}
+
+size_t ConflatingProducer::MaxMessageSize() const noexcept {
+    return queue_ ? queue_->max_message_size : 0;
+}
+
+size_t ConflatingProducer::KeyCount() const noexcept {
+    return entries_;
+}
+
+// ============================================================================
+// ConflatingConsumer
+// ============================================================================
+
+ConflatingConsumer::ConflatingConsumer(std::shared_ptr<detail::SPSCQueue> queue,
+                                       std::shared_ptr<detail::ConflationState> state,
+                                       std::vector<uint64_t> delivered, std::vector<uint8_t> scratch) noexcept
+    : queue_(std::move(queue))
+    , state_(std::move(state))
+    , delivered_(std::move(delivered))
+    , scratch_(std::move(scratch)) {
+    queue_->consumer_alive.store(true, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_CONSUMER, 1);
+}
+
+ConflatingConsumer::~ConflatingConsumer() noexcept {
+    if (!queue_) {
+        return;  // Moved-from
+    }
+    queue_->consumer_alive.store(false, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_CONSUMER, 0);
+    detail::RecordFlight(queue_->consumer_flight, FlightEventType::Disconnect,
+                         queue_->read_index.load(std::memory_order_relaxed), 0);
+}
+
+ConflatingConsumer::ConflatingConsumer(ConflatingConsumer&&) noexcept = default;
+
+ConflatingConsumer& ConflatingConsumer::operator=(ConflatingConsumer&& other) noexcept {
+    if (this != &other) {
+        ConflatingConsumer closing(std::move(*this));  // Close like the destructor
+        queue_ = std::move(other.queue_);
+        state_ = std::move(other.state_);
+        delivered_ = std::move(other.delivered_);
+        scratch_ = std::move(other.scratch_);
+    }
+    return *this;
+}
+
+std::optional<uint32_t> ConflatingConsumer::Take(uint64_t read, size_t& size, uint64_t& conflated) noexcept {
+    auto& queue = *queue_;
+    const uint32_t entry = state_->order[detail::GetSlotIndex(read, queue.capacity)].load(std::memory_order_relaxed);
+
+    // Clear first, then read: an update after the clear queues the key again
+    // (see the fence in TryPush)
+    state_->dirty[entry].store(0, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const auto& stamp = queue.stamps[entry];
+    const uint8_t* slot = queue.buffer.get() + static_cast<size_t>(entry) * queue.slot_size;
+    uint64_t version = 0;
+    while (true) {
+        version = stamp.load(std::memory_order_acquire);
+        if ((version & 1) != 0) {
+            // Producer is mid-write: short, but it may have been preempted
+            detail::SpinWaitWithYield([&stamp]() { return (stamp.load(std::memory_order_relaxed) & 1) == 0; });
+            continue;
+        }
+        uint32_t prefix = 0;
+        detail::SeqlockLoad(reinterpret_cast<uint8_t*>(&prefix), slot, detail::SIZE_PREFIX_BYTES);
+        const bool sane = detail::IsValidMessageSize(prefix, queue.max_message_size);  // Torn sizes
+        if (sane) {
+            detail::SeqlockLoad(scratch_.data(), detail::GetPayloadPointer(slot), prefix);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sane && stamp.load(std::memory_order_relaxed) == version) {
+            size = prefix;
+            break;
+        }
+    }
+
+    // Already delivered when the key was last taken (the update raced the clear)
+    if (version == delivered_[entry]) {
+        return std::nullopt;
+    }
+    conflated = (version - delivered_[entry]) / 2 - 1;  // Two stamp steps per update
+    delivered_[entry] = version;
+    return entry;
+}
+
+std::pair<PopResult, std::optional<ConflatingConsumer::Message>> ConflatingConsumer::TryPop() noexcept {
+    if (!queue_) {
+        return {PopResult::ChannelClosed, std::nullopt};  // Moved-from
+    }
+    auto& queue = *queue_;
+    // Acquire: a close seen here means every queued key is visible below
+    const bool producer_alive = queue.producer_alive.load(std::memory_order_acquire);
+    uint64_t read = queue.read_index.load(std::memory_order_relaxed);
+    const uint64_t write = queue.write_index.load(std::memory_order_acquire);
+
+    while (read != write) {
+        size_t size = 0;
+        uint64_t conflated = 0;
+        const auto entry = Take(read, size, conflated);
+        ++read;
+        if (!entry) {
+            continue;
+        }
+        queue.read_index.store(read, std::memory_order_release);
+        OMNI_TRACE(pop, queue.id, read - 1, size);
+        detail::RecordFlight(queue.consumer_flight, FlightEventType::Pop, read - 1, size);
+        detail::AddRelaxed(queue.consumer_stats.messages_received, 1);
+        detail::AddRelaxed(queue.consumer_stats.bytes_received, size);
+        if (conflated > 0) {
+            detail::AddRelaxed(queue.consumer_stats.messages_lost, conflated);
+        }
+        return {PopResult::Success, Message{
+            .key = state_->keys[*entry],
+            .data = std::span<const uint8_t>(scratch_.data(), size),
+            .conflated = conflated
+        }};
+    }
+
+    queue.read_index.store(read, std::memory_order_release);
+    if (!producer_alive) {
+        detail::AddRelaxed(queue.consumer_stats.failed_pops, 1);
+        return {PopResult::ChannelClosed, std::nullopt};
+    }
+    return {PopResult::Empty, std::nullopt};
+}
+
+size_t ConflatingConsumer::DrainBatch(size_t max_count, const BatchHandler& handler) noexcept {
+    if (!queue_ || max_count == 0) {
+        return 0;
+    }
+    auto& queue = *queue_;
+    const uint64_t first = queue.read_index.load(std::memory_order_relaxed);
+    const uint64_t write = queue.write_index.load(std::memory_order_acquire);
+
+    uint64_t read = first;
+    size_t handled = 0;
+    size_t bytes = 0;
+    uint64_t conflated_total = 0;
+    while (read != write && handled < max_count) {
+        size_t size = 0;
+        uint64_t conflated = 0;
+        const auto entry = Take(read, size, conflated);
+        ++read;
+        if (!entry) {
+            continue;
+        }
+        handler(state_->keys[*entry], std::span<const uint8_t>(scratch_.data(), size));
+        ++handled;
+        bytes += size;
+        conflated_total += conflated;
+    }
+    if (read == first) {
+        return 0;
+    }
+
+    queue.read_index.store(read, std::memory_order_release);
+    if (handled > 0) {
+        OMNI_TRACE(batch_pop, queue.id, first, handled, bytes);
+        detail::RecordFlight(queue.consumer_flight, FlightEventType::BatchPop, first, handled);
+        detail::AddRelaxed(queue.consumer_stats.messages_received, handled);
+        detail::AddRelaxed(queue.consumer_stats.bytes_received, bytes);
+        if (conflated_total > 0) {
+            detail::AddRelaxed(queue.consumer_stats.messages_lost, conflated_total);
+        }
+    }
+    return handled;
+}
+
+bool ConflatingConsumer::IsConnected() const noexcept {
+    return queue_ && queue_->producer_alive.load(std::memory_order_relaxed);
+}
+
+size_t ConflatingConsumer::Capacity() const noexcept {
+    return queue_ ? queue_->capacity : 0;
+}
+
+size_t ConflatingConsumer::MaxMessageSize() const noexcept {
+    return queue_ ? queue_->max_message_size : 0;
+}
+
+size_t ConflatingConsumer::DirtyKeys() const noexcept {
+    if (!queue_) {
+        return 0;
+    }
+    const uint64_t read = queue_->read_index.load(std::memory_order_relaxed);
+    const uint64_t write = queue_->write_index.load(std::memory_order_relaxed);
+    return static_cast<size_t>(std::min<uint64_t>(write - read, queue_->capacity));
+}
+
+uint64_t ConflatingConsumer::ConflatedMessages() const noexcept {
+    return queue_ ? queue_->consumer_stats.messages_lost.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace omni
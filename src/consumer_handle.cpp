@@ -1,7 +1,11 @@
 #include "omni/consumer_handle.hpp"
+#include "omni/placement.hpp"
 #include "omni/detail/spsc_queue.hpp"
 #include "omni/detail/queue_helpers.hpp"
 #include "omni/detail/wait_strategy.hpp"
+#include "omni/detail/trace.hpp"
+#include "omni/detail/flight_recorder.hpp"
+#include <algorithm>
 #include <atomic>
 #include <optional>
 #include <vector>
@@ -15,20 +19,95 @@ struct ConsumerHandle::Impl {
     // Queue reference
     std::shared_ptr<detail::SPSCQueue> queue;
     
-    // Statistics (relaxed atomics)
-    Stats statistics;
-    
     // Message buffer for zero-copy span lifetime
     std::vector<uint8_t> message_buffer;
     
+    // Pop latency trigger (consumer thread only); dump buffer reserved up front
+    std::chrono::nanoseconds latency_threshold{0};
+    FlightRecorderCallback latency_callback;
+    std::vector<FlightEvent> flight_buffer;
+    
+    // Message deadlines (ChannelConfig::message_deadlines): messages below
+    // this index were returned by Peek() and are delivered even if they
+    // expire before the pop
+    uint64_t live_until = 0;
+    
     // Constructor: Initialize with queue and signal consumer alive
     explicit Impl(std::shared_ptr<detail::SPSCQueue> q)
         : queue(std::move(q))
-        , statistics{0, 0, 0}
         , message_buffer()
     {
         // Signal consumer is alive (release semantics for visibility)
         queue->consumer_alive.store(true, std::memory_order_release);
+        OMNI_TRACE(liveness, queue->id, detail::TRACE_SIDE_CONSUMER, 1);
+    }
+    
+    void record_flight(FlightEventType type, uint64_t value = 0) noexcept {
+        detail::RecordFlight(queue->consumer_flight, type,
+                             queue->read_index.load(std::memory_order_relaxed), value);
+    }
+    
+    // True if message `index` carries a deadline that has passed. `now` is 0
+    // until needed, so the clock is read at most once per pop or batch.
+    bool expired(uint64_t index, const uint8_t* slot, uint64_t& now) const noexcept {
+        if (queue->deadline_bytes == 0 || index < live_until) {
+            return false;
+        }
+        const uint64_t deadline = detail::ReadDeadline(slot);
+        if (deadline == detail::NO_DEADLINE) {
+            return false;
+        }
+        if (now == 0) {
+            now = detail::DeadlineNowNs();
+        }
+        return deadline <= now;
+    }
+    
+    // First message in [read, write) that has not expired (write if none)
+    uint64_t skip_expired(uint64_t read, uint64_t write) const noexcept {
+        uint64_t now = 0;
+        while (read != write &&
+               expired(read, detail::GetSlotPointer(queue->slots, read, queue->capacity, queue->slot_size), now)) {
+            ++read;
+        }
+        return read;
+    }
+    
+    // Hand the expired run [read, live) back to the producer in one store
+    void release_expired(uint64_t read, uint64_t live) noexcept {
+        queue->read_index.store(live, std::memory_order_release);
+        queue->read_index.notify_one();
+        detail::AddRelaxed(queue->consumer_stats.messages_expired, live - read);
+        trace_run(true, read, live - read, 0);
+    }
+    
+    // Trace one contiguous run of a batch: `count` messages from `first`,
+    // either delivered (`bytes` in total) or dropped as expired
+    void trace_run(bool run_expired, uint64_t first, uint64_t count, size_t bytes) const noexcept {
+        if (count == 0) {
+            return;
+        }
+        if (run_expired) {
+            OMNI_TRACE(expire, queue->id, first, count);
+            detail::RecordFlight(queue->consumer_flight, FlightEventType::Expire, first, count);
+        } else {
+            OMNI_TRACE(batch_pop, queue->id, first, count, bytes);
+            detail::RecordFlight(queue->consumer_flight, FlightEventType::BatchPop, first, count);
+        }
+    }
+    
+    // A waiting pop succeeded: record Wake and fire the latency trigger if armed
+    void on_wake(std::chrono::steady_clock::time_point start) noexcept {
+        record_flight(FlightEventType::Wake);
+        if (!latency_callback) {
+            return;
+        }
+        const auto latency = std::chrono::steady_clock::now() - start;
+        if (latency > latency_threshold) {
+            detail::ReadFlightRecorder(*queue, flight_buffer);
+            latency_callback(std::chrono::duration_cast<std::chrono::nanoseconds>(latency),
+                             std::span<const FlightEvent>(flight_buffer));
+        }
     }
 };
 
@@ -66,14 +145,23 @@ std::pair<PopResult, std::optional<ConsumerHandle::Message>> ConsumerHandle::Try
     const bool producer_alive = pimpl_->queue->producer_alive.load(std::memory_order_relaxed);
     
     // 2. Load read_index (relaxed - own index) and write_index (acquire - remote index)
-    const uint64_t read = pimpl_->queue->read_index.load(std::memory_order_relaxed);
+    uint64_t read = pimpl_->queue->read_index.load(std::memory_order_relaxed);
     const uint64_t write = pimpl_->queue->write_index.load(std::memory_order_acquire);  // Sync with producer
     
+    // Drop expired messages at the head without surfacing them
+    if (pimpl_->queue->deadline_bytes != 0) {
+        const uint64_t live = pimpl_->skip_expired(read, write);
+        if (live != read) {
+            pimpl_->release_expired(read, live);
+            read = live;
+        }
+    }
+    
     // 3. Check if data available using utility function
     if (detail::IsQueueEmpty(read, write, pimpl_->queue->capacity)) {
         // If producer is dead and queue is empty, channel is closed
         if (!producer_alive) {
-            pimpl_->statistics.failed_pops++;
+            detail::AddRelaxed(pimpl_->queue->consumer_stats.failed_pops, 1);
             return {PopResult::ChannelClosed, std::nullopt};
         }
         // Otherwise, just empty
@@ -82,7 +170,7 @@ std::pair<PopResult, std::optional<ConsumerHandle::Message>> ConsumerHandle::Try
     
     // 4. Calculate slot pointer using utility function
     uint8_t* slot = detail::GetSlotPointer(
-        pimpl_->queue->buffer.get(),
+        pimpl_->queue->slots,
         read,
         pimpl_->queue->capacity,
         pimpl_->queue->slot_size);
@@ -98,18 +186,88 @@ std::pair<PopResult, std::optional<ConsumerHandle::Message>> ConsumerHandle::Try
     
     // 8. Store read_index + 1 (release) - ensures consumer has finished reading
     pimpl_->queue->read_index.store(read + 1, std::memory_order_release);
+    OMNI_TRACE(pop, pimpl_->queue->id, read, message_size);
+    detail::RecordFlight(pimpl_->queue->consumer_flight, FlightEventType::Pop, read, message_size);
     
     // 9. Call notify_one() on read_index to wake blocked producer
     pimpl_->queue->read_index.notify_one();
     
-    // 10. Update statistics (relaxed)
-    pimpl_->statistics.messages_received++;
-    pimpl_->statistics.bytes_received += message_size;
+    // 10. Update statistics (relaxed, consumer-owned cache line)
+    detail::AddRelaxed(pimpl_->queue->consumer_stats.messages_received, 1);
+    detail::AddRelaxed(pimpl_->queue->consumer_stats.bytes_received, message_size);
     
     // 11. Return success with message view
     return {PopResult::Success, Message{message_span}};
 }
 
+bool ConsumerHandle::SetPopLatencyTrigger(
+    std::chrono::nanoseconds threshold,
+    FlightRecorderCallback callback) noexcept
+{
+    if (threshold.count() <= 0 || !callback) {
+        return false;
+    }
+    
+    try {
+        pimpl_->flight_buffer.reserve(2 * detail::FLIGHT_RECORDER_EVENTS);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+    (void)detail::FlightNsPerTick();  // Calibrate now, not on the first trigger
+    
+    pimpl_->latency_threshold = threshold;
+    pimpl_->latency_callback = std::move(callback);
+    return true;
+}
+
+void ConsumerHandle::ClearPopLatencyTrigger() noexcept {
+    pimpl_->latency_callback = nullptr;
+}
+
+std::vector<FlightEvent> ConsumerHandle::DumpFlightRecorder() const {
+    std::vector<FlightEvent> events;
+    events.reserve(2 * detail::FLIGHT_RECORDER_EVENTS);
+    detail::ReadFlightRecorder(*pimpl_->queue, events);
+    return events;
+}
+
+bool ConsumerHandle::ApplyPlacement() noexcept {
+    auto& placement = pimpl_->queue->placement;
+    const int cpu = placement.planned_consumer_cpu.load(std::memory_order_relaxed);
+    if (cpu < 0 || !PinCurrentThread(cpu)) {
+        return false;
+    }
+    placement.pinned_consumer_cpu.store(cpu, std::memory_order_relaxed);
+    return true;
+}
+
+bool ConsumerHandle::BindReadySignal(std::atomic<uint64_t>* word, uint64_t mask,
+                                     std::shared_ptr<const void> owner) noexcept {
+    auto& binding = pimpl_->queue->ready_signal;
+    if (word == nullptr) {
+        binding.word.store(nullptr, std::memory_order_release);
+        return true;
+    }
+    try {
+        if (std::find(binding.owners.begin(), binding.owners.end(), owner) == binding.owners.end()) {
+            binding.owners.push_back(std::move(owner));
+        }
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+    binding.mask.store(mask, std::memory_order_relaxed);
+    binding.word.store(word, std::memory_order_release);
+    binding.generation.store(binding.generation.load(std::memory_order_relaxed) + 1,
+                             std::memory_order_release);
+    return true;
+}
+
+bool ConsumerHandle::ReadySignalAcknowledged() const noexcept {
+    const auto& binding = pimpl_->queue->ready_signal;
+    return binding.acknowledged.load(std::memory_order_acquire) ==
+           binding.generation.load(std::memory_order_relaxed);
+}
+
 bool ConsumerHandle::IsConnected() const noexcept {
     return pimpl_->queue->producer_alive.load(std::memory_order_relaxed);
 }
@@ -131,12 +289,21 @@ size_t ConsumerHandle::AvailableMessages() const noexcept {
 ChannelConfig ConsumerHandle::GetConfig() const noexcept {
     return ChannelConfig{
         .capacity = pimpl_->queue->capacity,
-        .max_message_size = pimpl_->queue->max_message_size
+        .max_message_size = pimpl_->queue->max_message_size,
+        .watermark_percent = pimpl_->queue->watermark_percent,
+        .message_deadlines = pimpl_->queue->deadline_bytes != 0
     };
 }
 
 ConsumerHandle::Stats ConsumerHandle::GetStats() const noexcept {
-    return pimpl_->statistics;
+    // Counters live on the shared queue so the broker can aggregate them
+    const auto& counters = pimpl_->queue->consumer_stats;
+    return Stats{
+        .messages_received = counters.messages_received.load(std::memory_order_relaxed),
+        .bytes_received = counters.bytes_received.load(std::memory_order_relaxed),
+        .failed_pops = counters.failed_pops.load(std::memory_order_relaxed),
+        .messages_expired = counters.messages_expired.load(std::memory_order_relaxed)
+    };
 }
 
 ConsumerHandle::~ConsumerHandle() noexcept {
@@ -144,6 +311,8 @@ ConsumerHandle::~ConsumerHandle() noexcept {
         // CRITICAL: Destruction barrier (seq_cst fence before signaling death)
         std::atomic_thread_fence(std::memory_order_seq_cst);
         pimpl_->queue->consumer_alive.store(false, std::memory_order_release);
+        OMNI_TRACE(liveness, pimpl_->queue->id, detail::TRACE_SIDE_CONSUMER, 0);
+        pimpl_->record_flight(FlightEventType::Disconnect);
         pimpl_->queue->read_index.notify_one();  // Wake blocked producer
     }
 }
@@ -153,7 +322,8 @@ ConsumerHandle& ConsumerHandle::operator=(ConsumerHandle&&) noexcept = default;
 
 std::pair<PopResult, std::optional<ConsumerHandle::Message>> ConsumerHandle::BlockingPop(
     std::chrono::milliseconds timeout) noexcept {
-    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + timeout;
     
     // Fast path: Try immediate pop first
     auto [result, msg] = TryPop();
@@ -161,6 +331,9 @@ std::pair<PopResult, std::optional<ConsumerHandle::Message>> ConsumerHandle::Blo
         return {result, std::move(msg)};
     }
     
+    // Slow path: record one Park/Wake pair per call in the flight recorder
+    pimpl_->record_flight(FlightEventType::Park);
+    
     // For infinite timeout, use pure atomic::wait (best performance)
     if (timeout == std::chrono::milliseconds::max()) {
         while (true) {
@@ -170,6 +343,9 @@ std::pair<PopResult, std::optional<ConsumerHandle::Message>> ConsumerHandle::Blo
             if (current_write != current_read) {
                 // Data arrived, retry pop
                 auto [r, m] = TryPop();
+                if (r == PopResult::Success) {
+                    pimpl_->on_wake(start);
+                }
                 if (r == PopResult::Success || r == PopResult::ChannelClosed) {
                     return {r, std::move(m)};
                 }
@@ -178,12 +354,15 @@ std::pair<PopResult, std::optional<ConsumerHandle::Message>> ConsumerHandle::Blo
             
             // Check if producer died while we were waiting
             if (!pimpl_->queue->producer_alive.load(std::memory_order_relaxed)) {
-                pimpl_->statistics.failed_pops++;
+                detail::AddRelaxed(pimpl_->queue->consumer_stats.failed_pops, 1);
                 return {PopResult::ChannelClosed, std::nullopt};
             }
             
             // Wait for write_index to change (zero overhead, lock-free)
+            OMNI_TRACE(consumer_park, pimpl_->queue->id, current_read, current_write);
             pimpl_->queue->write_index.wait(current_write, std::memory_order_acquire);
+            OMNI_TRACE(consumer_wake, pimpl_->queue->id,
+                       pimpl_->queue->write_index.load(std::memory_order_relaxed));
         }
     }
     
@@ -191,6 +370,9 @@ std::pair<PopResult, std::optional<ConsumerHandle::Message>> ConsumerHandle::Blo
     while (true) {
         // Try pop again
         auto [r, m] = TryPop();
+        if (r == PopResult::Success) {
+            pimpl_->on_wake(start);
+        }
         if (r == PopResult::Success || r == PopResult::ChannelClosed) {
             return {r, std::move(m)};
         }
@@ -198,18 +380,97 @@ std::pair<PopResult, std::optional<ConsumerHandle::Message>> ConsumerHandle::Blo
         // Check timeout
         const auto now = std::chrono::steady_clock::now();
         if (now >= deadline) {
-            pimpl_->statistics.failed_pops++;
+            detail::AddRelaxed(pimpl_->queue->consumer_stats.failed_pops, 1);
+            pimpl_->record_flight(FlightEventType::Timeout);
             return {PopResult::Timeout, std::nullopt};
         }
         
         // Use optimized spin-wait utility (spin ~1-2us, then yield)
+        OMNI_TRACE(consumer_park, pimpl_->queue->id,
+                   pimpl_->queue->read_index.load(std::memory_order_relaxed),
+                   pimpl_->queue->write_index.load(std::memory_order_relaxed));
         detail::SpinWaitWithYield([this]() {
             // Check if data arrived during spin
             const uint64_t read = pimpl_->queue->read_index.load(std::memory_order_relaxed);
             const uint64_t write = pimpl_->queue->write_index.load(std::memory_order_acquire);
             return !detail::IsQueueEmpty(read, write, pimpl_->queue->capacity);
         });
+        OMNI_TRACE(consumer_wake, pimpl_->queue->id,
+                   pimpl_->queue->write_index.load(std::memory_order_relaxed));
+    }
+}
+
+std::optional<std::span<const uint8_t>> ConsumerHandle::Peek() noexcept {
+    const auto& queue = *pimpl_->queue;
+    uint64_t read = queue.read_index.load(std::memory_order_relaxed);
+    const uint64_t write = queue.write_index.load(std::memory_order_acquire);  // Sync with producer
+    if (queue.deadline_bytes != 0) {
+        const uint64_t live = pimpl_->skip_expired(read, write);
+        if (live != read) {
+            pimpl_->release_expired(read, live);
+            read = live;
+        }
+    }
+    if (detail::IsQueueEmpty(read, write, queue.capacity)) {
+        return std::nullopt;
     }
+    pimpl_->live_until = read + 1;  // The next pop returns what Peek() showed, expired or not
+    const uint8_t* slot = detail::GetSlotPointer(queue.slots, read, queue.capacity, queue.slot_size);
+    return std::span<const uint8_t>(detail::GetPayloadPointer(slot), detail::ReadSizePrefix(slot));
+}
+
+size_t ConsumerHandle::DrainBatch(size_t max_count, const BatchHandler& handler) noexcept {
+    auto& queue = *pimpl_->queue;
+    const uint64_t read = queue.read_index.load(std::memory_order_relaxed);
+    const uint64_t write = queue.write_index.load(std::memory_order_acquire);  // Sync with producer
+    const uint64_t available = detail::AvailableMessages(read, write, queue.capacity);
+    if (available == 0 || max_count == 0) {
+        return 0;
+    }
+    
+    // Slots stay owned by the consumer until the single release store below;
+    // expired messages are skipped inside the batch and released with it
+    size_t count = 0;
+    size_t batch_bytes = 0;
+    uint64_t expired = 0;
+    uint64_t now = 0;
+    uint64_t index = read;
+    uint64_t run_start = read;  // Current run of delivered (or expired) messages
+    size_t run_bytes = 0;
+    bool run_expired = false;
+    for (; index < read + available && count < max_count; ++index) {
+        const uint8_t* slot = detail::GetSlotPointer(queue.slots, index, queue.capacity, queue.slot_size);
+        const bool is_expired = pimpl_->expired(index, slot, now);
+        if (is_expired != run_expired) {
+            pimpl_->trace_run(run_expired, run_start, index - run_start, run_bytes);
+            run_start = index;
+            run_bytes = 0;
+            run_expired = is_expired;
+        }
+        if (is_expired) {
+            ++expired;
+            continue;
+        }
+        const size_t message_size = detail::ReadSizePrefix(slot);
+        handler(std::span<const uint8_t>(detail::GetPayloadPointer(slot), message_size));
+        run_bytes += message_size;
+        batch_bytes += message_size;
+        ++count;
+    }
+    
+    queue.read_index.store(index, std::memory_order_release);
+    queue.read_index.notify_one();
+    pimpl_->trace_run(run_expired, run_start, index - run_start, run_bytes);
+    if (expired != 0) {
+        detail::AddRelaxed(queue.consumer_stats.messages_expired, expired);
+    }
+    if (count == 0) {
+        return 0;
+    }
+    
+    detail::AddRelaxed(queue.consumer_stats.messages_received, count);
+    detail::AddRelaxed(queue.consumer_stats.bytes_received, batch_bytes);
+    return count;
 }
 
 std::pair<PopResult, std::vector<ConsumerHandle::Message>> ConsumerHandle::BatchPop(
@@ -226,11 +487,18 @@ std::pair<PopResult, std::vector<ConsumerHandle::Message>> ConsumerHandle::Batch
     // Check producer alive (relaxed)
     bool producer_alive = pimpl_->queue->producer_alive.load(std::memory_order_relaxed);
     
+    // Messages obtained via BlockingPop are counted there, not in the batch totals
+    size_t waited_count = 0;
+    size_t batch_bytes = 0;
+    uint64_t expired = 0;
+    uint64_t now = 0;  // Deadline clock, read once for the batch
+    
     // If timeout specified, wait for first message
     if (timeout.count() > 0) {
         auto [result, msg] = BlockingPop(timeout);
         if (result == PopResult::Success) {
             messages.push_back(std::move(msg.value()));
+            waited_count = 1;
         } else {
             return {result, std::move(messages)};  // Timeout or ChannelClosed
         }
@@ -239,7 +507,11 @@ std::pair<PopResult, std::vector<ConsumerHandle::Message>> ConsumerHandle::Batch
         producer_alive = pimpl_->queue->producer_alive.load(std::memory_order_relaxed);
     }
     
-    // Consume as many messages as available up to max_count
+    // Consume as many messages as available up to max_count, tracing each
+    // contiguous run of delivered (or expired) messages
+    uint64_t run_start = pimpl_->queue->read_index.load(std::memory_order_relaxed);
+    size_t run_bytes = 0;
+    bool run_expired = false;
     while (messages.size() < max_count) {
         // Load read_index (relaxed - own index) and write_index (acquire - remote index)
         const uint64_t read = pimpl_->queue->read_index.load(std::memory_order_relaxed);
@@ -252,11 +524,26 @@ std::pair<PopResult, std::vector<ConsumerHandle::Message>> ConsumerHandle::Batch
         
         // Calculate slot pointer
         uint8_t* slot = detail::GetSlotPointer(
-            pimpl_->queue->buffer.get(),
+            pimpl_->queue->slots,
             read,
             pimpl_->queue->capacity,
             pimpl_->queue->slot_size);
         
+        const bool is_expired = pimpl_->expired(read, slot, now);
+        if (is_expired != run_expired) {
+            pimpl_->trace_run(run_expired, run_start, read - run_start, run_bytes);
+            run_start = read;
+            run_bytes = 0;
+            run_expired = is_expired;
+        }
+        
+        // Expired: release the slot without surfacing the message
+        if (is_expired) {
+            pimpl_->queue->read_index.store(read + 1, std::memory_order_release);
+            ++expired;
+            continue;
+        }
+        
         // Read size prefix and get payload pointer
         const size_t message_size = detail::ReadSizePrefix(slot);
         const uint8_t* payload = detail::GetPayloadPointer(slot);
@@ -268,20 +555,33 @@ std::pair<PopResult, std::vector<ConsumerHandle::Message>> ConsumerHandle::Batch
         // Update read_index (release) - publishes that slot is consumed
         pimpl_->queue->read_index.store(read + 1, std::memory_order_release);
         
-        // Update statistics (relaxed)
-        pimpl_->statistics.messages_received++;
-        pimpl_->statistics.bytes_received += message_size;
+        run_bytes += message_size;
+        batch_bytes += message_size;
+    }
+    pimpl_->trace_run(run_expired, run_start,
+                      pimpl_->queue->read_index.load(std::memory_order_relaxed) - run_start, run_bytes);
+    
+    if (expired != 0) {
+        detail::AddRelaxed(pimpl_->queue->consumer_stats.messages_expired, expired);
+        if (messages.empty()) {
+            pimpl_->queue->read_index.notify_one();  // Slots freed, nothing returned
+        }
     }
     
     // CRITICAL: Single notify for entire batch (amortizes atomic overhead)
     if (!messages.empty()) {
         pimpl_->queue->read_index.notify_one();
+        
+        // Update statistics once per batch (relaxed, consumer-owned cache line).
+        // A message obtained through BlockingPop above was already counted there.
+        detail::AddRelaxed(pimpl_->queue->consumer_stats.messages_received, messages.size() - waited_count);
+        detail::AddRelaxed(pimpl_->queue->consumer_stats.bytes_received, batch_bytes);
         return {PopResult::Success, std::move(messages)};
     }
     
     // No messages and producer dead
     if (!producer_alive) {
-        pimpl_->statistics.failed_pops++;
+        detail::AddRelaxed(pimpl_->queue->consumer_stats.failed_pops, 1);
         return {PopResult::ChannelClosed, std::move(messages)};
     }
     
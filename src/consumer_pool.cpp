@@ -0,0 +1,274 @@
+#include "omni/consumer_pool.hpp"
+#include "omni/placement.hpp"
+#include "omni/detail/published_entries.hpp"
+#include "omni/detail/spsc_queue.hpp"
+#include "omni/detail/work_stealing_deque.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace omni {
+
+struct ConsumerPool::Impl {
+    struct Entry {
+        Entry(ChannelId channel_id, ConsumerHandle&& handle, Handler&& callback)
+            : id(channel_id), consumer(std::move(handle)), handler(std::move(callback)) {}
+
+        ChannelId id;
+        ConsumerHandle consumer;
+        Handler handler;
+
+        // Set by the scan that queues the channel, cleared after its drain:
+        // whoever holds it is the only thread touching the consumer
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<bool> ready{false};
+    };
+
+    // Worker-written counters (relaxed, single writer)
+    struct alignas(detail::CACHE_LINE_SIZE) WorkerCounters {
+        std::atomic<uint64_t> passes{0};
+        std::atomic<uint64_t> idle_passes{0};
+        std::atomic<uint64_t> drains{0};
+        std::atomic<uint64_t> messages{0};
+        std::atomic<uint64_t> steals{0};
+    };
+
+    struct Worker {
+        explicit Worker(size_t deque_capacity) : deque(deque_capacity) {}
+
+        Impl* owner = nullptr;
+        size_t index = 0;
+        detail::WorkStealingDeque<Entry> deque;    // Ready channels
+        WorkerCounters counters;
+        detail::PublishedEntries<Entry>::Reader reader;
+        uint64_t rng = 0;
+        std::thread thread;
+    };
+
+    static constexpr int kSpinPasses = 64;  // Idle passes before yielding between passes
+
+    // Worker running on this thread (nullptr off the workers)
+    static thread_local Worker* tls_worker_;
+
+    const ConsumerPoolConfig config_;
+
+    // Writer side: AddChannel/RemoveChannel/Shutdown (never taken by workers)
+    std::mutex writer_mutex_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // Published channel array; every worker is a reader
+    detail::PublishedEntries<Entry> channels_;
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> running_{false};
+
+    explicit Impl(ConsumerPoolConfig config)
+        : config_{
+              .workers = config.workers ? config.workers : std::max(1u, std::thread::hardware_concurrency()),
+              .worker_cpus = std::move(config.worker_cpus),
+              .batch_size = std::max<size_t>(config.batch_size, 1),
+              .max_channels = std::bit_ceil(std::max<size_t>(config.max_channels, 1))}
+    {
+    }
+
+    [[nodiscard]] bool OnWorker() const noexcept {
+        return tls_worker_ != nullptr && tls_worker_->owner == this;
+    }
+
+    size_t Drain(Worker& worker, Entry* entry) noexcept {
+        const size_t handled = entry->consumer.DrainBatch(config_.batch_size, entry->handler);
+        entry->ready.store(false, std::memory_order_release);  // Hand the consumer back
+        detail::AddRelaxed(worker.counters.drains, 1);
+        return handled;
+    }
+
+    Entry* Steal(Worker& worker) noexcept;
+    void Run(Worker& worker) noexcept;
+    void StopWorkers() noexcept;
+};
+
+thread_local ConsumerPool::Impl::Worker* ConsumerPool::Impl::tls_worker_ = nullptr;
+
+ConsumerPool::Impl::Entry* ConsumerPool::Impl::Steal(Worker& worker) noexcept {
+    const size_t count = workers_.size();
+    if (count < 2) {
+        return nullptr;
+    }
+    const size_t start = detail::NextRandom(worker.rng) % count;
+    for (size_t i = 0; i < count; ++i) {
+        Worker& victim = *workers_[(start + i) % count];
+        if (&victim == &worker) {
+            continue;
+        }
+        if (Entry* entry = victim.deque.Steal()) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+void ConsumerPool::Impl::Run(Worker& worker) noexcept {
+    tls_worker_ = &worker;
+    if (!config_.worker_cpus.empty()) {
+        // Best effort: an unusable CPU leaves the worker unpinned
+        (void)PinCurrentThread(config_.worker_cpus[worker.index % config_.worker_cpus.size()]);
+    }
+
+    const size_t stride = workers_.size();
+    int idle_streak = 0;
+    while (!stop_.load(std::memory_order_relaxed)) {
+        // Queue home channels that have messages and are not already queued
+        const auto& entries = channels_.Acquire(worker.reader).entries;
+        for (size_t i = worker.index; i < entries.size(); i += stride) {
+            Entry* entry = entries[i];
+            if (entry->ready.load(std::memory_order_relaxed) || entry->consumer.AvailableMessages() == 0) {
+                continue;
+            }
+            if (!entry->ready.exchange(true, std::memory_order_acquire)) {
+                // Cannot fail: the deque holds max_channels and each channel is queued once
+                (void)worker.deque.Push(entry);
+            }
+        }
+
+        // Own ready channels, newest first; meanwhile idle workers take the oldest
+        uint64_t handled = 0;
+        while (Entry* entry = worker.deque.Pop()) {
+            handled += Drain(worker, entry);
+        }
+        if (handled == 0) {
+            // Bounded, so home channels are rescanned soon
+            for (size_t stolen = 0; stolen < stride; ++stolen) {
+                Entry* entry = Steal(worker);
+                if (entry == nullptr) {
+                    break;
+                }
+                handled += Drain(worker, entry);
+                detail::AddRelaxed(worker.counters.steals, 1);
+            }
+        }
+
+        detail::AddRelaxed(worker.counters.passes, 1);
+        if (handled == 0) {
+            detail::AddRelaxed(worker.counters.idle_passes, 1);
+            if (++idle_streak >= kSpinPasses) {
+                std::this_thread::yield();
+            }
+        } else {
+            detail::AddRelaxed(worker.counters.messages, handled);
+            idle_streak = 0;
+        }
+    }
+
+    tls_worker_ = nullptr;
+}
+
+// PRECONDITION: writer_mutex_ held
+void ConsumerPool::Impl::StopWorkers() noexcept {
+    stop_.store(true, std::memory_order_relaxed);
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    // Every pass ends with its own deque empty and its drains done, so no
+    // ready flag is left set
+    running_.store(false, std::memory_order_relaxed);
+}
+
+ConsumerPool::ConsumerPool(ConsumerPoolConfig config)
+    : pimpl_(std::make_unique<Impl>(std::move(config)))
+{
+    auto& impl = *pimpl_;
+    impl.workers_.reserve(impl.config_.workers);
+    for (size_t i = 0; i < impl.config_.workers; ++i) {
+        auto worker = std::make_unique<Impl::Worker>(impl.config_.max_channels);
+        worker->owner = &impl;
+        worker->index = i;
+        worker->rng = 0x9E3779B97F4A7C15ULL * (i + 1);
+        impl.channels_.AttachReader(worker->reader);
+        impl.workers_.push_back(std::move(worker));
+    }
+
+    // All deques exist before any worker can try to steal from them
+    std::lock_guard lock(impl.writer_mutex_);
+    impl.running_.store(true, std::memory_order_relaxed);
+    try {
+        for (auto& worker : impl.workers_) {
+            worker->thread = std::thread([&impl, w = worker.get()]() { impl.Run(*w); });
+        }
+    } catch (...) {
+        impl.StopWorkers();
+        throw;
+    }
+}
+
+ConsumerPool::~ConsumerPool() {
+    Shutdown();
+}
+
+std::optional<ConsumerPool::ChannelId> ConsumerPool::AddChannel(ConsumerHandle&& consumer, Handler handler) noexcept {
+    if (!handler || pimpl_->OnWorker()) {
+        return std::nullopt;
+    }
+    std::lock_guard lock(pimpl_->writer_mutex_);
+    if (!pimpl_->running_.load(std::memory_order_relaxed) ||
+        pimpl_->channels_.Count() >= pimpl_->config_.max_channels) {
+        return std::nullopt;
+    }
+    // On failure the handle stays with the caller
+    return pimpl_->channels_.Add(true, std::move(consumer), std::move(handler));
+}
+
+std::optional<ConsumerHandle> ConsumerPool::RemoveChannel(ChannelId id) noexcept {
+    if (pimpl_->OnWorker()) {
+        return std::nullopt;
+    }
+    std::lock_guard lock(pimpl_->writer_mutex_);
+    auto entry = pimpl_->channels_.Remove(id, pimpl_->running_.load(std::memory_order_relaxed));
+    if (!entry) {
+        return std::nullopt;
+    }
+    // No scan can queue it again; wait out a queued or running drain
+    while (entry->ready.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    return std::optional<ConsumerHandle>(std::move(entry->consumer));
+}
+
+void ConsumerPool::Shutdown() noexcept {
+    if (pimpl_->OnWorker()) {
+        return;
+    }
+    std::lock_guard lock(pimpl_->writer_mutex_);
+    if (pimpl_->running_.load(std::memory_order_relaxed)) {
+        pimpl_->StopWorkers();
+    }
+}
+
+size_t ConsumerPool::WorkerCount() const noexcept {
+    return pimpl_->workers_.size();
+}
+
+ConsumerPool::Stats ConsumerPool::GetStats() const noexcept {
+    Stats stats{};
+    for (const auto& worker : pimpl_->workers_) {
+        const auto& counters = worker->counters;
+        stats.passes += counters.passes.load(std::memory_order_relaxed);
+        stats.idle_passes += counters.idle_passes.load(std::memory_order_relaxed);
+        stats.drains += counters.drains.load(std::memory_order_relaxed);
+        stats.messages += counters.messages.load(std::memory_order_relaxed);
+        stats.steals += counters.steals.load(std::memory_order_relaxed);
+    }
+    stats.channels = pimpl_->channels_.Count();
+    return stats;
+}
+
+uint64_t ConsumerPool::WorkerMessages(size_t worker) const noexcept {
+    if (worker >= pimpl_->workers_.size()) {
+        return 0;
+    }
+    return pimpl_->workers_[worker]->counters.messages.load(std::memory_order_relaxed);
+}
+
+} // namespace omni
@@ -0,0 +1,317 @@
+#include "omni/fair_multiplexer.hpp"
+#include "omni/detail/spsc_queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <utility>
+#include <vector>
+
+namespace omni {
+
+namespace {
+
+constexpr uint32_t DEFAULT_MESSAGE_QUANTUM = 16;
+constexpr uint32_t DEFAULT_BYTE_QUANTUM = 16 * 1024;
+
+// One bit per source, shared with the producers of every bound channel
+struct ReadyBitmap {
+    explicit ReadyBitmap(size_t words)
+        : bits(std::make_unique<std::atomic<uint64_t>[]>(words)) {}
+
+    std::unique_ptr<std::atomic<uint64_t>[]> bits;
+};
+
+} // namespace
+
+struct FairMultiplexer::Impl {
+    struct Source {
+        std::optional<ConsumerHandle> consumer;
+        SourceId id = 0;
+        uint32_t weight = 1;
+        int64_t deficit = 0;
+        bool closed = false;
+        bool bind_pending = false;  // Producer has not acknowledged the binding yet
+        uint64_t messages = 0;
+        uint64_t bytes = 0;
+        uint64_t visits = 0;
+    };
+
+    FairShareUnit unit;
+    int64_t quantum;
+    size_t max_batch;
+    size_t words;
+    std::shared_ptr<ReadyBitmap> bitmap;
+    std::vector<Source> sources;
+    size_t source_count = 0;
+    size_t pending_binds = 0;
+    SourceId next_id = 1;
+
+    // Round-robin start: the word after the one a round began with
+    size_t cursor = 0;
+
+    Stats stats{};
+
+    // Visit in progress, read by the drain adapter (built once, so a visit
+    // never constructs a std::function)
+    Source* visiting = nullptr;
+    const Handler* handler = nullptr;
+    size_t visit_bytes = 0;
+    ConsumerHandle::BatchHandler drain;
+
+    explicit Impl(const FairMultiplexerConfig& config)
+        : unit(config.unit),
+          quantum(config.quantum != 0 ? config.quantum
+                  : config.unit == FairShareUnit::Messages ? DEFAULT_MESSAGE_QUANTUM
+                                                           : DEFAULT_BYTE_QUANTUM),
+          max_batch(std::max<size_t>(config.max_batch, 1)),
+          words(std::max<size_t>((config.max_sources + 63) / 64, 1)),
+          bitmap(std::make_shared<ReadyBitmap>(words)),
+          sources(words * 64) {
+        drain = [this](std::span<const uint8_t> data) {
+            visit_bytes += data.size();
+            (*handler)(visiting->id, data);
+        };
+    }
+
+    std::atomic<uint64_t>& WordOf(size_t slot) noexcept {
+        return bitmap->bits[slot / 64];
+    }
+
+    static uint64_t MaskOf(size_t slot) noexcept {
+        return uint64_t{1} << (slot % 64);
+    }
+
+    const Source* Find(SourceId id) const noexcept {
+        for (const auto& source : sources) {
+            if (source.id == id && source.consumer) {
+                return &source;
+            }
+        }
+        return nullptr;
+    }
+
+    Source* Find(SourceId id) noexcept {
+        return const_cast<Source*>(std::as_const(*this).Find(id));
+    }
+
+    // Mark a source ready from the consumer side (initial state, leftovers)
+    void Raise(size_t slot) noexcept {
+        WordOf(slot).fetch_or(MaskOf(slot), std::memory_order_relaxed);
+    }
+
+    // A push racing AddSource may have missed both the binding and the
+    // initial check: look at unacknowledged sources every round until their
+    // producer has pushed armed once (or closed)
+    void CheckPendingBinds() noexcept {
+        for (size_t slot = 0; slot < sources.size() && pending_binds > 0; ++slot) {
+            Source& source = sources[slot];
+            if (!source.consumer || !source.bind_pending) {
+                continue;
+            }
+            // Acknowledgement first: its acquire makes every earlier push visible below
+            if (source.consumer->ReadySignalAcknowledged() || source.closed) {
+                source.bind_pending = false;
+                --pending_binds;
+            }
+            if (source.consumer->AvailableMessages() > 0 || !source.consumer->IsConnected()) {
+                Raise(slot);
+            }
+        }
+    }
+
+    // Drain one ready source for this round; returns messages handled
+    size_t Visit(size_t slot) noexcept {
+        Source& source = sources[slot];
+        if (!source.consumer || source.closed) {
+            return 0;  // Stale bit (removed source, or a closed one's last wake)
+        }
+        ConsumerHandle& consumer = *source.consumer;
+
+        // Grant this round's credit; overdraft from the last round is repaid first
+        source.deficit += static_cast<int64_t>(source.weight) * quantum;
+
+        // In Bytes mode a batch is sized so that even max-size messages cannot
+        // overrun the credit; the tail is taken one message at a time
+        const int64_t max_message = static_cast<int64_t>(std::max<size_t>(consumer.MaxMessageSize(), 1));
+        visiting = &source;
+        visit_bytes = 0;
+        size_t handled = 0;
+        while (source.deficit > 0 && handled < max_batch) {
+            const int64_t affordable = unit == FairShareUnit::Messages
+                ? source.deficit
+                : std::max<int64_t>(source.deficit / max_message, 1);
+            const size_t want = std::min(static_cast<size_t>(affordable), max_batch - handled);
+            const size_t before_bytes = visit_bytes;
+            const size_t count = consumer.DrainBatch(want, drain);
+            if (count == 0) {
+                break;
+            }
+            handled += count;
+            source.deficit -= unit == FairShareUnit::Messages
+                ? static_cast<int64_t>(count)
+                : static_cast<int64_t>(visit_bytes - before_bytes);
+        }
+
+        if (handled > 0) {
+            ++source.visits;
+            source.messages += handled;
+            source.bytes += visit_bytes;
+            ++stats.visits;
+            stats.messages += handled;
+            stats.bytes += visit_bytes;
+        }
+
+        if (consumer.AvailableMessages() > 0) {
+            Raise(slot);  // Out of credit or batch: next round
+        } else {
+            // Ran empty: forfeit unused credit (keep any overdraft)
+            source.deficit = std::min<int64_t>(source.deficit, 0);
+            if (!consumer.IsConnected() && consumer.AvailableMessages() == 0) {
+                source.closed = true;
+            }
+        }
+        return handled;
+    }
+};
+
+FairMultiplexer::FairMultiplexer(FairMultiplexerConfig config)
+    : pimpl_(std::make_unique<Impl>(config)) {}
+
+FairMultiplexer::~FairMultiplexer() {
+    for (auto& source : pimpl_->sources) {
+        if (source.consumer) {
+            (void)source.consumer->BindReadySignal(nullptr, 0, nullptr);
+        }
+    }
+}
+
+std::optional<FairMultiplexer::SourceId> FairMultiplexer::AddSource(ConsumerHandle&& consumer,
+                                                                    uint32_t weight) noexcept {
+    if (weight == 0 || !consumer.pimpl_) {
+        return std::nullopt;
+    }
+    auto& impl = *pimpl_;
+    const auto free_slot = std::find_if(impl.sources.begin(), impl.sources.end(),
+                                        [](const Impl::Source& source) { return !source.consumer; });
+    if (free_slot == impl.sources.end()) {
+        return std::nullopt;
+    }
+    const size_t slot = static_cast<size_t>(free_slot - impl.sources.begin());
+    if (!consumer.BindReadySignal(&impl.WordOf(slot), Impl::MaskOf(slot), impl.bitmap)) {
+        return std::nullopt;
+    }
+
+    auto& source = *free_slot;
+    source = Impl::Source{};
+    source.consumer.emplace(std::move(consumer));
+    source.id = impl.next_id++;
+    source.weight = weight;
+    source.bind_pending = true;
+    ++impl.source_count;
+    ++impl.pending_binds;
+
+    // Messages pushed before the binding raised nothing: look now, and again
+    // each round until the producer acknowledges (see CheckPendingBinds)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (source.consumer->AvailableMessages() > 0 || !source.consumer->IsConnected()) {
+        impl.Raise(slot);
+    }
+    return source.id;
+}
+
+std::optional<ConsumerHandle> FairMultiplexer::RemoveSource(SourceId source_id) noexcept {
+    auto& impl = *pimpl_;
+    Impl::Source* source = impl.Find(source_id);
+    if (source == nullptr) {
+        return std::nullopt;
+    }
+    const size_t slot = static_cast<size_t>(source - impl.sources.data());
+    if (source->bind_pending) {
+        --impl.pending_binds;
+    }
+    (void)source->consumer->BindReadySignal(nullptr, 0, nullptr);
+    impl.WordOf(slot).fetch_and(~Impl::MaskOf(slot), std::memory_order_relaxed);
+
+    std::optional<ConsumerHandle> consumer = std::move(source->consumer);
+    source->consumer.reset();
+    source->id = 0;
+    --impl.source_count;
+    return consumer;
+}
+
+bool FairMultiplexer::SetWeight(SourceId source_id, uint32_t weight) noexcept {
+    Impl::Source* source = pimpl_->Find(source_id);
+    if (source == nullptr || weight == 0) {
+        return false;
+    }
+    source->weight = weight;
+    return true;
+}
+
+size_t FairMultiplexer::Poll(const Handler& handler) noexcept {
+    auto& impl = *pimpl_;
+    if (impl.pending_binds > 0) {
+        impl.CheckPendingBinds();
+    }
+    impl.handler = &handler;
+    size_t handled = 0;
+    bool any_ready = false;
+
+    // One pass over the bitmap, starting at a rotating word so no group of
+    // sources is always served first
+    const size_t start = impl.cursor;
+    for (size_t n = 0; n < impl.words; ++n) {
+        const size_t w = (start + n) % impl.words;
+        auto& word = impl.bitmap->bits[w];
+        if (word.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        // Take the whole word: bits set during the drains below belong to
+        // the next round. The fence pairs with the producers' fence.
+        uint64_t ready = word.exchange(0, std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (ready != 0) {
+            const size_t bit = static_cast<size_t>(std::countr_zero(ready));
+            ready &= ready - 1;
+            any_ready = true;
+            handled += impl.Visit(w * 64 + bit);
+        }
+    }
+    impl.cursor = (start + 1) % impl.words;
+    impl.visiting = nullptr;
+    impl.handler = nullptr;
+
+    if (any_ready) {
+        ++impl.stats.rounds;
+    } else {
+        ++impl.stats.empty_polls;
+    }
+    return handled;
+}
+
+std::optional<FairMultiplexer::SourceStats> FairMultiplexer::GetSourceStats(SourceId source_id) const noexcept {
+    const Impl::Source* source = pimpl_->Find(source_id);
+    if (source == nullptr) {
+        return std::nullopt;
+    }
+    return SourceStats{
+        .messages = source->messages,
+        .bytes = source->bytes,
+        .visits = source->visits,
+        .deficit = source->deficit,
+        .weight = source->weight,
+        .closed = source->closed
+    };
+}
+
+FairMultiplexer::Stats FairMultiplexer::GetStats() const noexcept {
+    Stats stats = pimpl_->stats;
+    stats.sources = pimpl_->source_count;
+    return stats;
+}
+
+size_t FairMultiplexer::SourceCount() const noexcept {
+    return pimpl_->source_count;
+}
+
+} // namespace omni
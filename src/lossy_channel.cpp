@@ -0,0 +1,247 @@
+#include "omni/lossy_channel.hpp"
+#include "omni/detail/spsc_queue.hpp"
+#include "omni/detail/queue_helpers.hpp"
+#include "omni/detail/seqlock.hpp"
+#include "omni/detail/wait_strategy.hpp"
+#include "omni/detail/trace.hpp"
+#include "omni/detail/flight_recorder.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace omni {
+
+// ============================================================================
+// LossyProducer
+// ============================================================================
+
+LossyProducer::LossyProducer(std::shared_ptr<detail::SPSCQueue> queue) noexcept
+    : queue_(std::move(queue)) {
+    queue_->producer_alive.store(true, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_PRODUCER, 1);
+}
+
+LossyProducer::~LossyProducer() noexcept {
+    if (!queue_) {
+        return;  // Moved-from
+    }
+    // Every published stamp is visible before the consumer can see the close
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    queue_->producer_alive.store(false, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_PRODUCER, 0);
+    detail::RecordFlight(queue_->producer_flight, FlightEventType::Disconnect,
+                         queue_->write_index.load(std::memory_order_relaxed), 0);
+}
+
+LossyProducer::LossyProducer(LossyProducer&&) noexcept = default;
+
+LossyProducer& LossyProducer::operator=(LossyProducer&& other) noexcept {
+    if (this != &other) {
+        LossyProducer closing(std::move(*this));  // Close like the destructor
+        queue_ = std::move(other.queue_);
+    }
+    return *this;
+}
+
+PushResult LossyProducer::TryPush(std::span<const uint8_t> data) noexcept {
+    if (!queue_) {
+        return PushResult::ChannelClosed;  // Moved-from
+    }
+    auto& queue = *queue_;
+    if (!detail::IsValidMessageSize(data.size(), queue.max_message_size)) {
+        return PushResult::InvalidSize;
+    }
+    if (!queue.consumer_alive.load(std::memory_order_relaxed)) {
+        detail::AddRelaxed(queue.producer_stats.failed_pushes, 1);
+        return PushResult::ChannelClosed;
+    }
+
+    // Own index only: never waits for (or even reads) the consumer
+    const uint64_t write = queue.write_index.load(std::memory_order_relaxed);
+    auto& stamp = queue.stamps[detail::GetSlotIndex(write, queue.capacity)];
+    uint8_t* slot = detail::GetSlotPointer(queue.buffer.get(), write, queue.capacity, queue.slot_size);
+
+    // Seqlock write (see detail/seqlock.hpp): odd stamp, fence, slot, even stamp
+    stamp.store(2 * write + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const auto size = static_cast<uint32_t>(data.size());
+    detail::SeqlockStore(slot, reinterpret_cast<const uint8_t*>(&size), detail::SIZE_PREFIX_BYTES);
+    detail::SeqlockStore(detail::GetPayloadPointer(slot), data.data(), data.size());
+    stamp.store(2 * (write + 1), std::memory_order_release);
+    queue.write_index.store(write + 1, std::memory_order_release);
+
+    OMNI_TRACE(publish, queue.id, write, data.size());  // May be lapped unread: not a commit
+    detail::RecordFlight(queue.producer_flight, FlightEventType::Push, write, data.size());
+    detail::AddRelaxed(queue.producer_stats.messages_sent, 1);
+    detail::AddRelaxed(queue.producer_stats.bytes_sent, data.size());
+    return PushResult::Success;
+}
+
+bool LossyProducer::IsConnected() const noexcept {
+    return queue_ && queue_->consumer_alive.load(std::memory_order_relaxed);
+}
+
+size_t LossyProducer::Capacity() const noexcept {
+    return queue_ ? queue_->capacity : 0;
+}
+
+size_t LossyProducer::MaxMessageSize() const noexcept {
+    return queue_ ? queue_->max_message_size : 0;
+}
+
+uint64_t LossyProducer::Published() const noexcept {
+    return queue_ ? queue_->write_index.load(std::memory_order_relaxed) : 0;
+}
+
+// ============================================================================
+// LossyConsumer
+// ============================================================================
+
+LossyConsumer::LossyConsumer(std::shared_ptr<detail::SPSCQueue> queue, std::vector<uint8_t> scratch) noexcept
+    : queue_(std::move(queue)), scratch_(std::move(scratch)) {
+    queue_->consumer_alive.store(true, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_CONSUMER, 1);
+}
+
+LossyConsumer::~LossyConsumer() noexcept {
+    if (!queue_) {
+        return;  // Moved-from
+    }
+    queue_->consumer_alive.store(false, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_CONSUMER, 0);
+    detail::RecordFlight(queue_->consumer_flight, FlightEventType::Disconnect,
+                         queue_->read_index.load(std::memory_order_relaxed), 0);
+}
+
+LossyConsumer::LossyConsumer(LossyConsumer&&) noexcept = default;
+
+LossyConsumer& LossyConsumer::operator=(LossyConsumer&& other) noexcept {
+    if (this != &other) {
+        LossyConsumer closing(std::move(*this));  // Close like the destructor
+        queue_ = std::move(other.queue_);
+        scratch_ = std::move(other.scratch_);
+    }
+    return *this;
+}
+
+std::pair<PopResult, std::optional<LossyConsumer::Message>> LossyConsumer::TryPop() noexcept {
+    if (!queue_) {
+        return {PopResult::ChannelClosed, std::nullopt};  // Moved-from
+    }
+    auto& queue = *queue_;
+    const uint64_t capacity = queue.capacity;
+    // Acquire: a close seen here means every message before it is visible below
+    const bool producer_alive = queue.producer_alive.load(std::memory_order_acquire);
+    uint64_t read = queue.read_index.load(std::memory_order_relaxed);
+    uint64_t missed = 0;
+
+    while (true) {
+        const uint64_t write = queue.write_index.load(std::memory_order_acquire);
+        if (read == write) {
+            if (!producer_alive) {
+                detail::AddRelaxed(queue.consumer_stats.failed_pops, 1);
+                return {PopResult::ChannelClosed, std::nullopt};
+            }
+            return {PopResult::Empty, std::nullopt};
+        }
+        // Lapped: everything before write - capacity is certainly gone
+        if (write - read > capacity) {
+            missed += write - capacity - read;
+            read = write - capacity;
+        }
+
+        // Seqlock read: stamp must say "message `read`, complete" before and
+        // after the copy, otherwise the producer overwrote the slot
+        const auto& stamp = queue.stamps[detail::GetSlotIndex(read, capacity)];
+        const uint64_t expected = 2 * (read + 1);
+        if (stamp.load(std::memory_order_acquire) == expected) {
+            const uint8_t* slot = detail::GetSlotPointer(queue.buffer.get(), read, capacity, queue.slot_size);
+            uint32_t size = 0;
+            detail::SeqlockLoad(reinterpret_cast<uint8_t*>(&size), slot, detail::SIZE_PREFIX_BYTES);
+            const bool sane = detail::IsValidMessageSize(size, queue.max_message_size);  // Torn sizes
+            if (sane) {
+                detail::SeqlockLoad(scratch_.data(), detail::GetPayloadPointer(slot), size);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sane && stamp.load(std::memory_order_relaxed) == expected) {
+                queue.read_index.store(read + 1, std::memory_order_release);
+                OMNI_TRACE(pop, queue.id, read, size);
+                detail::RecordFlight(queue.consumer_flight, FlightEventType::Pop, read, size);
+                detail::AddRelaxed(queue.consumer_stats.messages_received, 1);
+                detail::AddRelaxed(queue.consumer_stats.bytes_received, size);
+                if (missed > 0) {
+                    detail::AddRelaxed(queue.consumer_stats.messages_lost, missed);
+                }
+                return {PopResult::Success, Message{
+                    .data = std::span<const uint8_t>(scratch_.data(), size),
+                    .sequence = read,
+                    .missed = missed
+                }};
+            }
+        }
+
+        // Message `read` was overwritten. Skip to write - capacity, the oldest
+        // message that may still be intact (the producer may be on it now).
+        const uint64_t latest = queue.write_index.load(std::memory_order_acquire);
+        const uint64_t oldest = latest > read + capacity ? latest - capacity : read + 1;
+        missed += oldest - read;
+        read = oldest;
+    }
+}
+
+std::pair<PopResult, std::optional<LossyConsumer::Message>> LossyConsumer::BlockingPop(
+    std::chrono::milliseconds timeout) noexcept {
+    auto [result, message] = TryPop();
+    if (result != PopResult::Empty) {
+        return {result, message};
+    }
+
+    const bool infinite = timeout == std::chrono::milliseconds::max();
+    const auto deadline = infinite ? std::chrono::steady_clock::time_point::max()
+                                   : std::chrono::steady_clock::now() + timeout;
+    auto& queue = *queue_;  // TryPop() returned Empty, so not moved-from
+    while (true) {
+        detail::SpinWaitWithYield([&queue]() {
+            return queue.write_index.load(std::memory_order_acquire) !=
+                       queue.read_index.load(std::memory_order_relaxed) ||
+                   !queue.producer_alive.load(std::memory_order_relaxed);
+        });
+
+        auto [r, m] = TryPop();
+        if (r != PopResult::Empty) {
+            return {r, m};
+        }
+        if (!infinite && std::chrono::steady_clock::now() >= deadline) {
+            detail::AddRelaxed(queue.consumer_stats.failed_pops, 1);
+            detail::RecordFlight(queue.consumer_flight, FlightEventType::Timeout,
+                                 queue.read_index.load(std::memory_order_relaxed), 0);
+            return {PopResult::Timeout, std::nullopt};
+        }
+    }
+}
+
+bool LossyConsumer::IsConnected() const noexcept {
+    return queue_ && queue_->producer_alive.load(std::memory_order_relaxed);
+}
+
+size_t LossyConsumer::Capacity() const noexcept {
+    return queue_ ? queue_->capacity : 0;
+}
+
+size_t LossyConsumer::MaxMessageSize() const noexcept {
+    return queue_ ? queue_->max_message_size : 0;
+}
+
+size_t LossyConsumer::AvailableMessages() const noexcept {
+    if (!queue_) {
+        return 0;
+    }
+    const uint64_t read = queue_->read_index.load(std::memory_order_relaxed);
+    const uint64_t write = queue_->write_index.load(std::memory_order_relaxed);
+    return static_cast<size_t>(std::min<uint64_t>(write - read, queue_->capacity));
+}
+
+uint64_t LossyConsumer::MissedMessages() const noexcept {
+    return queue_ ? queue_->consumer_stats.messages_lost.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace omni
@@ -0,0 +1,254 @@
+#include "omni/merge_consumer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace omni {
+
+struct MergeConsumer::Impl {
+    enum class State : uint8_t {
+        Ready,      // Head peeked, in the heap
+        Empty,      // Live producer, nothing queued
+        Closed      // Producer gone, drained
+    };
+
+    struct Input {
+        explicit Input(ConsumerHandle&& handle) : consumer(std::move(handle)) {}
+
+        ConsumerHandle consumer;
+        State state = State::Empty;
+        Key head_key = 0;
+        Key last_key = 0;           // Last key emitted from this input
+        bool has_last = false;
+    };
+
+    KeyExtractor key;
+    MergeConsumerConfig config;
+    std::vector<Input> inputs;
+    std::vector<uint32_t> heap;     // Ready inputs, min (head_key, index) first
+    size_t empty_live = 0;          // Inputs in State::Empty
+
+    bool seen_any = false;
+    Key newest_key = 0;             // Newest head key seen on any input
+    bool emitted_any = false;
+    Key high_key = 0;               // Newest key emitted
+    Key last_emitted = 0;
+
+    Stats stats{};
+
+    // Emission in progress, read by the drain adapter (built once)
+    const Handler* handler = nullptr;
+    size_t current = 0;
+    ConsumerHandle::BatchHandler drain;
+
+    Impl(KeyExtractor extractor, MergeConsumerConfig cfg)
+        : key(extractor ? std::move(extractor) : KeyAtOffset(0)), config(cfg) {
+        drain = [this](std::span<const uint8_t> data) {
+            (*handler)(current, inputs[current].head_key, data);
+        };
+    }
+
+    bool Before(uint32_t a, uint32_t b) const noexcept {
+        const Key ka = inputs[a].head_key;
+        const Key kb = inputs[b].head_key;
+        return ka < kb || (ka == kb && a < b);
+    }
+
+    void SiftUp(size_t pos) noexcept {
+        while (pos > 0) {
+            const size_t parent = (pos - 1) / 2;
+            if (!Before(heap[pos], heap[parent])) {
+                break;
+            }
+            std::swap(heap[pos], heap[parent]);
+            pos = parent;
+        }
+    }
+
+    void SiftDown(size_t pos) noexcept {
+        const size_t size = heap.size();
+        while (true) {
+            const size_t left = 2 * pos + 1;
+            if (left >= size) {
+                break;
+            }
+            const size_t right = left + 1;
+            const size_t child = (right < size && Before(heap[right], heap[left])) ? right : left;
+            if (!Before(heap[child], heap[pos])) {
+                break;
+            }
+            std::swap(heap[pos], heap[child]);
+            pos = child;
+        }
+    }
+
+    // Peek at an input's head. Returns true (and sets head_key) if it has one;
+    // otherwise moves it to Empty or, if its producer is gone, Closed.
+    bool Look(size_t index) noexcept {
+        Input& input = inputs[index];
+        auto head = input.consumer.Peek();
+        if (!head && !input.consumer.IsConnected()) {
+            head = input.consumer.Peek();  // A last push may have landed before the close
+            if (!head) {
+                SetState(input, State::Closed);
+                ++stats.closed_inputs;
+                return false;
+            }
+        }
+        if (!head) {
+            SetState(input, State::Empty);
+            return false;
+        }
+        input.head_key = key(*head);
+        if (!seen_any || input.head_key > newest_key) {
+            newest_key = input.head_key;
+            seen_any = true;
+        }
+        return true;
+    }
+
+    void SetState(Input& input, State state) noexcept {
+        if (input.state == State::Empty) {
+            --empty_live;
+        }
+        if (state == State::Empty) {
+            ++empty_live;
+        }
+        input.state = state;
+    }
+
+    // Can `head_key` go out while some live inputs are empty? Each input is
+    // ordered, so an empty one can only deliver keys >= the last it gave;
+    // max_lateness lowers the wait to newest_key - max_lateness.
+    bool Emittable(Key head_key) const noexcept {
+        if (empty_live == 0) {
+            return true;
+        }
+        const bool lateness_bound = seen_any && newest_key >= config.max_lateness &&
+                                    config.max_lateness != std::numeric_limits<uint64_t>::max();
+        const Key assumed = lateness_bound ? newest_key - config.max_lateness : 0;
+        for (const Input& input : inputs) {
+            if (input.state != State::Empty) {
+                continue;
+            }
+            const bool below_last = input.has_last && head_key <= input.last_key;
+            const bool below_lateness = lateness_bound && head_key <= assumed;
+            if (!below_last && !below_lateness) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+MergeConsumer::KeyExtractor MergeConsumer::KeyAtOffset(size_t offset) {
+    return [offset](std::span<const uint8_t> data) -> Key {
+        Key value = 0;
+        if (data.size() >= offset + sizeof(value)) {
+            std::memcpy(&value, data.data() + offset, sizeof(value));
+        }
+        return value;
+    };
+}
+
+MergeConsumer::MergeConsumer(KeyExtractor key, MergeConsumerConfig config)
+    : pimpl_(std::make_unique<Impl>(std::move(key), config)) {}
+
+MergeConsumer::~MergeConsumer() = default;
+
+std::optional<size_t> MergeConsumer::AddInput(ConsumerHandle&& consumer) noexcept {
+    auto& impl = *pimpl_;
+    try {
+        impl.inputs.reserve(impl.inputs.size() + 1);
+        impl.heap.reserve(impl.inputs.size() + 1);
+    } catch (const std::bad_alloc&) {
+        return std::nullopt;
+    }
+    const size_t index = impl.inputs.size();
+    impl.inputs.emplace_back(std::move(consumer));
+    ++impl.empty_live;  // New inputs start Empty
+    if (impl.Look(index)) {
+        impl.SetState(impl.inputs[index], Impl::State::Ready);
+        impl.heap.push_back(static_cast<uint32_t>(index));
+        impl.SiftUp(impl.heap.size() - 1);
+    }
+    return index;
+}
+
+size_t MergeConsumer::Poll(const Handler& handler, size_t max_count) noexcept {
+    auto& impl = *pimpl_;
+    impl.handler = &handler;
+
+    // Inputs that were empty at the last look
+    if (impl.empty_live > 0) {
+        for (size_t i = 0; i < impl.inputs.size(); ++i) {
+            if (impl.inputs[i].state == Impl::State::Empty && impl.Look(i)) {
+                impl.SetState(impl.inputs[i], Impl::State::Ready);
+                impl.heap.push_back(static_cast<uint32_t>(i));
+                impl.SiftUp(impl.heap.size() - 1);
+            }
+        }
+    }
+
+    size_t emitted = 0;
+    while (emitted < max_count && !impl.heap.empty()) {
+        const uint32_t top = impl.heap.front();
+        Impl::Input& input = impl.inputs[top];
+        const Key head_key = input.head_key;
+        if (!impl.Emittable(head_key)) {
+            ++impl.stats.stalls;
+            break;
+        }
+
+        impl.current = top;
+        if (input.consumer.DrainBatch(1, impl.drain) == 0) {
+            break;  // Not reachable: the head was peeked by this consumer
+        }
+        ++emitted;
+        if (impl.emitted_any && head_key < impl.high_key) {
+            ++impl.stats.late;
+        }
+        impl.high_key = impl.emitted_any ? std::max(impl.high_key, head_key) : head_key;
+        impl.emitted_any = true;
+        impl.last_emitted = head_key;
+        input.last_key = head_key;
+        input.has_last = true;
+
+        // Next head of the same input replaces the top; otherwise drop it
+        if (impl.Look(top)) {
+            impl.SiftDown(0);
+        } else {
+            impl.heap.front() = impl.heap.back();
+            impl.heap.pop_back();
+            if (!impl.heap.empty()) {
+                impl.SiftDown(0);
+            }
+        }
+    }
+
+    impl.stats.messages += emitted;
+    impl.handler = nullptr;
+    return emitted;
+}
+
+bool MergeConsumer::Done() const noexcept {
+    return std::all_of(pimpl_->inputs.begin(), pimpl_->inputs.end(),
+                       [](const Impl::Input& input) { return input.state == Impl::State::Closed; });
+}
+
+std::optional<MergeConsumer::Key> MergeConsumer::LastKey() const noexcept {
+    if (!pimpl_->emitted_any) {
+        return std::nullopt;
+    }
+    return pimpl_->last_emitted;
+}
+
+size_t MergeConsumer::InputCount() const noexcept {
+    return pimpl_->inputs.size();
+}
+
+MergeConsumer::Stats MergeConsumer::GetStats() const noexcept {
+    return pimpl_->stats;
+}
+
+} // namespace omni
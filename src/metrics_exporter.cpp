@@ -0,0 +1,465 @@
+#include "omni/metrics_exporter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
+#if defined(OMNI_PLATFORM_LINUX)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace omni {
+
+namespace {
+
+// OpenMetrics label value escaping: backslash, double quote, newline
+std::string EscapeLabel(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const char c : value) {
+        switch (c) {
+            case '\\': escaped += "\\\\"; break;
+            case '"':  escaped += "\\\""; break;
+            case '\n': escaped += "\\n"; break;
+            default:   escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+// Shortest text that parses back to the same double. The ostream default
+// (6 significant digits) turns 1234567.8 into 1.23457e+06 and freezes
+// long-running counters.
+std::string FormatDouble(double value) {
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, result.ptr);
+}
+
+// "GET /metrics" followed by the end of the path (not "/metricsfoo")
+bool IsMetricsRequest(const std::string& request) {
+    constexpr std::string_view target = "GET /metrics";
+    return request.rfind(target, 0) == 0 && request.size() > target.size()
+        && (request[target.size()] == ' ' || request[target.size()] == '?');
+}
+
+// Total time a scraper gets to send its request head; the snapshot loop
+// runs on the same thread, so one slow client can delay it at most this long
+constexpr auto REQUEST_TIMEOUT = std::chrono::milliseconds(200);
+
+// Counter delta per second; a counter that went backwards belongs to a
+// channel removed and recreated under the same name (reset: rate 0)
+double CounterRate(uint64_t current, uint64_t previous, double elapsed) {
+    return current >= previous ? static_cast<double>(current - previous) / elapsed : 0.0;
+}
+
+// Emit "# TYPE" / "# HELP" header for one metric family
+void WriteFamily(std::ostringstream& out, const std::string& name, const char* type, const char* help) {
+    out << "# TYPE " << name << ' ' << type << '\n';
+    out << "# HELP " << name << ' ' << help << '\n';
+}
+
+} // namespace
+
+struct MetricsExporter::Impl {
+    MetricsExporterConfig config_;
+    MailboxBroker& broker_;
+
+    // Last rendered text (served to scrapers; never recomputed per scrape)
+    mutable std::mutex text_mutex_;
+    std::string text_;
+
+    // Previous counters for rate computation (exporter thread / SnapshotNow only)
+    std::mutex snapshot_mutex_;
+    std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> previous_counts_;
+    std::chrono::steady_clock::time_point previous_time_{};
+
+    std::atomic<bool> running_{false};
+    std::atomic<uint16_t> bound_port_{0};
+    std::thread worker_;
+    int listen_fd_ = -1;
+
+    Impl(MetricsExporterConfig config, MailboxBroker& broker)
+        : config_(std::move(config))
+        , broker_(broker)
+    {
+        config_.interval = std::max(config_.interval, std::chrono::milliseconds(10));
+    }
+
+    Snapshot TakeSnapshot();
+    void Publish(std::string text);
+    void SnapshotAndPublish() noexcept;
+    bool OpenListener() noexcept;
+    void CloseListener() noexcept;
+    void ServeOne() noexcept;
+    void Run() noexcept;
+};
+
+MetricsExporter::Snapshot MetricsExporter::Impl::TakeSnapshot() {
+    std::lock_guard lock(snapshot_mutex_);
+
+    Snapshot snapshot;
+    snapshot.broker = broker_.GetStats();
+
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed = previous_time_ == std::chrono::steady_clock::time_point{}
+        ? 0.0
+        : std::chrono::duration<double>(now - previous_time_).count();
+
+    std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> current_counts;
+    current_counts.reserve(previous_counts_.size());
+
+    // Relaxed counter loads only; the broker visits outside its registry lock
+    broker_.ForEachChannelStats([&](const MailboxBroker::ChannelStats& stats) {
+        double send_rate = 0.0;
+        double receive_rate = 0.0;
+
+        auto it = previous_counts_.find(stats.name);
+        if (elapsed > 0.0 && it != previous_counts_.end()) {
+            send_rate = CounterRate(stats.messages_sent, it->second.first, elapsed);
+            receive_rate = CounterRate(stats.messages_received, it->second.second, elapsed);
+        }
+
+        current_counts.emplace(stats.name, std::make_pair(stats.messages_sent, stats.messages_received));
+        snapshot.channels.push_back(ChannelSample{stats, send_rate, receive_rate});
+    });
+
+    // Stable output order for diffing and tests
+    std::sort(snapshot.channels.begin(), snapshot.channels.end(),
+        [](const ChannelSample& a, const ChannelSample& b) { return a.stats.name < b.stats.name; });
+
+    previous_counts_ = std::move(current_counts);
+    previous_time_ = now;
+    return snapshot;
+}
+
+void MetricsExporter::Impl::Publish(std::string text) {
+    if (!config_.file_path.empty()) {
+        // Write to temporary file then rename so readers never see partial
+        // output; a failed or short write (full disk) keeps the last good file
+        const std::string temp_path = config_.file_path + ".tmp";
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file << text;
+        file.close();
+        if (!file.good() || std::rename(temp_path.c_str(), config_.file_path.c_str()) != 0) {
+            std::remove(temp_path.c_str());
+        }
+    }
+
+    std::lock_guard lock(text_mutex_);
+    text_ = std::move(text);
+}
+
+void MetricsExporter::Impl::SnapshotAndPublish() noexcept {
+    try {
+        Publish(Render(TakeSnapshot(), config_.metric_prefix));
+    } catch (...) {
+        // Allocation or I/O failure: keep serving the previous text
+    }
+}
+
+#if defined(OMNI_PLATFORM_LINUX)
+
+bool MetricsExporter::Impl::OpenListener() noexcept {
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+
+    const int reuse = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // Loopback only: metrics are not meant to be exposed off-host directly
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(config_.http_port.value_or(0));
+
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+        || ::listen(listen_fd_, 16) != 0) {
+        CloseListener();
+        return false;
+    }
+
+    socklen_t len = sizeof(addr);
+    if (::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        bound_port_.store(ntohs(addr.sin_port), std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void MetricsExporter::Impl::CloseListener() noexcept {
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+    bound_port_.store(0, std::memory_order_relaxed);
+}
+
+void MetricsExporter::Impl::ServeOne() noexcept {
+    const int client = ::accept(listen_fd_, nullptr, nullptr);
+    if (client < 0) {
+        return;
+    }
+
+    try {
+        // Read request head (bounded size, one overall deadline; body is ignored)
+        std::string request;
+        char buffer[1024];
+        pollfd pfd{client, POLLIN, 0};
+        const auto deadline = std::chrono::steady_clock::now() + REQUEST_TIMEOUT;
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0 || !running_.load(std::memory_order_acquire)
+                || ::poll(&pfd, 1, static_cast<int>(std::min<int64_t>(remaining.count(), 100))) < 0) {
+                break;
+            }
+            if ((pfd.revents & (POLLIN | POLLHUP | POLLERR)) == 0) {
+                continue;  // Re-check the deadline and Stop() every 100ms at most
+            }
+            const ssize_t n = ::recv(client, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                break;
+            }
+            request.append(buffer, static_cast<size_t>(n));
+        }
+
+        std::string status = "200 OK";
+        std::string content_type = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+        std::string body;
+
+        if (IsMetricsRequest(request)) {
+            std::lock_guard lock(text_mutex_);
+            body = text_;
+        } else {
+            status = "404 Not Found";
+            content_type = "text/plain";
+            body = "not found\n";
+        }
+
+        std::ostringstream response;
+        response << "HTTP/1.1 " << status << "\r\n"
+                 << "Content-Type: " << content_type << "\r\n"
+                 << "Content-Length: " << body.size() << "\r\n"
+                 << "Connection: close\r\n\r\n"
+                 << body;
+        const std::string out = response.str();
+
+        size_t sent = 0;
+        while (sent < out.size()) {
+            const ssize_t n = ::send(client, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                break;
+            }
+            sent += static_cast<size_t>(n);
+        }
+    } catch (...) {
+        // Drop this scrape on allocation failure
+    }
+
+    ::close(client);
+}
+
+void MetricsExporter::Impl::Run() noexcept {
+    auto next_snapshot = std::chrono::steady_clock::now() + config_.interval;
+
+    while (running_.load(std::memory_order_acquire)) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= next_snapshot) {
+            SnapshotAndPublish();
+            next_snapshot = now + config_.interval;
+        }
+
+        // Wake at least every 100ms to observe Stop()
+        const auto until_snapshot = std::chrono::duration_cast<std::chrono::milliseconds>(next_snapshot - now);
+        const int wait_ms = static_cast<int>(std::clamp<int64_t>(until_snapshot.count(), 1, 100));
+
+        if (listen_fd_ >= 0) {
+            pollfd pfd{listen_fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, wait_ms) > 0 && (pfd.revents & POLLIN)) {
+                ServeOne();
+            }
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(wait_ms));
+        }
+    }
+}
+
+#else
+
+bool MetricsExporter::Impl::OpenListener() noexcept {
+    return false;  // HTTP endpoint only implemented for POSIX sockets
+}
+
+void MetricsExporter::Impl::CloseListener() noexcept {
+}
+
+void MetricsExporter::Impl::ServeOne() noexcept {
+}
+
+void MetricsExporter::Impl::Run() noexcept {
+    auto next_snapshot = std::chrono::steady_clock::now() + config_.interval;
+
+    while (running_.load(std::memory_order_acquire)) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= next_snapshot) {
+            SnapshotAndPublish();
+            next_snapshot = now + config_.interval;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+#endif
+
+MetricsExporter::MetricsExporter(MetricsExporterConfig config, MailboxBroker& broker)
+    : pimpl_(std::make_unique<Impl>(std::move(config), broker))
+{
+}
+
+MetricsExporter::~MetricsExporter() {
+    Stop();
+}
+
+bool MetricsExporter::Start() noexcept {
+    if (pimpl_->running_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    if (pimpl_->config_.http_port.has_value() && !pimpl_->OpenListener()) {
+        return false;
+    }
+
+    // Serve something meaningful from the very first scrape
+    pimpl_->SnapshotAndPublish();
+
+    pimpl_->running_.store(true, std::memory_order_release);
+    try {
+        pimpl_->worker_ = std::thread([this]() { pimpl_->Run(); });
+    } catch (...) {
+        pimpl_->running_.store(false, std::memory_order_release);
+        pimpl_->CloseListener();
+        return false;
+    }
+    return true;
+}
+
+void MetricsExporter::Stop() noexcept {
+    pimpl_->running_.store(false, std::memory_order_release);
+    if (pimpl_->worker_.joinable()) {
+        pimpl_->worker_.join();
+    }
+    pimpl_->CloseListener();
+}
+
+bool MetricsExporter::IsRunning() const noexcept {
+    return pimpl_->running_.load(std::memory_order_acquire);
+}
+
+uint16_t MetricsExporter::BoundPort() const noexcept {
+    return pimpl_->bound_port_.load(std::memory_order_relaxed);
+}
+
+void MetricsExporter::SnapshotNow() noexcept {
+    pimpl_->SnapshotAndPublish();
+}
+
+std::string MetricsExporter::GetText() const {
+    std::lock_guard lock(pimpl_->text_mutex_);
+    return pimpl_->text_;
+}
+
+std::string MetricsExporter::Render(const Snapshot& snapshot, const std::string& prefix) {
+    std::ostringstream out;
+    const std::string broker = prefix + "_broker_";
+    const std::string channel = prefix + "_channel_";
+
+    // Broker-wide families
+    WriteFamily(out, broker + "active_channels", "gauge", "Currently registered channels.");
+    out << broker << "active_channels " << snapshot.broker.active_channels << '\n';
+    WriteFamily(out, broker + "channels_opened", "counter", "Channels opened since process start.");
+    out << broker << "channels_opened_total " << snapshot.broker.total_channels_created << '\n';
+    WriteFamily(out, broker + "messages_sent", "counter", "Messages committed across all channels.");
+    out << broker << "messages_sent_total " << snapshot.broker.total_messages_sent << '\n';
+    WriteFamily(out, broker + "bytes_sent", "counter", "Payload bytes committed across all channels.");
+    out << broker << "bytes_sent_total " << snapshot.broker.total_bytes_transferred << '\n';
+
+    // Per-channel families: one family header, then one sample per channel
+    const auto family = [&](const char* name, const char* type, const char* help,
+                            const char* suffix, auto&& value) {
+        WriteFamily(out, channel + name, type, help);
+        for (const auto& sample : snapshot.channels) {
+            out << channel << name << suffix << "{channel=\"" << EscapeLabel(sample.stats.name) << "\"} ";
+            if constexpr (std::is_floating_point_v<decltype(value(sample))>) {
+                out << FormatDouble(value(sample)) << '\n';
+            } else {
+                out << value(sample) << '\n';
+            }
+        }
+    };
+
+    family("capacity", "gauge", "Ring buffer capacity in slots.", "",
+        [](const ChannelSample& s) { return s.stats.capacity; });
+    family("depth", "gauge", "Messages currently queued.", "",
+        [](const ChannelSample& s) { return s.stats.depth; });
+    family("messages_sent", "counter", "Messages committed by the producer.", "_total",
+        [](const ChannelSample& s) { return s.stats.messages_sent; });
+    family("bytes_sent", "counter", "Payload bytes committed by the producer.", "_total",
+        [](const ChannelSample& s) { return s.stats.bytes_sent; });
+    family("failed_pushes", "counter", "Pushes that returned QueueFull, Timeout or ChannelClosed.", "_total",
+        [](const ChannelSample& s) { return s.stats.failed_pushes; });
+    family("messages_received", "counter", "Messages popped by the consumer.", "_total",
+        [](const ChannelSample& s) { return s.stats.messages_received; });
+    family("bytes_received", "counter", "Payload bytes popped by the consumer.", "_total",
+        [](const ChannelSample& s) { return s.stats.bytes_received; });
+    family("failed_pops", "counter", "Pops that returned Timeout or ChannelClosed.", "_total",
+        [](const ChannelSample& s) { return s.stats.failed_pops; });
+    family("messages_lost", "counter", "Messages overwritten before being read (lossy, conflating and state channels).", "_total",
+        [](const ChannelSample& s) { return s.stats.messages_lost; });
+    family("messages_expired", "counter", "Messages dropped unread past their deadline.", "_total",
+        [](const ChannelSample& s) { return s.stats.messages_expired; });
+    family("send_rate", "gauge", "Messages per second committed over the last export interval.", "",
+        [](const ChannelSample& s) { return s.send_rate; });
+    family("receive_rate", "gauge", "Messages per second popped over the last export interval.", "",
+        [](const ChannelSample& s) { return s.receive_rate; });
+    family("max_depth", "gauge", "Highest queue depth observed by the producer.", "",
+        [](const ChannelSample& s) { return s.stats.saturation.max_depth; });
+    family("full_events", "counter", "Times the queue became full.", "_total",
+        [](const ChannelSample& s) { return s.stats.saturation.full_events; });
+
+    // Watermark time carries a second label, so it is written out explicitly
+    WriteFamily(out, channel + "time_above_watermark_seconds", "counter",
+        "Cumulative time queue depth was at or above the watermark.");
+    for (const auto& sample : snapshot.channels) {
+        const auto& sat = sample.stats.saturation;
+        for (size_t i = 0; i < WATERMARK_COUNT; ++i) {
+            // Watermarks are non-decreasing; a repeated percent is the same sample
+            if (i > 0 && sat.watermark_percent[i] == sat.watermark_percent[i - 1]) {
+                continue;
+            }
+            out << channel << "time_above_watermark_seconds_total{channel=\"" << EscapeLabel(sample.stats.name)
+                << "\",watermark=\"" << static_cast<unsigned>(sat.watermark_percent[i]) << "\"} "
+                << FormatDouble(static_cast<double>(sat.time_above_ns[i]) / 1e9) << '\n';
+        }
+    }
+
+    family("connected", "gauge", "1 if both producer and consumer handles are alive.", "",
+        [](const ChannelSample& s) { return (s.stats.producer_alive && s.stats.consumer_alive) ? 1 : 0; });
+
+    out << "# EOF\n";
+    return out.str();
+}
+
+} // namespace omni
@@ -0,0 +1,259 @@
+#include "omni/placement.hpp"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#if defined(OMNI_PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace omni {
+
+namespace detail {
+
+std::vector<int> ParseCpuList(std::string_view list) {
+    // Sysfs lines may carry trailing whitespace
+    while (!list.empty() && (list.back() == '\n' || list.back() == ' ')) {
+        list.remove_suffix(1);
+    }
+
+    std::vector<int> cpus;
+    while (!list.empty()) {
+        const size_t comma = list.find(',');
+        const std::string_view range = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+        int first = 0;
+        int last = 0;
+        const char* end = range.data() + range.size();
+        auto [ptr, ec] = std::from_chars(range.data(), end, first);
+        if (ec != std::errc{} || first < 0) {
+            return {};
+        }
+        last = first;
+        if (ptr != end) {
+            if (*ptr != '-') {
+                return {};
+            }
+            auto [range_end, range_ec] = std::from_chars(ptr + 1, end, last);
+            if (range_ec != std::errc{} || range_end != end || last < first) {
+                return {};
+            }
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+} // namespace detail
+
+namespace {
+
+#if defined(OMNI_PLATFORM_LINUX)
+std::optional<std::string> ReadSysfsLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    if (!file || !std::getline(file, line)) {
+        return std::nullopt;
+    }
+    return line;
+}
+
+int ReadSysfsInt(const std::string& path, int fallback) {
+    const auto line = ReadSysfsLine(path);
+    int value = fallback;
+    if (line) {
+        std::from_chars(line->data(), line->data() + line->size(), value);
+    }
+    return value;
+}
+
+// Lowest CPU sharing the highest-level data/unified cache of `dir`
+int ReadLastLevelCache(const std::string& dir, int fallback) {
+    int best_level = 0;
+    int llc = fallback;
+    for (int index = 0;; ++index) {
+        const std::string cache = dir + "cache/index" + std::to_string(index) + "/";
+        const int level = ReadSysfsInt(cache + "level", -1);
+        if (level < 0) {
+            break;
+        }
+        if (level <= best_level || ReadSysfsLine(cache + "type") == "Instruction") {
+            continue;
+        }
+        const auto shared = ReadSysfsLine(cache + "shared_cpu_list");
+        const auto cpus = shared ? detail::ParseCpuList(*shared) : std::vector<int>{};
+        if (!cpus.empty()) {
+            best_level = level;
+            llc = *std::min_element(cpus.begin(), cpus.end());
+        }
+    }
+    return llc;
+}
+#endif
+
+// Closeness of two CPUs: 0 = SMT siblings, 1 = shared LLC, 2 = same node, 3 = remote
+int Distance(const CpuInfo& a, const CpuInfo& b) noexcept {
+    if (a.core == b.core) return 0;
+    if (a.llc == b.llc) return 1;
+    if (a.numa_node == b.numa_node) return 2;
+    return 3;
+}
+
+bool Satisfies(PlacementPolicy policy, const CpuInfo& a, const CpuInfo& b) noexcept {
+    switch (policy) {
+        case PlacementPolicy::SameCore: return a.core == b.core;
+        case PlacementPolicy::SameLLC:  return a.core != b.core && a.llc == b.llc;
+        case PlacementPolicy::SameNode: return a.core != b.core && a.numa_node == b.numa_node;
+    }
+    return false;
+}
+
+} // namespace
+
+CpuTopology CpuTopology::Detect() {
+    std::vector<CpuInfo> cpus;
+#if defined(OMNI_PLATFORM_LINUX)
+    // CPU -> NUMA node (nodes are sparse on some machines, so walk the online list)
+    std::vector<std::pair<int, int>> node_of;
+    const std::string node_root = "/sys/devices/system/node/";
+    if (const auto nodes = ReadSysfsLine(node_root + "online")) {
+        for (int node : detail::ParseCpuList(*nodes)) {
+            const auto list = ReadSysfsLine(node_root + "node" + std::to_string(node) + "/cpulist");
+            for (int cpu : list ? detail::ParseCpuList(*list) : std::vector<int>{}) {
+                node_of.emplace_back(cpu, node);
+            }
+        }
+    }
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        const std::string root = "/sys/devices/system/cpu/";
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &allowed)) {
+                continue;
+            }
+            const std::string dir = root + "cpu" + std::to_string(cpu) + "/";
+            const int package = ReadSysfsInt(dir + "topology/physical_package_id", 0);
+            const auto node = std::find_if(node_of.begin(), node_of.end(),
+                                           [cpu](const auto& entry) { return entry.first == cpu; });
+            cpus.push_back(CpuInfo{
+                .cpu = cpu,
+                // core_id is only unique within a package
+                .core = package * 65536 + ReadSysfsInt(dir + "topology/core_id", cpu),
+                .package = package,
+                .llc = ReadLastLevelCache(dir, 0),
+                .numa_node = node != node_of.end() ? node->second : 0
+            });
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        const int count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int cpu = 0; cpu < count; ++cpu) {
+            cpus.push_back(CpuInfo{.cpu = cpu, .core = cpu, .package = 0, .llc = 0, .numa_node = 0});
+        }
+    }
+    return FromCpus(std::move(cpus));
+}
+
+CpuTopology CpuTopology::FromCpus(std::vector<CpuInfo> cpus) {
+    std::sort(cpus.begin(), cpus.end(),
+              [](const CpuInfo& a, const CpuInfo& b) { return a.cpu < b.cpu; });
+    cpus.erase(std::unique(cpus.begin(), cpus.end(),
+                           [](const CpuInfo& a, const CpuInfo& b) { return a.cpu == b.cpu; }),
+               cpus.end());
+
+    CpuTopology topology;
+    topology.cpus_ = std::move(cpus);
+    return topology;
+}
+
+std::optional<CpuInfo> CpuTopology::Find(int cpu) const noexcept {
+    const auto it = std::lower_bound(cpus_.begin(), cpus_.end(), cpu,
+                                     [](const CpuInfo& info, int value) { return info.cpu < value; });
+    if (it == cpus_.end() || it->cpu != cpu) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+std::optional<ChannelPlacement> CpuTopology::Recommend(
+    PlacementPolicy policy,
+    std::span<const int> busy_cpus) const
+{
+    const size_t n = cpus_.size();
+
+    // Endpoints already assigned per CPU, then per physical core (SMT siblings share it)
+    std::vector<int> cpu_load(n, 0);
+    for (int busy : busy_cpus) {
+        const auto it = std::lower_bound(cpus_.begin(), cpus_.end(), busy,
+                                         [](const CpuInfo& info, int value) { return info.cpu < value; });
+        if (it != cpus_.end() && it->cpu == busy) {
+            ++cpu_load[static_cast<size_t>(it - cpus_.begin())];
+        }
+    }
+    std::vector<int> core_load(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (cpus_[i].core == cpus_[j].core) {
+                core_load[i] += cpu_load[j];
+            }
+        }
+    }
+
+    // Lexicographic: CPU load, core load, distance, CPU numbers
+    using Score = std::tuple<int, int, int, int, int>;
+    std::optional<Score> best;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            if (!Satisfies(policy, cpus_[i], cpus_[j])) {
+                continue;
+            }
+            const int same_core = cpus_[i].core == cpus_[j].core ? 1 : 0;
+            const Score score{
+                cpu_load[i] + cpu_load[j],
+                core_load[i] + core_load[j] * (1 - same_core),
+                Distance(cpus_[i], cpus_[j]),
+                cpus_[i].cpu,
+                cpus_[j].cpu
+            };
+            if (!best || score < *best) {
+                best = score;
+            }
+        }
+    }
+
+    if (!best) {
+        return std::nullopt;
+    }
+    return ChannelPlacement{
+        .producer_cpu = std::get<3>(*best),
+        .consumer_cpu = std::get<4>(*best),
+        .policy = policy
+    };
+}
+
+bool PinCurrentThread(int cpu) noexcept {
+#if defined(OMNI_PLATFORM_LINUX)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+} // namespace omni
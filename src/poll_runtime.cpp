@@ -0,0 +1,194 @@
+#include "omni/poll_runtime.hpp"
+#include "omni/placement.hpp"
+#include "omni/detail/published_entries.hpp"
+#include "omni/detail/spsc_queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace omni {
+
+struct PollRuntime::Impl {
+    struct Entry {
+        Entry(ChannelId channel_id, ConsumerHandle&& handle, Handler&& callback)
+            : id(channel_id), consumer(std::move(handle)), handler(std::move(callback)) {}
+
+        ChannelId id;
+        ConsumerHandle consumer;
+        Handler handler;
+    };
+
+    // Poll-thread-written loop counters (relaxed, single writer)
+    struct alignas(detail::CACHE_LINE_SIZE) LoopCounters {
+        std::atomic<uint64_t> loops{0};
+        std::atomic<uint64_t> empty_loops{0};
+        std::atomic<uint64_t> polls{0};
+        std::atomic<uint64_t> empty_polls{0};
+        std::atomic<uint64_t> messages{0};
+        std::atomic<uint64_t> max_loop_messages{0};
+    };
+
+    enum class StartState : int { Pending, Running, PinFailed };
+
+    const PollRuntimeConfig config_;
+
+    // Writer side: Start/Stop/AddChannel/RemoveChannel (never taken by the poll thread)
+    std::mutex writer_mutex_;
+    std::thread worker_;
+
+    // Published channel array; the poll thread is its only reader
+    detail::PublishedEntries<Entry> channels_;
+    detail::PublishedEntries<Entry>::Reader poll_reader_;
+    std::atomic<bool> stop_requested_{false};
+    std::atomic<bool> running_{false};
+    std::atomic<StartState> start_state_{StartState::Pending};
+    std::atomic<std::thread::id> poll_thread_id_{};
+
+    LoopCounters counters_;
+
+    explicit Impl(PollRuntimeConfig config)
+        : config_{.cpu = config.cpu, .batch_size = std::max<size_t>(config.batch_size, 1)}
+    {
+        channels_.AttachReader(poll_reader_);
+    }
+
+    [[nodiscard]] bool OnPollThread() const noexcept {
+        return poll_thread_id_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+    void Run() noexcept;
+};
+
+void PollRuntime::Impl::Run() noexcept {
+    poll_thread_id_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    if (config_.cpu >= 0 && !PinCurrentThread(config_.cpu)) {
+        start_state_.store(StartState::PinFailed, std::memory_order_release);
+        return;
+    }
+    start_state_.store(StartState::Running, std::memory_order_release);
+
+    const size_t batch_size = config_.batch_size;
+    while (!stop_requested_.load(std::memory_order_relaxed)) {
+        const auto& entries = channels_.Acquire(poll_reader_).entries;
+
+        uint64_t loop_messages = 0;
+        uint64_t empty_polls = 0;
+        for (Entry* entry : entries) {
+            const size_t handled = entry->consumer.DrainBatch(batch_size, entry->handler);
+            loop_messages += handled;
+            empty_polls += handled == 0 ? 1 : 0;
+        }
+
+        detail::AddRelaxed(counters_.loops, 1);
+        detail::AddRelaxed(counters_.polls, entries.size());
+        detail::AddRelaxed(counters_.empty_polls, empty_polls);
+        if (loop_messages == 0) {
+            detail::AddRelaxed(counters_.empty_loops, 1);
+        } else {
+            detail::AddRelaxed(counters_.messages, loop_messages);
+            if (loop_messages > counters_.max_loop_messages.load(std::memory_order_relaxed)) {
+                counters_.max_loop_messages.store(loop_messages, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+PollRuntime::PollRuntime(PollRuntimeConfig config)
+    : pimpl_(std::make_unique<Impl>(config))
+{
+}
+
+PollRuntime::~PollRuntime() {
+    Stop();
+}
+
+bool PollRuntime::Start() noexcept {
+    if (pimpl_->OnPollThread()) {
+        return false;
+    }
+    std::lock_guard lock(pimpl_->writer_mutex_);
+    if (pimpl_->running_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    pimpl_->stop_requested_.store(false, std::memory_order_relaxed);
+    pimpl_->start_state_.store(Impl::StartState::Pending, std::memory_order_relaxed);
+    try {
+        pimpl_->worker_ = std::thread([impl = pimpl_.get()]() { impl->Run(); });
+    } catch (const std::system_error&) {
+        return false;
+    }
+
+    Impl::StartState state;
+    while ((state = pimpl_->start_state_.load(std::memory_order_acquire)) == Impl::StartState::Pending) {
+        std::this_thread::yield();
+    }
+    if (state == Impl::StartState::PinFailed) {
+        pimpl_->worker_.join();
+        pimpl_->poll_thread_id_.store(std::thread::id{}, std::memory_order_relaxed);
+        return false;
+    }
+
+    // The poll thread acknowledges the current array on its first loop
+    pimpl_->running_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void PollRuntime::Stop() noexcept {
+    if (pimpl_->OnPollThread()) {
+        return;
+    }
+    std::lock_guard lock(pimpl_->writer_mutex_);
+    if (!pimpl_->running_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    pimpl_->stop_requested_.store(true, std::memory_order_relaxed);
+    pimpl_->worker_.join();
+    pimpl_->running_.store(false, std::memory_order_relaxed);
+    pimpl_->poll_thread_id_.store(std::thread::id{}, std::memory_order_relaxed);
+}
+
+bool PollRuntime::IsRunning() const noexcept {
+    return pimpl_->running_.load(std::memory_order_relaxed);
+}
+
+std::optional<PollRuntime::ChannelId> PollRuntime::AddChannel(ConsumerHandle&& consumer, Handler handler) noexcept {
+    if (!handler || pimpl_->OnPollThread()) {
+        return std::nullopt;
+    }
+    std::lock_guard lock(pimpl_->writer_mutex_);
+    // On failure the handle stays with the caller
+    return pimpl_->channels_.Add(pimpl_->running_.load(std::memory_order_relaxed),
+                                 std::move(consumer), std::move(handler));
+}
+
+std::optional<ConsumerHandle> PollRuntime::RemoveChannel(ChannelId id) noexcept {
+    if (pimpl_->OnPollThread()) {
+        return std::nullopt;
+    }
+    std::lock_guard lock(pimpl_->writer_mutex_);
+    auto entry = pimpl_->channels_.Remove(id, pimpl_->running_.load(std::memory_order_relaxed));
+    if (!entry) {
+        return std::nullopt;
+    }
+    // No loop can reach the entry any more
+    return std::optional<ConsumerHandle>(std::move(entry->consumer));
+}
+
+PollRuntime::Stats PollRuntime::GetStats() const noexcept {
+    const auto& counters = pimpl_->counters_;
+    return Stats{
+        .loops = counters.loops.load(std::memory_order_relaxed),
+        .empty_loops = counters.empty_loops.load(std::memory_order_relaxed),
+        .polls = counters.polls.load(std::memory_order_relaxed),
+        .empty_polls = counters.empty_polls.load(std::memory_order_relaxed),
+        .messages = counters.messages.load(std::memory_order_relaxed),
+        .max_loop_messages = counters.max_loop_messages.load(std::memory_order_relaxed),
+        .channels = pimpl_->channels_.Count()
+    };
+}
+
+} // namespace omni
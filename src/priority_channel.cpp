@@ -0,0 +1,275 @@
+#include "omni/priority_channel.hpp"
+#include "omni/detail/priority_wake.hpp"
+#include "omni/detail/wait_strategy.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <limits>
+
+namespace omni {
+
+// ============================================================================
+// PriorityProducer
+// ============================================================================
+
+PriorityProducer::PriorityProducer(std::vector<ProducerHandle> lanes,
+                                   std::shared_ptr<detail::PriorityWake> wake) noexcept
+    : lanes_(std::move(lanes)), wake_(std::move(wake)) {}
+
+PriorityProducer::~PriorityProducer() noexcept {
+    if (!wake_) {
+        return;  // Moved-from
+    }
+    // Mark every lane closed first (release stores of producer_alive), then
+    // bump the epoch so a consumer parked on it sees the close when it wakes
+    lanes_.clear();
+    wake_->epoch.fetch_add(1, std::memory_order_release);
+    wake_->epoch.notify_all();
+}
+
+PriorityProducer::PriorityProducer(PriorityProducer&&) noexcept = default;
+
+PriorityProducer& PriorityProducer::operator=(PriorityProducer&& other) noexcept {
+    if (this != &other) {
+        PriorityProducer closing(std::move(*this));  // Close and wake like the destructor
+        lanes_ = std::move(other.lanes_);
+        wake_ = std::move(other.wake_);
+    }
+    return *this;
+}
+
+PushResult PriorityProducer::TryPush(size_t lane, std::span<const uint8_t> data) noexcept {
+    if (lanes_.empty()) {
+        return PushResult::ChannelClosed;  // Moved-from
+    }
+    if (lane >= lanes_.size()) {
+        return PushResult::InvalidSize;
+    }
+    const PushResult result = lanes_[lane].TryPush(data);
+    if (result == PushResult::Success) {
+        NotifyConsumer();
+    }
+    return result;
+}
+
+PushResult PriorityProducer::BlockingPush(size_t lane, std::span<const uint8_t> data,
+                                          std::chrono::milliseconds timeout) noexcept {
+    if (lanes_.empty()) {
+        return PushResult::ChannelClosed;  // Moved-from
+    }
+    if (lane >= lanes_.size()) {
+        return PushResult::InvalidSize;
+    }
+    const PushResult result = lanes_[lane].BlockingPush(data, timeout);
+    if (result == PushResult::Success) {
+        NotifyConsumer();
+    }
+    return result;
+}
+
+size_t PriorityProducer::LaneCount() const noexcept {
+    return lanes_.size();
+}
+
+const ProducerHandle& PriorityProducer::Lane(size_t lane) const noexcept {
+    return lanes_[lane];
+}
+
+void PriorityProducer::NotifyConsumer() noexcept {
+    // Pairs with the fence in PriorityConsumer::BlockingPop(): either the
+    // consumer's re-check sees this message or this load sees it parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (wake_->consumer_parked.load(std::memory_order_relaxed)) {
+        wake_->epoch.fetch_add(1, std::memory_order_release);
+        wake_->epoch.notify_one();
+    }
+}
+
+// ============================================================================
+// PriorityConsumer
+// ============================================================================
+
+PriorityConsumer::PriorityConsumer(std::vector<ConsumerHandle> lanes, PriorityMode mode,
+                                   std::vector<uint32_t> weights,
+                                   std::shared_ptr<detail::PriorityWake> wake) noexcept
+    : lanes_(std::move(lanes)),
+      mode_(mode),
+      weights_(std::move(weights)),
+      credits_(weights_),
+      wake_(std::move(wake)) {}
+
+PriorityConsumer::~PriorityConsumer() noexcept = default;
+PriorityConsumer::PriorityConsumer(PriorityConsumer&&) noexcept = default;
+PriorityConsumer& PriorityConsumer::operator=(PriorityConsumer&&) noexcept = default;
+
+size_t PriorityConsumer::LaneCount() const noexcept {
+    return lanes_.size();
+}
+
+const ConsumerHandle& PriorityConsumer::Lane(size_t lane) const noexcept {
+    return lanes_[lane];
+}
+
+std::optional<size_t> PriorityConsumer::SelectLane() noexcept {
+    bool backlogged = false;
+    for (size_t i = 0; i < lanes_.size(); ++i) {
+        if (lanes_[i].AvailableMessages() == 0) {
+            continue;
+        }
+        if (mode_ == PriorityMode::Strict || credits_[i] > 0) {
+            return i;
+        }
+        backlogged = true;
+    }
+    if (!backlogged) {
+        return std::nullopt;
+    }
+
+    // Every backlogged lane spent its credit: start a new round
+    std::copy(weights_.begin(), weights_.end(), credits_.begin());
+    for (size_t i = 0; i < lanes_.size(); ++i) {
+        if (lanes_[i].AvailableMessages() > 0) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+size_t PriorityConsumer::Allowance(size_t lane) const noexcept {
+    if (mode_ == PriorityMode::Strict) {
+        return std::numeric_limits<size_t>::max();
+    }
+    return credits_[lane];
+}
+
+void PriorityConsumer::Charge(size_t lane, size_t count) noexcept {
+    last_lane_ = lane;
+    if (mode_ == PriorityMode::Weighted) {
+        credits_[lane] -= static_cast<uint32_t>(std::min<size_t>(count, credits_[lane]));
+    }
+}
+
+PopResult PriorityConsumer::NothingResult() const noexcept {
+    // All lanes share one producer object, so lane 0 speaks for all of them.
+    // Re-check the lanes after seeing it gone: a push may have landed just
+    // before the close.
+    if (!lanes_.empty() && lanes_.front().IsConnected()) {
+        return PopResult::Empty;
+    }
+    for (const auto& lane : lanes_) {
+        if (lane.AvailableMessages() > 0) {
+            return PopResult::Empty;
+        }
+    }
+    return PopResult::ChannelClosed;
+}
+
+std::pair<PopResult, std::optional<PriorityConsumer::Message>> PriorityConsumer::TryPop() noexcept {
+    if (const auto lane = SelectLane()) {
+        auto [result, message] = lanes_[*lane].TryPop();
+        if (result == PopResult::Success) {
+            Charge(*lane, 1);
+        }
+        return {result, std::move(message)};
+    }
+    return {NothingResult(), std::nullopt};
+}
+
+std::pair<PopResult, std::optional<PriorityConsumer::Message>> PriorityConsumer::BlockingPop(
+    std::chrono::milliseconds timeout) noexcept {
+    auto [result, message] = TryPop();
+    if (result != PopResult::Empty) {
+        return {result, std::move(message)};
+    }
+
+    if (timeout == std::chrono::milliseconds::max()) {
+        if (!wake_) {
+            return {PopResult::ChannelClosed, std::nullopt};  // Moved-from
+        }
+        while (true) {
+            // Announce the park, then re-check every lane: a push that missed
+            // the flag is seen here, one that saw it bumps the epoch
+            const uint32_t epoch = wake_->epoch.load(std::memory_order_acquire);
+            wake_->consumer_parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto [r, m] = TryPop();
+            if (r != PopResult::Empty) {
+                wake_->consumer_parked.store(false, std::memory_order_relaxed);
+                return {r, std::move(m)};
+            }
+
+            wake_->epoch.wait(epoch, std::memory_order_acquire);
+            wake_->consumer_parked.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    // Finite timeout: spin then yield across all lanes
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        detail::SpinWaitWithYield([this]() {
+            for (const auto& lane : lanes_) {
+                if (lane.AvailableMessages() > 0) {
+                    return true;
+                }
+            }
+            return false;
+        });
+
+        auto [r, m] = TryPop();
+        if (r != PopResult::Empty) {
+            return {r, std::move(m)};
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return {PopResult::Timeout, std::nullopt};
+        }
+    }
+}
+
+std::pair<PopResult, std::vector<PriorityConsumer::Message>> PriorityConsumer::BatchPop(
+    size_t max_count) noexcept {
+    std::vector<Message> messages;
+    if (max_count == 0) {
+        return {PopResult::Empty, std::move(messages)};
+    }
+    messages.reserve(std::min<size_t>(max_count, 64));
+
+    while (messages.size() < max_count) {
+        const auto lane = SelectLane();
+        if (!lane) {
+            break;
+        }
+        const size_t want = std::min(max_count - messages.size(), Allowance(*lane));
+        auto [result, batch] = lanes_[*lane].BatchPop(want);
+        if (result != PopResult::Success || batch.empty()) {
+            break;
+        }
+        Charge(*lane, batch.size());
+        std::move(batch.begin(), batch.end(), std::back_inserter(messages));
+    }
+
+    if (messages.empty()) {
+        return {NothingResult(), std::move(messages)};
+    }
+    return {PopResult::Success, std::move(messages)};
+}
+
+size_t PriorityConsumer::DrainBatch(size_t max_count, const BatchHandler& handler) noexcept {
+    size_t drained = 0;
+    while (drained < max_count) {
+        const auto lane = SelectLane();
+        if (!lane) {
+            break;
+        }
+        const size_t want = std::min(max_count - drained, Allowance(*lane));
+        const size_t count = lanes_[*lane].DrainBatch(want, handler);
+        if (count == 0) {
+            break;
+        }
+        Charge(*lane, count);
+        drained += count;
+    }
+    return drained;
+}
+
+} // namespace omni
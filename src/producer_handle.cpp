@@ -1,7 +1,13 @@
 #include "omni/producer_handle.hpp"
+#include "omni/placement.hpp"
 #include "omni/detail/spsc_queue.hpp"
 #include "omni/detail/wait_strategy.hpp"
 #include "omni/detail/queue_helpers.hpp"
+#include "omni/detail/saturation.hpp"
+#include "omni/detail/watermark.hpp"
+#include "omni/detail/trace.hpp"
+#include "omni/detail/flight_recorder.hpp"
+#include <algorithm>
 #include <atomic>
 #include <optional>
 #include <limits>
@@ -15,26 +21,96 @@ struct ProducerHandle::Impl {
     // Queue reference
     std::shared_ptr<detail::SPSCQueue> queue_;
     
-    // Statistics (atomic for thread-safe relaxed reads)
-    std::atomic<uint64_t> messages_sent_{0};
-    std::atomic<uint64_t> bytes_sent_{0};
-    std::atomic<uint64_t> failed_pushes_{0};
-    
     // Reservation tracking (nullopt = no active reservation)
     std::optional<size_t> reserved_slot_;
     
+    // Read index observed by the last Reserve() (depth sampling in Commit)
+    uint64_t observed_read_ = 0;
+    
+    // Producer watermark callback (producer thread only)
+    WatermarkCallback watermark_callback_;
+    detail::WatermarkThresholds watermark_thresholds_{};
+    bool watermark_above_ = false;
+    
+    // Ready-signal generation last acknowledged (producer thread only)
+    uint64_t ready_generation_ = 0;
+    
     // Constructor: Initialize with queue and signal producer alive
     explicit Impl(std::shared_ptr<detail::SPSCQueue> queue)
         : queue_(std::move(queue))
-        , messages_sent_(0)
-        , bytes_sent_(0)
-        , failed_pushes_(0)
         , reserved_slot_(std::nullopt)
     {
         // Signal producer is alive (release semantics for visibility)
         queue_->producer_alive.store(true, std::memory_order_release);
+        OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_PRODUCER, 1);
     }
-    };
+    
+    // Record depth after a push (or a full queue) and fire watermark crossings
+    void record_depth_(uint64_t depth, bool full) noexcept {
+        if (full) {
+            if (!queue_->saturation.in_full_episode) {
+                detail::RecordFlight(queue_->producer_flight, FlightEventType::QueueFull,
+                                     queue_->write_index.load(std::memory_order_relaxed), 0);
+            }
+            detail::RecordProducerFull(*queue_);
+        } else {
+            detail::RecordProducerDepth(*queue_, depth);
+        }
+        evaluate_watermarks_(depth);
+    }
+    
+    // Ready bitmap (FairMultiplexer): one acquire load when disarmed. Armed,
+    // the fence pairs with the multiplexer's fence after it clears the bit:
+    // either it sees this message or this load sees the bit clear. The RMW
+    // only happens on the clear -> set edge. The first armed push after a bind
+    // acknowledges it, ending the binder's polling of the ring.
+    void raise_ready_() noexcept {
+        auto& binding = queue_->ready_signal;
+        auto* word = binding.word.load(std::memory_order_acquire);
+        if (word == nullptr) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint64_t generation = binding.generation.load(std::memory_order_acquire);
+        if (generation != ready_generation_) {
+            ready_generation_ = generation;
+            binding.acknowledged.store(generation, std::memory_order_release);
+        }
+        const uint64_t mask = binding.mask.load(std::memory_order_relaxed);
+        if ((word->load(std::memory_order_relaxed) & mask) == 0) {
+            word->fetch_or(mask, std::memory_order_release);
+        }
+    }
+    
+    void evaluate_watermarks_(uint64_t depth) noexcept {
+        // Producer callback: one branch when none registered
+        if (watermark_callback_) {
+            if (auto event = detail::EvaluateWatermark(watermark_above_, depth, watermark_thresholds_)) {
+                watermark_callback_(*event, static_cast<size_t>(depth));
+            }
+        }
+        
+        // Broker observer: acquire load of a read-mostly line (plain mov on x86), observer pointer
+        // only loaded when a crossing fires
+        auto& binding = queue_->watermark_observer;
+        const uint64_t high = binding.high_slots.load(std::memory_order_acquire);
+        if (high == 0) {
+            if (binding.above) {
+                binding.above = false;  // Disarmed: restart hysteresis when re-armed
+            }
+            return;
+        }
+        const detail::WatermarkThresholds thresholds{
+            .high_slots = high,
+            .low_slots = binding.low_slots.load(std::memory_order_relaxed)
+        };
+        if (auto event = detail::EvaluateWatermark(binding.above, depth, thresholds)) {
+            if (auto observer = binding.observer.load(std::memory_order_acquire)) {
+                (*observer)(queue_->name, *event, static_cast<size_t>(depth));
+            }
+        }
+    }
+};
 
 // Constructor
 ProducerHandle::ProducerHandle(std::shared_ptr<detail::SPSCQueue> queue)
@@ -83,18 +159,20 @@ if (!detail::IsValidMessageSize(bytes, pimpl_->queue_->max_message_size)) {
     
     // 4. Check for queue full using utility function
     if (detail::IsQueueFull(write, read, pimpl_->queue_->capacity)) {
+        pimpl_->record_depth_(pimpl_->queue_->capacity - 1, true);
         return std::nullopt;  // Queue full (leave 1 slot empty to distinguish full/empty)
     }
     
     // 5. Calculate slot pointer using utility function
     uint8_t* slot = detail::GetSlotPointer(
-        pimpl_->queue_->buffer.get(),
+        pimpl_->queue_->slots,
         write,
         pimpl_->queue_->capacity,
         pimpl_->queue_->slot_size);
     
     // 6. Store reserved_slot in Impl
     pimpl_->reserved_slot_ = detail::GetSlotIndex(write, pimpl_->queue_->capacity);
+    pimpl_->observed_read_ = read;
     
     // 7. Return ReserveResult with pointer to payload using utility function
     return ReserveResult{
@@ -104,6 +182,17 @@ if (!detail::IsValidMessageSize(bytes, pimpl_->queue_->max_message_size)) {
 }
 
 bool ProducerHandle::Commit(size_t actual_bytes) noexcept {
+    return CommitDeadlineNs(actual_bytes, detail::NO_DEADLINE);
+}
+
+bool ProducerHandle::CommitWithDeadline(
+    size_t actual_bytes,
+    std::chrono::steady_clock::time_point deadline) noexcept
+{
+    return CommitDeadlineNs(actual_bytes, detail::ToDeadlineNs(deadline));
+}
+
+bool ProducerHandle::CommitDeadlineNs(size_t actual_bytes, uint64_t deadline_ns) noexcept {
 // 1. Validate preconditions using utility function
 if (!detail::IsValidMessageSize(actual_bytes, pimpl_->queue_->max_message_size)) {
     return false;
@@ -116,25 +205,33 @@ if (!detail::IsValidMessageSize(actual_bytes, pimpl_->queue_->max_message_size))
     // 2. Write size prefix to slot using utility function
     const size_t slot_index = pimpl_->reserved_slot_.value();
     uint8_t* slot = detail::GetSlotPointer(
-        pimpl_->queue_->buffer.get(),
+        pimpl_->queue_->slots,
         slot_index,
         pimpl_->queue_->capacity,
         pimpl_->queue_->slot_size);
     detail::WriteSizePrefix(slot, actual_bytes);
+    if (pimpl_->queue_->deadline_bytes != 0) {
+        detail::WriteDeadline(slot, deadline_ns);
+    }
     
     // 3. Load write_index (relaxed - own index)
     const uint64_t write = pimpl_->queue_->write_index.load(std::memory_order_relaxed);
     
     // 4. Store write_index + 1 (release) - ensures size + payload writes visible
-    // Release fence ensures size + payload writes visible
+    // The probe fires first: a spinning consumer may pop the message (and fire
+    // pop) as soon as the store lands
+    OMNI_TRACE(commit, pimpl_->queue_->id, write, actual_bytes);
     pimpl_->queue_->write_index.store(write + 1, std::memory_order_release);
+    detail::RecordFlight(pimpl_->queue_->producer_flight, FlightEventType::Push, write, actual_bytes);
     
     // 5. Call notify_one() on write_index
     pimpl_->queue_->write_index.notify_one();
+    pimpl_->raise_ready_();
     
-    // 6. Update statistics (relaxed)
-    pimpl_->messages_sent_.fetch_add(1, std::memory_order_relaxed);
-    pimpl_->bytes_sent_.fetch_add(actual_bytes, std::memory_order_relaxed);
+    // 6. Update statistics (relaxed, producer-owned cache line)
+    detail::AddRelaxed(pimpl_->queue_->producer_stats.messages_sent, 1);
+    detail::AddRelaxed(pimpl_->queue_->producer_stats.bytes_sent, actual_bytes);
+    pimpl_->record_depth_(write + 1 - pimpl_->observed_read_, false);
     
     // 7. Clear reserved_slot
     pimpl_->reserved_slot_.reset();
@@ -153,16 +250,17 @@ PushResult ProducerHandle::BlockingPush(
 {
     // 1. Validate preconditions using utility function
     if (!detail::IsValidMessageSize(data.size(), pimpl_->queue_->max_message_size)) {
-        pimpl_->failed_pushes_.fetch_add(1, std::memory_order_relaxed);
+        detail::AddRelaxed(pimpl_->queue_->producer_stats.failed_pushes, 1);
         return PushResult::InvalidSize;
     }
     
     const auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool parked = false;  // Flight recorder: one Park/Wake pair per call
     
     while (true) {
         // 2. Check if consumer is alive
         if (!pimpl_->queue_->consumer_alive.load(std::memory_order_relaxed)) {
-            pimpl_->failed_pushes_.fetch_add(1, std::memory_order_relaxed);
+            detail::AddRelaxed(pimpl_->queue_->producer_stats.failed_pushes, 1);
             return PushResult::ChannelClosed;
         }
         
@@ -176,31 +274,70 @@ PushResult ProducerHandle::BlockingPush(
             bool committed = Commit(data.size());
             if (!committed) {
                 // This should never happen if Reserve succeeded
-                pimpl_->failed_pushes_.fetch_add(1, std::memory_order_relaxed);
+                detail::AddRelaxed(pimpl_->queue_->producer_stats.failed_pushes, 1);
                 return PushResult::QueueFull;
             }
             
+            if (parked) {
+                detail::RecordFlight(pimpl_->queue_->producer_flight, FlightEventType::Wake,
+                                     pimpl_->queue_->write_index.load(std::memory_order_relaxed), 0);
+            }
             return PushResult::Success;
         }
         
         // 6. Check timeout
         const auto now = std::chrono::steady_clock::now();
         if (now >= deadline) {
-            pimpl_->failed_pushes_.fetch_add(1, std::memory_order_relaxed);
+            detail::AddRelaxed(pimpl_->queue_->producer_stats.failed_pushes, 1);
+            detail::RecordFlight(pimpl_->queue_->producer_flight, FlightEventType::Timeout,
+                                 pimpl_->queue_->write_index.load(std::memory_order_relaxed), 0);
             return PushResult::Timeout;
         }
         
+        if (!parked) {
+            detail::RecordFlight(pimpl_->queue_->producer_flight, FlightEventType::Park,
+                                 pimpl_->queue_->write_index.load(std::memory_order_relaxed), 0);
+            parked = true;
+        }
+        
         // 7. Spin-wait with yield for sub-microsecond p99 latency
         // Delegates to utility function for reuse across producer/consumer
+        OMNI_TRACE(producer_park, pimpl_->queue_->id,
+                   pimpl_->queue_->write_index.load(std::memory_order_relaxed),
+                   pimpl_->queue_->read_index.load(std::memory_order_relaxed));
         detail::SpinWaitWithYield([&]() {
             const uint64_t new_read = pimpl_->queue_->read_index.load(std::memory_order_acquire);
             const uint64_t current_write = pimpl_->queue_->write_index.load(std::memory_order_relaxed);
             return !detail::IsQueueFull(current_write, new_read, pimpl_->queue_->capacity);
         });
+        OMNI_TRACE(producer_wake, pimpl_->queue_->id,
+                   pimpl_->queue_->read_index.load(std::memory_order_relaxed));
     }
 }
 
 PushResult ProducerHandle::TryPush(std::span<const uint8_t> data) noexcept {
+    return TryPushDeadlineNs(data, detail::NO_DEADLINE);
+}
+
+PushResult ProducerHandle::TryPushWithDeadline(
+    std::span<const uint8_t> data,
+    std::chrono::steady_clock::time_point deadline) noexcept
+{
+    return TryPushDeadlineNs(data, detail::ToDeadlineNs(deadline));
+}
+
+PushResult ProducerHandle::TryPushWithTtl(
+    std::span<const uint8_t> data,
+    std::chrono::nanoseconds ttl) noexcept
+{
+    // Saturate instead of overflowing for very long TTLs; ttl <= 0 is already expired
+    const uint64_t now = detail::DeadlineNowNs();
+    const uint64_t ttl_ns = ttl.count() > 0 ? static_cast<uint64_t>(ttl.count()) : 0;
+    const uint64_t deadline_ns = now + std::min(ttl_ns, std::numeric_limits<uint64_t>::max() - now);
+    return TryPushDeadlineNs(data, deadline_ns == detail::NO_DEADLINE ? 1 : deadline_ns);
+}
+
+PushResult ProducerHandle::TryPushDeadlineNs(std::span<const uint8_t> data, uint64_t deadline_ns) noexcept {
 // 1. Validate preconditions using utility function
 if (!detail::IsValidMessageSize(data.size(), pimpl_->queue_->max_message_size)) {
     return PushResult::InvalidSize;
@@ -208,14 +345,14 @@ if (!detail::IsValidMessageSize(data.size(), pimpl_->queue_->max_message_size))
     
     // 2. Check if consumer is alive
     if (!pimpl_->queue_->consumer_alive.load(std::memory_order_relaxed)) {
-        pimpl_->failed_pushes_.fetch_add(1, std::memory_order_relaxed);
+        detail::AddRelaxed(pimpl_->queue_->producer_stats.failed_pushes, 1);
         return PushResult::ChannelClosed;
     }
     
     // 3. Reserve space
     auto result = Reserve(data.size());
     if (!result.has_value()) {
-        pimpl_->failed_pushes_.fetch_add(1, std::memory_order_relaxed);
+        detail::AddRelaxed(pimpl_->queue_->producer_stats.failed_pushes, 1);
         return PushResult::QueueFull;
     }
     
@@ -223,10 +360,10 @@ if (!detail::IsValidMessageSize(data.size(), pimpl_->queue_->max_message_size))
     std::memcpy(result->data, data.data(), data.size());
     
     // 5. Commit the message
-    bool committed = Commit(data.size());
+    bool committed = CommitDeadlineNs(data.size(), deadline_ns);
     if (!committed) {
         // This should never happen if Reserve succeeded
-        pimpl_->failed_pushes_.fetch_add(1, std::memory_order_relaxed);
+        detail::AddRelaxed(pimpl_->queue_->producer_stats.failed_pushes, 1);
         return PushResult::QueueFull;
     }
     
@@ -256,31 +393,36 @@ size_t ProducerHandle::BatchPush(
     
     size_t pushed = 0;
     size_t total_bytes = 0;
+    uint64_t depth = 0;  // Depth after last push, sampled once per batch
+    const uint64_t first = pimpl_->queue_->write_index.load(std::memory_order_relaxed);
+    bool full = false;
     
-    // 3. Loop through messages
+    // 3. Loop through messages (slots only; the batch is published once below)
     for (const auto& msg : messages) {
         // Check space availability (acquire remote read index)
-        const uint64_t write = pimpl_->queue_->write_index.load(std::memory_order_relaxed);
+        const uint64_t write = first + pushed;
         const uint64_t read = pimpl_->queue_->read_index.load(std::memory_order_acquire);
         
         if (detail::IsQueueFull(write, read, pimpl_->queue_->capacity)) {
-            break;  // Queue full - return partial count
+            full = true;
+            break;  // Queue full - return partial count (recorded once published)
         }
+        depth = write + 1 - read;
         
         // Write message (size prefix + payload) using utility functions
         uint8_t* slot = detail::GetSlotPointer(
-            pimpl_->queue_->buffer.get(),
+            pimpl_->queue_->slots,
             write,
             pimpl_->queue_->capacity,
             pimpl_->queue_->slot_size);
         
         // Write size prefix and payload using utility functions
         detail::WriteSizePrefix(slot, msg.size());
+        if (pimpl_->queue_->deadline_bytes != 0) {
+            detail::WriteDeadline(slot, detail::NO_DEADLINE);  // Slot may hold an old deadline
+        }
         std::memcpy(detail::GetPayloadPointer(slot), msg.data(), msg.size());
         
-        // Store write_index (release) - ensures size + payload writes visible
-        pimpl_->queue_->write_index.store(write + 1, std::memory_order_release);
-        
         // Increment counter
         ++pushed;
         total_bytes += msg.size();
@@ -292,16 +434,64 @@ size_t ProducerHandle::BatchPush(
     // For 1000 messages: saves ~65us (1000x65ns) vs ~65ns (single notify)
     // Result: 10-100x throughput improvement for high-frequency scenarios
     if (pushed > 0) {
+        // Probe before the release store (see Commit), which makes every
+        // size + payload write of the batch visible at once
+        OMNI_TRACE(batch_push, pimpl_->queue_->id, first, pushed, total_bytes);
+        pimpl_->queue_->write_index.store(first + pushed, std::memory_order_release);
+        detail::RecordFlight(pimpl_->queue_->producer_flight, FlightEventType::BatchPush, first, pushed);
         pimpl_->queue_->write_index.notify_one();
+        pimpl_->raise_ready_();
         
         // 5. Update statistics once (batch count)
-        pimpl_->messages_sent_.fetch_add(pushed, std::memory_order_relaxed);
-        pimpl_->bytes_sent_.fetch_add(total_bytes, std::memory_order_relaxed);
+        detail::AddRelaxed(pimpl_->queue_->producer_stats.messages_sent, pushed);
+        detail::AddRelaxed(pimpl_->queue_->producer_stats.bytes_sent, total_bytes);
+        if (pushed == messages.size()) {
+            pimpl_->record_depth_(depth, false);
+        }
+    }
+    if (full) {
+        pimpl_->record_depth_(pimpl_->queue_->capacity - 1, true);
     }
     
     return pushed;
 }
 
+bool ProducerHandle::SetWatermarkCallback(WatermarkConfig config, WatermarkCallback callback) noexcept {
+    if (!config.IsValid() || !callback) {
+        return false;
+    }
+    
+    pimpl_->watermark_thresholds_ = detail::ComputeWatermarkThresholds(pimpl_->queue_->capacity, config);
+    pimpl_->watermark_callback_ = std::move(callback);
+    pimpl_->watermark_above_ = false;
+    return true;
+}
+
+void ProducerHandle::ClearWatermarkCallback() noexcept {
+    pimpl_->watermark_callback_ = nullptr;
+    pimpl_->watermark_above_ = false;
+}
+
+size_t ProducerHandle::CheckWatermarks() noexcept {
+    // Same arithmetic as AvailableSlots(), but acquire so the depth is current
+    const uint64_t write = pimpl_->queue_->write_index.load(std::memory_order_relaxed);
+    const uint64_t read = pimpl_->queue_->read_index.load(std::memory_order_acquire);
+    const uint64_t depth = detail::ProducerDepth(write, read, pimpl_->queue_->capacity);
+    
+    pimpl_->evaluate_watermarks_(depth);
+    return static_cast<size_t>(depth);
+}
+
+bool ProducerHandle::ApplyPlacement() noexcept {
+    auto& placement = pimpl_->queue_->placement;
+    const int cpu = placement.planned_producer_cpu.load(std::memory_order_relaxed);
+    if (cpu < 0 || !PinCurrentThread(cpu)) {
+        return false;
+    }
+    placement.pinned_producer_cpu.store(cpu, std::memory_order_relaxed);
+    return true;
+}
+
 bool ProducerHandle::IsConnected() const noexcept {
     // Check consumer_alive flag (relaxed read)
     return pimpl_->queue_->consumer_alive.load(std::memory_order_relaxed);
@@ -325,15 +515,20 @@ size_t ProducerHandle::AvailableSlots() const noexcept {
 ChannelConfig ProducerHandle::GetConfig() const noexcept {
     return ChannelConfig{
         .capacity = pimpl_->queue_->capacity,
-        .max_message_size = pimpl_->queue_->max_message_size
+        .max_message_size = pimpl_->queue_->max_message_size,
+        .watermark_percent = pimpl_->queue_->watermark_percent,
+        .message_deadlines = pimpl_->queue_->deadline_bytes != 0
     };
 }
 
 ProducerHandle::Stats ProducerHandle::GetStats() const noexcept {
+    // Counters live on the shared queue so the broker can aggregate them
+    const auto& counters = pimpl_->queue_->producer_stats;
     return Stats{
-        .messages_sent = pimpl_->messages_sent_.load(std::memory_order_relaxed),
-        .bytes_sent = pimpl_->bytes_sent_.load(std::memory_order_relaxed),
-        .failed_pushes = pimpl_->failed_pushes_.load(std::memory_order_relaxed)
+        .messages_sent = counters.messages_sent.load(std::memory_order_relaxed),
+        .bytes_sent = counters.bytes_sent.load(std::memory_order_relaxed),
+        .failed_pushes = counters.failed_pushes.load(std::memory_order_relaxed),
+        .saturation = detail::ReadSaturation(*pimpl_->queue_)
     };
 }
 
@@ -345,9 +540,13 @@ ProducerHandle::~ProducerHandle() noexcept {
         
         // Signal producer is dead (release semantics)
         pimpl_->queue_->producer_alive.store(false, std::memory_order_release);
+        OMNI_TRACE(liveness, pimpl_->queue_->id, detail::TRACE_SIDE_PRODUCER, 0);
+        detail::RecordFlight(pimpl_->queue_->producer_flight, FlightEventType::Disconnect,
+                             pimpl_->queue_->write_index.load(std::memory_order_relaxed), 0);
         
         // Wake blocked consumer
         pimpl_->queue_->write_index.notify_one();
+        pimpl_->raise_ready_();
     }
 }
 
@@ -0,0 +1,196 @@
+#include "omni/state_channel.hpp"
+#include "omni/detail/spsc_queue.hpp"
+#include "omni/detail/queue_helpers.hpp"
+#include "omni/detail/seqlock.hpp"
+#include "omni/detail/trace.hpp"
+#include "omni/detail/flight_recorder.hpp"
+#include <atomic>
+
+namespace omni {
+
+// ============================================================================
+// StateProducer
+// ============================================================================
+
+StateProducer::StateProducer(std::shared_ptr<detail::SPSCQueue> queue) noexcept
+    : queue_(std::move(queue)) {
+    queue_->producer_alive.store(true, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_PRODUCER, 1);
+}
+
+StateProducer::~StateProducer() noexcept {
+    if (!queue_) {
+        return;  // Moved-from
+    }
+    // The last version is visible before the consumer can see the close
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    queue_->producer_alive.store(false, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_PRODUCER, 0);
+    detail::RecordFlight(queue_->producer_flight, FlightEventType::Disconnect,
+                         queue_->write_index.load(std::memory_order_relaxed), 0);
+}
+
+StateProducer::StateProducer(StateProducer&&) noexcept = default;
+
+StateProducer& StateProducer::operator=(StateProducer&& other) noexcept {
+    if (this != &other) {
+        StateProducer closing(std::move(*this));  // Close like the destructor
+        queue_ = std::move(other.queue_);
+    }
+    return *this;
+}
+
+PushResult StateProducer::Publish(std::span<const uint8_t> data) noexcept {
+    if (!queue_) {
+        return PushResult::ChannelClosed;  // Moved-from
+    }
+    auto& queue = *queue_;
+    if (!detail::IsValidMessageSize(data.size(), queue.max_message_size)) {
+        return PushResult::InvalidSize;
+    }
+    if (!queue.consumer_alive.load(std::memory_order_relaxed)) {
+        detail::AddRelaxed(queue.producer_stats.failed_pushes, 1);
+        return PushResult::ChannelClosed;
+    }
+
+    // Version `write + 1` goes to the buffer version `write` did not use;
+    // stamps as a lossy channel's: 2 * write + 1 while writing, then 2 * (write + 1)
+    const uint64_t write = queue.write_index.load(std::memory_order_relaxed);
+    auto& stamp = queue.stamps[detail::GetSlotIndex(write, queue.capacity)];
+    uint8_t* slot = detail::GetSlotPointer(queue.buffer.get(), write, queue.capacity, queue.slot_size);
+
+    stamp.store(2 * write + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const auto size = static_cast<uint32_t>(data.size());
+    detail::SeqlockStore(slot, reinterpret_cast<const uint8_t*>(&size), detail::SIZE_PREFIX_BYTES);
+    detail::SeqlockStore(detail::GetPayloadPointer(slot), data.data(), data.size());
+    stamp.store(2 * (write + 1), std::memory_order_release);
+    queue.write_index.store(write + 1, std::memory_order_release);
+
+    OMNI_TRACE(publish, queue.id, write, data.size());  // May be superseded unread: not a commit
+    detail::RecordFlight(queue.producer_flight, FlightEventType::Push, write, data.size());
+    detail::AddRelaxed(queue.producer_stats.messages_sent, 1);
+    detail::AddRelaxed(queue.producer_stats.bytes_sent, data.size());
+    return PushResult::Success;
+}
+
+bool StateProducer::IsConnected() const noexcept {
+    return queue_ && queue_->consumer_alive.load(std::memory_order_relaxed);
+}
+
+size_t StateProducer::MaxMessageSize() const noexcept {
+    return queue_ ? queue_->max_message_size : 0;
+}
+
+uint64_t StateProducer::Version() const noexcept {
+    return queue_ ? queue_->write_index.load(std::memory_order_relaxed) : 0;
+}
+
+// ============================================================================
+// StateConsumer
+// ============================================================================
+
+StateConsumer::StateConsumer(std::shared_ptr<detail::SPSCQueue> queue, std::vector<uint8_t> scratch) noexcept
+    : queue_(std::move(queue)), scratch_(std::move(scratch)) {
+    queue_->consumer_alive.store(true, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_CONSUMER, 1);
+}
+
+StateConsumer::~StateConsumer() noexcept {
+    if (!queue_) {
+        return;  // Moved-from
+    }
+    queue_->consumer_alive.store(false, std::memory_order_release);
+    OMNI_TRACE(liveness, queue_->id, detail::TRACE_SIDE_CONSUMER, 0);
+    detail::RecordFlight(queue_->consumer_flight, FlightEventType::Disconnect,
+                         queue_->read_index.load(std::memory_order_relaxed), 0);
+}
+
+StateConsumer::StateConsumer(StateConsumer&&) noexcept = default;
+
+StateConsumer& StateConsumer::operator=(StateConsumer&& other) noexcept {
+    if (this != &other) {
+        StateConsumer closing(std::move(*this));  // Close like the destructor
+        queue_ = std::move(other.queue_);
+        scratch_ = std::move(other.scratch_);
+        retries_ = other.retries_;
+    }
+    return *this;
+}
+
+std::pair<PopResult, std::optional<StateConsumer::Snapshot>> StateConsumer::Read() noexcept {
+    if (!queue_) {
+        return {PopResult::ChannelClosed, std::nullopt};  // Moved-from
+    }
+    auto& queue = *queue_;
+
+    while (true) {
+        const uint64_t version = queue.write_index.load(std::memory_order_acquire);
+        if (version == 0) {
+            // Acquire, then re-check: a publish before the close is seen here
+            const bool producer_alive = queue.producer_alive.load(std::memory_order_acquire);
+            if (queue.write_index.load(std::memory_order_acquire) != 0) {
+                continue;
+            }
+            if (producer_alive) {
+                return {PopResult::Empty, std::nullopt};
+            }
+            detail::AddRelaxed(queue.consumer_stats.failed_pops, 1);
+            return {PopResult::ChannelClosed, std::nullopt};
+        }
+
+        // Seqlock read of the newest buffer; a mismatch means the writer has
+        // since published twice and reused it, so start over from the version
+        const uint64_t index = version - 1;
+        const auto& stamp = queue.stamps[detail::GetSlotIndex(index, queue.capacity)];
+        const uint64_t expected = 2 * version;
+        if (stamp.load(std::memory_order_acquire) == expected) {
+            const uint8_t* slot = detail::GetSlotPointer(queue.buffer.get(), index, queue.capacity, queue.slot_size);
+            uint32_t size = 0;
+            detail::SeqlockLoad(reinterpret_cast<uint8_t*>(&size), slot, detail::SIZE_PREFIX_BYTES);
+            const bool sane = detail::IsValidMessageSize(size, queue.max_message_size);  // Torn sizes
+            if (sane) {
+                detail::SeqlockLoad(scratch_.data(), detail::GetPayloadPointer(slot), size);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sane && stamp.load(std::memory_order_relaxed) == expected) {
+                // Stats count versions seen, not reads: a hot reader re-reading
+                // the same version writes nothing
+                const uint64_t seen = queue.read_index.load(std::memory_order_relaxed);
+                if (version != seen) {
+                    queue.read_index.store(version, std::memory_order_release);
+                    OMNI_TRACE(pop, queue.id, index, size);
+                    detail::RecordFlight(queue.consumer_flight, FlightEventType::Pop, index, size);
+                    detail::AddRelaxed(queue.consumer_stats.messages_received, 1);
+                    detail::AddRelaxed(queue.consumer_stats.bytes_received, size);
+                    if (version - seen > 1) {
+                        detail::AddRelaxed(queue.consumer_stats.messages_lost, version - seen - 1);
+                    }
+                }
+                return {PopResult::Success, Snapshot{
+                    .data = std::span<const uint8_t>(scratch_.data(), size),
+                    .version = version
+                }};
+            }
+        }
+        ++retries_;
+    }
+}
+
+bool StateConsumer::ChangedSince(uint64_t version) const noexcept {
+    return queue_ && queue_->write_index.load(std::memory_order_acquire) > version;
+}
+
+uint64_t StateConsumer::Version() const noexcept {
+    return queue_ ? queue_->write_index.load(std::memory_order_acquire) : 0;
+}
+
+bool StateConsumer::IsConnected() const noexcept {
+    return queue_ && queue_->producer_alive.load(std::memory_order_relaxed);
+}
+
+size_t StateConsumer::MaxMessageSize() const noexcept {
+    return queue_ ? queue_->max_message_size : 0;
+}
+
+} // namespace omni
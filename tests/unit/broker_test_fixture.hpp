@@ -0,0 +1,98 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include "omni/mailbox_broker.hpp"
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+// Sequence number at offset 0, then (size - 8) copies of its low byte
+inline std::vector<uint8_t> Sample(uint64_t seq, size_t size = 16) {
+    std::vector<uint8_t> bytes(size, static_cast<uint8_t>(seq));
+    std::memcpy(bytes.data(), &seq, sizeof(seq));
+    return bytes;
+}
+
+inline uint64_t SeqOf(std::span<const uint8_t> data) {
+    uint64_t seq = 0;
+    std::memcpy(&seq, data.data(), sizeof(seq));
+    return seq;
+}
+
+// Test fixture for tests that open channels in MailboxBroker::Instance().
+//
+// Every channel a test opens through the helpers is removed in TearDown(),
+// after the test body has destroyed its handles. A name that is still taken
+// when a test starts therefore means some test leaked a handle: the request
+// fails with NameExists instead of being cleaned up silently.
+class BrokerChannelTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        auto& broker = omni::MailboxBroker::Instance();
+        for (const auto& name : opened_) {
+            broker.RemoveChannel(name);
+            EXPECT_FALSE(broker.HasChannel(name)) << "handles of " << name << " outlived the test";
+        }
+    }
+
+    // Removes `name` in TearDown() (channels created directly through the broker)
+    void Track(std::string name) {
+        opened_.push_back(std::move(name));
+    }
+
+    std::optional<omni::ChannelPair> MakeChannel(const std::string& name, omni::ChannelConfig config = {}) {
+        return Open(name, omni::MailboxBroker::Instance().RequestChannel(name, config));
+    }
+
+    // Channels prefix0 .. prefix<count - 1>
+    std::vector<omni::ChannelPair> MakeChannels(const std::string& prefix, size_t count,
+                                                omni::ChannelConfig config = {}) {
+        std::vector<omni::ChannelPair> channels;
+        for (size_t i = 0; i < count; ++i) {
+            if (auto channel = MakeChannel(prefix + std::to_string(i), config)) {
+                channels.push_back(std::move(*channel));
+            }
+        }
+        return channels;
+    }
+
+    std::optional<omni::LossyChannelPair> MakeLossyChannel(const std::string& name, omni::ChannelConfig config = {}) {
+        return Open(name, omni::MailboxBroker::Instance().RequestLossyChannel(name, config));
+    }
+
+    std::optional<omni::ConflatingChannelPair> MakeConflatingChannel(const std::string& name,
+                                                                     omni::ChannelConfig config = {}) {
+        return Open(name, omni::MailboxBroker::Instance().RequestConflatingChannel(name, config));
+    }
+
+    std::optional<omni::StateChannelPair> MakeStateChannel(const std::string& name, omni::ChannelConfig config = {}) {
+        return Open(name, omni::MailboxBroker::Instance().RequestStateChannel(name, config));
+    }
+
+    // Lanes are registered as <name>.lane<i>
+    std::optional<omni::PriorityChannelPair> MakePriorityChannel(const std::string& name,
+                                                                 omni::PriorityChannelConfig config = {}) {
+        auto [error, channel] = omni::MailboxBroker::Instance().RequestPriorityChannel(name, config);
+        EXPECT_EQ(error, omni::ChannelError::Success) << name;
+        if (channel) {
+            for (size_t i = 0; i < config.lanes.size(); ++i) {
+                Track(name + ".lane" + std::to_string(i));
+            }
+        }
+        return std::move(channel);
+    }
+
+private:
+    template<typename Pair>
+    std::optional<Pair> Open(const std::string& name, std::pair<omni::ChannelError, std::optional<Pair>> result) {
+        EXPECT_EQ(result.first, omni::ChannelError::Success) << name;
+        if (result.second) {
+            Track(name);
+        }
+        return std::move(result.second);
+    }
+
+    std::vector<std::string> opened_;
+};
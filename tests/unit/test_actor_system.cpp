@@ -0,0 +1,304 @@
+#include <gtest/gtest.h>
+#include "omni/actor_system.hpp"
+#include "omni/mailbox_broker.hpp"
+#include "omni/detail/work_stealing_deque.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+template<typename Pred>
+bool WaitFor(Pred pred, std::chrono::milliseconds timeout = 5000ms) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+std::vector<uint8_t> Encode(uint64_t value) {
+    std::vector<uint8_t> bytes(sizeof(value));
+    std::memcpy(bytes.data(), &value, sizeof(value));
+    return bytes;
+}
+
+uint64_t Decode(std::span<const uint8_t> bytes) {
+    uint64_t value = 0;
+    std::memcpy(&value, bytes.data(), sizeof(value));
+    return value;
+}
+
+} // namespace
+
+TEST(WorkStealingDequeTest, OwnerIsLifoThievesAreFifo) {
+    omni::detail::WorkStealingDeque<int> deque(4);
+    int items[5] = {0, 1, 2, 3, 4};
+    EXPECT_TRUE(deque.Empty());
+    EXPECT_EQ(deque.Pop(), nullptr);
+    EXPECT_EQ(deque.Steal(), nullptr);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(deque.Push(&items[i]));
+    }
+    EXPECT_FALSE(deque.Push(&items[4]));  // Bounded
+
+    EXPECT_EQ(deque.Pop(), &items[3]);
+    EXPECT_EQ(deque.Steal(), &items[0]);
+    EXPECT_EQ(deque.Pop(), &items[2]);
+    EXPECT_EQ(deque.Pop(), &items[1]);
+    EXPECT_EQ(deque.Pop(), nullptr);
+    EXPECT_TRUE(deque.Empty());
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealsNeitherLoseNorDuplicate) {
+    constexpr int kItems = 100'000;
+    constexpr int kThieves = 3;
+    omni::detail::WorkStealingDeque<int> deque(1024);
+    std::vector<int> items(kItems);
+    std::vector<std::atomic<int>> taken(kItems);
+    std::atomic<bool> done{false};
+
+    auto take = [&](int* item) { taken[item - items.data()].fetch_add(1, std::memory_order_relaxed); };
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < kThieves; ++t) {
+        thieves.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire) || !deque.Empty()) {
+                if (int* item = deque.Steal()) {
+                    take(item);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < kItems; ++i) {
+        while (!deque.Push(&items[i])) {
+            if (int* item = deque.Pop()) {
+                take(item);
+            }
+        }
+        if (i % 3 == 0) {
+            if (int* item = deque.Pop()) {
+                take(item);
+            }
+        }
+    }
+    while (int* item = deque.Pop()) {
+        take(item);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (int i = 0; i < kItems; ++i) {
+        ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+    }
+}
+
+TEST(ActorSystemTest, PingRingDeliversEveryHop) {
+    constexpr size_t kRing = 8;
+    constexpr uint64_t kHops = 10'000;
+
+    omni::ActorSystem system({.workers = 2});
+    EXPECT_EQ(system.WorkerCount(), 2);
+
+    // Each actor forwards the decremented counter to its successor
+    std::vector<std::unique_ptr<omni::ActorRef>> next(kRing);
+    std::atomic<bool> finished{false};
+    std::vector<omni::ActorId> ids;
+    for (size_t i = 0; i < kRing; ++i) {
+        auto id = system.Spawn([&next, &finished, i](omni::ActorContext&, std::span<const uint8_t> message) {
+            const uint64_t remaining = Decode(message);
+            if (remaining == 0) {
+                finished.store(true, std::memory_order_release);
+                return;
+            }
+            while (next[i]->Send(Encode(remaining - 1)) == omni::PushResult::QueueFull) {
+            }
+        });
+        ASSERT_TRUE(id.has_value());
+        ids.push_back(*id);
+    }
+    for (size_t i = 0; i < kRing; ++i) {
+        auto ref = system.Connect(ids[(i + 1) % kRing]);
+        ASSERT_TRUE(ref.has_value());
+        next[i] = std::make_unique<omni::ActorRef>(std::move(*ref));
+    }
+
+    auto start = system.Connect(ids[0]);
+    ASSERT_TRUE(start.has_value());
+    ASSERT_EQ(start->Send(Encode(kHops)), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return finished.load(std::memory_order_acquire); }));
+
+    // Counters are bumped after the batch returns
+    ASSERT_TRUE(WaitFor([&] { return system.GetStats().messages == kHops + 1; }));
+    const auto stats = system.GetStats();
+    EXPECT_EQ(stats.actors, kRing);
+    EXPECT_GE(stats.runs, 1);
+
+    system.Shutdown();
+    EXPECT_EQ(system.GetStats().actors, 0);
+}
+
+TEST(ActorSystemTest, FanInFromManySendersAndBatchYield) {
+    constexpr int kSenders = 4;
+    constexpr uint64_t kPerSender = 5'000;
+
+    omni::ActorSystem system({.workers = 2, .batch_size = 8});
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> count{0};
+    auto sink = system.Spawn([&](omni::ActorContext&, std::span<const uint8_t> message) {
+        sum.fetch_add(Decode(message), std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_release);
+    });
+    ASSERT_TRUE(sink.has_value());
+
+    std::vector<std::thread> senders;
+    for (int s = 0; s < kSenders; ++s) {
+        auto ref = system.Connect(*sink);
+        ASSERT_TRUE(ref.has_value());
+        EXPECT_EQ(ref->Target(), *sink);
+        senders.emplace_back([ref = std::move(*ref)]() mutable {
+            for (uint64_t i = 1; i <= kPerSender; ++i) {
+                while (ref.Send(Encode(i)) == omni::PushResult::QueueFull) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& sender : senders) {
+        sender.join();
+    }
+
+    ASSERT_TRUE(WaitFor([&] { return count.load(std::memory_order_acquire) == kSenders * kPerSender; }));
+    EXPECT_EQ(sum.load(), kSenders * kPerSender * (kPerSender + 1) / 2);
+    ASSERT_TRUE(WaitFor([&] { return system.GetStats().messages == kSenders * kPerSender; }));
+
+    // Full mailboxes outrun an 8-message batch, so the actor must have yielded
+    const auto stats = system.GetStats();
+    EXPECT_GT(stats.yields, 0);
+    EXPECT_GE(stats.runs, kSenders * kPerSender / 8);
+}
+
+TEST(ActorSystemTest, StopClosesMailbox) {
+    omni::ActorSystem system({.workers = 1});
+    std::atomic<int> handled{0};
+    auto id = system.Spawn([&](omni::ActorContext& context, std::span<const uint8_t>) {
+        handled.fetch_add(1);
+        context.Stop();
+    });
+    ASSERT_TRUE(id.has_value());
+    auto ref = system.Connect(*id);
+    ASSERT_TRUE(ref.has_value());
+
+    ASSERT_EQ(ref->Send(Encode(1)), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return ref->Send(Encode(2)) == omni::PushResult::ChannelClosed; }));
+    EXPECT_EQ(handled.load(), 1);
+    EXPECT_EQ(system.GetStats().actors, 0);
+    EXPECT_FALSE(system.Connect(*id).has_value());
+
+    // Moved-from refs are closed too
+    omni::ActorRef moved = std::move(*ref);
+    EXPECT_EQ(ref->Send(Encode(3)), omni::PushResult::ChannelClosed);
+    EXPECT_EQ(ref->Target(), 0);
+    EXPECT_EQ(moved.Target(), *id);
+}
+
+TEST(ActorSystemTest, BehaviorsSpawnAndConnect) {
+    omni::ActorSystem system({.workers = 2});
+    std::atomic<uint64_t> echoed{0};
+    auto leaf = system.Spawn([&](omni::ActorContext&, std::span<const uint8_t> message) {
+        echoed.store(Decode(message), std::memory_order_release);
+    });
+    ASSERT_TRUE(leaf.has_value());
+
+    // Root spawns a child on first message and forwards to it through a new channel
+    std::unique_ptr<omni::ActorRef> child;
+    auto root = system.Spawn([&](omni::ActorContext& context, std::span<const uint8_t> message) {
+        if (!child) {
+            auto id = context.System().Spawn([&, leaf_id = *leaf](omni::ActorContext& inner, std::span<const uint8_t> data) {
+                auto to_leaf = inner.System().Connect(leaf_id);
+                if (to_leaf) {
+                    (void)to_leaf->Send(Encode(Decode(data) + inner.Self()));
+                }
+            });
+            child = std::make_unique<omni::ActorRef>(*context.System().Connect(*id));
+        }
+        (void)child->Send(message);
+    });
+    ASSERT_TRUE(root.has_value());
+
+    auto ref = system.Connect(*root);
+    ASSERT_TRUE(ref.has_value());
+    ASSERT_EQ(ref->Send(Encode(100)), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return echoed.load(std::memory_order_acquire) != 0; }));
+    EXPECT_EQ(echoed.load(), 100 + child->Target());
+    EXPECT_EQ(system.GetStats().actors, 3);
+    system.Shutdown();  // Before child goes away
+}
+
+TEST(ActorSystemTest, ShutdownClosesRefsAndReleasesChannels) {
+    auto& broker = omni::MailboxBroker::Instance();
+    const size_t channels_before = broker.GetStats().active_channels;
+
+    auto system = std::make_unique<omni::ActorSystem>(omni::ActorSystemConfig{.workers = 1, .max_actors = 2});
+    auto a = system->Spawn([](omni::ActorContext&, std::span<const uint8_t>) {});
+    auto b = system->Spawn([](omni::ActorContext&, std::span<const uint8_t>) {});
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    EXPECT_FALSE(system->Spawn([](omni::ActorContext&, std::span<const uint8_t>) {}).has_value());
+    EXPECT_FALSE(system->Spawn(nullptr).has_value());
+    EXPECT_FALSE(system->Connect(12345).has_value());
+
+    // Mailboxes are owned by the system, never registered in the broker
+    auto ref = system->Connect(*a, {.capacity = 8, .max_message_size = 64});
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(broker.GetStats().active_channels, channels_before);
+    EXPECT_EQ(system->GetStats().mailboxes, 1);
+
+    system.reset();
+    EXPECT_EQ(ref->Send(Encode(1)), omni::PushResult::ChannelClosed);
+    ref.reset();
+    EXPECT_EQ(broker.GetStats().active_channels, channels_before);
+}
+
+TEST(ActorSystemTest, ClosedMailboxesArePrunedOnceDrained) {
+    omni::ActorSystem system({.workers = 1});
+    std::atomic<uint64_t> handled{0};
+    auto id = system.Spawn([&](omni::ActorContext&, std::span<const uint8_t>) {
+        handled.fetch_add(1, std::memory_order_release);
+    });
+    ASSERT_TRUE(id.has_value());
+
+    auto keep = system.Connect(*id);
+    ASSERT_TRUE(keep.has_value());
+    std::vector<omni::ActorRef> transient;
+    for (int i = 0; i < 4; ++i) {
+        auto ref = system.Connect(*id);
+        ASSERT_TRUE(ref.has_value());
+        ASSERT_EQ(ref->Send(Encode(i)), omni::PushResult::Success);
+        transient.push_back(std::move(*ref));
+    }
+    EXPECT_EQ(system.GetStats().mailboxes, 5);
+    ASSERT_TRUE(WaitFor([&] { return handled.load(std::memory_order_acquire) == 4; }));
+
+    // Dropping a ref does not schedule the actor; its next run prunes
+    transient.clear();
+    ASSERT_EQ(keep->Send(Encode(9)), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return system.GetStats().mailboxes == 1; }));
+    EXPECT_EQ(handled.load(), 5);
+    ASSERT_EQ(keep->Send(Encode(10)), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return handled.load(std::memory_order_acquire) == 6; }));
+}
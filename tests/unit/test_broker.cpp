@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "omni/mailbox_broker.hpp"
+#include <string>
+#include <vector>
 
 // Test that Instance() returns a singleton (same reference every time)
 TEST(BrokerTest, Singleton) {
@@ -200,6 +202,215 @@ TEST(BrokerTest, GetStats) {
     EXPECT_EQ(stats_after.total_channels_created, created_before + 1);
 }
 
+// Test GetStats aggregates message and byte counters across channels
+TEST(BrokerTest, GetStatsAggregatesTraffic) {
+    auto& broker = omni::MailboxBroker::Instance();
+    
+    const auto before = broker.GetStats();
+    
+    auto [error1, channel1] = broker.RequestChannel("test-stats-aggregate-1");
+    auto [error2, channel2] = broker.RequestChannel("test-stats-aggregate-2");
+    ASSERT_EQ(error1, omni::ChannelError::Success);
+    ASSERT_EQ(error2, omni::ChannelError::Success);
+    
+    std::vector<uint8_t> small(10, 0x11);
+    std::vector<uint8_t> large(100, 0x22);
+    ASSERT_EQ(channel1->producer.TryPush(small), omni::PushResult::Success);
+    ASSERT_EQ(channel1->producer.TryPush(small), omni::PushResult::Success);
+    ASSERT_EQ(channel2->producer.TryPush(large), omni::PushResult::Success);
+    
+    const auto after = broker.GetStats();
+    EXPECT_EQ(after.total_messages_sent, before.total_messages_sent + 3);
+    EXPECT_EQ(after.total_bytes_transferred, before.total_bytes_transferred + 120);
+}
+
+// Test removed channels keep contributing to broker totals
+TEST(BrokerTest, GetStatsIncludesRemovedChannels) {
+    auto& broker = omni::MailboxBroker::Instance();
+    
+    const auto before = broker.GetStats();
+    {
+        auto [error, channel] = broker.RequestChannel("test-stats-retired");
+        ASSERT_EQ(error, omni::ChannelError::Success);
+        std::vector<uint8_t> payload(32, 0x33);
+        ASSERT_EQ(channel->producer.TryPush(payload), omni::PushResult::Success);
+    }
+    ASSERT_TRUE(broker.RemoveChannel("test-stats-retired"));
+    
+    const auto after = broker.GetStats();
+    EXPECT_EQ(after.total_messages_sent, before.total_messages_sent + 1);
+    EXPECT_EQ(after.total_bytes_transferred, before.total_bytes_transferred + 32);
+}
+
+// Test GetChannelStats reports producer and consumer counters for one channel
+TEST(BrokerTest, GetChannelStats) {
+    auto& broker = omni::MailboxBroker::Instance();
+    
+    EXPECT_FALSE(broker.GetChannelStats("test-channel-stats-missing").has_value());
+    
+    auto [error, channel] = broker.RequestChannel("test-channel-stats", {
+        .capacity = 8,
+        .max_message_size = 64
+    });
+    ASSERT_EQ(error, omni::ChannelError::Success);
+    
+    std::vector<uint8_t> payload(16, 0x44);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(channel->producer.TryPush(payload), omni::PushResult::Success);
+    }
+    auto [result, msg] = channel->consumer.TryPop();
+    ASSERT_EQ(result, omni::PopResult::Success);
+    
+    auto stats = broker.GetChannelStats("test-channel-stats");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->name, "test-channel-stats");
+    EXPECT_EQ(stats->capacity, 8);
+    EXPECT_EQ(stats->max_message_size, 64);
+    EXPECT_EQ(stats->depth, 2);
+    EXPECT_EQ(stats->messages_sent, 3);
+    EXPECT_EQ(stats->bytes_sent, 48);
+    EXPECT_EQ(stats->failed_pushes, 0);
+    EXPECT_EQ(stats->messages_received, 1);
+    EXPECT_EQ(stats->bytes_received, 16);
+    EXPECT_EQ(stats->failed_pops, 0);
+    EXPECT_TRUE(stats->producer_alive);
+    EXPECT_TRUE(stats->consumer_alive);
+    EXPECT_EQ(stats->saturation.max_depth, 3);
+    EXPECT_EQ(stats->saturation.full_events, 0);
+}
+
+// Test configured watermarks propagate to the channel
+TEST(BrokerTest, ChannelWatermarkConfig) {
+    auto& broker = omni::MailboxBroker::Instance();
+    
+    auto [error, channel] = broker.RequestChannel("test-channel-watermarks", {
+        .capacity = 64,
+        .max_message_size = 64,
+        .watermark_percent = {95, 25, 75}  // Normalized to ascending order
+    });
+    ASSERT_EQ(error, omni::ChannelError::Success);
+    
+    const auto config = channel->consumer.GetConfig();
+    EXPECT_EQ(config.watermark_percent[0], 25);
+    EXPECT_EQ(config.watermark_percent[1], 75);
+    EXPECT_EQ(config.watermark_percent[2], 95);
+    
+    auto stats = broker.GetChannelStats("test-channel-watermarks");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->saturation.watermark_percent, config.watermark_percent);
+}
 
+// Test ForEachChannelStats visits registered channels and allows re-entry
+TEST(BrokerTest, ForEachChannelStats) {
+    auto& broker = omni::MailboxBroker::Instance();
+    
+    auto [error, channel] = broker.RequestChannel("test-foreach-stats");
+    ASSERT_EQ(error, omni::ChannelError::Success);
+    std::vector<uint8_t> payload(8, 0x55);
+    ASSERT_EQ(channel->producer.TryPush(payload), omni::PushResult::Success);
+    
+    size_t visited = 0;
+    bool found = false;
+    broker.ForEachChannelStats([&](const omni::MailboxBroker::ChannelStats& stats) {
+        ++visited;
+        if (stats.name == "test-foreach-stats") {
+            found = true;
+            EXPECT_EQ(stats.messages_sent, 1);
+            EXPECT_EQ(stats.depth, 1);
+        }
+        // Visitor runs outside the registry lock, so broker calls are safe
+        EXPECT_TRUE(broker.HasChannel(stats.name));
+    });
+    
+    EXPECT_TRUE(found);
+    EXPECT_EQ(visited, broker.GetStats().active_channels);
+}
 
+// Test broker watermark observer arms existing and new channels
+TEST(BrokerTest, WatermarkObserver) {
+    auto& broker = omni::MailboxBroker::Instance();
+    
+    auto [error1, existing] = broker.RequestChannel("test-watermark-existing", {.capacity = 16});
+    ASSERT_EQ(error1, omni::ChannelError::Success);
+    
+    std::vector<std::pair<std::string, omni::WatermarkEvent>> events;
+    EXPECT_FALSE(broker.SetWatermarkObserver({.high_percent = 0, .low_percent = 0},
+                                             [](std::string_view, omni::WatermarkEvent, size_t) {}));
+    ASSERT_TRUE(broker.SetWatermarkObserver({.high_percent = 80, .low_percent = 50},
+        [&events](std::string_view channel, omni::WatermarkEvent event, size_t) {
+            if (channel.starts_with("test-watermark-")) {
+                events.emplace_back(std::string(channel), event);
+            }
+        }));
+    
+    auto [error2, created] = broker.RequestChannel("test-watermark-created", {.capacity = 16});
+    ASSERT_EQ(error2, omni::ChannelError::Success);
+    
+    // 15 usable slots: High at depth 12, Low at depth 7
+    std::vector<uint8_t> payload(8, 0x33);
+    for (int i = 0; i < 12; ++i) {
+        ASSERT_EQ(existing->producer.TryPush(payload), omni::PushResult::Success);
+        ASSERT_EQ(created->producer.TryPush(payload), omni::PushResult::Success);
+    }
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0], std::make_pair(std::string("test-watermark-existing"), omni::WatermarkEvent::High));
+    EXPECT_EQ(events[1], std::make_pair(std::string("test-watermark-created"), omni::WatermarkEvent::High));
+    
+    // Drain to the low threshold; the producer observes it on its next check
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(existing->consumer.TryPop().first, omni::PopResult::Success);
+    }
+    EXPECT_EQ(existing->producer.CheckWatermarks(), 7u);
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[2].second, omni::WatermarkEvent::Low);
+    
+    // Empty observer disarms every channel
+    ASSERT_TRUE(broker.SetWatermarkObserver({}, nullptr));
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(existing->producer.TryPush(payload), omni::PushResult::Success);
+    }
+    EXPECT_EQ(events.size(), 3u);
+}
+
+// Test channels get distinct non-zero ids (carried by trace probes)
+TEST(BrokerTest, ChannelIds) {
+    auto& broker = omni::MailboxBroker::Instance();
+    
+    auto [error1, first] = broker.RequestChannel("test-channel-id-1");
+    auto [error2, second] = broker.RequestChannel("test-channel-id-2");
+    ASSERT_EQ(error1, omni::ChannelError::Success);
+    ASSERT_EQ(error2, omni::ChannelError::Success);
+    
+    const auto stats1 = broker.GetChannelStats("test-channel-id-1");
+    const auto stats2 = broker.GetChannelStats("test-channel-id-2");
+    ASSERT_TRUE(stats1.has_value());
+    ASSERT_TRUE(stats2.has_value());
+    EXPECT_NE(stats1->id, 0u);
+    EXPECT_EQ(stats2->id, stats1->id + 1);
+}
 
+// Test flight recorder dump through the broker
+TEST(BrokerTest, DumpFlightRecorder) {
+    auto& broker = omni::MailboxBroker::Instance();
+    EXPECT_FALSE(broker.DumpFlightRecorder("test-flight-missing").has_value());
+    
+    auto [error, channel] = broker.RequestChannel("test-flight-recorder", {.capacity = 8});
+    ASSERT_EQ(error, omni::ChannelError::Success);
+    
+    // 7 usable slots: the 8th push starts a full episode, the 9th is the same episode
+    std::vector<uint8_t> payload(16, 0x77);
+    for (int i = 0; i < 9; ++i) {
+        (void)channel->producer.TryPush(payload);
+    }
+    ASSERT_EQ(channel->consumer.TryPop().first, omni::PopResult::Success);
+    
+    auto events = broker.DumpFlightRecorder("test-flight-recorder");
+    ASSERT_TRUE(events.has_value());
+    ASSERT_EQ(events->size(), 9u);
+    EXPECT_EQ((*events)[0].type, omni::FlightEventType::Push);
+    EXPECT_EQ((*events)[0].value, 16u);
+    EXPECT_EQ((*events)[7].type, omni::FlightEventType::QueueFull);
+    EXPECT_EQ((*events)[7].index, 7u);
+    EXPECT_EQ((*events)[8].type, omni::FlightEventType::Pop);
+    EXPECT_EQ((*events)[8].index, 0u);
+}
@@ -118,3 +118,26 @@ TEST(EnumTest, ChannelErrorValues) {
     EXPECT_NE(ChannelError::Success, ChannelError::InvalidConfig);
     EXPECT_NE(ChannelError::Success, ChannelError::AllocationFailed);
 }
+
+TEST(ConfigTest, NormalizeWatermarks) {
+    // Test: Watermarks clamp to [1, 100] and are sorted ascending
+    ChannelConfig config;
+    config.watermark_percent = {120, 0, 60};
+    auto normalized = config.Normalize();
+    EXPECT_EQ(normalized.watermark_percent[0], 1);
+    EXPECT_EQ(normalized.watermark_percent[1], 60);
+    EXPECT_EQ(normalized.watermark_percent[2], 100);
+    EXPECT_TRUE(normalized.IsValid());
+}
+
+TEST(ConfigTest, IsValidWatermarks) {
+    // Test: Defaults are valid, descending or out-of-range values are not
+    ChannelConfig config;
+    EXPECT_TRUE(config.IsValid());
+    
+    config.watermark_percent = {80, 50, 95};
+    EXPECT_FALSE(config.IsValid());
+    
+    config.watermark_percent = {0, 50, 95};
+    EXPECT_FALSE(config.IsValid());
+}
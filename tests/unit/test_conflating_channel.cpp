@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "broker_test_fixture.hpp"
+#include "omni/conflating_channel.hpp"
+#include "omni/mailbox_broker.hpp"
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ConflatingChannelTest = BrokerChannelTest;
+
+TEST_F(ConflatingChannelTest, LatestValuePerKeyInFirstDirtyOrder) {
+    auto channel = MakeConflatingChannel("test-conflate-order", {.capacity = 8, .max_message_size = 64});
+    ASSERT_TRUE(channel.has_value());
+    auto& [producer, consumer] = *channel;
+    EXPECT_EQ(producer.Capacity(), 8);
+
+    // Keys dirtied in the order 30, 10, 20; 30 and 10 updated again after
+    ASSERT_EQ(producer.TryPush(30, Sample(1)), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPush(10, Sample(2)), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPush(30, Sample(3)), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPush(20, Sample(4)), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPush(10, Sample(5)), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPush(30, Sample(6, 40)), omni::PushResult::Success);
+    EXPECT_EQ(producer.KeyCount(), 3);
+    EXPECT_EQ(consumer.DirtyKeys(), 3);
+    EXPECT_EQ(omni::MailboxBroker::Instance().GetChannelStats("test-conflate-order")->depth, 3);
+
+    auto [r1, m1] = consumer.TryPop();
+    ASSERT_EQ(r1, omni::PopResult::Success);
+    EXPECT_EQ(m1->key, 30);
+    EXPECT_EQ(SeqOf(m1->data), 6);
+    EXPECT_EQ(m1->data.size(), 40);  // Value replaced whole, size included
+    EXPECT_EQ(m1->conflated, 2);
+
+    std::vector<std::pair<uint64_t, uint64_t>> drained;
+    EXPECT_EQ(consumer.DrainBatch(8, [&](uint64_t key, std::span<const uint8_t> data) {
+        drained.emplace_back(key, SeqOf(data));
+    }), 2);
+    EXPECT_EQ(drained, (std::vector<std::pair<uint64_t, uint64_t>>{{10, 5}, {20, 4}}));
+    EXPECT_EQ(consumer.TryPop().first, omni::PopResult::Empty);
+
+    // A delivered key goes back into the queue, behind keys dirtied before it
+    ASSERT_EQ(producer.TryPush(20, Sample(7)), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPush(30, Sample(8)), omni::PushResult::Success);
+    EXPECT_EQ(consumer.TryPop().second->key, 20);
+    auto [r2, m2] = consumer.TryPop();
+    ASSERT_EQ(r2, omni::PopResult::Success);
+    EXPECT_EQ(m2->key, 30);
+    EXPECT_EQ(SeqOf(m2->data), 8);
+    EXPECT_EQ(m2->conflated, 0);
+
+    EXPECT_EQ(consumer.ConflatedMessages(), 3);
+    const auto stats = omni::MailboxBroker::Instance().GetChannelStats("test-conflate-order");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->messages_sent, 8);
+    EXPECT_EQ(stats->messages_received, 5);
+    EXPECT_EQ(stats->messages_lost, 3);
+    EXPECT_EQ(stats->depth, 0);
+}
+
+TEST_F(ConflatingChannelTest, KeyTableLimitsSizesAndDisconnect) {
+    auto channel = MakeConflatingChannel("test-conflate-close", {.capacity = 8, .max_message_size = 64});
+    ASSERT_TRUE(channel.has_value());
+    auto producer = std::move(channel->producer);
+    auto consumer = std::move(channel->consumer);
+
+    EXPECT_EQ(producer.TryPush(1, {}), omni::PushResult::InvalidSize);
+    EXPECT_EQ(producer.TryPush(1, Sample(0, 65)), omni::PushResult::InvalidSize);
+    EXPECT_EQ(channel->producer.TryPush(1, Sample(0)), omni::PushResult::ChannelClosed);  // Moved-from
+
+    // Sparse keys (colliding low bits) fill the table; a ninth key does not fit
+    for (uint64_t i = 0; i < 8; ++i) {
+        ASSERT_EQ(producer.TryPush(i << 40, Sample(i)), omni::PushResult::Success);
+    }
+    EXPECT_EQ(producer.TryPush(99, Sample(9)), omni::PushResult::QueueFull);
+    EXPECT_EQ(producer.TryPush(3ULL << 40, Sample(10, 61)), omni::PushResult::Success);  // Known key still updates
+    EXPECT_EQ(producer.KeyCount(), 8);
+
+    { auto gone = std::move(producer); }
+    EXPECT_FALSE(consumer.IsConnected());
+
+    // Dirty keys are drained before the close is reported
+    size_t delivered = 0;
+    EXPECT_EQ(consumer.DrainBatch(3, [&](uint64_t, std::span<const uint8_t>) { ++delivered; }), 3);
+    while (true) {
+        auto [result, message] = consumer.TryPop();
+        if (result != omni::PopResult::Success) {
+            EXPECT_EQ(result, omni::PopResult::ChannelClosed);
+            break;
+        }
+        if (message->key == 3ULL << 40) {
+            EXPECT_EQ(message->data.size(), 61);
+            EXPECT_EQ(message->data.back(), 10);
+        }
+        ++delivered;
+    }
+    EXPECT_EQ(delivered, 8);
+
+    // Consumer gone: the producer is told instead of writing into the void
+    auto other = MakeConflatingChannel("test-conflate-close-2", {.capacity = 8});
+    ASSERT_TRUE(other.has_value());
+    { auto gone = std::move(other->consumer); }
+    EXPECT_FALSE(other->producer.IsConnected());
+    EXPECT_EQ(other->producer.TryPush(1, Sample(0)), omni::PushResult::ChannelClosed);
+}
+
+TEST_F(ConflatingChannelTest, ConcurrentUpdatesDeliverEveryFinalValueUntorn) {
+    constexpr uint64_t kKeys = 16;
+    constexpr uint64_t kUpdates = 200'000;
+    auto channel = MakeConflatingChannel("test-conflate-race", {.capacity = kKeys, .max_message_size = 128});
+    ASSERT_TRUE(channel.has_value());
+
+    std::thread producer([producer = std::move(channel->producer)]() mutable {
+        for (uint64_t seq = 0; seq < kUpdates; ++seq) {
+            // Sizes vary so a torn read would also show as a wrong length
+            (void)producer.TryPush(seq % kKeys, Sample(seq, 8 + seq % 113));
+        }
+    });
+
+    std::vector<uint64_t> last(kKeys, 0);  // Newest sequence delivered + 1
+    uint64_t received = 0;
+    bool torn = false;
+    bool stale = false;
+    while (true) {
+        auto [result, message] = channel->consumer.TryPop();
+        if (result == omni::PopResult::Empty) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (result != omni::PopResult::Success) {
+            EXPECT_EQ(result, omni::PopResult::ChannelClosed);
+            break;
+        }
+        const uint64_t seq = SeqOf(message->data);
+        torn |= seq % kKeys != message->key || message->data.size() != 8 + seq % 113;
+        for (size_t i = 8; i < message->data.size(); ++i) {
+            torn |= message->data[i] != static_cast<uint8_t>(seq);
+        }
+        stale |= seq + 1 <= last[message->key];  // Never the same or an older value twice
+        last[message->key] = seq + 1;
+        ++received;
+    }
+    producer.join();
+
+    EXPECT_FALSE(torn);
+    EXPECT_FALSE(stale);
+    for (uint64_t key = 0; key < kKeys; ++key) {
+        EXPECT_EQ(last[key], kUpdates - kKeys + key + 1) << "key " << key;  // Final update of each key
+    }
+    EXPECT_EQ(received + channel->consumer.ConflatedMessages(), kUpdates);
+}
@@ -5,6 +5,7 @@
 #include <thread>
 #include <chrono>
 #include <vector>
+#include <algorithm>
 
 using namespace omni;
 using namespace std::chrono_literals;
@@ -176,6 +177,39 @@ TEST_F(ConsumerHandleTest, BatchPopSingleNotify) {
     EXPECT_EQ(push_result, PushResult::Success);
 }
 
+// Test: DrainBatch hands messages over in place and releases slots once per batch
+TEST_F(ConsumerHandleTest, DrainBatch) {
+    auto producer = ProducerHandle::CreateForTesting_(queue_);
+    auto consumer = ConsumerHandle::CreateForTesting_(queue_);
+    
+    for (int i = 0; i < 5; ++i) {
+        std::string msg = "Message " + std::to_string(i);
+        std::vector<uint8_t> data(msg.begin(), msg.end());
+        ASSERT_EQ(producer.TryPush(std::span<const uint8_t>(data)), PushResult::Success);
+    }
+    
+    std::vector<std::string> received;
+    uint64_t read_index_during_handler = 0;
+    const ConsumerHandle::BatchHandler handler = [&](std::span<const uint8_t> data) {
+        received.emplace_back(data.begin(), data.end());
+        read_index_during_handler = queue_->read_index.load();
+    };
+    
+    // Limited batch: slots are only released after the last handler call
+    EXPECT_EQ(consumer.DrainBatch(3, handler), 3);
+    EXPECT_EQ(read_index_during_handler, 0);
+    EXPECT_EQ(queue_->read_index.load(), 3);
+    
+    EXPECT_EQ(consumer.DrainBatch(10, handler), 2);
+    EXPECT_EQ(consumer.DrainBatch(10, handler), 0);
+    EXPECT_EQ(consumer.DrainBatch(0, handler), 0);
+    
+    ASSERT_EQ(received.size(), 5);
+    EXPECT_EQ(received.front(), "Message 0");
+    EXPECT_EQ(received.back(), "Message 4");
+    EXPECT_EQ(consumer.GetStats().messages_received, 5);
+}
+
 // Test: Destructor signals producer
 TEST_F(ConsumerHandleTest, Destructor) {
     auto producer = ProducerHandle::CreateForTesting_(queue_);
@@ -281,3 +315,75 @@ TEST_F(ConsumerHandleTest, MoveSemantics) {
     // Moved-from handles should be safe to destroy
     // (destructor checks pimpl_ validity)
 }
+
+// Test: Statistics are stored on the shared queue and count every pop path once
+TEST_F(ConsumerHandleTest, StatsSharedWithQueue) {
+    auto producer = ProducerHandle::CreateForTesting_(queue_);
+    auto consumer = ConsumerHandle::CreateForTesting_(queue_);
+    
+    std::vector<uint8_t> data(10, 0x42);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(producer.TryPush(data), PushResult::Success);
+    }
+    
+    // TryPop + BatchPop with timeout (first message via BlockingPop)
+    auto [r1, m1] = consumer.TryPop();
+    ASSERT_EQ(r1, PopResult::Success);
+    auto [r2, batch] = consumer.BatchPop(10, 10ms);
+    ASSERT_EQ(r2, PopResult::Success);
+    ASSERT_EQ(batch.size(), 3);
+    
+    auto stats = consumer.GetStats();
+    EXPECT_EQ(stats.messages_received, 4);
+    EXPECT_EQ(stats.bytes_received, 40);
+    EXPECT_EQ(queue_->consumer_stats.messages_received.load(), 4);
+    EXPECT_EQ(queue_->producer_stats.messages_sent.load(), 4);
+}
+
+// Test: Pop latency trigger dumps the flight recorder for slow waits only
+TEST_F(ConsumerHandleTest, PopLatencyTrigger) {
+    auto producer = ProducerHandle::CreateForTesting_(queue_);
+    auto consumer = ConsumerHandle::CreateForTesting_(queue_);
+    std::vector<uint8_t> data(8, 0x42);
+    
+    std::vector<FlightEvent> captured;
+    std::chrono::nanoseconds captured_latency{0};
+    EXPECT_FALSE(consumer.SetPopLatencyTrigger(0ns, [](auto, auto) {}));
+    ASSERT_TRUE(consumer.SetPopLatencyTrigger(5ms,
+        [&](std::chrono::nanoseconds latency, std::span<const FlightEvent> events) {
+            captured_latency = latency;
+            captured.assign(events.begin(), events.end());
+        }));
+    
+    // Immediate pop is not timed
+    ASSERT_EQ(producer.TryPush(data), PushResult::Success);
+    ASSERT_EQ(consumer.BlockingPop(1s).first, PopResult::Success);
+    EXPECT_TRUE(captured.empty());
+    
+    // Pop that waits past the threshold fires with the recent history
+    std::thread producer_thread([&producer, &data]() {
+        std::this_thread::sleep_for(20ms);
+        (void)producer.TryPush(data);
+    });
+    ASSERT_EQ(consumer.BlockingPop(1s).first, PopResult::Success);
+    producer_thread.join();
+    
+    EXPECT_GE(captured_latency, 5ms);
+    ASSERT_GE(captured.size(), 5u);
+    const auto count = [&captured](FlightEventType type) {
+        return std::count_if(captured.begin(), captured.end(),
+                             [type](const FlightEvent& e) { return e.type == type; });
+    };
+    EXPECT_EQ(count(FlightEventType::Push), 2);
+    EXPECT_EQ(count(FlightEventType::Pop), 2);
+    EXPECT_EQ(count(FlightEventType::Park), 1);
+    EXPECT_EQ(count(FlightEventType::Wake), 1);
+    EXPECT_EQ(captured.back().type, FlightEventType::Wake);
+    
+    // Cleared trigger no longer fires; dump still available on demand
+    consumer.ClearPopLatencyTrigger();
+    captured.clear();
+    EXPECT_EQ(consumer.BlockingPop(10ms).first, PopResult::Timeout);
+    EXPECT_TRUE(captured.empty());
+    EXPECT_EQ(consumer.DumpFlightRecorder().back().type, FlightEventType::Timeout);
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "broker_test_fixture.hpp"
+#include "omni/consumer_pool.hpp"
+#include "omni/mailbox_broker.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr omni::ChannelConfig kConfig{.capacity = 64, .max_message_size = 64};
+
+template<typename Pred>
+bool WaitFor(Pred pred, std::chrono::milliseconds timeout = 5000ms) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+// Per-channel handler state: checks order and that drains never overlap
+struct ChannelProbe {
+    std::atomic<bool> inside{false};
+    std::atomic<uint64_t> next{0};
+    std::atomic<uint64_t> received{0};
+    std::atomic<bool> overlap{false};
+    std::atomic<bool> out_of_order{false};
+
+    omni::ConsumerPool::Handler MakeHandler(std::chrono::microseconds work = 0us) {
+        return [this, work](std::span<const uint8_t> data) {
+            if (inside.exchange(true)) {
+                overlap.store(true);
+            }
+            if (SeqOf(data) != next.load(std::memory_order_relaxed)) {
+                out_of_order.store(true);
+            }
+            next.store(next.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (work > 0us) {
+                std::this_thread::sleep_for(work);
+            }
+            inside.store(false);
+            received.fetch_add(1, std::memory_order_release);
+        };
+    }
+};
+
+} // namespace
+
+using ConsumerPoolTest = BrokerChannelTest;
+
+TEST_F(ConsumerPoolTest, DrainsEveryChannelInOrderWithoutOverlap) {
+    constexpr size_t kChannels = 16;
+    constexpr uint64_t kPerChannel = 2'000;
+
+    auto channels = MakeChannels("test-pool-order-", kChannels, kConfig);
+    std::vector<ChannelProbe> probes(kChannels);
+    omni::ConsumerPool pool({.workers = 4, .batch_size = 8});
+    EXPECT_EQ(pool.WorkerCount(), 4);
+
+    for (size_t i = 0; i < kChannels; ++i) {
+        ASSERT_TRUE(pool.AddChannel(std::move(channels[i].consumer), probes[i].MakeHandler()).has_value());
+    }
+    EXPECT_EQ(pool.GetStats().channels, kChannels);
+
+    // One producer thread per channel
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < kChannels; ++i) {
+        producers.emplace_back([&producer = channels[i].producer] {
+            for (uint64_t n = 0; n < kPerChannel; ++n) {
+                while (producer.TryPush(Sample(n)) == omni::PushResult::QueueFull) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    for (size_t i = 0; i < kChannels; ++i) {
+        ASSERT_TRUE(WaitFor([&] { return probes[i].received.load(std::memory_order_acquire) == kPerChannel; }))
+            << "channel " << i;
+        EXPECT_FALSE(probes[i].overlap.load()) << "channel " << i;
+        EXPECT_FALSE(probes[i].out_of_order.load()) << "channel " << i;
+    }
+
+    ASSERT_TRUE(WaitFor([&] { return pool.GetStats().messages == kChannels * kPerChannel; }));
+    const auto stats = pool.GetStats();
+    EXPECT_GE(stats.drains, kChannels * kPerChannel / 8);
+    EXPECT_GT(stats.passes, 0);
+}
+
+TEST_F(ConsumerPoolTest, IdleWorkersStealFromOverloadedOne) {
+    // With 2 workers, even-indexed channels are polled by worker 0
+    constexpr size_t kChannels = 8;
+    auto channels = MakeChannels("test-pool-steal-", kChannels, kConfig);
+    std::vector<ChannelProbe> probes(kChannels);
+    omni::ConsumerPool pool({.workers = 2, .batch_size = 1});
+
+    for (size_t i = 0; i < kChannels; ++i) {
+        ASSERT_TRUE(pool.AddChannel(std::move(channels[i].consumer), probes[i].MakeHandler(200us)).has_value());
+    }
+
+    // Load only worker 0's home channels; slow handlers leave the rest queued
+    uint64_t sent = 0;
+    for (uint64_t n = 0; n < 20; ++n) {
+        for (size_t i = 0; i < kChannels; i += 2) {
+            ASSERT_EQ(channels[i].producer.TryPush(Sample(n)), omni::PushResult::Success);
+            ++sent;
+        }
+    }
+    ASSERT_TRUE(WaitFor([&] { return pool.GetStats().messages == sent; }));
+
+    const auto stats = pool.GetStats();
+    EXPECT_GT(stats.steals, 0);
+    EXPECT_GT(pool.WorkerMessages(0), 0);
+    EXPECT_GT(pool.WorkerMessages(1), 0);
+    EXPECT_EQ(pool.WorkerMessages(2), 0);
+    for (size_t i = 0; i < kChannels; i += 2) {
+        EXPECT_FALSE(probes[i].overlap.load());
+        EXPECT_FALSE(probes[i].out_of_order.load());
+    }
+}
+
+TEST_F(ConsumerPoolTest, AddRemoveAndShutdown) {
+    auto channels = MakeChannels("test-pool-remove-", 2, kConfig);
+    ChannelProbe probe_a;
+    ChannelProbe probe_b;
+    omni::ConsumerPool pool({.workers = 2, .max_channels = 2});
+
+    auto id_a = pool.AddChannel(std::move(channels[0].consumer), probe_a.MakeHandler());
+    auto id_b = pool.AddChannel(std::move(channels[1].consumer), probe_b.MakeHandler());
+    ASSERT_TRUE(id_a.has_value());
+    ASSERT_TRUE(id_b.has_value());
+    EXPECT_NE(*id_a, *id_b);
+
+    // Full pool and empty handler both leave the handle with the caller
+    auto extra_channels = MakeChannels("test-pool-remove-extra-", 1, kConfig);
+    auto& extra = extra_channels[0];
+    EXPECT_FALSE(pool.AddChannel(std::move(extra.consumer), probe_a.MakeHandler()).has_value());
+    EXPECT_FALSE(pool.AddChannel(std::move(extra.consumer), nullptr).has_value());
+    EXPECT_TRUE(extra.consumer.IsConnected());
+
+    ASSERT_EQ(channels[0].producer.TryPush(Sample(0)), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return probe_a.received.load() == 1; }));
+
+    auto consumer_a = pool.RemoveChannel(*id_a);
+    ASSERT_TRUE(consumer_a.has_value());
+    EXPECT_FALSE(pool.RemoveChannel(*id_a).has_value());
+    EXPECT_EQ(pool.GetStats().channels, 1);
+
+    // Removed channel is no longer drained
+    ASSERT_EQ(channels[0].producer.TryPush(Sample(1)), omni::PushResult::Success);
+    ASSERT_EQ(channels[1].producer.TryPush(Sample(0)), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return probe_b.received.load() == 1; }));
+    EXPECT_EQ(probe_a.received.load(), 1);
+    auto [result, message] = consumer_a->TryPop();
+    ASSERT_EQ(result, omni::PopResult::Success);
+    EXPECT_EQ(SeqOf(message->Data()), 1);
+
+    // After shutdown, channels can still be taken back but not added
+    pool.Shutdown();
+    pool.Shutdown();
+    EXPECT_FALSE(pool.AddChannel(std::move(*consumer_a), probe_a.MakeHandler()).has_value());
+    EXPECT_TRUE(pool.RemoveChannel(*id_b).has_value());
+}
+
+TEST_F(ConsumerPoolTest, HandlerCannotReenterPool) {
+    auto channels = MakeChannels("test-pool-reenter-", 1, kConfig);
+    omni::ConsumerPool pool({.workers = 1});
+    std::atomic<int> outcome{0};
+    std::optional<omni::ConsumerPool::ChannelId> id;
+    id = pool.AddChannel(std::move(channels[0].consumer), [&](std::span<const uint8_t>) {
+        outcome.store(pool.RemoveChannel(*id).has_value() ? 2 : 1);
+    });
+    ASSERT_TRUE(id.has_value());
+
+    ASSERT_EQ(channels[0].producer.TryPush(Sample(0)), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return outcome.load() != 0; }));
+    EXPECT_EQ(outcome.load(), 1);
+}
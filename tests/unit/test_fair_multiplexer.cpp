@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "broker_test_fixture.hpp"
+#include "omni/fair_multiplexer.hpp"
+#include "omni/mailbox_broker.hpp"
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr omni::ChannelConfig kConfig{.capacity = 1024, .max_message_size = 256};
+
+void Fill(omni::ProducerHandle& producer, size_t count, size_t bytes) {
+    const std::vector<uint8_t> payload(bytes, 0xAB);
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(producer.TryPush(payload), omni::PushResult::Success);
+    }
+}
+
+} // namespace
+
+using FairMultiplexerTest = BrokerChannelTest;
+
+TEST_F(FairMultiplexerTest, SharesBacklogByWeightInMessages) {
+    auto channels = MakeChannels("test-fair-msgs-", 3, kConfig);
+    omni::FairMultiplexer mux({.quantum = 4});
+    std::vector<omni::FairMultiplexer::SourceId> ids;
+    const uint32_t weights[] = {1, 2, 4};
+    for (size_t i = 0; i < 3; ++i) {
+        Fill(channels[i].producer, 500, 8);
+        auto id = mux.AddSource(std::move(channels[i].consumer), weights[i]);
+        ASSERT_TRUE(id.has_value());
+        ids.push_back(*id);
+    }
+    EXPECT_EQ(mux.SourceCount(), 3);
+
+    // Every round grants 4, 8 and 16 messages while all are backlogged
+    std::map<omni::FairMultiplexer::SourceId, size_t> served;
+    for (int round = 0; round < 10; ++round) {
+        EXPECT_EQ(mux.Poll([&](omni::FairMultiplexer::SourceId id, std::span<const uint8_t>) { ++served[id]; }),
+                  28);
+    }
+    EXPECT_EQ(served[ids[0]], 40);
+    EXPECT_EQ(served[ids[1]], 80);
+    EXPECT_EQ(served[ids[2]], 160);
+
+    const auto stats = mux.GetSourceStats(ids[2]);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->messages, 160);
+    EXPECT_EQ(stats->bytes, 160 * 8);
+    EXPECT_EQ(stats->visits, 10);
+    EXPECT_EQ(stats->weight, 4);
+    EXPECT_EQ(mux.GetStats().rounds, 10);
+}
+
+TEST_F(FairMultiplexerTest, ByteModeChargesMessageSize) {
+    auto channels = MakeChannels("test-fair-bytes-", 2, kConfig);
+    omni::FairMultiplexer mux({.unit = omni::FairShareUnit::Bytes, .quantum = 1024});
+    Fill(channels[0].producer, 200, 256);  // Large messages
+    Fill(channels[1].producer, 800, 16);   // Small messages
+    auto large = mux.AddSource(std::move(channels[0].consumer));
+    auto small = mux.AddSource(std::move(channels[1].consumer));
+    ASSERT_TRUE(large && small);
+
+    for (int round = 0; round < 8; ++round) {
+        mux.Poll([](omni::FairMultiplexer::SourceId, std::span<const uint8_t>) {});
+    }
+
+    // Equal weights: equal bytes, very different message counts
+    const auto large_stats = *mux.GetSourceStats(*large);
+    const auto small_stats = *mux.GetSourceStats(*small);
+    EXPECT_EQ(large_stats.bytes, 8 * 1024);
+    EXPECT_EQ(small_stats.bytes, 8 * 1024);
+    EXPECT_EQ(large_stats.messages, 8 * 4);
+    EXPECT_EQ(small_stats.messages, 8 * 64);
+}
+
+TEST_F(FairMultiplexerTest, ReadyBitmapSkipsIdleSources) {
+    auto channels = MakeChannels("test-fair-idle-", 100, {.capacity = 64, .max_message_size = 16});
+    omni::FairMultiplexer mux({.max_sources = 128});
+    std::vector<omni::FairMultiplexer::SourceId> ids;
+    for (auto& channel : channels) {
+        ids.push_back(*mux.AddSource(std::move(channel.consumer)));
+    }
+    const auto handler = [](omni::FairMultiplexer::SourceId, std::span<const uint8_t>) {};
+
+    EXPECT_EQ(mux.Poll(handler), 0);
+    EXPECT_EQ(mux.GetStats().empty_polls, 1);
+
+    // Only the sources that were pushed to are visited
+    Fill(channels[7].producer, 3, 4);
+    Fill(channels[93].producer, 2, 4);
+    EXPECT_EQ(mux.Poll(handler), 5);
+    EXPECT_EQ(mux.GetStats().visits, 2);
+    EXPECT_EQ(mux.Poll(handler), 0);
+    EXPECT_EQ(mux.GetStats().visits, 2);
+
+    // A push from another thread is found through the bitmap too
+    std::thread producer([&] { Fill(channels[42].producer, 1, 4); });
+    producer.join();
+    EXPECT_EQ(mux.Poll(handler), 1);
+    EXPECT_EQ(mux.GetSourceStats(ids[42])->messages, 1);
+}
+
+TEST_F(FairMultiplexerTest, BindRacingSinglePushesStrandsNothing) {
+    constexpr size_t kRounds = 2000;
+    auto channels = MakeChannels("test-fair-bind-race-", 1, {.capacity = 64, .max_message_size = 16});
+    ASSERT_EQ(channels.size(), 1);
+    auto& producer = channels[0].producer;
+    std::optional<omni::ConsumerHandle> consumer = std::move(channels[0].consumer);
+    const auto handler = [](omni::FairMultiplexer::SourceId, std::span<const uint8_t>) {};
+
+    // Each round binds while one message is pushed, then polls without
+    // further pushes: the message must be found on an otherwise idle channel
+    for (size_t round = 0; round < kRounds; ++round) {
+        omni::FairMultiplexer mux;
+        std::atomic<bool> go{false};
+        std::thread pusher([&] {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            Fill(producer, 1, 8);
+        });
+        go.store(true, std::memory_order_release);
+        auto id = mux.AddSource(std::move(*consumer));
+        ASSERT_TRUE(id.has_value());
+        pusher.join();
+
+        size_t handled = 0;
+        for (int poll = 0; poll < 4 && handled == 0; ++poll) {
+            handled += mux.Poll(handler);
+        }
+        ASSERT_EQ(handled, 1) << "round " << round;
+        consumer = mux.RemoveSource(*id);
+        ASSERT_TRUE(consumer.has_value());
+    }
+}
+
+TEST_F(FairMultiplexerTest, RemoveCloseAndLimits) {
+    auto channels = MakeChannels("test-fair-remove-", 3, kConfig);
+    omni::FairMultiplexer mux({.max_sources = 1});  // Rounded up to 64
+    EXPECT_FALSE(mux.AddSource(std::move(channels[0].consumer), 0).has_value());
+    auto id = mux.AddSource(std::move(channels[0].consumer));
+    auto closing = mux.AddSource(std::move(channels[1].consumer));
+    ASSERT_TRUE(id && closing);
+    EXPECT_FALSE(mux.SetWeight(*id, 0));
+    EXPECT_TRUE(mux.SetWeight(*id, 3));
+    EXPECT_EQ(mux.GetSourceStats(*id)->weight, 3);
+
+    // Producer gone: the close raises the bit and the source is marked closed
+    Fill(channels[1].producer, 1, 4);
+    { auto gone = std::move(channels[1].producer); }
+    EXPECT_EQ(mux.Poll([](omni::FairMultiplexer::SourceId, std::span<const uint8_t>) {}), 1);
+    EXPECT_TRUE(mux.GetSourceStats(*closing)->closed);
+
+    // A removed source is no longer drained; its messages stay in the handle
+    auto consumer = mux.RemoveSource(*id);
+    ASSERT_TRUE(consumer.has_value());
+    EXPECT_FALSE(mux.RemoveSource(*id).has_value());
+    Fill(channels[0].producer, 2, 4);
+    EXPECT_EQ(mux.Poll([](omni::FairMultiplexer::SourceId, std::span<const uint8_t>) {}), 0);
+    EXPECT_EQ(consumer->AvailableMessages(), 2);
+    EXPECT_EQ(mux.SourceCount(), 1);
+}
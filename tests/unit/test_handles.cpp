@@ -4,6 +4,8 @@
 #include <memory>
 #include <limits>
 #include <chrono>
+#include <thread>
+#include <vector>
 
 // Test fixture with friend access to ProducerHandle
 class ProducerHandleTestFixture : public ::testing::Test {
@@ -734,3 +736,98 @@ TEST_F(ProducerHandleTestFixture, BatchPushWraparound) {
     EXPECT_EQ(stats.bytes_sent, 9);  // 1 byte × 9 messages
 }
 
+// Test saturation tracking: peak depth, full episodes and watermark time
+TEST_F(ProducerHandleTestFixture, SaturationStats) {
+    // Capacity 8 = 7 usable slots; watermarks 50/80/95% -> 4/6/7 slots
+    auto queue = std::make_shared<omni::detail::SPSCQueue>(8, 64);
+    auto producer = CreateTestProducerFromQueue(queue);
+    std::vector<uint8_t> data(8, 0x5A);
+    
+    auto stats = producer.GetStats();
+    EXPECT_EQ(stats.saturation.max_depth, 0);
+    EXPECT_EQ(stats.saturation.full_events, 0);
+    EXPECT_EQ(stats.saturation.watermark_percent[1], 80);
+    
+    // Fill to the 50% watermark only
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(producer.TryPush(data), omni::PushResult::Success);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    stats = producer.GetStats();
+    EXPECT_EQ(stats.saturation.max_depth, 4);
+    EXPECT_GT(stats.saturation.time_above_ns[0], 0);
+    EXPECT_EQ(stats.saturation.time_above_ns[1], 0);
+    
+    // Fill completely; repeated QueueFull within one episode counts once
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(producer.TryPush(data), omni::PushResult::Success);
+    }
+    EXPECT_EQ(producer.TryPush(data), omni::PushResult::QueueFull);
+    EXPECT_EQ(producer.TryPush(data), omni::PushResult::QueueFull);
+    stats = producer.GetStats();
+    EXPECT_EQ(stats.saturation.max_depth, 7);
+    EXPECT_EQ(stats.saturation.full_events, 1);
+    EXPECT_GE(stats.saturation.time_above_ns[0], stats.saturation.time_above_ns[2]);
+    
+    // Drain one slot, push (ends episode), then hit full again: second episode
+    queue->read_index.store(queue->read_index.load() + 1, std::memory_order_release);
+    ASSERT_EQ(producer.TryPush(data), omni::PushResult::Success);
+    EXPECT_EQ(producer.TryPush(data), omni::PushResult::QueueFull);
+    EXPECT_EQ(producer.GetStats().saturation.full_events, 2);
+    
+    // Draining below all watermarks stops the clocks
+    queue->read_index.store(queue->write_index.load() - 1, std::memory_order_release);
+    ASSERT_EQ(producer.TryPush(data), omni::PushResult::Success);
+    const auto settled = producer.GetStats().saturation.time_above_ns;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    EXPECT_EQ(producer.GetStats().saturation.time_above_ns, settled);
+}
+
+// Test watermark callback fires once per crossing with hysteresis
+TEST_F(ProducerHandleTestFixture, WatermarkCallbackHysteresis) {
+    // Capacity 16 = 15 usable slots; 80/50% -> high 12 slots, low 7 slots
+    auto queue = std::make_shared<omni::detail::SPSCQueue>(16, 64);
+    auto producer = CreateTestProducerFromQueue(queue);
+    std::vector<uint8_t> data(8, 0x5A);
+    
+    std::vector<std::pair<omni::WatermarkEvent, size_t>> events;
+    EXPECT_FALSE(producer.SetWatermarkCallback({.high_percent = 50, .low_percent = 50},
+                                               [](omni::WatermarkEvent, size_t) {}));
+    EXPECT_FALSE(producer.SetWatermarkCallback({}, nullptr));
+    ASSERT_TRUE(producer.SetWatermarkCallback({.high_percent = 80, .low_percent = 50},
+        [&events](omni::WatermarkEvent event, size_t depth) { events.emplace_back(event, depth); }));
+    
+    // Below high: no event
+    for (int i = 0; i < 11; ++i) {
+        ASSERT_EQ(producer.TryPush(data), omni::PushResult::Success);
+    }
+    EXPECT_TRUE(events.empty());
+    
+    // Crossing high fires once, further pushes and QueueFull do not repeat it
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(producer.TryPush(data), omni::PushResult::Success);
+    }
+    EXPECT_EQ(producer.TryPush(data), omni::PushResult::QueueFull);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].first, omni::WatermarkEvent::High);
+    EXPECT_EQ(events[0].second, 12u);
+    
+    // Draining into the band (depth 9) does not fire Low
+    queue->read_index.store(6, std::memory_order_release);
+    EXPECT_EQ(producer.CheckWatermarks(), 9u);
+    EXPECT_EQ(events.size(), 1u);
+    
+    // Draining to the low threshold fires Low (observed without pushing)
+    queue->read_index.store(8, std::memory_order_release);
+    EXPECT_EQ(producer.CheckWatermarks(), 7u);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[1].first, omni::WatermarkEvent::Low);
+    EXPECT_EQ(events[1].second, 7u);
+    
+    // Cleared callback is not invoked
+    producer.ClearWatermarkCallback();
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_EQ(producer.TryPush(data), omni::PushResult::Success);
+    }
+    EXPECT_EQ(events.size(), 2u);
+}
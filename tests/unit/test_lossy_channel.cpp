@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "broker_test_fixture.hpp"
+#include "omni/lossy_channel.hpp"
+#include "omni/mailbox_broker.hpp"
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using LossyChannelTest = BrokerChannelTest;
+
+TEST_F(LossyChannelTest, OverwritesOldestAndReportsGap) {
+    auto channel = MakeLossyChannel("test-lossy-gap", {.capacity = 8, .max_message_size = 64});
+    ASSERT_TRUE(channel.has_value());
+    auto& [producer, consumer] = *channel;
+    EXPECT_EQ(producer.Capacity(), 8);
+
+    // Never QueueFull: 20 pushes into 8 slots keep the newest 8
+    for (uint64_t seq = 0; seq < 20; ++seq) {
+        ASSERT_EQ(producer.TryPush(Sample(seq)), omni::PushResult::Success);
+    }
+    EXPECT_EQ(producer.Published(), 20);
+    EXPECT_EQ(consumer.AvailableMessages(), 8);
+    EXPECT_EQ(omni::MailboxBroker::Instance().GetChannelStats("test-lossy-gap")->depth, 8);
+
+    auto [result, first] = consumer.TryPop();
+    ASSERT_EQ(result, omni::PopResult::Success);
+    EXPECT_EQ(first->sequence, 12);
+    EXPECT_EQ(first->missed, 12);
+    EXPECT_EQ(SeqOf(first->data), 12);
+    for (uint64_t seq = 13; seq < 20; ++seq) {
+        auto [r, message] = consumer.TryPop();
+        ASSERT_EQ(r, omni::PopResult::Success);
+        EXPECT_EQ(message->sequence, seq);
+        EXPECT_EQ(message->missed, 0);
+        EXPECT_EQ(SeqOf(message->data), seq);
+    }
+    EXPECT_EQ(consumer.TryPop().first, omni::PopResult::Empty);
+
+    // A consumer that keeps up misses nothing
+    ASSERT_EQ(producer.TryPush(Sample(20)), omni::PushResult::Success);
+    EXPECT_EQ(consumer.TryPop().second->missed, 0);
+
+    EXPECT_EQ(consumer.MissedMessages(), 12);
+    const auto stats = omni::MailboxBroker::Instance().GetChannelStats("test-lossy-gap");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->messages_sent, 21);
+    EXPECT_EQ(stats->messages_received, 9);
+    EXPECT_EQ(stats->messages_lost, 12);
+    EXPECT_EQ(stats->depth, 0);
+}
+
+TEST_F(LossyChannelTest, SizeLimitsAndDisconnect) {
+    auto channel = MakeLossyChannel("test-lossy-close", {.capacity = 8, .max_message_size = 64});
+    ASSERT_TRUE(channel.has_value());
+    auto producer = std::move(channel->producer);
+    auto consumer = std::move(channel->consumer);
+
+    EXPECT_EQ(producer.TryPush({}), omni::PushResult::InvalidSize);
+    EXPECT_EQ(producer.TryPush(Sample(0, 65)), omni::PushResult::InvalidSize);
+    EXPECT_EQ(channel->producer.TryPush(Sample(0)), omni::PushResult::ChannelClosed);  // Moved-from
+
+    // Odd sizes round-trip exactly
+    ASSERT_EQ(producer.TryPush(Sample(1, 61)), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPush(Sample(2, 9)), omni::PushResult::Success);
+    { auto gone = std::move(producer); }
+    EXPECT_FALSE(consumer.IsConnected());
+
+    // Drained before the close is reported
+    auto [r1, m1] = consumer.TryPop();
+    ASSERT_EQ(r1, omni::PopResult::Success);
+    EXPECT_EQ(m1->data.size(), 61);
+    EXPECT_EQ(m1->data.back(), 1);
+    auto [r2, m2] = consumer.BlockingPop(std::chrono::milliseconds(10));
+    ASSERT_EQ(r2, omni::PopResult::Success);
+    EXPECT_EQ(m2->data.size(), 9);
+    EXPECT_EQ(consumer.TryPop().first, omni::PopResult::ChannelClosed);
+    EXPECT_EQ(consumer.BlockingPop().first, omni::PopResult::ChannelClosed);
+
+    // Consumer gone: the producer is told instead of writing into the void
+    auto other = MakeLossyChannel("test-lossy-close-2", {.capacity = 8});
+    ASSERT_TRUE(other.has_value());
+    EXPECT_EQ(other->consumer.BlockingPop(std::chrono::milliseconds(5)).first, omni::PopResult::Timeout);
+    { auto gone = std::move(other->consumer); }
+    EXPECT_FALSE(other->producer.IsConnected());
+    EXPECT_EQ(other->producer.TryPush(Sample(0)), omni::PushResult::ChannelClosed);
+}
+
+TEST_F(LossyChannelTest, ConcurrentOverwriteNeverTearsAndCountsEveryGap) {
+    constexpr uint64_t kMessages = 200'000;
+    auto channel = MakeLossyChannel("test-lossy-race", {.capacity = 8, .max_message_size = 128});
+    ASSERT_TRUE(channel.has_value());
+
+    std::thread producer([producer = std::move(channel->producer)]() mutable {
+        for (uint64_t seq = 0; seq < kMessages; ++seq) {
+            // Sizes vary so a torn read would also show as a wrong length
+            (void)producer.TryPush(Sample(seq, 8 + seq % 113));
+        }
+    });
+
+    uint64_t received = 0;
+    uint64_t missed = 0;
+    uint64_t next = 0;
+    bool torn = false;
+    while (true) {
+        auto [result, message] = channel->consumer.BlockingPop();
+        if (result != omni::PopResult::Success) {
+            EXPECT_EQ(result, omni::PopResult::ChannelClosed);
+            break;
+        }
+        const uint64_t seq = SeqOf(message->data);
+        torn |= seq != message->sequence || message->data.size() != 8 + seq % 113;
+        for (size_t i = 8; i < message->data.size(); ++i) {
+            torn |= message->data[i] != static_cast<uint8_t>(seq);
+        }
+        EXPECT_EQ(message->sequence, next + message->missed);
+        next = message->sequence + 1;
+        ++received;
+        missed += message->missed;
+    }
+    producer.join();
+
+    EXPECT_FALSE(torn);
+    EXPECT_EQ(next, kMessages);
+    EXPECT_EQ(received + missed, kMessages);
+    EXPECT_EQ(channel->consumer.MissedMessages(), missed);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "broker_test_fixture.hpp"
+#include "omni/merge_consumer.hpp"
+#include "omni/mailbox_broker.hpp"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr omni::ChannelConfig kConfig{.capacity = 1024, .max_message_size = 64};
+
+// Timestamp at offset 0, sequence number at offset 8
+std::vector<uint8_t> Event(uint64_t ts, uint64_t seq = 0) {
+    std::vector<uint8_t> bytes(16);
+    std::memcpy(bytes.data(), &ts, sizeof(ts));
+    std::memcpy(bytes.data() + 8, &seq, sizeof(seq));
+    return bytes;
+}
+
+void Push(omni::ProducerHandle& producer, uint64_t ts) {
+    ASSERT_EQ(producer.TryPush(Event(ts)), omni::PushResult::Success);
+}
+
+} // namespace
+
+using MergeConsumerTest = BrokerChannelTest;
+
+TEST_F(MergeConsumerTest, MergesInputsInKeyOrder) {
+    constexpr size_t kInputs = 4;
+    auto channels = MakeChannels("test-merge-order-", kInputs, kConfig);
+    omni::MergeConsumer merge;
+    for (auto& channel : channels) {
+        ASSERT_TRUE(merge.AddInput(std::move(channel.consumer)).has_value());
+    }
+    EXPECT_EQ(merge.InputCount(), kInputs);
+
+    // Interleaved increasing timestamps split randomly over the inputs
+    std::mt19937 rng(7);
+    for (uint64_t ts = 1; ts <= 800; ++ts) {
+        const size_t input = rng() % kInputs;
+        Push(channels[input].producer, ts);
+    }
+    for (auto& channel : channels) {
+        auto gone = std::move(channel.producer);
+    }
+
+    std::vector<uint64_t> keys;
+    while (!merge.Done()) {
+        merge.Poll([&](size_t input, uint64_t key, std::span<const uint8_t> data) {
+            uint64_t ts = 0;
+            std::memcpy(&ts, data.data(), sizeof(ts));
+            EXPECT_EQ(ts, key);
+            EXPECT_LT(input, kInputs);
+            keys.push_back(key);
+        });
+    }
+    ASSERT_EQ(keys.size(), 800);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(keys[i], i + 1);
+    }
+    const auto stats = merge.GetStats();
+    EXPECT_EQ(stats.messages, 800);
+    EXPECT_EQ(stats.late, 0);
+    EXPECT_EQ(stats.closed_inputs, kInputs);
+    EXPECT_EQ(merge.LastKey(), 800);
+}
+
+TEST_F(MergeConsumerTest, EmptyInputHoldsBackNewerHeads) {
+    auto channels = MakeChannels("test-merge-wait-", 2, kConfig);
+    omni::MergeConsumer merge;
+    ASSERT_TRUE(merge.AddInput(std::move(channels[0].consumer)).has_value());
+    ASSERT_TRUE(merge.AddInput(std::move(channels[1].consumer)).has_value());
+    const auto ignore = [](size_t, uint64_t, std::span<const uint8_t>) {};
+
+    // Input 1 has delivered nothing yet: nothing is known to be first
+    Push(channels[0].producer, 10);
+    Push(channels[0].producer, 20);
+    EXPECT_EQ(merge.Poll(ignore), 0);
+    EXPECT_EQ(merge.GetStats().stalls, 1);
+
+    // Input 1 at 15: 10 and 15 go out, 20 waits for input 1's next key
+    Push(channels[1].producer, 15);
+    EXPECT_EQ(merge.Poll(ignore), 2);
+    EXPECT_EQ(merge.LastKey(), 15);
+
+    // Input 1 can still only deliver >= 15, so a head at 15 could go; 20 cannot
+    EXPECT_EQ(merge.Poll(ignore), 0);
+    Push(channels[1].producer, 30);
+    EXPECT_EQ(merge.Poll(ignore), 1);
+    EXPECT_EQ(merge.LastKey(), 20);
+
+    // max_count bounds one call
+    Push(channels[0].producer, 40);
+    EXPECT_EQ(merge.Poll(ignore, 1), 1);
+    EXPECT_EQ(merge.LastKey(), 30);
+}
+
+TEST_F(MergeConsumerTest, LatenessBoundStopsSilentInputFromStalling) {
+    auto channels = MakeChannels("test-merge-late-", 3, kConfig);
+    omni::MergeConsumer merge(omni::MergeConsumer::KeyAtOffset(0), {.max_lateness = 100});
+    for (auto& channel : channels) {
+        ASSERT_TRUE(merge.AddInput(std::move(channel.consumer)).has_value());
+    }
+    std::vector<uint64_t> keys;
+    const auto record = [&](size_t, uint64_t key, std::span<const uint8_t>) { keys.push_back(key); };
+
+    // Input 1 stays silent. Newest head seen is 10: nothing is 100 behind it.
+    for (uint64_t ts : {10, 50, 120, 200}) {
+        Push(channels[0].producer, ts);
+    }
+    EXPECT_EQ(merge.Poll(record), 0);
+
+    // A head at 500 moves the bound to 400: input 0 drains up to 200, then
+    // 500 waits for input 0 (last key 200) as well as the silent input
+    Push(channels[2].producer, 500);
+    EXPECT_EQ(merge.Poll(record), 4);
+    EXPECT_EQ(keys, (std::vector<uint64_t>{10, 50, 120, 200}));
+    EXPECT_EQ(merge.GetStats().late, 0);
+
+    // The silent input finally delivers something older: out at once, counted late
+    Push(channels[1].producer, 5);
+    EXPECT_EQ(merge.Poll(record), 1);
+    EXPECT_EQ(keys.back(), 5);
+    EXPECT_EQ(merge.GetStats().late, 1);
+    EXPECT_EQ(merge.LastKey(), 5);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "broker_test_fixture.hpp"
+#include "omni/mailbox_broker.hpp"
+#include "omni/detail/spsc_queue.hpp"
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using namespace std::chrono_literals;
+
+} // namespace
+
+using MessageDeadlinesTest = BrokerChannelTest;
+
+TEST_F(MessageDeadlinesTest, ExpiredMessagesAreSkippedAndCounted) {
+    auto channel = MakeChannel("test-deadline-skip", {.capacity = 16, .max_message_size = 64, .message_deadlines = true});
+    ASSERT_TRUE(channel.has_value());
+    auto& [producer, consumer] = *channel;
+    EXPECT_TRUE(producer.GetConfig().message_deadlines);
+    EXPECT_TRUE(consumer.GetConfig().message_deadlines);
+
+    const auto past = Clock::now() - 1s;
+    const auto future = Clock::now() + 1h;
+
+    // TryPop: expired head run dropped, plain and unexpired messages delivered
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(1), past), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(2), past), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPush(Sample(3)), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(4), future), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPushWithTtl(Sample(5), -1ms), omni::PushResult::Success);
+    auto [r1, m1] = consumer.TryPop();
+    ASSERT_EQ(r1, omni::PopResult::Success);
+    EXPECT_EQ(SeqOf(m1->Data()), 3);
+    EXPECT_EQ(SeqOf(consumer.TryPop().second->Data()), 4);
+    EXPECT_EQ(consumer.TryPop().first, omni::PopResult::Empty);  // 5 expired
+    EXPECT_EQ(consumer.AvailableMessages(), 0);
+
+    // BatchPop: expired messages in the middle of a batch
+    for (uint64_t seq = 10; seq < 16; ++seq) {
+        ASSERT_EQ(producer.TryPushWithDeadline(Sample(seq), seq % 2 == 0 ? past : future), omni::PushResult::Success);
+    }
+    auto [r2, batch] = consumer.BatchPop(16);
+    ASSERT_EQ(r2, omni::PopResult::Success);
+    ASSERT_EQ(batch.size(), 3);
+    EXPECT_EQ(SeqOf(batch[0].Data()), 11);
+    EXPECT_EQ(SeqOf(batch[2].Data()), 15);
+
+    // DrainBatch: max_count counts delivered messages, not skipped ones
+    for (uint64_t seq = 20; seq < 26; ++seq) {
+        ASSERT_EQ(producer.TryPushWithDeadline(Sample(seq), seq < 23 ? past : future), omni::PushResult::Success);
+    }
+    std::vector<uint64_t> drained;
+    EXPECT_EQ(consumer.DrainBatch(2, [&](std::span<const uint8_t> data) { drained.push_back(SeqOf(data)); }), 2);
+    EXPECT_EQ(drained, (std::vector<uint64_t>{23, 24}));
+    EXPECT_EQ(consumer.AvailableMessages(), 1);
+
+    // Reserve/CommitWithDeadline, and a batch of expired messages only
+    auto reservation = producer.Reserve(16);
+    ASSERT_TRUE(reservation.has_value());
+    std::memcpy(reservation->data, Sample(30).data(), 16);
+    ASSERT_TRUE(producer.CommitWithDeadline(16, past));
+    EXPECT_EQ(consumer.DrainBatch(8, [&](std::span<const uint8_t> data) { drained.push_back(SeqOf(data)); }), 1);
+    EXPECT_EQ(drained.back(), 25);
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(31), past), omni::PushResult::Success);
+    EXPECT_EQ(consumer.DrainBatch(8, [](std::span<const uint8_t>) {}), 0);
+    EXPECT_EQ(consumer.BatchPop(8).first, omni::PopResult::Empty);
+
+    const auto stats = omni::MailboxBroker::Instance().GetChannelStats("test-deadline-skip");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->messages_sent, 19);
+    EXPECT_EQ(stats->messages_received, 8);
+    EXPECT_EQ(stats->messages_expired, 11);
+    EXPECT_EQ(consumer.GetStats().messages_expired, 11);
+    EXPECT_EQ(stats->depth, 0);
+}
+
+TEST_F(MessageDeadlinesTest, TtlPeekAndClose) {
+    auto channel = MakeChannel("test-deadline-ttl", {.capacity = 8, .message_deadlines = true});
+    ASSERT_TRUE(channel.has_value());
+    auto producer = std::move(channel->producer);
+    auto consumer = std::move(channel->consumer);
+
+    // Live until the TTL runs out
+    ASSERT_EQ(producer.TryPushWithTtl(Sample(1), 1h), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPushWithTtl(Sample(2), 1ms), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPushWithTtl(Sample(3), std::chrono::nanoseconds::max()), omni::PushResult::Success);
+    EXPECT_EQ(SeqOf(consumer.TryPop().second->Data()), 1);
+    std::this_thread::sleep_for(5ms);
+
+    // Peek skips the expired message
+    auto peeked = consumer.Peek();
+    ASSERT_TRUE(peeked.has_value());
+    EXPECT_EQ(SeqOf(*peeked), 3);
+    EXPECT_EQ(SeqOf(consumer.TryPop().second->Data()), 3);
+
+    // A peeked message is popped as shown even if it expires in between
+    const auto deadline = Clock::now() + 200ms;
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(4), deadline), omni::PushResult::Success);
+    EXPECT_EQ(SeqOf(consumer.Peek().value()), 4);
+    std::this_thread::sleep_until(deadline + 1ms);
+    EXPECT_EQ(SeqOf(consumer.TryPop().second->Data()), 4);
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(5), deadline), omni::PushResult::Success);
+    EXPECT_FALSE(consumer.Peek().has_value());
+    EXPECT_EQ(consumer.GetStats().messages_expired, 2);
+
+    // Deadlines on a full ring: expiry frees the slots for the producer
+    for (uint64_t seq = 10; seq < 17; ++seq) {
+        ASSERT_EQ(producer.TryPushWithDeadline(Sample(seq), Clock::now() - 1s), omni::PushResult::Success);
+    }
+    EXPECT_EQ(producer.TryPush(Sample(17)), omni::PushResult::QueueFull);
+    EXPECT_EQ(consumer.TryPop().first, omni::PopResult::Empty);
+    EXPECT_EQ(producer.AvailableSlots(), 7);
+
+    // Expired messages left behind a closed producer read as a closed channel
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(20), Clock::now() - 1s), omni::PushResult::Success);
+    { auto gone = std::move(producer); }
+    EXPECT_EQ(consumer.BlockingPop(10ms).first, omni::PopResult::ChannelClosed);
+    EXPECT_EQ(consumer.GetStats().messages_expired, 10);
+}
+
+TEST_F(MessageDeadlinesTest, FlightRecorderTracesEachRun) {
+    auto channel = MakeChannel("test-deadline-flight", {.capacity = 16, .message_deadlines = true});
+    ASSERT_TRUE(channel.has_value());
+    auto& [producer, consumer] = *channel;
+    const auto past = Clock::now() - 1s;
+
+    // One delivered run on each side of an expired one
+    ASSERT_EQ(producer.TryPush(Sample(0)), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(1), past), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(2), past), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPush(Sample(3)), omni::PushResult::Success);
+    EXPECT_EQ(consumer.DrainBatch(8, [](std::span<const uint8_t>) {}), 2);
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(4), past), omni::PushResult::Success);
+    EXPECT_EQ(consumer.TryPop().first, omni::PopResult::Empty);
+
+    auto events = omni::MailboxBroker::Instance().DumpFlightRecorder("test-deadline-flight");
+    ASSERT_TRUE(events.has_value());
+    std::vector<omni::FlightEvent> consumed;
+    for (const auto& event : *events) {
+        if (!event.producer) {
+            consumed.push_back(event);
+        }
+    }
+    ASSERT_EQ(consumed.size(), 4);
+    const std::pair<omni::FlightEventType, uint32_t> expected[] = {
+        {omni::FlightEventType::BatchPop, 0},
+        {omni::FlightEventType::Expire, 1},
+        {omni::FlightEventType::BatchPop, 3},
+        {omni::FlightEventType::Expire, 4},
+    };
+    const uint32_t counts[] = {1, 2, 1, 1};
+    for (size_t i = 0; i < consumed.size(); ++i) {
+        EXPECT_EQ(consumed[i].type, expected[i].first) << i;
+        EXPECT_EQ(consumed[i].index, expected[i].second) << i;
+        EXPECT_EQ(consumed[i].value, counts[i]) << i;
+    }
+}
+
+TEST_F(MessageDeadlinesTest, ChannelsWithoutDeadlinesIgnoreThem) {
+    auto channel = MakeChannel("test-deadline-off", {.capacity = 8, .max_message_size = 64});
+    ASSERT_TRUE(channel.has_value());
+    auto& [producer, consumer] = *channel;
+    EXPECT_FALSE(producer.GetConfig().message_deadlines);
+
+    // Deadlines are not stored, so nothing ever expires
+    ASSERT_EQ(producer.TryPushWithDeadline(Sample(1), Clock::now() - 1s), omni::PushResult::Success);
+    ASSERT_EQ(producer.TryPushWithTtl(Sample(2, 60), -1s), omni::PushResult::Success);
+    EXPECT_EQ(SeqOf(consumer.TryPop().second->Data()), 1);
+    auto [result, message] = consumer.TryPop();
+    ASSERT_EQ(result, omni::PopResult::Success);
+    EXPECT_EQ(message->Data().size(), 60);
+    EXPECT_EQ(consumer.GetStats().messages_expired, 0);
+
+    // Slot layout unchanged: 4-byte prefix + payload, rounded to 8
+    auto plain = consumer.GetQueueForTesting_();
+    EXPECT_EQ(plain->slot_size, 72);
+    EXPECT_EQ(plain->slots, plain->buffer.get());
+    auto with = MakeChannel("test-deadline-on", {.capacity = 8, .max_message_size = 64, .message_deadlines = true});
+    ASSERT_TRUE(with.has_value());
+    EXPECT_EQ(with->consumer.GetQueueForTesting_()->slot_size, 80);  // + 8-byte deadline
+}
+
+TEST_F(MessageDeadlinesTest, OtherChannelKindsRejectDeadlines) {
+    auto& broker = omni::MailboxBroker::Instance();
+    const omni::ChannelConfig config{.capacity = 8, .message_deadlines = true};
+
+    EXPECT_EQ(broker.RequestLossyChannel("test-deadline-lossy", config).first, omni::ChannelError::InvalidConfig);
+    EXPECT_EQ(broker.RequestConflatingChannel("test-deadline-conflating", config).first,
+              omni::ChannelError::InvalidConfig);
+    EXPECT_EQ(broker.RequestStateChannel("test-deadline-state", config).first, omni::ChannelError::InvalidConfig);
+    EXPECT_FALSE(broker.HasChannel("test-deadline-lossy"));
+    EXPECT_FALSE(broker.HasChannel("test-deadline-conflating"));
+    EXPECT_FALSE(broker.HasChannel("test-deadline-state"));
+}
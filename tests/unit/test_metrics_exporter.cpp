@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+#include "omni/metrics_exporter.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(OMNI_PLATFORM_LINUX)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+omni::MailboxBroker::ChannelStats MakeStats(const std::string& name) {
+    return omni::MailboxBroker::ChannelStats{
+        .name = name,
+        .capacity = 1024,
+        .max_message_size = 4096,
+        .depth = 7,
+        .messages_sent = 100,
+        .bytes_sent = 6400,
+        .failed_pushes = 3,
+        .messages_received = 93,
+        .bytes_received = 5952,
+        .failed_pops = 1,
+        .producer_alive = true,
+        .consumer_alive = true,
+        .saturation = {
+            .max_depth = 900,
+            .full_events = 2,
+            .watermark_percent = {50, 80, 95},
+            .time_above_ns = {3'000'000'000, 1'500'000'000, 250'000'000}
+        }
+    };
+}
+
+#if defined(OMNI_PLATFORM_LINUX)
+// Minimal loopback HTTP GET (what `curl http://127.0.0.1:<port>/metrics` does)
+std::string HttpGet(uint16_t port, const std::string& path) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return {};
+    }
+    const std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    ::send(fd, request.data(), request.size(), 0);
+
+    std::string response;
+    char buffer[4096];
+    ssize_t n = 0;
+    while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(fd);
+    return response;
+}
+#endif
+
+} // namespace
+
+// Test rendering of broker and channel families in OpenMetrics format
+TEST(MetricsExporterTest, RenderFormat) {
+    omni::MetricsExporter::Snapshot snapshot{
+        .broker = {.active_channels = 1, .total_channels_created = 2,
+                   .total_messages_sent = 100, .total_bytes_transferred = 6400},
+        .channels = {{MakeStats("orders"), 50.0, 46.5}}
+    };
+
+    const std::string text = omni::MetricsExporter::Render(snapshot);
+
+    EXPECT_NE(text.find("# TYPE omni_broker_active_channels gauge\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE omni_broker_channels_opened counter\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_broker_channels_opened_total 2\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_broker_messages_sent_total 100\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE omni_channel_depth gauge\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_channel_depth{channel=\"orders\"} 7\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_channel_failed_pushes_total{channel=\"orders\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_channel_receive_rate{channel=\"orders\"} 46.5\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_channel_connected{channel=\"orders\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_channel_max_depth{channel=\"orders\"} 900\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_channel_full_events_total{channel=\"orders\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_channel_time_above_watermark_seconds_total{channel=\"orders\",watermark=\"80\"} 1.5\n"),
+              std::string::npos);
+
+    // OpenMetrics requires the terminating EOF marker
+    ASSERT_GE(text.size(), 6u);
+    EXPECT_EQ(text.substr(text.size() - 6), "# EOF\n");
+}
+
+// Test label values are escaped per OpenMetrics rules
+TEST(MetricsExporterTest, RenderEscapesLabels) {
+    omni::MetricsExporter::Snapshot snapshot{};
+    snapshot.channels.push_back({MakeStats("a\"b\\c\nd"), 0.0, 0.0});
+
+    const std::string text = omni::MetricsExporter::Render(snapshot, "svc");
+
+    EXPECT_NE(text.find("svc_channel_depth{channel=\"a\\\"b\\\\c\\nd\"} 7\n"), std::string::npos);
+}
+
+// Test a watermark percent configured twice is written once per channel
+TEST(MetricsExporterTest, RenderRepeatedWatermarkOnce) {
+    omni::MetricsExporter::Snapshot snapshot{};
+    auto stats = MakeStats("orders");
+    stats.saturation.watermark_percent = {80, 80, 95};
+    stats.saturation.time_above_ns = {1'500'000'000, 1'500'000'000, 250'000'000};
+    snapshot.channels.push_back({stats, 0.0, 0.0});
+
+    const std::string text = omni::MetricsExporter::Render(snapshot);
+
+    const std::string sample = "omni_channel_time_above_watermark_seconds_total{channel=\"orders\",watermark=\"80\"} 1.5\n";
+    const size_t first = text.find(sample);
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_EQ(text.find(sample, first + 1), std::string::npos);
+    EXPECT_NE(text.find("omni_channel_time_above_watermark_seconds_total{channel=\"orders\",watermark=\"95\"} 0.25\n"),
+              std::string::npos);
+}
+
+// Test snapshots read live broker counters and derive rates
+TEST(MetricsExporterTest, SnapshotReadsBroker) {
+    auto& broker = omni::MailboxBroker::Instance();
+    auto [error, channel] = broker.RequestChannel("test-metrics-snapshot");
+    ASSERT_EQ(error, omni::ChannelError::Success);
+
+    omni::MetricsExporter exporter;
+    exporter.SnapshotNow();
+
+    std::vector<uint8_t> payload(16, 0x01);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(channel->producer.TryPush(payload), omni::PushResult::Success);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    exporter.SnapshotNow();
+
+    const std::string text = exporter.GetText();
+    EXPECT_NE(text.find("omni_channel_messages_sent_total{channel=\"test-metrics-snapshot\"} 5\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("omni_channel_depth{channel=\"test-metrics-snapshot\"} 5\n"), std::string::npos);
+    EXPECT_EQ(text.find("omni_channel_send_rate{channel=\"test-metrics-snapshot\"} 0\n"), std::string::npos);
+}
+
+// Test a channel recreated under the same name reads as a counter reset
+TEST(MetricsExporterTest, RecreatedChannelResetsRate) {
+    auto& broker = omni::MailboxBroker::Instance();
+    auto first = broker.RequestChannel("test-metrics-reset");
+    ASSERT_EQ(first.first, omni::ChannelError::Success);
+    std::vector<uint8_t> payload(16, 0x01);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(first.second->producer.TryPush(payload), omni::PushResult::Success);
+    }
+
+    omni::MetricsExporter exporter;
+    exporter.SnapshotNow();
+
+    first.second.reset();
+    ASSERT_TRUE(broker.RemoveChannel("test-metrics-reset"));
+    auto second = broker.RequestChannel("test-metrics-reset");
+    ASSERT_EQ(second.first, omni::ChannelError::Success);
+    ASSERT_EQ(second.second->producer.TryPush(payload), omni::PushResult::Success);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    exporter.SnapshotNow();
+
+    const std::string text = exporter.GetText();
+    EXPECT_NE(text.find("omni_channel_messages_sent_total{channel=\"test-metrics-reset\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_channel_send_rate{channel=\"test-metrics-reset\"} 0\n"), std::string::npos);
+}
+
+// Test file output is rewritten on snapshot
+TEST(MetricsExporterTest, FileOutput) {
+    const std::string path = ::testing::TempDir() + "omni_metrics_test.prom";
+
+    omni::MetricsExporter exporter({.file_path = path});
+    exporter.SnapshotNow();
+
+    std::ifstream file(path);
+    ASSERT_TRUE(file.is_open());
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_NE(contents.str().find("omni_broker_active_channels"), std::string::npos);
+    EXPECT_EQ(contents.str(), exporter.GetText());
+
+    std::remove(path.c_str());
+}
+
+#if defined(OMNI_PLATFORM_LINUX)
+// Test doubles keep full precision (no 6-digit ostream rounding)
+TEST(MetricsExporterTest, RenderDoublesAtFullPrecision) {
+    omni::MetricsExporter::Snapshot snapshot{};
+    auto stats = MakeStats("orders");
+    stats.saturation.watermark_percent = {80, 90, 95};
+    stats.saturation.time_above_ns = {1'000'000'000'000'001, 0, 0};  // ~11.6 days plus 1ns
+    snapshot.channels.push_back({stats, 1234567.8, 0.0});
+
+    const std::string text = omni::MetricsExporter::Render(snapshot);
+
+    EXPECT_NE(text.find("omni_channel_send_rate{channel=\"orders\"} 1234567.8\n"), std::string::npos);
+    EXPECT_NE(text.find("omni_channel_time_above_watermark_seconds_total{channel=\"orders\",watermark=\"80\"} "
+                        "1000000.000000001\n"), std::string::npos);
+}
+
+// Test loopback HTTP endpoint serves the last snapshot
+TEST(MetricsExporterTest, HttpEndpoint) {
+    omni::MetricsExporter exporter({
+        .interval = std::chrono::milliseconds(20),
+        .http_port = 0  // Ephemeral port
+    });
+    ASSERT_TRUE(exporter.Start());
+    EXPECT_TRUE(exporter.IsRunning());
+    ASSERT_NE(exporter.BoundPort(), 0);
+
+    const std::string ok = HttpGet(exporter.BoundPort(), "/metrics");
+    EXPECT_EQ(ok.rfind("HTTP/1.1 200 OK\r\n", 0), 0u);
+    EXPECT_NE(ok.find("application/openmetrics-text"), std::string::npos);
+    EXPECT_NE(ok.find("# EOF\n"), std::string::npos);
+
+    const std::string missing = HttpGet(exporter.BoundPort(), "/other");
+    EXPECT_EQ(missing.rfind("HTTP/1.1 404", 0), 0u);
+    EXPECT_EQ(HttpGet(exporter.BoundPort(), "/metricsfoo").rfind("HTTP/1.1 404", 0), 0u);
+    EXPECT_EQ(HttpGet(exporter.BoundPort(), "/metrics?name[]=x").rfind("HTTP/1.1 200 OK\r\n", 0), 0u);
+
+    // Second Start() while running is rejected
+    EXPECT_FALSE(exporter.Start());
+
+    exporter.Stop();
+    EXPECT_FALSE(exporter.IsRunning());
+    EXPECT_EQ(exporter.BoundPort(), 0);
+}
+
+// Test a client that connects and never sends cannot stall Stop()
+TEST(MetricsExporterTest, SilentClientDoesNotBlockStop) {
+    omni::MetricsExporter exporter({
+        .interval = std::chrono::milliseconds(20),
+        .http_port = 0
+    });
+    ASSERT_TRUE(exporter.Start());
+
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(exporter.BoundPort());
+    ASSERT_EQ(::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));  // Exporter is now reading from it
+
+    // Scrapes after the silent client still get through
+    const std::string ok = HttpGet(exporter.BoundPort(), "/metrics");
+    EXPECT_EQ(ok.rfind("HTTP/1.1 200 OK\r\n", 0), 0u);
+
+    const auto start = std::chrono::steady_clock::now();
+    exporter.Stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+    ::close(fd);
+}
+#endif
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "omni/mailbox_broker.hpp"
+#include "omni/placement.hpp"
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 2 nodes x 2 LLCs x 2 cores x 2 SMT threads, numbered like Linux does:
+// CPUs 0-7 are the first thread of every core, 8-15 their siblings
+omni::CpuTopology MakeTopology(bool smt = true) {
+    std::vector<omni::CpuInfo> cpus;
+    for (int thread = 0; thread < (smt ? 2 : 1); ++thread) {
+        for (int core = 0; core < 8; ++core) {
+            cpus.push_back(omni::CpuInfo{
+                .cpu = thread * 8 + core,
+                .core = core,
+                .package = core / 4,
+                .llc = core / 2,
+                .numa_node = core / 4
+            });
+        }
+    }
+    return omni::CpuTopology::FromCpus(std::move(cpus));
+}
+
+} // namespace
+
+TEST(PlacementTest, ParseCpuList) {
+    EXPECT_EQ(omni::detail::ParseCpuList("0-3,8,10-11\n"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(omni::detail::ParseCpuList("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(omni::detail::ParseCpuList("").empty());
+    EXPECT_TRUE(omni::detail::ParseCpuList("3-1").empty());
+    EXPECT_TRUE(omni::detail::ParseCpuList("0,x").empty());
+}
+
+TEST(PlacementTest, FromCpusSortsAndFinds) {
+    auto topology = MakeTopology();
+    ASSERT_EQ(topology.Cpus().size(), 16u);
+    EXPECT_EQ(topology.Cpus().front().cpu, 0);
+    EXPECT_EQ(topology.Cpus().back().cpu, 15);
+
+    auto info = topology.Find(13);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->core, 5);
+    EXPECT_EQ(info->numa_node, 1);
+    EXPECT_FALSE(topology.Find(16).has_value());
+}
+
+TEST(PlacementTest, RecommendHonorsPolicy) {
+    const auto topology = MakeTopology();
+
+    auto same_core = topology.Recommend(omni::PlacementPolicy::SameCore);
+    ASSERT_TRUE(same_core.has_value());
+    EXPECT_EQ(topology.Find(same_core->producer_cpu)->core, topology.Find(same_core->consumer_cpu)->core);
+    EXPECT_NE(same_core->producer_cpu, same_core->consumer_cpu);
+
+    auto same_llc = topology.Recommend(omni::PlacementPolicy::SameLLC);
+    ASSERT_TRUE(same_llc.has_value());
+    auto producer = *topology.Find(same_llc->producer_cpu);
+    auto consumer = *topology.Find(same_llc->consumer_cpu);
+    EXPECT_NE(producer.core, consumer.core);
+    EXPECT_EQ(producer.llc, consumer.llc);
+    EXPECT_EQ(same_llc->policy, omni::PlacementPolicy::SameLLC);
+
+    // Closest satisfying pair first: same node prefers a shared LLC when nothing is busy
+    auto same_node = topology.Recommend(omni::PlacementPolicy::SameNode);
+    ASSERT_TRUE(same_node.has_value());
+    EXPECT_EQ(topology.Find(same_node->producer_cpu)->llc, topology.Find(same_node->consumer_cpu)->llc);
+}
+
+TEST(PlacementTest, RecommendAvoidsBusyCpusAndSiblings) {
+    const auto topology = MakeTopology();
+
+    // Cores 0 and 1 (CPUs 0, 1) taken: their siblings 8 and 9 are avoided too
+    const std::vector<int> busy{0, 1};
+    auto placement = topology.Recommend(omni::PlacementPolicy::SameLLC, busy);
+    ASSERT_TRUE(placement.has_value());
+    for (int cpu : {placement->producer_cpu, placement->consumer_cpu}) {
+        EXPECT_NE(topology.Find(cpu)->llc, 0) << "cpu " << cpu;
+    }
+}
+
+TEST(PlacementTest, RecommendFailsWhenUnsatisfiable) {
+    const auto no_smt = MakeTopology(false);
+    EXPECT_FALSE(no_smt.Recommend(omni::PlacementPolicy::SameCore).has_value());
+    EXPECT_TRUE(no_smt.Recommend(omni::PlacementPolicy::SameLLC).has_value());
+
+    const auto single = omni::CpuTopology::FromCpus({{.cpu = 0, .core = 0, .package = 0, .llc = 0, .numa_node = 0}});
+    EXPECT_FALSE(single.Recommend(omni::PlacementPolicy::SameNode).has_value());
+}
+
+TEST(PlacementTest, DetectFindsCallingCpus) {
+    const auto topology = omni::CpuTopology::Detect();
+    ASSERT_FALSE(topology.Cpus().empty());
+    for (const auto& info : topology.Cpus()) {
+        EXPECT_GE(info.cpu, 0);
+    }
+}
+
+TEST(PlacementTest, BrokerSpreadsChannelsAndReportsPlacement) {
+    auto& broker = omni::MailboxBroker::Instance();
+    broker.SetCpuTopology(MakeTopology());
+
+    auto [error1, channel1] = broker.RequestChannel("test-placement-a");
+    auto [error2, channel2] = broker.RequestChannel("test-placement-b");
+    ASSERT_EQ(error1, omni::ChannelError::Success);
+    ASSERT_EQ(error2, omni::ChannelError::Success);
+
+    auto first = broker.PlaceChannel("test-placement-a", omni::PlacementPolicy::SameLLC);
+    auto second = broker.PlaceChannel("test-placement-b", omni::PlacementPolicy::SameLLC);
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+
+    const std::set<int> cpus{first->producer_cpu, first->consumer_cpu,
+                             second->producer_cpu, second->consumer_cpu};
+    EXPECT_EQ(cpus.size(), 4u);
+
+    auto stats = broker.GetChannelStats("test-placement-b");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->placement.producer_cpu, second->producer_cpu);
+    EXPECT_EQ(stats->placement.consumer_cpu, second->consumer_cpu);
+    EXPECT_EQ(stats->producer_pinned_cpu, -1);
+
+    EXPECT_FALSE(broker.PlaceChannel("test-placement-missing").has_value());
+    broker.SetCpuTopology(omni::CpuTopology::Detect());
+}
+
+TEST(PlacementTest, ApplyPlacementPinsEndpointThreads) {
+    auto& broker = omni::MailboxBroker::Instance();
+    auto [error, channel] = broker.RequestChannel("test-placement-apply");
+    ASSERT_EQ(error, omni::ChannelError::Success);
+
+    // Nothing planned yet
+    EXPECT_FALSE(channel->producer.ApplyPlacement());
+
+    const int cpu = omni::CpuTopology::Detect().Cpus().front().cpu;
+    ASSERT_TRUE(broker.SetChannelPlacement("test-placement-apply", {.producer_cpu = cpu, .consumer_cpu = cpu}));
+    EXPECT_FALSE(broker.SetChannelPlacement("test-placement-apply", {.producer_cpu = -2}));
+
+    // Pin on helper threads so the test runner itself stays unpinned
+    bool producer_pinned = false;
+    bool consumer_pinned = false;
+    std::thread([&] { producer_pinned = channel->producer.ApplyPlacement(); }).join();
+    std::thread([&] { consumer_pinned = channel->consumer.ApplyPlacement(); }).join();
+    EXPECT_TRUE(producer_pinned);
+    EXPECT_TRUE(consumer_pinned);
+
+    auto stats = broker.GetChannelStats("test-placement-apply");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->producer_pinned_cpu, cpu);
+    EXPECT_EQ(stats->consumer_pinned_cpu, cpu);
+}
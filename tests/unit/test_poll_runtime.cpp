@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "omni/mailbox_broker.hpp"
+#include "omni/poll_runtime.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Spin (with yield) until pred() or the deadline; the runtime itself never sleeps
+template<typename Pred>
+bool WaitFor(Pred pred, std::chrono::milliseconds timeout = 5000ms) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+std::vector<uint8_t> Bytes(const std::string& text) {
+    return {text.begin(), text.end()};
+}
+
+} // namespace
+
+TEST(PollRuntimeTest, DeliversMessagesInlineAndCountsLoops) {
+    auto& broker = omni::MailboxBroker::Instance();
+    auto [error, channel] = broker.RequestChannel("test-poll-deliver", {.capacity = 64, .max_message_size = 64});
+    ASSERT_EQ(error, omni::ChannelError::Success);
+
+    omni::PollRuntime runtime({.batch_size = 4});
+    std::atomic<int> received{0};
+    std::atomic<int> sum{0};
+    auto id = runtime.AddChannel(std::move(channel->consumer), [&](std::span<const uint8_t> data) {
+        sum.fetch_add(data[0], std::memory_order_relaxed);
+        received.fetch_add(1, std::memory_order_release);
+    });
+    ASSERT_TRUE(id.has_value());
+    ASSERT_TRUE(runtime.Start());
+    EXPECT_TRUE(runtime.IsRunning());
+    EXPECT_FALSE(runtime.Start());
+
+    for (uint8_t i = 1; i <= 20; ++i) {
+        const std::vector<uint8_t> data{i};
+        ASSERT_EQ(channel->producer.BlockingPush(data, 1000ms), omni::PushResult::Success);
+    }
+    ASSERT_TRUE(WaitFor([&] { return received.load(std::memory_order_acquire) == 20; }));
+    EXPECT_EQ(sum.load(), 210);
+
+    runtime.Stop();
+    EXPECT_FALSE(runtime.IsRunning());
+
+    const auto stats = runtime.GetStats();
+    EXPECT_EQ(stats.messages, 20);
+    EXPECT_EQ(stats.channels, 1);
+    EXPECT_GT(stats.loops, 0);
+    EXPECT_LE(stats.max_loop_messages, 4);  // batch_size bounds one channel per loop
+    EXPECT_EQ(stats.polls, stats.loops);
+    EXPECT_GE(stats.EmptyPollRatio(), 0.0);
+    EXPECT_LE(stats.EmptyLoopRatio(), 1.0);
+}
+
+TEST(PollRuntimeTest, AddAndRemoveWhileRunning) {
+    auto& broker = omni::MailboxBroker::Instance();
+    auto [error_a, a] = broker.RequestChannel("test-poll-add-a");
+    auto [error_b, b] = broker.RequestChannel("test-poll-add-b");
+    ASSERT_EQ(error_a, omni::ChannelError::Success);
+    ASSERT_EQ(error_b, omni::ChannelError::Success);
+
+    omni::PollRuntime runtime;
+    ASSERT_TRUE(runtime.Start());
+
+    std::atomic<int> from_a{0};
+    std::atomic<int> from_b{0};
+    auto id_a = runtime.AddChannel(std::move(a->consumer), [&](std::span<const uint8_t>) { from_a.fetch_add(1); });
+    auto id_b = runtime.AddChannel(std::move(b->consumer), [&](std::span<const uint8_t>) { from_b.fetch_add(1); });
+    ASSERT_TRUE(id_a.has_value());
+    ASSERT_TRUE(id_b.has_value());
+    EXPECT_NE(*id_a, *id_b);
+    EXPECT_EQ(runtime.GetStats().channels, 2);
+
+    ASSERT_EQ(a->producer.TryPush(Bytes("a")), omni::PushResult::Success);
+    ASSERT_EQ(b->producer.TryPush(Bytes("b")), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return from_a.load() == 1 && from_b.load() == 1; }));
+
+    // Removed handle comes back and is no longer polled
+    auto consumer_a = runtime.RemoveChannel(*id_a);
+    ASSERT_TRUE(consumer_a.has_value());
+    EXPECT_FALSE(runtime.RemoveChannel(*id_a).has_value());
+    EXPECT_EQ(runtime.GetStats().channels, 1);
+
+    ASSERT_EQ(a->producer.TryPush(Bytes("a2")), omni::PushResult::Success);
+    ASSERT_EQ(b->producer.TryPush(Bytes("b2")), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return from_b.load() == 2; }));
+    EXPECT_EQ(from_a.load(), 1);
+
+    auto [result, message] = consumer_a->TryPop();
+    ASSERT_EQ(result, omni::PopResult::Success);
+    EXPECT_EQ(message->Data().size(), 2);
+}
+
+TEST(PollRuntimeTest, HandlerCannotReenterRuntime) {
+    auto& broker = omni::MailboxBroker::Instance();
+    auto [error, channel] = broker.RequestChannel("test-poll-reenter");
+    ASSERT_EQ(error, omni::ChannelError::Success);
+
+    omni::PollRuntime runtime;
+    std::atomic<int> outcome{0};
+    std::optional<omni::PollRuntime::ChannelId> id;
+    id = runtime.AddChannel(std::move(channel->consumer), [&](std::span<const uint8_t>) {
+        const bool refused = !runtime.RemoveChannel(*id).has_value() && !runtime.Start();
+        outcome.store(refused ? 1 : 2);
+    });
+    ASSERT_TRUE(id.has_value());
+    ASSERT_TRUE(runtime.Start());
+
+    ASSERT_EQ(channel->producer.TryPush(Bytes("x")), omni::PushResult::Success);
+    ASSERT_TRUE(WaitFor([&] { return outcome.load() != 0; }));
+    EXPECT_EQ(outcome.load(), 1);
+}
+
+TEST(PollRuntimeTest, RejectsInvalidRegistrationAndKeepsHandle) {
+    auto& broker = omni::MailboxBroker::Instance();
+    auto [error, channel] = broker.RequestChannel("test-poll-invalid");
+    ASSERT_EQ(error, omni::ChannelError::Success);
+
+    omni::PollRuntime runtime;
+    EXPECT_FALSE(runtime.AddChannel(std::move(channel->consumer), nullptr).has_value());
+    EXPECT_TRUE(channel->consumer.IsConnected());  // Handle left with the caller
+    EXPECT_FALSE(runtime.RemoveChannel(12345).has_value());
+}
+
+TEST(PollRuntimeTest, PinsToConfiguredCpu) {
+    const int cpu = omni::CpuTopology::Detect().Cpus().front().cpu;
+    omni::PollRuntime pinned({.cpu = cpu});
+    EXPECT_TRUE(pinned.Start());
+
+    omni::PollRuntime invalid({.cpu = 1 << 20});
+    EXPECT_FALSE(invalid.Start());
+    EXPECT_FALSE(invalid.IsRunning());
+}
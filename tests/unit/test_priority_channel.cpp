@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "broker_test_fixture.hpp"
+#include "omni/mailbox_broker.hpp"
+#include "omni/priority_channel.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+std::vector<uint8_t> Encode(uint32_t value) {
+    std::vector<uint8_t> bytes(sizeof(value));
+    std::memcpy(bytes.data(), &value, sizeof(value));
+    return bytes;
+}
+
+uint32_t Decode(std::span<const uint8_t> bytes) {
+    uint32_t value = 0;
+    std::memcpy(&value, bytes.data(), sizeof(value));
+    return value;
+}
+
+} // namespace
+
+using PriorityChannelTest = BrokerChannelTest;
+
+TEST_F(PriorityChannelTest, StrictModeServesHigherLanesFirst) {
+    auto channel = MakePriorityChannel("test-prio-strict", {.lanes = {{.capacity = 16}, {.capacity = 256}}, .weights = {}});
+    ASSERT_TRUE(channel.has_value());
+    auto& [producer, consumer] = *channel;
+    EXPECT_EQ(producer.LaneCount(), 2);
+    EXPECT_EQ(consumer.Mode(), omni::PriorityMode::Strict);
+    EXPECT_TRUE(omni::MailboxBroker::Instance().HasChannel("test-prio-strict.lane1"));
+
+    // Bulk backlog first, then a control message that must overtake it
+    for (uint32_t n = 0; n < 100; ++n) {
+        ASSERT_EQ(producer.TryPush(1, Encode(100 + n)), omni::PushResult::Success);
+    }
+    ASSERT_EQ(producer.TryPush(0, Encode(1)), omni::PushResult::Success);
+    EXPECT_EQ(producer.TryPush(2, Encode(0)), omni::PushResult::InvalidSize);
+
+    auto [result, message] = consumer.TryPop();
+    ASSERT_EQ(result, omni::PopResult::Success);
+    EXPECT_EQ(Decode(message->Data()), 1);
+    EXPECT_EQ(consumer.LastLane(), 0);
+
+    for (uint32_t n = 0; n < 100; ++n) {
+        auto [r, m] = consumer.TryPop();
+        ASSERT_EQ(r, omni::PopResult::Success);
+        EXPECT_EQ(Decode(m->Data()), 100 + n);
+        EXPECT_EQ(consumer.LastLane(), 1);
+    }
+    EXPECT_EQ(consumer.TryPop().first, omni::PopResult::Empty);
+}
+
+TEST_F(PriorityChannelTest, WeightedModeSharesBacklogByWeight) {
+    auto channel = MakePriorityChannel("test-prio-weighted", {
+        .lanes = {{.capacity = 256}, {.capacity = 256}, {.capacity = 256}},
+        .mode = omni::PriorityMode::Weighted,
+        .weights = {4, 2, 1},
+    });
+    ASSERT_TRUE(channel.has_value());
+    auto& [producer, consumer] = *channel;
+    for (uint32_t n = 0; n < 70; ++n) {
+        for (size_t lane = 0; lane < 3; ++lane) {
+            ASSERT_EQ(producer.TryPush(lane, Encode(static_cast<uint32_t>(lane))), omni::PushResult::Success);
+        }
+    }
+
+    // While all lanes are backlogged, every round of 7 pops is 4:2:1
+    size_t served[3] = {0, 0, 0};
+    for (size_t i = 0; i < 70; ++i) {
+        auto [r, m] = consumer.TryPop();
+        ASSERT_EQ(r, omni::PopResult::Success);
+        EXPECT_EQ(Decode(m->Data()), consumer.LastLane());
+        ++served[consumer.LastLane()];
+    }
+    EXPECT_EQ(served[0], 40);
+    EXPECT_EQ(served[1], 20);
+    EXPECT_EQ(served[2], 10);
+
+    // Batches follow the same schedule: 5 more rounds of 4:2:1, then 4:1
+    std::vector<uint32_t> lanes;
+    const size_t drained = consumer.DrainBatch(40, [&](std::span<const uint8_t> data) {
+        lanes.push_back(Decode(data));
+    });
+    ASSERT_EQ(drained, 40);
+    EXPECT_EQ(std::count(lanes.begin(), lanes.end(), 0u), 24);
+    EXPECT_EQ(std::count(lanes.begin(), lanes.end(), 1u), 11);
+    EXPECT_EQ(std::count(lanes.begin(), lanes.end(), 2u), 5);
+
+    auto [result, batch] = consumer.BatchPop(1000);
+    ASSERT_EQ(result, omni::PopResult::Success);
+    EXPECT_EQ(batch.size(), 210 - 110);
+}
+
+TEST_F(PriorityChannelTest, BlockingPopWakesOnAnyLaneAndOnClose) {
+    auto channel = MakePriorityChannel("test-prio-wake", {.lanes = {{}, {}, {}}, .weights = {}});
+    ASSERT_TRUE(channel.has_value());
+    auto producer = std::move(channel->producer);
+    auto& consumer = channel->consumer;
+
+    std::thread sender([&producer] {
+        std::this_thread::sleep_for(20ms);
+        ASSERT_EQ(producer.TryPush(2, Encode(7)), omni::PushResult::Success);
+    });
+    auto [result, message] = consumer.BlockingPop();
+    sender.join();
+    ASSERT_EQ(result, omni::PopResult::Success);
+    EXPECT_EQ(Decode(message->Data()), 7);
+    EXPECT_EQ(consumer.LastLane(), 2);
+
+    EXPECT_EQ(consumer.BlockingPop(5ms).first, omni::PopResult::Timeout);
+
+    // Destroying the producer wakes an infinite wait with ChannelClosed
+    std::thread closer([producer = std::move(producer)]() mutable {
+        std::this_thread::sleep_for(20ms);
+        auto gone = std::move(producer);
+    });
+    EXPECT_EQ(consumer.BlockingPop().first, omni::PopResult::ChannelClosed);
+    closer.join();
+    EXPECT_EQ(consumer.TryPop().first, omni::PopResult::ChannelClosed);
+}
+
+TEST_F(PriorityChannelTest, RejectsInvalidConfigAndRollsBackLanes) {
+    auto& broker = omni::MailboxBroker::Instance();
+    EXPECT_EQ(broker.RequestPriorityChannel("test-prio-none", {.lanes = {}, .weights = {}}).first,
+              omni::ChannelError::InvalidConfig);
+    EXPECT_EQ(broker.RequestPriorityChannel("test-prio-many",
+                                            {.lanes = std::vector<omni::ChannelConfig>(9), .weights = {}}).first,
+              omni::ChannelError::InvalidConfig);
+    EXPECT_EQ(broker.RequestPriorityChannel("test-prio-w", {.mode = omni::PriorityMode::Weighted,
+                                                            .weights = {1}}).first,
+              omni::ChannelError::InvalidConfig);
+    EXPECT_EQ(broker.RequestPriorityChannel("test-prio-w", {.mode = omni::PriorityMode::Weighted,
+                                                            .weights = {1, 0}}).first,
+              omni::ChannelError::InvalidConfig);
+    EXPECT_FALSE(broker.HasChannel("test-prio-w.lane0"));
+
+    // A clash on lane 1 removes lane 0 again
+    auto blocker = MakeChannel("test-prio-clash.lane1");
+    ASSERT_TRUE(blocker.has_value());
+    EXPECT_EQ(broker.RequestPriorityChannel("test-prio-clash").first, omni::ChannelError::NameExists);
+    EXPECT_FALSE(broker.HasChannel("test-prio-clash.lane0"));
+}
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 #include <omni/detail/spsc_queue.hpp>
+#include <omni/detail/flight_recorder.hpp>
+#include <atomic>
 #include <string>
+#include <thread>
 #include <cstring>
+#include <vector>
 
 TEST(SPSCQueueTest, InitialState) {
     omni::detail::SPSCQueue queue(16, 256);
@@ -77,3 +81,94 @@ TEST(SPSCQueueTest, PowerOfTwoCapacity) {
     // Note: In debug builds, this will assert. In release, behavior is undefined.
     // We document the requirement rather than testing assertion failure.
 }
+
+TEST(SPSCQueueTest, CountersOnSeparateCacheLines) {
+    omni::detail::SPSCQueue queue(16, 64);
+    
+    const auto line = [](const void* p) {
+        return reinterpret_cast<uintptr_t>(p) / omni::detail::CACHE_LINE_SIZE;
+    };
+    
+    // Producer-written and consumer-written counters must never share a line
+    EXPECT_NE(line(&queue.producer_stats), line(&queue.consumer_stats));
+    EXPECT_NE(line(&queue.producer_stats), line(&queue.write_index));
+    EXPECT_NE(line(&queue.consumer_stats), line(&queue.read_index));
+    EXPECT_EQ(queue.producer_stats.messages_sent.load(), 0);
+    EXPECT_EQ(queue.consumer_stats.messages_received.load(), 0);
+}
+
+TEST(SPSCQueueTest, FlightRecorderRing) {
+    omni::detail::SPSCQueue queue(16, 64);
+    std::vector<omni::FlightEvent> events;
+    events.reserve(2 * omni::detail::FLIGHT_RECORDER_EVENTS);
+    
+    // Rings live on their own lines, away from the indices
+    const auto line = [](const void* p) {
+        return reinterpret_cast<uintptr_t>(p) / omni::detail::CACHE_LINE_SIZE;
+    };
+    EXPECT_NE(line(&queue.producer_flight), line(&queue.consumer_flight.slots.back()));
+    EXPECT_NE(line(&queue.producer_flight.slots.back()), line(&queue.consumer_flight));
+    
+    // Overfill the producer ring: only the newest FLIGHT_RECORDER_EVENTS remain
+    const uint64_t total = omni::detail::FLIGHT_RECORDER_EVENTS + 8;
+    for (uint64_t i = 0; i < total; ++i) {
+        omni::detail::RecordFlight(queue.producer_flight, omni::FlightEventType::Push, i, i * 10);
+    }
+    omni::detail::RecordFlight(queue.consumer_flight, omni::FlightEventType::Pop, 7, uint64_t{1} << 30);
+    
+    omni::detail::ReadFlightRecorder(queue, events);
+    ASSERT_EQ(events.size(), omni::detail::FLIGHT_RECORDER_EVENTS + 1);
+    EXPECT_EQ(events.front().index, 8u);
+    EXPECT_EQ(events.front().value, 80u);
+    EXPECT_TRUE(events.front().producer);
+    
+    // Merged oldest first; value saturates at 24 bits
+    EXPECT_EQ(events.back().type, omni::FlightEventType::Pop);
+    EXPECT_FALSE(events.back().producer);
+    EXPECT_EQ(events.back().value, (1u << 24) - 1);
+    for (size_t i = 1; i < events.size(); ++i) {
+        EXPECT_LE(events[i - 1].ticks, events[i].ticks);
+        EXPECT_GE(events[i - 1].age_ns, events[i].age_ns);
+    }
+}
+
+TEST(SPSCQueueTest, FlightRecorderReadRacesWriter) {
+    omni::detail::FlightRing ring;
+    std::atomic<bool> stop{false};
+
+    // Each event carries its sequence number as both index and value
+    std::thread writer([&] {
+        for (uint64_t seq = 0; !stop.load(std::memory_order_relaxed); ++seq) {
+            omni::detail::RecordFlight(ring, omni::FlightEventType::Push, seq, seq & 0xFFFFFF);
+        }
+    });
+
+    // Kept events are whole (index and value from one write) and consecutive,
+    // with ticks in write order (no new ticks next to an old packed word)
+    while (ring.head.load(std::memory_order_relaxed) < 2 * omni::detail::FLIGHT_RECORDER_EVENTS) {
+        std::this_thread::yield();
+    }
+    std::vector<omni::FlightEvent> events;
+    events.reserve(omni::detail::FLIGHT_RECORDER_EVENTS);
+    size_t reads_with_events = 0;
+    for (int read = 0; read < 20000; ++read) {
+        events.clear();
+        omni::detail::ReadFlightRing(ring, true, events);
+        reads_with_events += events.empty() ? 0 : 1;
+        for (size_t i = 0; i < events.size(); ++i) {
+            ASSERT_EQ(events[i].index & 0xFFFFFF, events[i].value) << "torn at read " << read;
+            if (i > 0) {
+                ASSERT_EQ(events[i].index, events[i - 1].index + 1) << "gap at read " << read;
+                ASSERT_LE(events[i - 1].ticks, events[i].ticks) << "overwritten slot kept at read " << read;
+            }
+        }
+    }
+    stop.store(true, std::memory_order_relaxed);
+    writer.join();
+    EXPECT_GT(reads_with_events, 0);
+
+    // Once the writer is done, the full ring is readable
+    events.clear();
+    omni::detail::ReadFlightRing(ring, true, events);
+    EXPECT_EQ(events.size(), omni::detail::FLIGHT_RECORDER_EVENTS);
+}
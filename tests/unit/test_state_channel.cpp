@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "broker_test_fixture.hpp"
+#include "omni/state_channel.hpp"
+#include "omni/mailbox_broker.hpp"
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using StateChannelTest = BrokerChannelTest;
+
+TEST_F(StateChannelTest, ReadsLatestVersion) {
+    auto channel = MakeStateChannel("test-state-latest", {.capacity = 1024, .max_message_size = 64});
+    ASSERT_TRUE(channel.has_value());
+    auto& [producer, consumer] = *channel;
+
+    EXPECT_EQ(consumer.Read().first, omni::PopResult::Empty);
+    EXPECT_FALSE(consumer.ChangedSince(0));
+    EXPECT_EQ(omni::MailboxBroker::Instance().GetChannelStats("test-state-latest")->capacity, 2);  // Not 1024
+
+    ASSERT_EQ(producer.Publish(Sample(1)), omni::PushResult::Success);
+    EXPECT_EQ(producer.Version(), 1);
+    EXPECT_TRUE(consumer.ChangedSince(0));
+    auto [r1, s1] = consumer.Read();
+    ASSERT_EQ(r1, omni::PopResult::Success);
+    EXPECT_EQ(s1->version, 1);
+    EXPECT_EQ(SeqOf(s1->data), 1);
+    EXPECT_FALSE(consumer.ChangedSince(1));
+
+    // Reading again returns the same value; publishes in between are skipped
+    EXPECT_EQ(consumer.Read().second->version, 1);
+    for (uint64_t counter = 2; counter <= 5; ++counter) {
+        ASSERT_EQ(producer.Publish(Sample(counter, 8 + counter)), omni::PushResult::Success);
+    }
+    EXPECT_TRUE(consumer.ChangedSince(1));
+    EXPECT_EQ(consumer.Version(), 5);
+    auto [r2, s2] = consumer.Read();
+    ASSERT_EQ(r2, omni::PopResult::Success);
+    EXPECT_EQ(s2->version, 5);
+    EXPECT_EQ(s2->data.size(), 13);
+    EXPECT_EQ(SeqOf(s2->data), 5);
+    EXPECT_EQ(consumer.Retries(), 0);
+
+    const auto stats = omni::MailboxBroker::Instance().GetChannelStats("test-state-latest");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->messages_sent, 5);
+    EXPECT_EQ(stats->messages_received, 2);  // Versions seen, not Read() calls
+    EXPECT_EQ(stats->messages_lost, 3);
+    EXPECT_EQ(stats->depth, 0);
+}
+
+TEST_F(StateChannelTest, SizeLimitsAndDisconnect) {
+    auto channel = MakeStateChannel("test-state-close", {.max_message_size = 64});
+    ASSERT_TRUE(channel.has_value());
+    auto producer = std::move(channel->producer);
+    auto consumer = std::move(channel->consumer);
+
+    EXPECT_EQ(producer.Publish({}), omni::PushResult::InvalidSize);
+    EXPECT_EQ(producer.Publish(Sample(0, 65)), omni::PushResult::InvalidSize);
+    EXPECT_EQ(channel->producer.Publish(Sample(0)), omni::PushResult::ChannelClosed);  // Moved-from
+    EXPECT_EQ(channel->consumer.Read().first, omni::PopResult::ChannelClosed);
+
+    // The last value outlives the producer
+    ASSERT_EQ(producer.Publish(Sample(7, 64)), omni::PushResult::Success);
+    { auto gone = std::move(producer); }
+    EXPECT_FALSE(consumer.IsConnected());
+    auto [result, snapshot] = consumer.Read();
+    ASSERT_EQ(result, omni::PopResult::Success);
+    EXPECT_EQ(snapshot->data.size(), 64);
+    EXPECT_EQ(snapshot->data.back(), 7);
+
+    // Closed without ever publishing
+    auto empty = MakeStateChannel("test-state-close-2", {});
+    ASSERT_TRUE(empty.has_value());
+    { auto gone = std::move(empty->producer); }
+    EXPECT_EQ(empty->consumer.Read().first, omni::PopResult::ChannelClosed);
+
+    // Consumer gone: the producer is told
+    auto other = MakeStateChannel("test-state-close-3", {});
+    ASSERT_TRUE(other.has_value());
+    { auto gone = std::move(other->consumer); }
+    EXPECT_FALSE(other->producer.IsConnected());
+    EXPECT_EQ(other->producer.Publish(Sample(0)), omni::PushResult::ChannelClosed);
+}
+
+TEST_F(StateChannelTest, ConcurrentPublishNeverTearsAndVersionsOnlyGrow) {
+    constexpr uint64_t kPublishes = 200'000;
+    auto channel = MakeStateChannel("test-state-race", {.max_message_size = 256});
+    ASSERT_TRUE(channel.has_value());
+
+    std::atomic<bool> done{false};
+    std::thread producer([producer = std::move(channel->producer), &done]() mutable {
+        for (uint64_t counter = 1; counter <= kPublishes; ++counter) {
+            // Sizes vary so a torn read would also show as a wrong length
+            (void)producer.Publish(Sample(counter, 8 + counter % 241));
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    bool torn = false;
+    bool backwards = false;
+    uint64_t seen = 0;
+    while (true) {
+        const bool finished = done.load(std::memory_order_acquire);
+        if (!channel->consumer.ChangedSince(seen)) {
+            if (finished) {
+                break;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        auto [result, snapshot] = channel->consumer.Read();
+        EXPECT_EQ(result, omni::PopResult::Success);
+        if (!snapshot) {
+            break;  // Still join the producer below
+        }
+        const uint64_t counter = SeqOf(snapshot->data);
+        torn |= counter != snapshot->version || snapshot->data.size() != 8 + counter % 241;
+        for (size_t i = 8; i < snapshot->data.size(); ++i) {
+            torn |= snapshot->data[i] != static_cast<uint8_t>(counter);
+        }
+        backwards |= snapshot->version <= seen;
+        seen = snapshot->version;
+    }
+    producer.join();
+
+    EXPECT_FALSE(torn);
+    EXPECT_FALSE(backwards);
+    EXPECT_EQ(seen, kPublishes);
+    const auto stats = omni::MailboxBroker::Instance().GetChannelStats("test-state-race");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->messages_received + stats->messages_lost, kPublishes);
+}